@@ -76,6 +76,39 @@ extern int AxonKwsHostGetNextAudioFeatureSlice(const AudioInputFeatureType **aud
  */
 uint8_t AxonKwsModelFc4GetClassification(int32_t *score, char **label);
 
+/**
+ * Replaces the function used to read layer 1 weights from flash when the layer 1 weight cache is
+ * enabled (FC4_L1_WEIGHT_CACHE). Default is a memcpy through the memory mapped flash; boards can
+ * supply a quad read (flash_4read), host builds can supply a deliberately slow one to exercise the
+ * prefetch. NULL restores the default.
+ */
+void AxonKwsModelFc4SetWeightReader(void (*read_function)(const int8_t *flash_src, int8_t *ram_dst, uint32_t length));
+
+/**
+ * Sets the function invoked in Axon ISR context when a layer 1 weight tile needs to be read
+ * (FC4_L1_WEIGHT_CACHE). The host is expected to call AxonKwsModelFc4LoadWeights() from task or main
+ * loop context in response. With no function set (the default) tiles are read in the callback.
+ */
+void AxonKwsModelFc4SetWeightLoadRequest(void (*request_function)(void));
+
+/**
+ * Reads the requested layer 1 weight tile, and queues it if axon is waiting on it.
+ * Returns 1 if a tile was read, 0 if none was requested.
+ */
+int AxonKwsModelFc4LoadWeights();
+
+/**
+ * Time spent reading layer 1 weight tiles, and the number of tiles that weren't prefetched in time
+ * and held up axon. Both are 0 if the weight cache is disabled.
+ */
+void AxonKwsModelFc4GetWeightCacheStats(uint32_t *load_ticks, uint32_t *stall_cnt);
+
+/**
+ * Multiply-accumulates performed per inference with the pruned row blocks skipped, and the count the
+ * dense layers would perform. Both are 0 if sparse layers are disabled (FC4_SPARSE_LAYERS).
+ */
+void AxonKwsModelFc4GetSparseStats(uint32_t *macs, uint32_t *dense_macs);
+
 #ifdef __cplusplus
 } // extern "C" {
 #endif
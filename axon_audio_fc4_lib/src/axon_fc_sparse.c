@@ -0,0 +1,332 @@
+/**
+ *          Copyright (c) 2020-2022, Atlazo Inc.
+ *          All rights reserved.
+ *
+ *          Licensed under the Apache License, Version 2.0 (the "License");
+ *          you may not use this file except in compliance with the License.
+ *          You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *          Unless required by applicable law or agreed to in writing, software
+ *          distributed under the License is distributed on an "AS IS" BASIS,
+ *          WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *          See the License for the specific language governing permissions and
+ *          limitations under the License.
+ *
+ */
+#include <string.h>
+#include "axon_api.h"
+#include "axon_logging_api.h"
+#include "axon_fc_sparse.h"
+
+/*
+ * returns true if the block survives, either per the mask or, w/o a mask, because it has a non-0 weight.
+ */
+static AxonBoolEnum fc_sparse_block_survives(const uint8_t *block_mask, const int8_t *weights, uint16_t input_length, uint16_t block_ndx) {
+  if (NULL != block_mask) {
+    return (block_mask[block_ndx>>3] >> (block_ndx&7)) & 1 ? kAxonBoolTrue : kAxonBoolFalse;
+  }
+  const int8_t *block_weights = weights + (uint32_t)block_ndx*FC_SPARSE_BLOCK_ROWS*input_length;
+  for (uint32_t ndx=0;ndx<(uint32_t)FC_SPARSE_BLOCK_ROWS*input_length;ndx++) {
+    if (0 != block_weights[ndx]) {
+      return kAxonBoolTrue;
+    }
+  }
+  return kAxonBoolFalse;
+}
+
+/*
+ * Returns the size of the input in bytes.
+ */
+static uint32_t fc_sparse_input_bytes(uint16_t input_length, AxonDataWidthEnum input_data_width) {
+  switch (input_data_width) {
+  case kAxonDataWidth8: return input_length;
+  case kAxonDataWidth16:
+  case kAxonDataWidth12: return input_length*sizeof(int16_t);
+  default: return input_length*sizeof(int32_t);
+  }
+}
+
+
+/*
+ * Pruned rows have all 0 weights, so their output doesn't depend on the input: it is whatever the bias, activation,
+ * normalization and quantization make of a dot product of 0. It is found at prepare w/ a FullyConnected layer over
+ * the pruned rows' constants, a short 0 input and FC_SPARSE_CONSTANT_ROWS rows of 0 weights at a time.
+ */
+#define FC_SPARSE_CONSTANT_INPUT_LENGTH 16
+static const _Alignas(16) int8_t fc_sparse_zero_weights[FC_SPARSE_CONSTANT_ROWS][FC_SPARSE_CONSTANT_INPUT_LENGTH];
+
+static AxonResultEnum fc_sparse_compute_pruned_output(void *axon_handle,
+    uint16_t first_row,
+    uint16_t row_cnt,
+    const int32_t *bias_prime,
+    int32_t bias_add_multiplier,
+    uint16_t bias_add_rounding,
+    AxonAfEnum activation_function,
+    const int32_t *normalization_mult,
+    uint8_t normalization_mult_rounding,
+    const int32_t *normalization_add,
+    uint8_t normalization_add_rounding,
+    int32_t quantize_multiplier,
+    int32_t quantize_add,
+    uint8_t quantize_rounding,
+    int32_t standalone_quantize_add,
+    int32_t *buf1,
+    int32_t *buf2,
+    uint16_t buf1_length,
+    uint16_t buf2_length,
+    int32_t *run_io_buffer,
+    uint16_t sparse_buffer_length,
+    int32_t *pruned_output,
+    AxonOpHandle *axon_op_handles,
+    uint8_t op_handle_cnt,
+    AxonFullyConnectedStopStepEnum stop_step) {
+  AxonResultEnum result;
+  for (uint16_t row=first_row;row<first_row+row_cnt;row+=FC_SPARSE_CONSTANT_ROWS) {
+    uint16_t rows = first_row+row_cnt-row < FC_SPARSE_CONSTANT_ROWS ? first_row+row_cnt-row : FC_SPARSE_CONSTANT_ROWS;
+    uint8_t tmp_op_handle_cnt = op_handle_cnt;
+    memset(run_io_buffer, 0, FC_SPARSE_CONSTANT_INPUT_LENGTH);
+    if (kAxonResultSuccess != (result = AxonApiDefineOpListFullyConnectedWithStopStep(axon_handle,
+        FC_SPARSE_CONSTANT_INPUT_LENGTH,
+        rows,
+        kAxonDataWidth8,
+        run_io_buffer,
+        sparse_buffer_length,
+        fc_sparse_zero_weights[0],
+        NULL==bias_prime ? NULL : bias_prime+row,
+        bias_add_multiplier,
+        bias_add_rounding,
+        activation_function,
+        NULL==normalization_mult ? NULL : normalization_mult+row,
+        normalization_mult_rounding,
+        NULL==normalization_add ? NULL : normalization_add+row,
+        normalization_add_rounding,
+        quantize_multiplier,
+        quantize_add,
+        quantize_rounding,
+        standalone_quantize_add,
+        buf1,
+        buf2,
+        buf1_length,
+        buf2_length,
+        axon_op_handles,
+        &tmp_op_handle_cnt,
+        stop_step))) {
+      return result;
+    }
+    result = AxonApiExecuteOps(axon_handle, tmp_op_handle_cnt, axon_op_handles, kAxonAsyncModeSynchronous);
+    AxonApiFreeOpHandles(axon_handle, tmp_op_handle_cnt, axon_op_handles);
+    if (kAxonResultSuccess > result) {
+      return result;
+    }
+    memcpy(pruned_output+row, run_io_buffer, rows*sizeof(int32_t));
+  }
+  return kAxonResultSuccess;
+}
+
+AxonResultEnum AxonFcSparseDefineOpList(void *axon_handle,
+    uint16_t input_length,
+    uint16_t output_length,
+    AxonDataWidthEnum input_data_width,
+    int32_t *io_buffer,
+    uint16_t io_buffer_length,
+    const int8_t *weights,
+    const int32_t *bias_prime,
+    int32_t bias_add_multiplier,
+    uint16_t bias_add_rounding,
+    AxonAfEnum activation_function,
+    const int32_t *normalization_mult,
+    uint8_t normalization_mult_rounding,
+    const int32_t *normalization_add,
+    uint8_t normalization_add_rounding,
+    int32_t quantize_multiplier,
+    int32_t quantize_add,
+    uint8_t quantize_rounding,
+    int32_t standalone_quantize_add,
+    int32_t *buf1,
+    int32_t *buf2,
+    uint16_t buf1_length,
+    uint16_t buf2_length,
+    const uint8_t *block_mask,
+    int32_t *input_copy,
+    int32_t *run_io_buffer,
+    uint16_t sparse_buffer_length,
+    int32_t *pruned_output,
+    AxonOpHandle *axon_op_handles,
+    uint8_t *op_handle_cnt,
+    AxonFullyConnectedStopStepEnum stop_step,
+    FcSparseInfoStruct *info) {
+  AxonResultEnum result;
+  AxonInputStruct axon_input;
+  uint16_t block_cnt = output_length/FC_SPARSE_BLOCK_ROWS;
+  uint16_t surviving_rows = 0;
+  uint16_t longest_run = 0;
+  uint16_t run_rows = 0;
+  uint8_t run_cnt = 0;
+  uint8_t total_ops_needed = 0;
+  uint8_t tmp_op_handle_cnt;
+  uint16_t input_copy_words = FC_SPARSE_COPY_WORDS(fc_sparse_input_bytes(input_length, input_data_width));
+
+  if ((NULL==op_handle_cnt) || (NULL==io_buffer) || (NULL==weights)) {
+    return kAxonResultFailureNullBuffer;
+  }
+  if (block_cnt*FC_SPARSE_BLOCK_ROWS != output_length) {
+    return kAxonResultFailureInvalidLength;
+  }
+
+  for (uint16_t block_ndx=0;block_ndx<block_cnt;block_ndx++) {
+    if (!fc_sparse_block_survives(block_mask, weights, input_length, block_ndx)) {
+      run_rows = 0;
+      continue;
+    }
+    if (0==run_rows) {
+      run_cnt++;
+    }
+    run_rows += FC_SPARSE_BLOCK_ROWS;
+    surviving_rows += FC_SPARSE_BLOCK_ROWS;
+    longest_run = run_rows > longest_run ? run_rows : longest_run;
+  }
+  if (NULL != info) {
+    info->surviving_rows = surviving_rows;
+    info->run_cnt = run_cnt;
+  }
+
+  if (surviving_rows == output_length) {
+    // nothing pruned, the dense layer is cheaper than copying around it.
+    return AxonApiDefineOpListFullyConnectedWithStopStep(axon_handle, input_length, output_length, input_data_width,
+        io_buffer, io_buffer_length, weights, bias_prime, bias_add_multiplier, bias_add_rounding, activation_function,
+        normalization_mult, normalization_mult_rounding, normalization_add, normalization_add_rounding,
+        quantize_multiplier, quantize_add, quantize_rounding, standalone_quantize_add,
+        buf1, buf2, buf1_length, buf2_length, axon_op_handles, op_handle_cnt, stop_step);
+  }
+
+  if ((NULL==input_copy) || (NULL==run_io_buffer) || (NULL==pruned_output)) {
+    return kAxonResultFailureNullBuffer;
+  }
+  if ((sparse_buffer_length < input_copy_words) || (sparse_buffer_length < longest_run) || (io_buffer_length < input_copy_words) ||
+      (sparse_buffer_length < FC_SPARSE_CONSTANT_ROWS)) {
+    return kAxonResultBufferTooSmall;
+  }
+
+  // copies are bit-for-bit, done as packed int16s.
+  axon_input.data_width = kAxonDataWidth16;
+  axon_input.data_packing = kAxonDataPackingEnabled;
+  axon_input.output_rounding = kAxonRoundingNone;
+  axon_input.output_af = kAxonAfDisabled;
+  axon_input.x_stride = kAxonStride1;
+  axon_input.y_stride = kAxonStride1;
+  axon_input.q_stride = kAxonStride1;
+  axon_input.y_in = NULL;
+  axon_input.y_length = 0;
+
+  if (total_ops_needed+1 > *op_handle_cnt) {
+    return kAxonResultNotEnoughOpHandles;
+  }
+  // set the input aside, the runs' outputs are about to overwrite it.
+  axon_input.x_in = io_buffer;
+  axon_input.q_out = input_copy;
+  axon_input.length = input_copy_words*sizeof(int32_t)/sizeof(int16_t);
+  if (kAxonResultSuccess > (result = AxonApiDefineOpMemCpy(axon_handle, &axon_input, axon_op_handles+total_ops_needed))) {
+    return result;
+  }
+  total_ops_needed++;
+
+  for (uint16_t block_ndx=0;block_ndx<block_cnt;) {
+    AxonBoolEnum survives = fc_sparse_block_survives(block_mask, weights, input_length, block_ndx);
+    uint16_t first_row = block_ndx*FC_SPARSE_BLOCK_ROWS;
+    run_rows = 0;
+    for (;(block_ndx<block_cnt) && (survives==fc_sparse_block_survives(block_mask, weights, input_length, block_ndx));block_ndx++) {
+      run_rows += FC_SPARSE_BLOCK_ROWS;
+    }
+
+    if (!survives) {
+      // pruned rows get their precomputed output.
+      if (total_ops_needed+1 > *op_handle_cnt) {
+        AxonApiFreeOpHandles(axon_handle, total_ops_needed, axon_op_handles);
+        return kAxonResultNotEnoughOpHandles;
+      }
+      if (kAxonResultSuccess > (result = fc_sparse_compute_pruned_output(axon_handle, first_row, run_rows,
+          bias_prime, bias_add_multiplier, bias_add_rounding, activation_function,
+          normalization_mult, normalization_mult_rounding, normalization_add, normalization_add_rounding,
+          quantize_multiplier, quantize_add, quantize_rounding, standalone_quantize_add,
+          buf1, buf2, buf1_length, buf2_length, run_io_buffer, sparse_buffer_length, pruned_output,
+          axon_op_handles+total_ops_needed, *op_handle_cnt-total_ops_needed, stop_step))) {
+        AxonApiFreeOpHandles(axon_handle, total_ops_needed, axon_op_handles);
+        return result;
+      }
+      axon_input.x_in = pruned_output+first_row;
+      axon_input.q_out = io_buffer+first_row;
+      axon_input.length = run_rows*sizeof(int32_t)/sizeof(int16_t);
+      if (kAxonResultSuccess > (result = AxonApiDefineOpMemCpy(axon_handle, &axon_input, axon_op_handles+total_ops_needed))) {
+        AxonApiFreeOpHandles(axon_handle, total_ops_needed, axon_op_handles);
+        return result;
+      }
+      total_ops_needed++;
+      continue;
+    }
+
+    if (total_ops_needed+2 > *op_handle_cnt) {
+      AxonApiFreeOpHandles(axon_handle, total_ops_needed, axon_op_handles);
+      return kAxonResultNotEnoughOpHandles;
+    }
+
+    // copy the input in
+    axon_input.x_in = input_copy;
+    axon_input.q_out = run_io_buffer;
+    axon_input.length = input_copy_words*sizeof(int32_t)/sizeof(int16_t);
+    if (kAxonResultSuccess > (result = AxonApiDefineOpMemCpy(axon_handle, &axon_input, axon_op_handles+total_ops_needed))) {
+      AxonApiFreeOpHandles(axon_handle, total_ops_needed, axon_op_handles);
+      return result;
+    }
+    total_ops_needed++;
+
+    // the whole layer over the run's rows
+    tmp_op_handle_cnt = *op_handle_cnt-total_ops_needed-1; // leave room for the output copy
+    result = AxonApiDefineOpListFullyConnectedWithStopStep(axon_handle,
+        input_length,
+        run_rows,
+        input_data_width,
+        run_io_buffer,
+        sparse_buffer_length,
+        weights+(uint32_t)first_row*input_length,
+        NULL==bias_prime ? NULL : bias_prime+first_row,
+        bias_add_multiplier,
+        bias_add_rounding,
+        activation_function,
+        NULL==normalization_mult ? NULL : normalization_mult+first_row,
+        normalization_mult_rounding,
+        NULL==normalization_add ? NULL : normalization_add+first_row,
+        normalization_add_rounding,
+        quantize_multiplier,
+        quantize_add,
+        quantize_rounding,
+        standalone_quantize_add,
+        buf1,
+        buf2,
+        buf1_length,
+        buf2_length,
+        axon_op_handles+total_ops_needed,
+        &tmp_op_handle_cnt,
+        stop_step);
+    if (kAxonResultSuccess != result) {
+      axon_printf(axon_handle, "Define sparse FC rows %d-%d failed! %d\r\n", first_row, first_row+run_rows-1, result);
+      AxonApiFreeOpHandles(axon_handle, total_ops_needed, axon_op_handles);
+      return result;
+    }
+    total_ops_needed += tmp_op_handle_cnt;
+
+    // scatter the outputs into their rows
+    axon_input.x_in = run_io_buffer;
+    axon_input.q_out = io_buffer+first_row;
+    axon_input.length = run_rows*sizeof(int32_t)/sizeof(int16_t);
+    if (kAxonResultSuccess > (result = AxonApiDefineOpMemCpy(axon_handle, &axon_input, axon_op_handles+total_ops_needed))) {
+      AxonApiFreeOpHandles(axon_handle, total_ops_needed, axon_op_handles);
+      return result;
+    }
+    total_ops_needed++;
+  }
+
+  *op_handle_cnt = total_ops_needed;
+  return kAxonResultSuccess;
+}
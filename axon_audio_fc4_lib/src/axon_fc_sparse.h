@@ -0,0 +1,96 @@
+/**
+ *          Copyright (c) 2020-2022, Atlazo Inc.
+ *          All rights reserved.
+ *
+ *          Licensed under the Apache License, Version 2.0 (the "License");
+ *          you may not use this file except in compliance with the License.
+ *          You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *          Unless required by applicable law or agreed to in writing, software
+ *          distributed under the License is distributed on an "AS IS" BASIS,
+ *          WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *          See the License for the specific language governing permissions and
+ *          limitations under the License.
+ *
+ */
+#pragma once
+#include "axon_api.h"
+
+/*
+ * Structured row-sparse fully connected layer.
+ * Output rows are grouped into blocks of FC_SPARSE_BLOCK_ROWS. Blocks whose weights are all 0 are
+ * skipped: each run of consecutive surviving blocks gets its own FullyConnected op list over its rows, and
+ * the pruned rows get their output copied in. That output doesn't depend on the input, so it is computed
+ * once at prepare. Rows are independent in a FullyConnected layer, so the output is bit-exact w/ the
+ * dense layer.
+ */
+#define FC_SPARSE_BLOCK_ROWS 4
+
+/*
+ * Pruned rows' output is computed at prepare this many rows at a time.
+ */
+#define FC_SPARSE_CONSTANT_ROWS 32
+
+/*
+ * block mask has 1 bit per block, lsb 1st. Bit set => block survives.
+ */
+#define FC_SPARSE_MASK_BYTES(OUTPUT_LENGTH) (((OUTPUT_LENGTH)/FC_SPARSE_BLOCK_ROWS+7)/8)
+
+/*
+ * Copies are done as packed int16s, which need multiples of 8. Returns the number of int32s
+ * to copy to move INPUT_BYTES of input.
+ */
+#define FC_SPARSE_COPY_WORDS(INPUT_BYTES) ((((INPUT_BYTES)+15)/16)*4)
+
+typedef struct {
+  uint16_t surviving_rows;  /**< rows that get multiplied. MAC count is surviving_rows*input_length */
+  uint8_t run_cnt;          /**< runs of consecutive surviving blocks, 1 FullyConnected op list each */
+} FcSparseInfoStruct;
+
+/**
+ * Same parameters as AxonApiDefineOpListFullyConnectedWithStopStep(), plus:
+ * block_mask     surviving blocks, generated offline. If NULL, blocks of all 0 weights are found by scanning weights.
+ *                Pruned blocks must have all 0 weights.
+ * input_copy     holds the layer input while the runs execute. At least FC_SPARSE_COPY_WORDS(input bytes) long.
+ * run_io_buffer  io buffer for each run. At least as long as input_copy, the longest run and FC_SPARSE_CONSTANT_ROWS.
+ * pruned_output  output_length long, 16 byte aligned. Receives the pruned rows' output at prepare and has to
+ *                stay valid as long as the op list.
+ * info           optional, receives the surviving row and run counts.
+ *
+ * Note: the pruned rows' output is computed by executing small FullyConnected op lists synchronously,
+ * FC_SPARSE_CONSTANT_ROWS rows w/ an input of 16 at a time. run_io_buffer gets overwritten.
+ */
+AxonResultEnum AxonFcSparseDefineOpList(void *axon_handle,
+    uint16_t input_length,
+    uint16_t output_length,
+    AxonDataWidthEnum input_data_width,
+    int32_t *io_buffer,
+    uint16_t io_buffer_length,
+    const int8_t *weights,
+    const int32_t *bias_prime,
+    int32_t bias_add_multiplier,
+    uint16_t bias_add_rounding,
+    AxonAfEnum activation_function,
+    const int32_t *normalization_mult,
+    uint8_t normalization_mult_rounding,
+    const int32_t *normalization_add,
+    uint8_t normalization_add_rounding,
+    int32_t quantize_multiplier,
+    int32_t quantize_add,
+    uint8_t quantize_rounding,
+    int32_t standalone_quantize_add,
+    int32_t *buf1,
+    int32_t *buf2,
+    uint16_t buf1_length,
+    uint16_t buf2_length,
+    const uint8_t *block_mask,
+    int32_t *input_copy,
+    int32_t *run_io_buffer,
+    uint16_t sparse_buffer_length,
+    int32_t *pruned_output,
+    AxonOpHandle *axon_op_handles,
+    uint8_t *op_handle_cnt,
+    AxonFullyConnectedStopStepEnum stop_step,
+    FcSparseInfoStruct *info);
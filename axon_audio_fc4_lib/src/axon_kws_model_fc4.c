@@ -19,9 +19,19 @@
 #include <string.h>
 #include <assert.h>
 #include "axon_api.h"
+#include "axon_dep.h"
 #include "axon_kws_model_fc4_api.h"
-#include "axon_kws_model_fc4_const.h"
+/*
+ * A pruned weight set can be dropped in by pointing FC4_CONST_HEADER at it. It has the same contents as
+ * axon_kws_model_fc4_const.h, optionally w/ FC4_L<n>_BLOCK_MASK row-block masks (see axon_fc_sparse.h).
+ */
+#ifndef FC4_CONST_HEADER
+# define FC4_CONST_HEADER "axon_kws_model_fc4_const.h"
+#endif
+#include FC4_CONST_HEADER
+#include "axon_fc_sparse.h"
 #include "axon_logging_api.h"
+#include "axon_kws_stats_api.h"
 
 /*
 * make sure there is agreement between the internal model dimensions and the API stated model dimensions.
@@ -67,19 +77,218 @@ static_assert(FC4_L4_OUTPUT_LENGTH==FC4_OUTPUT_LENGTH, "FC4 OUTPUT LENGTH MISMAT
 # define FC4_DEBUG_FINAL_STEP_NAME "FC4_L1_OUTPUT"
 #endif
 
+/*
+ * Layer 1 weight cache
+ * Layer 1 weights (610x144 int8) live in flash, which axon can't reach, so the driver stages them row by row
+ * through the mm line buffer while the matrix multiply waits.
+ * With FC4_L1_WEIGHT_CACHE set, layer 1 is split into FC4_L1_TILE_CNT row tiles instead. Each tile is a
+ * fully connected layer of its own over a RAM copy of its weights. Tiles alternate between 2 RAM buffers, and
+ * the next tile is read from flash while axon is busy with the current one.
+ * The tile callbacks only request reads; the host does them from task or main loop context (see
+ * AxonKwsModelFc4SetWeightLoadRequest()), and a tile that isn't read in time gets queued once it is.
+ * Everything after the dot product is per-row, so the tiled output is bit-exact w/ the untiled output.
+ * Costs 2 x FC4_L1_TILE_ROWS x FC4_L1_PADDED_INPUT_LENGTH bytes of RAM and ~12 op handles per tile.
+ */
+#ifndef FC4_L1_WEIGHT_CACHE
+# define FC4_L1_WEIGHT_CACHE 0
+#endif
+
+#if FC4_L1_WEIGHT_CACHE
+# define FC4_L1_TILE_ROWS 36
+# define FC4_L1_TILE_CNT (FC4_L1_OUTPUT_LENGTH/FC4_L1_TILE_ROWS)
+static_assert(FC4_L1_TILE_CNT*FC4_L1_TILE_ROWS==FC4_L1_OUTPUT_LENGTH, "FC4_L1_TILE_ROWS MUST DIVIDE THE LAYER 1 OUTPUT LENGTH!");
+static_assert(0==(FC4_L1_TILE_CNT&1), "FC4_L1_TILE_CNT MUST BE EVEN SO TILE 0 CAN BE PREFETCHED DURING THE LAST TILE!");
+static_assert(0==(FC4_L1_TILE_ROWS&1), "FC4_L1_TILE_ROWS MUST BE EVEN!");
+/*
+ * weights in RAM need rows that are a multiple of 16 long. The input is zero padded to match so the padding
+ * contributes nothing.
+ */
+# define FC4_L1_PADDED_INPUT_LENGTH ((FC4_L1_INPUT_LENGTH+15) & ~0xf)
+# define FC4_L1_TILE_IO_BUFFER_SIZE (FC4_L1_PADDED_INPUT_LENGTH/4 > FC4_L1_TILE_ROWS ? FC4_L1_PADDED_INPUT_LENGTH/4 : FC4_L1_TILE_ROWS)
+# define FC4_AXON_OP_HANDLE_COUNT (12*FC4_L1_TILE_CNT+30) // 10 per layer, plus 2 copies per tile.
+#endif
+
+/*
+ * Sparse layers
+ * With FC4_SPARSE_LAYERS set, each layer skips the blocks of FC_SPARSE_BLOCK_ROWS rows that have been pruned
+ * to 0. Blocks are taken from FC4_L<n>_BLOCK_MASK if the weight header provides one, otherwise all 0 blocks are
+ * found at prepare. Output is bit-exact w/ the dense layers over the same weights.
+ * The rows and MACs actually performed get printed at prepare.
+ * Each layer costs a copy, a copy per gap and, per run of surviving blocks, 2 copies plus a FullyConnected
+ * op list (~12 op handles). Budgeted as FC4_SPARSE_MAX_RUNS runs per layer.
+ */
+#define FC4_SPARSE_LAYERS 0
+
+#if FC4_SPARSE_LAYERS
+static_assert(!FC4_L1_WEIGHT_CACHE, "FC4_SPARSE_LAYERS AND FC4_L1_WEIGHT_CACHE ARE MUTUALLY EXCLUSIVE!");
+# define FC4_SPARSE_MAX_RUNS 4
+# define FC4_AXON_OP_HANDLE_COUNT (4*(2+15*FC4_SPARSE_MAX_RUNS)) // 2 per layer, 14 per run plus its gap.
+static_assert(FC4_AXON_OP_HANDLE_COUNT<=255, "FC4_SPARSE_MAX_RUNS TOO LARGE!");
+# ifndef FC4_L1_BLOCK_MASK
+#  define FC4_L1_BLOCK_MASK NULL
+# endif
+# ifndef FC4_L2_BLOCK_MASK
+#  define FC4_L2_BLOCK_MASK NULL
+# endif
+# ifndef FC4_L3_BLOCK_MASK
+#  define FC4_L3_BLOCK_MASK NULL
+# endif
+# ifndef FC4_L4_BLOCK_MASK
+#  define FC4_L4_BLOCK_MASK NULL
+# endif
+# define FC4_SPARSE_BUFFER_SIZE FC_SPARSE_COPY_WORDS(FC4_L1_INPUT_LENGTH)
+#endif
+
+#ifndef FC4_AXON_OP_HANDLE_COUNT
+# define FC4_AXON_OP_HANDLE_COUNT 40 // 10 per layer.
+#endif
+
 RETAINED_MEMORY_SECTION_ATTRIBUTE
 static struct {
-# define FC4_AXON_OP_HANDLE_COUNT 40 // 10 per layer.
   AxonOpHandle fc4_axon_op_handles[FC4_AXON_OP_HANDLE_COUNT];
   void *axon_handle;
   void (*result_callback_function)(AxonResultEnum result);
   int32_t *io_buffer;
   uint8_t fc4_op_handle_count;
+#if FC4_L1_WEIGHT_CACHE
+  uint8_t l1_tile_op_ndx[FC4_L1_TILE_CNT+1]; // 1st op handle of each tile. Last entry is the 1st op of layer 2.
+  uint8_t l1_tile_ndx; // tile currently executing
+  volatile int8_t l1_resident_tile[2]; // which tile is in each weight buffer, -1 for none.
+  volatile int8_t l1_requested_tile; // tile the host has been asked to read, -1 for none.
+  volatile int8_t l1_waiting_tile; // tile that is due on axon but not read yet, -1 for none.
+#endif
 } fc4_retained_info;
 
+/*
+ * reads weights from flash into RAM. Defaults to a memcpy through the memory mapped flash.
+ */
+static void fc4_weight_read_memcpy(const int8_t *flash_src, int8_t *ram_dst, uint32_t length) {
+  memcpy(ram_dst, flash_src, length);
+}
+static void (*fc4_weight_read_function)(const int8_t *flash_src, int8_t *ram_dst, uint32_t length) = fc4_weight_read_memcpy;
+// asks the host to call AxonKwsModelFc4LoadWeights(). NULL reads tiles in the callback.
+static void (*fc4_weight_load_request_function)(void);
+static struct {
+  uint32_t load_ticks;   // time spent reading tiles from flash
+  uint32_t stall_cnt;    // tiles that weren't prefetched and had to be read before being queued
+} fc4_weight_cache_stats;
 
+void AxonKwsModelFc4SetWeightReader(void (*read_function)(const int8_t *flash_src, int8_t *ram_dst, uint32_t length)) {
+  fc4_weight_read_function = NULL==read_function ? fc4_weight_read_memcpy : read_function;
+}
 
-static int axon_kws_model_fc4_prepare(void *axon_handle,
+void AxonKwsModelFc4SetWeightLoadRequest(void (*request_function)(void)) {
+  fc4_weight_load_request_function = request_function;
+}
+
+void AxonKwsModelFc4GetWeightCacheStats(uint32_t *load_ticks, uint32_t *stall_cnt) {
+  if (NULL != load_ticks) {
+    *load_ticks = fc4_weight_cache_stats.load_ticks;
+  }
+  if (NULL != stall_cnt) {
+    *stall_cnt = fc4_weight_cache_stats.stall_cnt;
+  }
+}
+
+#if FC4_L1_WEIGHT_CACHE
+static int8_t _Alignas(16) fc4_l1_weight_tiles[2][FC4_L1_TILE_ROWS][FC4_L1_PADDED_INPUT_LENGTH];
+// quantized input is gathered here, then copied into the tile io buffer ahead of each tile.
+static int8_t _Alignas(16) fc4_l1_input[FC4_L1_PADDED_INPUT_LENGTH];
+static _Alignas(16) int32_t fc4_l1_tile_io_buffer[FC4_L1_TILE_IO_BUFFER_SIZE];
+#endif
+
+static struct {
+  uint32_t macs;        // multiply-accumulates performed per inference
+  uint32_t dense_macs;  // multiply-accumulates the dense layers would perform
+} fc4_sparse_stats;
+
+void AxonKwsModelFc4GetSparseStats(uint32_t *macs, uint32_t *dense_macs) {
+  if (NULL != macs) {
+    *macs = fc4_sparse_stats.macs;
+  }
+  if (NULL != dense_macs) {
+    *dense_macs = fc4_sparse_stats.dense_macs;
+  }
+}
+
+#if FC4_SPARSE_LAYERS
+// layer input is set aside here, then copied into the run io buffer ahead of each run.
+static _Alignas(16) int32_t fc4_sparse_input_copy[FC4_SPARSE_BUFFER_SIZE];
+static _Alignas(16) int32_t fc4_sparse_run_io_buffer[FC4_SPARSE_BUFFER_SIZE];
+static_assert(FC4_SPARSE_BUFFER_SIZE>=FC_SPARSE_CONSTANT_ROWS, "FC4_SPARSE_BUFFER_SIZE TOO SMALL!");
+
+// output of the pruned rows, computed at prepare and copied in by the op lists.
+RETAINED_MEMORY_SECTION_ATTRIBUTE
+static _Alignas(16) int32_t fc4_sparse_pruned_output[FC4_L1_OUTPUT_LENGTH+FC4_L2_OUTPUT_LENGTH+FC4_L3_OUTPUT_LENGTH+FC4_L4_OUTPUT_LENGTH];
+static const uint16_t fc4_sparse_pruned_output_offset[] = {
+    0,
+    FC4_L1_OUTPUT_LENGTH,
+    FC4_L1_OUTPUT_LENGTH+FC4_L2_OUTPUT_LENGTH,
+    FC4_L1_OUTPUT_LENGTH+FC4_L2_OUTPUT_LENGTH+FC4_L3_OUTPUT_LENGTH,
+};
+
+static void fc4_sparse_add_stats(void *axon_handle, uint8_t layer, uint16_t input_length, uint16_t output_length, const FcSparseInfoStruct *info) {
+  axon_printf(axon_handle, "FC4_L%d sparse: %d/%d rows, %d runs\r\n", layer, info->surviving_rows, output_length, info->run_cnt);
+  fc4_sparse_stats.macs += (uint32_t)info->surviving_rows*input_length;
+  fc4_sparse_stats.dense_macs += (uint32_t)output_length*input_length;
+}
+#endif
+
+/*
+ * Per layer parameters, as generated by the Axon Tflite pre-compiler into FC4_CONST_HEADER.
+ */
+typedef struct {
+  uint16_t input_length;
+  uint16_t output_length;
+  AxonDataWidthEnum input_data_width; /**< nominally 8bit but unsaturated, and unpacked */
+  const int8_t *weights;
+  const int32_t *bias_prime;
+  int32_t bias_add_multiplier;
+  uint16_t bias_add_rounding;
+  AxonAfEnum activation_function;
+  const int32_t *normalization_mult;
+  uint8_t normalization_mult_rounding;
+  const int32_t *normalization_add;
+  uint8_t normalization_add_rounding;
+  int32_t quantize_multiplier;
+  int32_t quantize_add;
+  uint8_t quantize_rounding;
+  int32_t standalone_quantize_add; /**< used only when non-0. Only necessary when quantize_add cannot be provided in sufficient precision */
+#if FC4_SPARSE_LAYERS
+  const uint8_t *block_mask;
+#endif
+} Fc4LayerStruct;
+
+#if FC4_SPARSE_LAYERS
+# define FC4_LAYER_BLOCK_MASK(N) , FC4_L##N##_BLOCK_MASK
+#else
+# define FC4_LAYER_BLOCK_MASK(N)
+#endif
+#define FC4_LAYER(N) { \
+    FC4_L##N##_INPUT_LENGTH, \
+    FC4_L##N##_OUTPUT_LENGTH, \
+    FC4_L##N##_INPUT_BITWIDTH, \
+    fc4_l##N##_weights[0], \
+    fc4_l##N##_bias_prime, \
+    FC4_L##N##_BIAS_ADD_MULTIPLIER, \
+    FC4_L##N##_BIAS_ADD_ROUNDING, \
+    FC4_L##N##_ACTIVATION_FUNCTION, \
+    fc4_l##N##_normalization_mult, \
+    FC4_L##N##_NORM_MULT_ROUNDING, \
+    fc4_l##N##_normalization_add, \
+    FC4_L##N##_NORM_ADD_ROUNDING, \
+    FC4_L##N##_QUANTIZE_MULTIPLIER, \
+    FC4_L##N##_QUANTIZE_ADD, \
+    FC4_L##N##_QUANTIZE_ROUNDING, \
+    FC4_L##N##_QUANTIZE_STANDALONE_ADD \
+    FC4_LAYER_BLOCK_MASK(N) }
+
+/*
+ * Defines a layer, skipping pruned row blocks if FC4_SPARSE_LAYERS is set.
+ */
+static AxonResultEnum fc4_define_layer(void *axon_handle,
+    uint8_t layer,
+    const Fc4LayerStruct *params,
     AxonOpHandle axon_op_handles[],
     uint8_t *op_handle_count,
     int32_t *io_buffer,
@@ -87,170 +296,276 @@ static int axon_kws_model_fc4_prepare(void *axon_handle,
     int32_t *buf1,
     int32_t *buf2,
     uint16_t buf1_length,
-    uint16_t buf2_length) {
+    uint16_t buf2_length,
+    AxonFullyConnectedStopStepEnum stop_step) {
+#if FC4_SPARSE_LAYERS
+  FcSparseInfoStruct sparse_info;
+  AxonResultEnum result = AxonFcSparseDefineOpList(axon_handle,
+      params->input_length,
+      params->output_length,
+      params->input_data_width,
+      io_buffer,
+      io_buffer_length,
+      params->weights,
+      params->bias_prime,
+      params->bias_add_multiplier,
+      params->bias_add_rounding,
+      params->activation_function,
+      params->normalization_mult,
+      params->normalization_mult_rounding,
+      params->normalization_add,
+      params->normalization_add_rounding,
+      params->quantize_multiplier,
+      params->quantize_add,
+      params->quantize_rounding,
+      params->standalone_quantize_add,
+      buf1,
+      buf2,
+      buf1_length,
+      buf2_length,
+      params->block_mask,
+      fc4_sparse_input_copy,
+      fc4_sparse_run_io_buffer,
+      FC4_SPARSE_BUFFER_SIZE,
+      fc4_sparse_pruned_output+fc4_sparse_pruned_output_offset[layer-1],
+      axon_op_handles,
+      op_handle_count,
+      stop_step,
+      &sparse_info);
+  if (kAxonResultSuccess == result) {
+    fc4_sparse_add_stats(axon_handle, layer, params->input_length, params->output_length, &sparse_info);
+  }
+  return result;
+#else
+  (void)layer;
+  return AxonApiDefineOpListFullyConnectedWithStopStep(axon_handle,
+      params->input_length,
+      params->output_length,
+      params->input_data_width,
+      io_buffer,
+      io_buffer_length,     /**< length of buf1. Must be >= max(input_length, output_length) */
+      params->weights,
+      params->bias_prime,
+      params->bias_add_multiplier,
+      params->bias_add_rounding,
+      params->activation_function,
+      params->normalization_mult,
+      params->normalization_mult_rounding,
+      params->normalization_add,
+      params->normalization_add_rounding,
+      params->quantize_multiplier,
+      params->quantize_add,
+      params->quantize_rounding,
+      params->standalone_quantize_add,
+      buf1,
+      buf2,
+      buf1_length,            /**< length of buf1. Must be >= output_length */
+      buf2_length,            /**< length of buf2. Must be >= output_length */
+      axon_op_handles,
+      op_handle_count,
+      stop_step);
+#endif
+}
 
-  // define each of the layers, appending the operations to each other.
-  if (NULL==op_handle_count) {
-    return kAxonResultFailureNullBuffer;
+#if FC4_L1_WEIGHT_CACHE
+/*
+ * Reads a tile of layer 1 weights into the weight buffer it alternates into.
+ * The row padding is never written so it stays 0.
+ * The caller marks the tile resident.
+ */
+static void fc4_l1_read_tile(uint8_t tile_ndx) {
+  uint32_t start_time = AxonHostGetTime();
+  fc4_retained_info.l1_resident_tile[tile_ndx&1] = -1;
+  for (uint16_t row=0;row<FC4_L1_TILE_ROWS;row++) {
+    fc4_weight_read_function(fc4_l1_weights[tile_ndx*FC4_L1_TILE_ROWS+row], fc4_l1_weight_tiles[tile_ndx&1][row], FC4_L1_INPUT_LENGTH);
   }
+  fc4_weight_cache_stats.load_ticks += AxonHostGetTime()-start_time;
+}
+
+/*
+ * Gets a tile read. Called from the tile callbacks, so the read itself is left to the host unless it
+ * hasn't set a request function.
+ */
+static void fc4_l1_request_tile(uint8_t tile_ndx) {
+  if (NULL==fc4_weight_load_request_function) {
+    fc4_l1_read_tile(tile_ndx);
+    fc4_retained_info.l1_resident_tile[tile_ndx&1] = tile_ndx;
+    return;
+  }
+  fc4_retained_info.l1_requested_tile = tile_ndx;
+  fc4_weight_load_request_function();
+}
+
+/*
+ * Defines layer 1 as FC4_L1_TILE_CNT fully connected layers, each preceded by a copy of the input into
+ * the tile io buffer and followed by a copy of the tile output into its slot in io_buffer.
+ */
+static AxonResultEnum fc4_l1_define_tiles(void *axon_handle,
+    AxonOpHandle axon_op_handles[],
+    uint8_t *op_handle_count,
+    int32_t *io_buffer,
+    int32_t *buf1,
+    int32_t *buf2,
+    uint16_t buf1_length,
+    uint16_t buf2_length) {
   AxonResultEnum result;
-  uint8_t tmp_op_handle_cnt;
+  AxonInputStruct axon_input;
   uint8_t total_ops_needed = 0;
-  tmp_op_handle_cnt=*op_handle_count-total_ops_needed;
+  uint8_t tmp_op_handle_cnt;
 
+  // copies are bit-for-bit, done as packed int16s.
+  axon_input.data_width = kAxonDataWidth16;
+  axon_input.data_packing = kAxonDataPackingEnabled;
+  axon_input.output_rounding = kAxonRoundingNone;
+  axon_input.output_af = kAxonAfDisabled;
+  axon_input.x_stride = kAxonStride1;
+  axon_input.y_stride = kAxonStride1;
+  axon_input.q_stride = kAxonStride1;
+  axon_input.y_in = NULL;
+  axon_input.y_length = 0;
+
+  for (uint8_t tile_ndx=0;tile_ndx<FC4_L1_TILE_CNT;tile_ndx++) {
+    uint16_t first_row = tile_ndx*FC4_L1_TILE_ROWS;
+    fc4_retained_info.l1_tile_op_ndx[tile_ndx] = total_ops_needed;
+
+    if (total_ops_needed+2 > *op_handle_count) {
+      AxonApiFreeOpHandles(axon_handle, total_ops_needed, axon_op_handles);
+      return kAxonResultBufferTooSmall;
+    }
 
-  if ((DEBUG_STOP_LAYER<0) || (DEBUG_STOP_LAYER >= 1)) {
+    // copy the input in
+    axon_input.x_in = (int32_t*)fc4_l1_input;
+    axon_input.q_out = fc4_l1_tile_io_buffer;
+    axon_input.length = FC4_L1_PADDED_INPUT_LENGTH/sizeof(int16_t);
+    if (kAxonResultSuccess > (result = AxonApiDefineOpMemCpy(axon_handle, &axon_input, axon_op_handles+total_ops_needed))) {
+      AxonApiFreeOpHandles(axon_handle, total_ops_needed, axon_op_handles);
+      return result;
+    }
+    total_ops_needed++;
 
-    // define layer1
+    // the tile, against its rows of the bias and normalization vectors
+    tmp_op_handle_cnt = *op_handle_count-total_ops_needed-1; // leave room for the output copy
     result = AxonApiDefineOpListFullyConnectedWithStopStep(axon_handle,
-        FC4_L1_INPUT_LENGTH,
-        FC4_L1_OUTPUT_LENGTH,
-        FC4_L1_INPUT_BITWIDTH,     /**< nominally 8bit but unsaturated, and unpacked */
-        io_buffer,
-        io_buffer_length,     /**< length of buf1. Must be >= max(input_length, output_length) */
-        fc4_l1_weights,
-        fc4_l1_bias_prime,
+        FC4_L1_PADDED_INPUT_LENGTH,
+        FC4_L1_TILE_ROWS,
+        FC4_L1_INPUT_BITWIDTH,
+        fc4_l1_tile_io_buffer,
+        FC4_L1_TILE_IO_BUFFER_SIZE,
+        fc4_l1_weight_tiles[tile_ndx&1][0],
+        fc4_l1_bias_prime+first_row,
         FC4_L1_BIAS_ADD_MULTIPLIER,
         FC4_L1_BIAS_ADD_ROUNDING,
         FC4_L1_ACTIVATION_FUNCTION,
-        fc4_l1_normalization_mult,
+        fc4_l1_normalization_mult+first_row,
         FC4_L1_NORM_MULT_ROUNDING,
-        fc4_l1_normalization_add,
+        fc4_l1_normalization_add+first_row,
         FC4_L1_NORM_ADD_ROUNDING,
         FC4_L1_QUANTIZE_MULTIPLIER,
         FC4_L1_QUANTIZE_ADD,
         FC4_L1_QUANTIZE_ROUNDING,
-        FC4_L1_QUANTIZE_STANDALONE_ADD, /**< used only when non-0. Only necessary when quantize_add cannot be provided in sufficient precision */
+        FC4_L1_QUANTIZE_STANDALONE_ADD,
         buf1,
         buf2,
-        buf1_length,            /**< length of buf1. Must be >= output_length */
-        buf2_length,            /**< length of buf2. Must be >= output_length */
+        buf1_length,
+        buf2_length,
         axon_op_handles+total_ops_needed,
         &tmp_op_handle_cnt,
         DEBUG_STOP_LAYER==1 ? DEBUG_STOP_STEP : kDontStop);
-
     if (kAxonResultSuccess != result) {
-      axon_printf(axon_handle, "Define FC4_L1 failed! %d\r\n" , result);
+      axon_printf(axon_handle, "Define FC4_L1 tile %d failed! %d\r\n", tile_ndx, result);
       AxonApiFreeOpHandles(axon_handle, total_ops_needed, axon_op_handles);
       return result;
     }
-
     total_ops_needed += tmp_op_handle_cnt;
-    tmp_op_handle_cnt=*op_handle_count-total_ops_needed;
-  }
 
-  if ((DEBUG_STOP_LAYER<0) || (DEBUG_STOP_LAYER >= 2)) {
-
-    // define layer2
-    result = AxonApiDefineOpListFullyConnectedWithStopStep(axon_handle,
-        FC4_L2_INPUT_LENGTH,
-        FC4_L2_OUTPUT_LENGTH,
-        FC4_L2_INPUT_BITWIDTH,     /**< nominally 8bit but unsaturated, and unpacked */
-        io_buffer,
-        io_buffer_length,     /**< length of buf1. Must be >= max(input_length, output_length) */
-        fc4_l2_weights,
-        fc4_l2_bias_prime,
-        FC4_L2_BIAS_ADD_MULTIPLIER,
-        FC4_L2_BIAS_ADD_ROUNDING,
-        FC4_L2_ACTIVATION_FUNCTION,
-        fc4_l2_normalization_mult,
-        FC4_L2_NORM_MULT_ROUNDING,
-        fc4_l2_normalization_add,
-        FC4_L2_NORM_ADD_ROUNDING,
-        FC4_L2_QUANTIZE_MULTIPLIER,
-        FC4_L2_QUANTIZE_ADD,
-        FC4_L2_QUANTIZE_ROUNDING,
-        FC4_L2_QUANTIZE_STANDALONE_ADD, /**< used only when non-0. Only necessary when quantize_add cannot be provided in sufficient precision */
-        buf1,
-        buf2,
-        buf1_length,            /**< length of buf1. Must be >= output_length */
-        buf2_length,            /**< length of buf2. Must be >= output_length */
-        axon_op_handles+total_ops_needed,
-        &tmp_op_handle_cnt,
-        DEBUG_STOP_LAYER==2 ? DEBUG_STOP_STEP : kDontStop);
-
-    if (kAxonResultSuccess != result) {
-      axon_printf(axon_handle, "Define FC4_L2 failed! %d\r\n" , result);
+    // copy the output out
+    axon_input.x_in = fc4_l1_tile_io_buffer;
+    axon_input.q_out = io_buffer+first_row;
+    axon_input.length = FC4_L1_TILE_ROWS*sizeof(int32_t)/sizeof(int16_t);
+    if (kAxonResultSuccess > (result = AxonApiDefineOpMemCpy(axon_handle, &axon_input, axon_op_handles+total_ops_needed))) {
       AxonApiFreeOpHandles(axon_handle, total_ops_needed, axon_op_handles);
       return result;
     }
-
-    total_ops_needed += tmp_op_handle_cnt;
-    tmp_op_handle_cnt=*op_handle_count-total_ops_needed;
+    total_ops_needed++;
   }
+  fc4_retained_info.l1_tile_op_ndx[FC4_L1_TILE_CNT] = total_ops_needed;
+  fc4_retained_info.l1_resident_tile[0] = -1;
+  fc4_retained_info.l1_resident_tile[1] = -1;
+  fc4_retained_info.l1_requested_tile = -1;
+  fc4_retained_info.l1_waiting_tile = -1;
 
-  if ((DEBUG_STOP_LAYER<0) || (DEBUG_STOP_LAYER >= 3)) {
-
-    // define layer3
-    result = AxonApiDefineOpListFullyConnectedWithStopStep(axon_handle,
-        FC4_L3_INPUT_LENGTH,
-        FC4_L3_OUTPUT_LENGTH,
-        FC4_L3_INPUT_BITWIDTH,     /**< nominally 8bit but unsaturated, and unpacked */
-        io_buffer,
-        io_buffer_length,     /**< length of buf1. Must be >= max(input_length, output_length) */
-        fc4_l3_weights,
-        fc4_l3_bias_prime,
-        FC4_L3_BIAS_ADD_MULTIPLIER,
-        FC4_L3_BIAS_ADD_ROUNDING,
-        FC4_L3_ACTIVATION_FUNCTION,
-        fc4_l3_normalization_mult,
-        FC4_L3_NORM_MULT_ROUNDING,
-        fc4_l3_normalization_add,
-        FC4_L3_NORM_ADD_ROUNDING,
-        FC4_L3_QUANTIZE_MULTIPLIER,
-        FC4_L3_QUANTIZE_ADD,
-        FC4_L3_QUANTIZE_ROUNDING,
-        FC4_L3_QUANTIZE_STANDALONE_ADD, /**< used only when non-0. Only necessary when quantize_add cannot be provided in sufficient precision */
-        buf1,
-        buf2,
-        buf1_length,            /**< length of buf1. Must be >= output_length */
-        buf2_length,            /**< length of buf2. Must be >= output_length */
-        axon_op_handles+total_ops_needed,
-        &tmp_op_handle_cnt,
-        DEBUG_STOP_LAYER==3 ? DEBUG_STOP_STEP : kDontStop);
+  *op_handle_count = total_ops_needed;
+  return kAxonResultSuccess;
+}
+#endif
 
-    if (kAxonResultSuccess != result) {
-      axon_printf(axon_handle, "Define FC4_L3 failed! %d\r\n" , result);
-      AxonApiFreeOpHandles(axon_handle, total_ops_needed, axon_op_handles);
-      return result;
-    }
+static int axon_kws_model_fc4_prepare(void *axon_handle,
+    AxonOpHandle axon_op_handles[],
+    uint8_t *op_handle_count,
+    int32_t *io_buffer,
+    uint16_t io_buffer_length,
+    int32_t *buf1,
+    int32_t *buf2,
+    uint16_t buf1_length,
+    uint16_t buf2_length) {
 
-    total_ops_needed += tmp_op_handle_cnt;
-    tmp_op_handle_cnt=*op_handle_count-total_ops_needed;
+  // define each of the layers, appending the operations to each other.
+  if (NULL==op_handle_count) {
+    return kAxonResultFailureNullBuffer;
   }
+  AxonResultEnum result;
+  uint8_t tmp_op_handle_cnt;
+  uint8_t total_ops_needed = 0;
+  tmp_op_handle_cnt=*op_handle_count-total_ops_needed;
+#if FC4_SPARSE_LAYERS
+  fc4_sparse_stats.macs = 0;
+  fc4_sparse_stats.dense_macs = 0;
+#endif
 
-  if ((DEBUG_STOP_LAYER<0) || (DEBUG_STOP_LAYER >= 4)) {
 
-    // define layer4
-    result = AxonApiDefineOpListFullyConnectedWithStopStep(axon_handle,
-        FC4_L4_INPUT_LENGTH,
-        FC4_L4_OUTPUT_LENGTH,
-        FC4_L4_INPUT_BITWIDTH,     /**< nominally 8bit but unsaturated, and unpacked */
-        io_buffer,
-        io_buffer_length,     /**< length of buf1. Must be >= max(input_length, output_length) */
-        fc4_l4_weights,
-        fc4_l4_bias_prime,
-        FC4_L4_BIAS_ADD_MULTIPLIER,
-        FC4_L4_BIAS_ADD_ROUNDING,
-        FC4_L4_ACTIVATION_FUNCTION,
-        fc4_l4_normalization_mult,
-        FC4_L4_NORM_MULT_ROUNDING,
-        fc4_l4_normalization_add,
-        FC4_L4_NORM_ADD_ROUNDING,
-        FC4_L4_QUANTIZE_MULTIPLIER,
-        FC4_L4_QUANTIZE_ADD,
-        FC4_L4_QUANTIZE_ROUNDING,
-        FC4_L4_QUANTIZE_STANDALONE_ADD, /**< used only when non-0. Only necessary when quantize_add cannot be provided in sufficient precision */
-        buf1,
-        buf2,
-        buf1_length,            /**< length of buf1. Must be >= output_length */
-        buf2_length,            /**< length of buf2. Must be >= output_length */
-        axon_op_handles+total_ops_needed,
-        &tmp_op_handle_cnt,
-        DEBUG_STOP_LAYER==4 ? DEBUG_STOP_STEP : kDontStop);
+  // some layers leave out normalization w/ NULL pointer variables, so the table can't be static.
+  const Fc4LayerStruct fc4_layers[] = {
+      FC4_LAYER(1),
+      FC4_LAYER(2),
+      FC4_LAYER(3),
+      FC4_LAYER(4),
+  };
+
+  for (uint8_t layer=1;layer<=sizeof(fc4_layers)/sizeof(fc4_layers[0]);layer++) {
+    if ((DEBUG_STOP_LAYER>=0) && (DEBUG_STOP_LAYER<layer)) {
+      break;
+    }
+
+#if FC4_L1_WEIGHT_CACHE
+    if (1==layer) {
+      // define layer1 as tiles
+      result = fc4_l1_define_tiles(axon_handle,
+          axon_op_handles+total_ops_needed,
+          &tmp_op_handle_cnt,
+          io_buffer,
+          buf1,
+          buf2,
+          buf1_length,
+          buf2_length);
+    } else
+#endif
+    {
+      result = fc4_define_layer(axon_handle,
+          layer,
+          &fc4_layers[layer-1],
+          axon_op_handles+total_ops_needed,
+          &tmp_op_handle_cnt,
+          io_buffer,
+          io_buffer_length,
+          buf1,
+          buf2,
+          buf1_length,
+          buf2_length,
+          DEBUG_STOP_LAYER==layer ? DEBUG_STOP_STEP : kDontStop);
+    }
 
     if (kAxonResultSuccess != result) {
-      axon_printf(axon_handle, "Define FC4_L4 failed! %d\r\n" , result);
+      axon_printf(axon_handle, "Define FC4_L%d failed! %d\r\n", layer, result);
       AxonApiFreeOpHandles(axon_handle, total_ops_needed, axon_op_handles);
       return result;
     }
@@ -259,6 +574,10 @@ static int axon_kws_model_fc4_prepare(void *axon_handle,
     tmp_op_handle_cnt=*op_handle_count-total_ops_needed;
   }
 
+#if FC4_SPARSE_LAYERS
+  axon_printf(axon_handle, "FC4 sparse: %d of %d MACs (%d%%)\r\n", fc4_sparse_stats.macs, fc4_sparse_stats.dense_macs,
+      fc4_sparse_stats.dense_macs ? fc4_sparse_stats.macs*100/fc4_sparse_stats.dense_macs : 0);
+#endif
 
   // last 1, so return the total used.
   *op_handle_count = total_ops_needed;
@@ -292,7 +611,12 @@ static_assert(sizeof(fc4_labels)/sizeof(fc4_labels[0])==FC4_OUTPUT_LENGTH, "FC4_
 *  io buffer will have int8 operations, needs to be 16byte aligned
 *  io buffer needs to be the larger of FC4_INPUT_LENGTH and (FC4_MIDLAYER_LENGTH * 4)
 */
-#define FC4_IO_BUFFER_SIZE (FC4_L1_INPUT_LENGTH/4 > FC4_L1_OUTPUT_LENGTH ? FC4_L1_INPUT_LENGTH/4 :  FC4_L1_OUTPUT_LENGTH)
+#if FC4_SPARSE_LAYERS
+// the input gets copied out in whole 16 byte chunks
+# define FC4_IO_BUFFER_SIZE (FC4_SPARSE_BUFFER_SIZE > FC4_L1_OUTPUT_LENGTH ? FC4_SPARSE_BUFFER_SIZE : FC4_L1_OUTPUT_LENGTH)
+#else
+# define FC4_IO_BUFFER_SIZE (FC4_L1_INPUT_LENGTH/4 > FC4_L1_OUTPUT_LENGTH ? FC4_L1_INPUT_LENGTH/4 :  FC4_L1_OUTPUT_LENGTH)
+#endif
 _Alignas(16) int32_t fc4_io_buffer[FC4_IO_BUFFER_SIZE];
 // buf1 & 2 are 24 bit operations only, don't need special alignment
 int32_t fc4_buff1[FC4_L1_OUTPUT_LENGTH];
@@ -328,6 +652,112 @@ static void fc4_classify_complete_callback(AxonResultEnum result, void *callback
   fc4_retained_info.result_callback_function(result);
 }
 
+#if FC4_L1_WEIGHT_CACHE
+static void fc4_l1_tile_complete_callback(AxonResultEnum result, void *callback_context);
+
+/*
+ * Queues a layer 1 tile, then requests the following tile for the other weight buffer while axon works.
+ * After the last tile, tile 0 gets requested so it is ready for the next inference.
+ * If the tile isn't resident yet, it is left waiting and AxonKwsModelFc4LoadWeights() queues it.
+ */
+static AxonResultEnum fc4_l1_queue_tile(uint8_t tile_ndx) {
+  static AxonMgrQueuedOpsStruct fc4_l1_tile_queued_ops;
+  AxonResultEnum result;
+  uint8_t next_tile_ndx = tile_ndx+1 < FC4_L1_TILE_CNT ? tile_ndx+1 : 0;
+
+  if (fc4_retained_info.l1_resident_tile[tile_ndx&1] != tile_ndx) {
+    // wasn't prefetched (1st inference) or the host is behind, axon has to wait for it.
+    fc4_weight_cache_stats.stall_cnt++;
+    if (NULL!=fc4_weight_load_request_function) {
+      fc4_retained_info.l1_tile_ndx = tile_ndx;
+      fc4_retained_info.l1_waiting_tile = tile_ndx;
+      if (fc4_retained_info.l1_requested_tile != tile_ndx) {
+        fc4_l1_request_tile(tile_ndx);
+      }
+      return kAxonResultSuccess;
+    }
+    fc4_l1_request_tile(tile_ndx);
+  }
+
+  fc4_retained_info.l1_tile_ndx = tile_ndx;
+  fc4_l1_tile_queued_ops.op_handle_list = fc4_retained_info.fc4_axon_op_handles+fc4_retained_info.l1_tile_op_ndx[tile_ndx];
+  fc4_l1_tile_queued_ops.op_handle_count = fc4_retained_info.l1_tile_op_ndx[tile_ndx+1]-fc4_retained_info.l1_tile_op_ndx[tile_ndx];
+  fc4_l1_tile_queued_ops.callback_context = NULL;
+  fc4_l1_tile_queued_ops.callback_function = fc4_l1_tile_complete_callback;
+  if (kAxonResultSuccess > (result=AXON_KWS_STATS_QUEUE_OPS_LIST(fc4_retained_info.axon_handle, &fc4_l1_tile_queued_ops))) {
+    return result;
+  }
+
+  // the other buffer held the previous tile, which is done.
+  if (fc4_retained_info.l1_resident_tile[next_tile_ndx&1] != next_tile_ndx) {
+    fc4_l1_request_tile(next_tile_ndx);
+  }
+  return result;
+}
+
+/*
+ * callback function invoked when a layer 1 tile has completed
+ */
+static void fc4_l1_tile_complete_callback(AxonResultEnum result, void *callback_context) {
+  static AxonMgrQueuedOpsStruct fc4_remaining_queued_ops;
+
+  if (kAxonResultSuccess > result) {
+    fc4_retained_info.result_callback_function(result);
+    return;
+  }
+  if (fc4_retained_info.l1_tile_ndx+1 < FC4_L1_TILE_CNT) {
+    if (kAxonResultSuccess > (result=fc4_l1_queue_tile(fc4_retained_info.l1_tile_ndx+1))) {
+      fc4_retained_info.result_callback_function(result);
+    }
+    return;
+  }
+
+  // layer 1 is done, queue the remaining layers
+  fc4_remaining_queued_ops.op_handle_list = fc4_retained_info.fc4_axon_op_handles+fc4_retained_info.l1_tile_op_ndx[FC4_L1_TILE_CNT];
+  fc4_remaining_queued_ops.op_handle_count = fc4_retained_info.fc4_op_handle_count-fc4_retained_info.l1_tile_op_ndx[FC4_L1_TILE_CNT];
+  fc4_remaining_queued_ops.callback_context = NULL;
+  fc4_remaining_queued_ops.callback_function = fc4_classify_complete_callback;
+  if (0==fc4_remaining_queued_ops.op_handle_count) {
+    // stopped after layer 1
+    fc4_classify_complete_callback(result, NULL);
+    return;
+  }
+  if (kAxonResultSuccess > (result=AXON_KWS_STATS_QUEUE_OPS_LIST(fc4_retained_info.axon_handle, &fc4_remaining_queued_ops))) {
+    fc4_retained_info.result_callback_function(result);
+  }
+}
+#endif
+
+int AxonKwsModelFc4LoadWeights() {
+#if FC4_L1_WEIGHT_CACHE
+  int8_t tile_ndx = fc4_retained_info.l1_requested_tile;
+  uint8_t tile_is_waiting;
+  uint32_t interrupt_state;
+  AxonResultEnum result;
+
+  if (0 > tile_ndx) {
+    return 0;
+  }
+  fc4_l1_read_tile(tile_ndx);
+
+  // the tile callback mustn't see the tile resident w/o also seeing the request cleared.
+  interrupt_state = AxonHostDisableInterrupts();
+  fc4_retained_info.l1_resident_tile[tile_ndx&1] = tile_ndx;
+  fc4_retained_info.l1_requested_tile = -1;
+  if ((tile_is_waiting = (fc4_retained_info.l1_waiting_tile == tile_ndx))) {
+    fc4_retained_info.l1_waiting_tile = -1;
+  }
+  AxonHostRestoreInterrupts(interrupt_state);
+
+  if (tile_is_waiting && (kAxonResultSuccess > (result=fc4_l1_queue_tile(tile_ndx)))) {
+    fc4_retained_info.result_callback_function(result);
+  }
+  return 1;
+#else
+  return 0;
+#endif
+}
+
 /*
  * FC4 classification does not happen slice-by-slice. Instead we need to gather
  * all the audio features, (61x10), flatten/pack/saturate them, then invoke to FC4 model.
@@ -341,7 +771,11 @@ AxonResultEnum AxonKwsModelFc4Infer(uint8_t window_width) {
   static AxonMgrQueuedOpsStruct fc4_axon_queued_ops;
 
   // pack saturate from MFCC_FEATURE_TYPE to int8_t
+#if FC4_L1_WEIGHT_CACHE
+  int8_t *io_buff = fc4_l1_input;
+#else
   int8_t *io_buff = (int8_t *)fc4_io_buffer;
+#endif
   for (uint16_t slice_ndx=0;slice_ndx<FC4_L1_INPUT_WIDTH;slice_ndx++) {
     const AudioInputFeatureType *slice_ptr;
     AxonKwsHostGetNextAudioFeatureSlice(&slice_ptr);
@@ -350,13 +784,18 @@ AxonResultEnum AxonKwsModelFc4Infer(uint8_t window_width) {
     io_buff+= AUDIO_INPUT_FEATURE_HEIGHT;
   }
 
+#if FC4_L1_WEIGHT_CACHE
+  // layer 1 goes a tile at a time, the remaining layers get queued after the last tile.
+  return fc4_l1_queue_tile(0);
+#endif
+
   // prepare/submit the batch operation to axon
   fc4_axon_queued_ops.op_handle_list = fc4_retained_info.fc4_axon_op_handles;
   fc4_axon_queued_ops.op_handle_count = fc4_retained_info.fc4_op_handle_count;
   fc4_axon_queued_ops.callback_context = NULL;
   fc4_axon_queued_ops.callback_function = fc4_classify_complete_callback;
   // and submit!
-  AxonApiQueueOpsList(fc4_retained_info.axon_handle, &fc4_axon_queued_ops);
+  return AXON_KWS_STATS_QUEUE_OPS_LIST(fc4_retained_info.axon_handle, &fc4_axon_queued_ops);
 }
 
 /*
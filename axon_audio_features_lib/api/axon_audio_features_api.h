@@ -217,4 +217,53 @@ uint8_t AxonAudioFeaturesBgSliceIsForeground();
 
 uint32_t AxonAudioFeaturesBgFgExecutionTicks();
 
+/*
+ * Gated feature extraction. With refresh_interval > 0 the BG/FG ops run first, and the feature ops
+ * only run if the slice is (or was recently) foreground, or after refresh_interval slices in a row have
+ * been skipped. Skipped slices are filled with the most recently computed background slice, so
+ * every slice still produces an output vector. 0 disables gating (default).
+ */
+void AxonAudioFeaturesSetGating(uint8_t refresh_interval);
+
+/*
+ * Returns the number of slices filled from the background cache since the last restart.
+ */
+uint32_t AxonAudioFeaturesGatedSliceCount();
+
+/*
+ * Returns the number of Axon op lists submitted since the last restart. In async mode each one
+ * completes with a single Axon interrupt, so this divided by the frame count is the interrupts per frame:
+ * 1 normally (beamformer, bg/fg and feature ops in one list), 2 in gated mode (3 with the beamformer)
+ * and 1 for a gated slice filled from the cache (just the bg/fg ops).
+ */
+uint32_t AxonAudioFeaturesOpListCount();
+
 void AxonAudioFeaturesBgFgPrintStats();
+
+/*
+ * Delay-and-sum beamformer for 2 microphone boards.
+ * When a steering preset is selected and the input is stereo (input_stride==2), each channel
+ * goes through a fractional delay FIR and the 2 channels are averaged before the hamming window.
+ * The beamformer ops are queued ahead of the feature ops so they run in the same per-frame batch.
+ * With kAxonAudioFeatureBeamformerOff, or mono input, channel 0 is used as-is.
+ */
+typedef enum {
+  kAxonAudioFeatureBeamformerOff,
+  kAxonAudioFeatureBeamformerBroadside,    // 0 degrees, source is straight in front of the mic pair
+  kAxonAudioFeatureBeamformerLeft45,       // -45 degrees, towards channel 0
+  kAxonAudioFeatureBeamformerRight45,      // 45 degrees, towards channel 1
+  kAxonAudioFeatureBeamformerLeftEndfire,  // -90 degrees, in line with the mics on the channel 0 side
+  kAxonAudioFeatureBeamformerRightEndfire, // 90 degrees, in line with the mics on the channel 1 side
+  kAxonAudioFeatureBeamformerSteerCount,
+} AxonAudioFeatureBeamformerSteeringEnum;
+
+/*
+ * Selects the steering preset. Takes effect on the next frame; don't call while a frame is being processed.
+ */
+AxonResultEnum AxonAudioFeaturesBeamformerSetSteering(AxonAudioFeatureBeamformerSteeringEnum steering);
+
+AxonAudioFeatureBeamformerSteeringEnum AxonAudioFeaturesBeamformerGetSteering();
+
+uint32_t AxonAudioFeaturesBeamformerExecutionTicks();
+
+void AxonAudioFeaturesBeamformerPrintStats();
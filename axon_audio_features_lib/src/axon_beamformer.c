@@ -0,0 +1,325 @@
+/**
+ *          Copyright (c) 2020-2022, Atlazo Inc.
+ *          All rights reserved.
+ *
+ *          Licensed under the Apache License, Version 2.0 (the "License");
+ *          you may not use this file except in compliance with the License.
+ *          You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *          Unless required by applicable law or agreed to in writing, software
+ *          distributed under the License is distributed on an "AS IS" BASIS,
+ *          WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *          See the License for the specific language governing permissions and
+ *          limitations under the License.
+ *
+ */
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "axon_api.h"
+#include "axon_dep.h"
+#include "axon_audio_features_api.h"
+#include "axon_kws_stats_api.h"
+#include "axon_beamformer.h"
+#include "axon_beamformer_weights.h"
+#if AXON_BEAMFORMER_FLOAT_REFERENCE
+#include <math.h>
+#endif
+
+extern void AxonPrintf(char *fmt_string, ...);
+
+/*
+ * Delay-and-sum beamformer.
+ * 1. CPU de-interleaves the stereo input into 2 int32 channel buffers, each preceded by
+ *    BEAMFORMER_FIR_TAP_CNT samples of history from the previous frame.
+ * 2. FIR channel 0 directly into the real slots of the fft buffer.
+ * 3. FIR channel 1 into a scratch buffer.
+ * 4. Xpy the 2 with a rounding of 1 (ie, the average) back into the real slots of the fft buffer.
+ */
+typedef enum {
+  kBeamformerAxonOpChannel0Fir,
+  kBeamformerAxonOpChannel1Fir,
+  kBeamformerAxonOpSumXpy,
+  kBeamformerAxonOpCount
+} BeamformerAxonOperationEnum;
+static_assert(BEAMFORMER_OP_CNT==kBeamformerAxonOpCount, "BEAMFORMER_OP_CNT IS OUT OF DATE!!");
+
+RETAINED_MEMORY_SECTION_ATTRIBUTE
+static struct {
+  AxonAudioFeatureBeamformerSteeringEnum steering;
+  AxonOpHandle axon_ops[kBeamformerAxonOpCount];
+  BeamformerStatsStruct stats;
+  uint32_t profiling_timestamp;
+} beamformer_state_info;
+
+/*
+ * buffers in un-retained memory. Taps are copied to RAM so the
+ * FIR ops can keep pointing at the same place when the steering changes.
+ */
+static int32_t _Alignas(16) channel_buffers[BEAMFORMER_CHANNEL_CNT][BEAMFORMER_CHANNEL_BUFFER_LEN];
+static int32_t _Alignas(16) channel1_fir_output[AXON_AUDIO_FEATURE_FRAME_LEN];
+static int32_t _Alignas(16) steering_taps[BEAMFORMER_CHANNEL_CNT][BEAMFORMER_FIR_TAP_CNT];
+
+#if AXON_BEAMFORMER_FLOAT_REFERENCE
+static float reference_history[BEAMFORMER_CHANNEL_CNT][BEAMFORMER_CHANNEL_BUFFER_LEN];
+static float reference_output[AXON_AUDIO_FEATURE_FRAME_LEN];
+static int32_t *reference_fft_buffer;
+#endif
+
+/*
+ * API function
+ */
+AxonResultEnum AxonBeamformerPrepare(void *axon_handle, int32_t *fft_buffer) {
+  AxonInputStruct axon_input;
+  AxonResultEnum result;
+
+  AxonBeamformerRestart();
+
+  /*
+   * Common settings
+   */
+  axon_input.data_width = kAxonDataWidth24;
+  axon_input.data_packing = kAxonDataPackingDisabled;
+  axon_input.output_af = kAxonAfDisabled;
+  axon_input.x_stride = kAxonStride1;
+  axon_input.y_stride = kAxonStride1;
+
+  /*
+   * kBeamformerAxonOpChannel0Fir, output goes to the real slots of the fft buffer.
+   */
+  axon_input.length = BEAMFORMER_CHANNEL_BUFFER_LEN; // output length is length-y_length, ie, 1 frame
+  axon_input.y_length = BEAMFORMER_FIR_TAP_CNT;
+  axon_input.output_rounding = kAxonRoundingNone+BEAMFORMER_TAP_Q;
+  axon_input.x_in = channel_buffers[0];
+  axon_input.y_in = steering_taps[0];
+  axon_input.q_out = fft_buffer;
+  axon_input.q_stride = kAxonStride2;
+  if (kAxonResultSuccess > (result=AxonApiDefineOpFir(axon_handle, &axon_input, &beamformer_state_info.axon_ops[kBeamformerAxonOpChannel0Fir]))) {
+    return result;
+  }
+
+  /*
+   * kBeamformerAxonOpChannel1Fir, output goes to scratch.
+   */
+  axon_input.x_in = channel_buffers[1];
+  axon_input.y_in = steering_taps[1];
+  axon_input.q_out = channel1_fir_output;
+  axon_input.q_stride = kAxonStride1;
+  if (kAxonResultSuccess > (result=AxonApiDefineOpFir(axon_handle, &axon_input, &beamformer_state_info.axon_ops[kBeamformerAxonOpChannel1Fir]))) {
+    return result;
+  }
+
+  /*
+   * kBeamformerAxonOpSumXpy, average the 2 channels in place.
+   */
+  axon_input.length = AXON_AUDIO_FEATURE_FRAME_LEN;
+  axon_input.output_rounding = kAxonRoundingNone+1;
+  axon_input.x_in = fft_buffer;
+  axon_input.x_stride = kAxonStride2;
+  axon_input.y_in = channel1_fir_output;
+  axon_input.y_stride = kAxonStride1;
+  axon_input.q_out = fft_buffer;
+  axon_input.q_stride = kAxonStride2;
+  if (kAxonResultSuccess > (result=AxonApiDefineOpXpy(axon_handle, &axon_input, &beamformer_state_info.axon_ops[kBeamformerAxonOpSumXpy]))) {
+    return result;
+  }
+
+#if AXON_BEAMFORMER_FLOAT_REFERENCE
+  reference_fft_buffer = fft_buffer;
+#endif
+  beamformer_state_info.stats.op_cnt = kBeamformerAxonOpCount;
+  beamformer_state_info.stats.group_delay_samples = BEAMFORMER_GROUP_DELAY_SAMPLES;
+  return AxonAudioFeaturesBeamformerSetSteering(beamformer_state_info.steering);
+}
+
+void AxonBeamformerRestart() {
+  // history from the last stream no longer applies
+  memset(channel_buffers, 0, sizeof(channel_buffers));
+  beamformer_state_info.stats.frame_cnt = 0;
+  beamformer_state_info.stats.execution_time_ticks = 0;
+#if AXON_BEAMFORMER_FLOAT_REFERENCE
+  memset(reference_history, 0, sizeof(reference_history));
+  beamformer_state_info.stats.max_reference_error = 0;
+#endif
+}
+
+AxonBoolEnum AxonBeamformerIsActive(uint8_t input_stride) {
+  return (2==input_stride) && (kAxonAudioFeatureBeamformerOff!=beamformer_state_info.steering) ? kAxonBoolTrue : kAxonBoolFalse;
+}
+
+void AxonBeamformerCopyRawInput(
+    const int16_t *raw_input_ping,
+    uint32_t ping_count,
+    const int16_t *raw_input_pong,
+    int32_t *fft_buffer) {
+  uint32_t ndx;
+  int32_t *channel0 = channel_buffers[0]+BEAMFORMER_FIR_TAP_CNT;
+  int32_t *channel1 = channel_buffers[1]+BEAMFORMER_FIR_TAP_CNT;
+
+#if AXON_BEAMFORMER_FLOAT_REFERENCE
+  AxonBeamformerReferenceFloat(raw_input_ping, ping_count, raw_input_pong, reference_output);
+#endif
+
+  /*
+   * frames overlap by AXON_AUDIO_FEATURE_FRAME_SHIFT, so the samples immediately preceding
+   * this frame are the ones just before the shift point in the last frame.
+   */
+  for (ndx=0;ndx<BEAMFORMER_CHANNEL_CNT;ndx++) {
+    memmove(channel_buffers[ndx], channel_buffers[ndx]+AXON_AUDIO_FEATURE_FRAME_SHIFT, BEAMFORMER_FIR_TAP_CNT*sizeof(int32_t));
+  }
+
+  for (ndx=0; ndx<ping_count;ndx++) {
+    *channel0++ = raw_input_ping[0];
+    *channel1++ = raw_input_ping[1];
+    fft_buffer[2*ndx+1] = 0; // 0 out the imaginary component
+    raw_input_ping += 2;
+  }
+  for (;ndx<AXON_AUDIO_FEATURE_FRAME_LEN;ndx++) {
+    *channel0++ = raw_input_pong[0];
+    *channel1++ = raw_input_pong[1];
+    fft_buffer[2*ndx+1] = 0; // 0 out the imaginary component
+    raw_input_pong += 2;
+  }
+}
+
+#if AXON_BEAMFORMER_FLOAT_REFERENCE
+static void beamformer_check_reference() {
+  for (uint32_t ndx=0;ndx<AXON_AUDIO_FEATURE_FRAME_LEN;ndx++) {
+    float error = fabsf(reference_output[ndx]-(float)reference_fft_buffer[2*ndx]);
+    if (error > beamformer_state_info.stats.max_reference_error) {
+      beamformer_state_info.stats.max_reference_error = error;
+    }
+  }
+}
+#endif
+
+/*
+ * API function
+ */
+void AxonBeamformerFrameComplete() {
+  beamformer_state_info.stats.frame_cnt++;
+  beamformer_state_info.stats.execution_time_ticks += (AxonHostGetTime()-beamformer_state_info.profiling_timestamp);
+#if AXON_BEAMFORMER_FLOAT_REFERENCE
+  beamformer_check_reference();
+#endif
+}
+
+static void beamformer_ops_done_callback(AxonResultEnum result, void *callback_context) {
+  AxonBeamformerFrameComplete();
+}
+
+/*
+ * API function
+ */
+uint8_t AxonBeamformerCopyOpHandles(AxonOpHandle *op_handles) {
+  memcpy(op_handles, beamformer_state_info.axon_ops, sizeof(beamformer_state_info.axon_ops));
+  return kBeamformerAxonOpCount;
+}
+
+/*
+ * API function
+ */
+void AxonBeamformerFrameStart() {
+  beamformer_state_info.profiling_timestamp = AxonHostGetTime();
+}
+
+/*
+ * API function
+ */
+AxonResultEnum AxonBeamformerProcessFrame(void *axon_handle, AxonAsyncModeEnum async_mode) {
+  /*
+   * queued ops struct doesn't need to be
+   * in retained memory.
+   */
+  static AxonMgrQueuedOpsStruct beamformer_queued_ops;
+  AxonResultEnum result;
+
+  AxonBeamformerFrameStart();
+  if (async_mode==kAxonAsyncModeSynchronous) {
+    if (kAxonResultSuccess > (result=AXON_KWS_STATS_EXECUTE_OPS(axon_handle, kBeamformerAxonOpCount, beamformer_state_info.axon_ops, kAxonAsyncModeSynchronous))) {
+      return result;
+    }
+    beamformer_ops_done_callback(result, NULL);
+    return kAxonResultSuccess;
+  }
+  /*
+   * queued batch for async mode. This goes ahead of the bg/fg ops, the callback
+   * is only used for profiling.
+   */
+  beamformer_queued_ops.callback_context = NULL;
+  beamformer_queued_ops.callback_function = beamformer_ops_done_callback;
+  beamformer_queued_ops.op_handle_count = kBeamformerAxonOpCount;
+  beamformer_queued_ops.op_handle_list = beamformer_state_info.axon_ops;
+  return AXON_KWS_STATS_QUEUE_OPS_LIST(axon_handle, &beamformer_queued_ops);
+}
+
+const BeamformerStatsStruct *AxonBeamformerGetStats() {
+  return &beamformer_state_info.stats;
+}
+
+#if AXON_BEAMFORMER_FLOAT_REFERENCE
+void AxonBeamformerReferenceFloat(
+    const int16_t *raw_input_ping,
+    uint32_t ping_count,
+    const int16_t *raw_input_pong,
+    float *output) {
+  uint32_t ndx;
+  uint8_t channel;
+
+  for (channel=0;channel<BEAMFORMER_CHANNEL_CNT;channel++) {
+    memmove(reference_history[channel], reference_history[channel]+AXON_AUDIO_FEATURE_FRAME_SHIFT, BEAMFORMER_FIR_TAP_CNT*sizeof(float));
+    for (ndx=0;ndx<AXON_AUDIO_FEATURE_FRAME_LEN;ndx++) {
+      reference_history[channel][BEAMFORMER_FIR_TAP_CNT+ndx] = ndx<ping_count ? raw_input_ping[2*ndx+channel] : raw_input_pong[2*(ndx-ping_count)+channel];
+    }
+  }
+  for (ndx=0;ndx<AXON_AUDIO_FEATURE_FRAME_LEN;ndx++) {
+    float sum = 0;
+    for (channel=0;channel<BEAMFORMER_CHANNEL_CNT;channel++) {
+      for (uint8_t tap=0;tap<BEAMFORMER_FIR_TAP_CNT;tap++) {
+        sum += reference_history[channel][ndx+tap] * steering_taps[channel][tap] / (float)(1<<BEAMFORMER_TAP_Q);
+      }
+    }
+    output[ndx] = sum/BEAMFORMER_CHANNEL_CNT;
+  }
+}
+#endif
+
+/*
+ * API function
+ */
+AxonResultEnum AxonAudioFeaturesBeamformerSetSteering(AxonAudioFeatureBeamformerSteeringEnum steering) {
+  if (steering>=kAxonAudioFeatureBeamformerSteerCount) {
+    return kAxonResultFailureInputOutOfRange;
+  }
+  beamformer_state_info.steering = steering;
+  if (kAxonAudioFeatureBeamformerOff!=steering) {
+    // preset table doesn't include "off"
+    memcpy(steering_taps, beamformer_steering_taps[steering-1], sizeof(steering_taps));
+  }
+  return kAxonResultSuccess;
+}
+
+AxonAudioFeatureBeamformerSteeringEnum AxonAudioFeaturesBeamformerGetSteering() {
+  return beamformer_state_info.steering;
+}
+
+uint32_t AxonAudioFeaturesBeamformerExecutionTicks() {
+  return beamformer_state_info.stats.execution_time_ticks;
+}
+
+void AxonAudioFeaturesBeamformerPrintStats() {
+  AxonPrintf("Beamformer: steer %d, # %u, ops %d, delay %d samples, ticks %u"
+#if AXON_BEAMFORMER_FLOAT_REFERENCE
+      ", max ref err %f"
+#endif
+      "\r\n",
+      beamformer_state_info.steering, beamformer_state_info.stats.frame_cnt, beamformer_state_info.stats.op_cnt,
+      beamformer_state_info.stats.group_delay_samples, beamformer_state_info.stats.execution_time_ticks
+#if AXON_BEAMFORMER_FLOAT_REFERENCE
+      , beamformer_state_info.stats.max_reference_error
+#endif
+      );
+}
@@ -0,0 +1,108 @@
+/**
+ *          Copyright (c) 2020-2022, Atlazo Inc.
+ *          All rights reserved.
+ *
+ *          Licensed under the Apache License, Version 2.0 (the "License");
+ *          you may not use this file except in compliance with the License.
+ *          You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *          Unless required by applicable law or agreed to in writing, software
+ *          distributed under the License is distributed on an "AS IS" BASIS,
+ *          WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *          See the License for the specific language governing permissions and
+ *          limitations under the License.
+ *
+ */
+#pragma once
+#include "axon_api.h"
+#include "axon_audio_features_api.h"
+#include <assert.h>
+
+/*
+ * 2 microphones, 1 fractional delay FIR per microphone.
+ * FIR requires at least 12 coefficients (multiple of 4) with the last one 0.
+ */
+#define BEAMFORMER_CHANNEL_CNT 2
+#define BEAMFORMER_FIR_TAP_CNT 12
+
+/*
+ * Each channel buffer holds BEAMFORMER_FIR_TAP_CNT samples of history followed by the frame.
+ */
+#define BEAMFORMER_CHANNEL_BUFFER_LEN (BEAMFORMER_FIR_TAP_CNT+AXON_AUDIO_FEATURE_FRAME_LEN)
+static_assert(0==(BEAMFORMER_CHANNEL_BUFFER_LEN%4), "FIR INPUT LENGTH MUST BE A MULTIPLE OF 4!!");
+
+/*
+ * Output sample n lines up with input sample n-BEAMFORMER_GROUP_DELAY_SAMPLES
+ * (filters are centered on tap 5, history is BEAMFORMER_FIR_TAP_CNT long).
+ */
+#define BEAMFORMER_GROUP_DELAY_SAMPLES 7
+
+/*
+ * Set to 1 on host builds to compute a floating point reference alongside the
+ * axon output. The max error is tracked in the beamformer stats.
+ * axon_tools/beamformer_reference builds the library this way.
+ */
+#ifndef AXON_BEAMFORMER_FLOAT_REFERENCE
+#  define AXON_BEAMFORMER_FLOAT_REFERENCE 0
+#endif
+
+typedef struct {
+  uint32_t frame_cnt;              // frames beamformed since last Restart.
+  uint32_t execution_time_ticks;   // accumulated time from queuing the beamformer ops to their completion.
+  uint8_t op_cnt;                  // axon ops added to each frame
+  uint8_t group_delay_samples;     // algorithmic latency added to the audio
+#if AXON_BEAMFORMER_FLOAT_REFERENCE
+  float max_reference_error;       // largest |axon-reference| seen since last Restart.
+#endif
+} BeamformerStatsStruct;
+
+AxonResultEnum AxonBeamformerPrepare(void *axon_handle, int32_t *fft_buffer);
+
+void AxonBeamformerRestart();
+
+/*
+ * Returns true if the beamformer should run for input of the given stride.
+ */
+AxonBoolEnum AxonBeamformerIsActive(uint8_t input_stride);
+
+/*
+ * De-interleaves the 2 channels into the beamformer buffers (replaces copy_raw_to_fft_buffer()).
+ * The imaginary slots of fft_buffer are cleared, the real slots get filled in by the axon ops.
+ */
+void AxonBeamformerCopyRawInput(
+    const int16_t *raw_input_ping,
+    uint32_t ping_count,
+    const int16_t *raw_input_pong,
+    int32_t *fft_buffer);
+
+/*
+ * Queues (or executes, in synchronous mode) the beamformer ops. Output lands in the real
+ * slots of the fft_buffer supplied to AxonBeamformerPrepare().
+ */
+AxonResultEnum AxonBeamformerProcessFrame(void *axon_handle, AxonAsyncModeEnum async_mode);
+
+/*
+ * For callers that submit the beamformer ops at the front of their own op list instead of AxonBeamformerProcessFrame().
+ * AxonBeamformerCopyOpHandles() copies BEAMFORMER_OP_CNT handles and returns the count.
+ * AxonBeamformerFrameStart() is called before the ops are submitted, AxonBeamformerFrameComplete() after they complete.
+ */
+#define BEAMFORMER_OP_CNT 3
+uint8_t AxonBeamformerCopyOpHandles(AxonOpHandle *op_handles);
+void AxonBeamformerFrameStart();
+void AxonBeamformerFrameComplete();
+
+const BeamformerStatsStruct *AxonBeamformerGetStats();
+
+#if AXON_BEAMFORMER_FLOAT_REFERENCE
+/*
+ * Floating point delay-and-sum of the same input, using the same taps. Keeps its own history.
+ * output receives AXON_AUDIO_FEATURE_FRAME_LEN samples.
+ */
+void AxonBeamformerReferenceFloat(
+    const int16_t *raw_input_ping,
+    uint32_t ping_count,
+    const int16_t *raw_input_pong,
+    float *output);
+#endif
@@ -0,0 +1,60 @@
+/**
+ *          Copyright (c) 2020-2022, Atlazo Inc.
+ *          All rights reserved.
+ *
+ *          Licensed under the Apache License, Version 2.0 (the "License");
+ *          you may not use this file except in compliance with the License.
+ *          You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *          Unless required by applicable law or agreed to in writing, software
+ *          distributed under the License is distributed on an "AS IS" BASIS,
+ *          WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *          See the License for the specific language governing permissions and
+ *          limitations under the License.
+ *
+ */
+#pragma once
+#include "axon_beamformer.h"
+
+/*
+ * Fractional delay filters for the delay-and-sum beamformer.
+ *
+ * Microphones are assumed to be BEAMFORMER_MIC_SPACING_MM apart, speed of sound 343m/s.
+ * For a steering angle theta (0 => broadside, +/-90 => endfire) the inter-channel delay in samples is
+ *     tau = spacing * sin(theta) / 343 * 16000
+ * Channel 0 is delayed by (5 - tau/2) samples and channel 1 by (5 + tau/2) samples, so the mic the
+ * wavefront reaches first waits for the other.
+ *
+ * Each filter is an 11 tap hamming windowed sinc, normalized to unity DC gain:
+ *     h(n) = sinc(n-delay) * (0.54+0.46*cos(2*PI*(n-delay)/11)), n=0..10
+ *
+ * Axon FIR correlates the taps with the input (q[n] = sum(y[k]*x[n+k])), so the taps are stored
+ * time-reversed, followed by the mandatory 0 coefficient. Format is Q1.14.
+ */
+#define BEAMFORMER_MIC_SPACING_MM 40
+#define BEAMFORMER_TAP_Q 14
+
+static const int32_t beamformer_steering_taps[kAxonAudioFeatureBeamformerSteerCount-1][BEAMFORMER_CHANNEL_CNT][BEAMFORMER_FIR_TAP_CNT] = {
+    { // kAxonAudioFeatureBeamformerBroadside, tau=0
+        {0,0,0,0,0,16384,0,0,0,0,0,0},
+        {0,0,0,0,0,16384,0,0,0,0,0,0},
+    },
+    { // kAxonAudioFeatureBeamformerLeft45, tau=-1.319
+        {187,-531,1263,-2973,13316,6705,-2226,969,-389,129,-66,0},
+        {-66,129,-389,969,-2226,6705,13316,-2973,1263,-531,187,0},
+    },
+    { // kAxonAudioFeatureBeamformerRight45, tau=1.319
+        {-66,129,-389,969,-2226,6705,13316,-2973,1263,-531,187,0},
+        {187,-531,1263,-2973,13316,6705,-2226,969,-389,129,-66,0},
+    },
+    { // kAxonAudioFeatureBeamformerLeftEndfire, tau=-1.866
+        {61,-163,377,-937,16255,1094,-421,183,-70,23,-17,0},
+        {-17,23,-70,183,-421,1094,16255,-937,377,-163,61,0},
+    },
+    { // kAxonAudioFeatureBeamformerRightEndfire, tau=1.866
+        {-17,23,-70,183,-421,1094,16255,-937,377,-163,61,0},
+        {61,-163,377,-937,16255,1094,-421,183,-70,23,-17,0},
+    },
+};
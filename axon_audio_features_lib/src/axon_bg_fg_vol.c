@@ -23,6 +23,7 @@
 #include "axon_api.h"
 #include "axon_dep.h"
 #include "axon_audio_features_api.h"
+#include "axon_kws_stats_api.h"
 #include <math.h>
 #include "axon_bg_fg_vol.h"
 
@@ -46,9 +47,14 @@ typedef enum {
   kBgFgAxonOpAltSamplePowerL2Norm,
 #endif
   kBgFgAxonOpSamplePowerL2Norm,
+#if BGFG_SUBTRACT_MEAN
+  kBgFgAxonOpClearImaginary, // 0 the imaginary slots back out so the buffer is ready for the fft
+#endif
   kBgFgAxonOpCount // 1 operation
 } BgFgAxonOperationEnum;
 
+static_assert(kBgFgAxonOpCount<=BGFG_MAX_OP_CNT, "BGFG_MAX_OP_CNT TOO SMALL!!");
+
 RETAINED_MEMORY_SECTION_ATTRIBUTE
 struct {
   BackgroundForegroundResultsStruct r;
@@ -64,6 +70,7 @@ struct {
   uint32_t profiling_timestamp;
   uint8_t winddow_width_in_slices;
   volatile uint8_t busy;
+  void (*done_callback)(AxonResultEnum result); // optional, invoked after the bg/fg state is updated
 } BgFgInfoStruct;
 
 void AxonBgFgPrintStats() {
@@ -152,6 +159,21 @@ AxonResultEnum AxonBgFgPrepare(void *axon_handle, int32_t *raw_input, uint32_t r
   if (kAxonResultSuccess > (result=AxonApiDefineOpL2norm(axon_handle, &axon_input, &BgFgInfoStruct.axon_ops[kBgFgAxonOpSamplePowerL2Norm]))) {
     return result;
   }
+
+#if BGFG_SUBTRACT_MEAN
+  // 0*x+0 into the "imaginary" locations used by kBgFgAxonOpSubtractMean
+  axon_input.length = raw_input_len>>1;
+  axon_input.output_rounding = kAxonRoundingNone;
+  axon_input.x_in = raw_input+1;
+  axon_input.x_stride = kAxonStride2;
+  axon_input.a_in = 0;
+  axon_input.b_in = 0;
+  axon_input.q_out = raw_input+1;
+  axon_input.q_stride = kAxonStride2;
+  if (kAxonResultSuccess > (result=AxonApiDefineOpAxpb(axon_handle, &axon_input, &BgFgInfoStruct.axon_ops[kBgFgAxonOpClearImaginary]))) {
+    return result;
+  }
+#endif
   BgFgInfoStruct.winddow_width_in_slices = bgfg_window_slice_cnt;
   return kAxonResultSuccess;
 }
@@ -222,17 +244,13 @@ static void calc_window_width(BackgroundForegroundResultsStruct *bg_fg_results,
 }
 
 /*
- * callback when axon ops complete.
+ * Updates the background/foreground state once the axon ops have completed.
  */
-static bg_fg_ops_done_callback(AxonResultEnum result, void *callback_context) {
-  AxonBoolEnum last_frame = (AxonBoolEnum)callback_context;
+void AxonBgFgFrameComplete(AxonBoolEnum last_frame) {
   // not busy any more
   BgFgInfoStruct.busy = 0;
 #if BGFG_SUBTRACT_MEAN
-  // need to 0 out the imaginary slots.
-  for (int sample_ndx=0; sample_ndx < AXON_AUDIO_FEATURE_FRAME_LEN; sample_ndx+=2) {
-    *(BgFgInfoStruct.input_ptr+1+sample_ndx) = 0;
-  }
+  // imaginary slots were 0'd by kBgFgAxonOpClearImaginary
   float power_f = BgFgInfoStruct.alt_sample_power;
 #else
   float power_f = BgFgInfoStruct.current_sample_power;
@@ -309,22 +327,49 @@ static bg_fg_ops_done_callback(AxonResultEnum result, void *callback_context) {
   BgFgInfoStruct.r.execution_time_ticks += (AxonHostGetTime()-BgFgInfoStruct.profiling_timestamp);
 }
 
+/*
+ * callback when axon ops complete.
+ */
+static void bg_fg_ops_done_callback(AxonResultEnum result, void *callback_context) {
+  AxonBgFgFrameComplete((AxonBoolEnum)callback_context);
+
+  if (NULL!=BgFgInfoStruct.done_callback) {
+    BgFgInfoStruct.done_callback(result);
+  }
+}
+
+/*
+ * API function
+ */
+uint8_t AxonBgFgCopyOpHandles(AxonOpHandle *op_handles) {
+  memcpy(op_handles, BgFgInfoStruct.axon_ops, sizeof(BgFgInfoStruct.axon_ops));
+  return kBgFgAxonOpCount;
+}
+
+/*
+ * API function
+ */
+void AxonBgFgFrameStart() {
+  BgFgInfoStruct.profiling_timestamp = AxonHostGetTime();
+  BgFgInfoStruct.r.valid_window_length = 0;
+  BgFgInfoStruct.busy = 1;
+}
+
 /*
  * API function
  * Note: raw_input expects signed 32bit values every other index, ie, the input format to the FFT.
  * This will queue up an operation then perform all the calculations in the callback.
  */
-AxonResultEnum AxonBgFgProcessFrame(void *axon_handle, AxonBoolEnum last_frame, AxonAsyncModeEnum async_mode) {
+AxonResultEnum AxonBgFgProcessFrame(void *axon_handle, AxonBoolEnum last_frame, AxonAsyncModeEnum async_mode, void (*done_callback)(AxonResultEnum result)) {
   /*
    * queued ops struct doesn't need to be
    * in retained memory.
    */
   static AxonMgrQueuedOpsStruct bg_fg_queued_ops;
-  BgFgInfoStruct.profiling_timestamp = AxonHostGetTime();
-  BgFgInfoStruct.r.valid_window_length = 0;
+  BgFgInfoStruct.done_callback = done_callback;
+  AxonBgFgFrameStart();
   if (async_mode==kAxonAsyncModeSynchronous) {
-    AxonApiExecuteOps(axon_handle, kBgFgAxonOpCount,  BgFgInfoStruct.axon_ops, kAxonAsyncModeSynchronous);
-    AxonApiQueueOpsList(axon_handle,&bg_fg_queued_ops);
+    AXON_KWS_STATS_EXECUTE_OPS(axon_handle, kBgFgAxonOpCount,  BgFgInfoStruct.axon_ops, kAxonAsyncModeSynchronous);
     bg_fg_ops_done_callback(kAxonResultSuccess, (void *)last_frame);
     return kAxonResultSuccess;
   } else {
@@ -333,9 +378,7 @@ AxonResultEnum AxonBgFgProcessFrame(void *axon_handle, AxonBoolEnum last_frame,
     bg_fg_queued_ops.callback_function = bg_fg_ops_done_callback;
     bg_fg_queued_ops.op_handle_count = kBgFgAxonOpCount;
     bg_fg_queued_ops.op_handle_list = BgFgInfoStruct.axon_ops;
-    // mark as busy
-    BgFgInfoStruct.busy = 1;
-    return AxonApiQueueOpsList(axon_handle,&bg_fg_queued_ops);
+    return AXON_KWS_STATS_QUEUE_OPS_LIST(axon_handle,&bg_fg_queued_ops);
   }
 }
 /*
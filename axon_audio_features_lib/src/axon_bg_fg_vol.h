@@ -92,10 +92,23 @@ typedef struct {
 
 void AxonBgFgRestart();
 
-AxonResultEnum AxonBgFgProcessFrame(void *axon_handle, AxonBoolEnum last_frame, AxonAsyncModeEnum async_mode);
+/*
+ * done_callback (can be NULL) is invoked once the bg/fg state has been updated for this frame.
+ */
+AxonResultEnum AxonBgFgProcessFrame(void *axon_handle, AxonBoolEnum last_frame, AxonAsyncModeEnum async_mode, void (*done_callback)(AxonResultEnum result));
 /*
  * Call this to get the processing state (busy=1, idle=0)
  */
 AxonResultEnum AxonBgFgProcessState();
 
 AxonResultEnum AxonBgFgPrepare(void *axon_handle, int32_t *raw_input, uint32_t raw_input_len, uint8_t bgfg_window_slice_cnt);
+
+/*
+ * For callers that submit the bg/fg ops as part of their own op list instead of AxonBgFgProcessFrame().
+ * AxonBgFgCopyOpHandles() copies up to BGFG_MAX_OP_CNT handles and returns the count.
+ * AxonBgFgFrameStart() is called before the ops are submitted, AxonBgFgFrameComplete() after they complete.
+ */
+#define BGFG_MAX_OP_CNT 5
+uint8_t AxonBgFgCopyOpHandles(AxonOpHandle *op_handles);
+void AxonBgFgFrameStart();
+void AxonBgFgFrameComplete(AxonBoolEnum last_frame);
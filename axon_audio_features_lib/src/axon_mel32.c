@@ -24,7 +24,9 @@
 #include "axon_dep.h"
 #include "axon_audio_features_api.h"
 #include "axon_logging_api.h"
+#include "axon_kws_stats_api.h"
 #include "axon_bg_fg_vol.h"
+#include "axon_beamformer.h"
 
 #define FILTER_BANK_EXTRA_COEFFS 2
 
@@ -32,14 +34,16 @@
 /*
  * This file can be built to support one or both of Mel32 (spectrogram) and MFCCs.
  * Steps are:
+ * 0. optional delay-and-sum beamformer on stereo input (see axon_beamformer.c)
  * 1. input: 512 samples of 16Khz audio (Mel32 and MFCC)
  * 2. cosine hamming window,     (Mel32 and MFCC)
  * 3. 512 tap FFT                (Mel32 and MFCC)
  * 4. Average power (X^2 + Y^2)/512 (Mel32 and MFCC)
+ * 4a. Optional spectral subtraction of the background noise floor (Mel32 and MFCC)
  * 5. Power rounding (Mel32 and MFFC use different values.Mel32 needs additional rounding because it doesn't have a SqRt performed before the filter banks).
  * 6. sqrt (MFCC only)
  * 7. 32 filters banks between 0 and 8000hz. (Mel32 and MFCC)
- * 8. Software rounding to 24 bits (Mel32 only)
+ * 8. Rounding to 24 bits, done on axon by splitting the power in 2 (Mel32 and MFCC w/o sqrt)
  * 9. ln()                                   (Mel32 and MFCC)
  * 10. ln() offset added - Input to ln() is interpreted as Q11.12 so whatever the actual q factor is, the difference needs to be added to the ln() output (Mel32 and MFCC)
  * 11. DCT (MFCC only)
@@ -52,9 +56,21 @@
  * 2 => log intermediate result execution times
  * 1 => Log final result vector
  * 0 => no logging
+ * The vectors are decimal text unless axon_utils is built with AXON_LOGGING_BINARY_DUMP=1, which sends them as
+ * binary dumps for axon_tools/vector_dump.
  */
 #define MEL32_DEBUG_VECTORS 0
 
+/*
+ * 1 => spectral subtraction of a per-bin noise floor from the fft power, prior to the filterbanks.
+ * The noise floor only adapts while the BG/FG detector reports background. In gated mode that is the current
+ * slice's decision. Otherwise BG/FG runs in the same op list as the update, so the previous slice's decision is
+ * used, and the first foreground slice after background still gets blended into the floor (at NOISE_FLOOR_ALPHA).
+ * Slices that gated mode fills from the background cache don't run the update at all, so the floor stays frozen
+ * through them and only learns on the refresh slices.
+ */
+#define MEL32_NOISE_SUPPRESSION 0
+
 
 // after doing the final log, need to add ln(2^ADJUSTMENT_BIT_COUNT) (in q11.12)
 /*
@@ -97,9 +113,17 @@ typedef enum {
   kMel32AxonOpWindowXty,  // 1st op is the window vector multiply
   kMel32AxonOpFft,    // do the fft
   kMel32AxonOpFftPowerXspys, // Square and sum real/imaginary pairs
-  kMfccAxonOpFftPowerSum,     // sum of the fft powers. Only for kAxonAudioFeatureMfccOrthoEnergyAppend
+  kMel32AxonOpNoiseFloorUpdateAxpby,   // blend the fft power into the noise floor. Only if MEL32_NOISE_SUPPRESSION
+  kMel32AxonOpNoiseSubtractAxpby,      // (1-floor)*power - over_subtraction*noise, relu'd. Only if MEL32_NOISE_SUPPRESSION
+  kMel32AxonOpNoiseSpectralFloorAxpby, // add floor*power back in. Only if MEL32_NOISE_SUPPRESSION
+  kMel32AxonOpPowerHiAxpb,    // upper bits of the fft power. Not for kAxonAudioFeatureMfccFftMagOrtho
+  kMel32AxonOpPowerLoAxpby,   // lower FILTER_BANK_SW_ROUND bits of the fft power. Not for kAxonAudioFeatureMfccFftMagOrtho
+  kMfccAxonOpFftPowerSum,     // sum of the fft powers (lower bits). Only for kAxonAudioFeatureMfccOrthoEnergyAppend
+  kMfccAxonOpFftPowerHiSum,   // sum of the fft powers (upper bits). Only for kAxonAudioFeatureMfccOrthoEnergyAppend
   kMfccAxonOpFftMagnitudeSqrt,  // Square root of power. Only for kAxonAudioFeatureMfccFftMagOrtho
   kMel32FilterBankPlaceHolder, // filterbank operations
+  kMel32AxonOpFilterBankRoundAxpb, // shift the lower bits filterbank output down. Not for kAxonAudioFeatureMfccFftMagOrtho
+  kMel32AxonOpFilterBankHiXpy,     // add the upper bits filterbank output. Not for kAxonAudioFeatureMfccFftMagOrtho
   kMel32AxonOpMelBinLog, // natural log of the mel bin
   kMfccAxonOpAddLogOffsetScalar, // add the log offset to correct for q11.12 interpretation of input to log
   kMfccAxonOpAddLogOffsetVector, // add the log offset to correct for q11.12 interpretation of input to log
@@ -125,6 +149,12 @@ typedef enum {
   kMel32FilterBankAxonOpCnt,
 } Mel32FilterBankAxonOpEnum;
 
+/*
+ * Mar ops in filter_bank_ops. Each one gets a 2nd copy when the power is split, see FILTER_BANK_FLOOR_BIAS.
+ */
+#define MEL32_FILTER_BANK_MAR_CNT (MEL32_COEFS_GROUP1_OP_CNT+MEL32_COEFS_GROUP2_OP_CNT)
+#define MEL32_FILTER_BANK_MAX_OP_CNT (kMel32FilterBankAxonOpCnt+MEL32_FILTER_BANK_MAR_CNT)
+
 # define IS_MEL32_MEMCPY_OP(OP_NDX) ((OP_NDX==kMel32AxonOpMemCpyMeans) || (OP_NDX==kMel32AxonOpMemCpyInvStds))
 
 
@@ -145,12 +175,36 @@ static struct {
   Mel32AxonOperationEnum op_enums[kMel32AxonOpCount];
   uint8_t op_cnt;
   uint8_t filterbank_op_ndx;
+  uint8_t filterbank_op_cnt;
   AxonOpHandle mel32_op_handles[kMel32AxonOpCount];
-  AxonOpHandle filterbank_op_handles[kMel32FilterBankAxonOpCnt];
+  AxonOpHandle filterbank_op_handles[MEL32_FILTER_BANK_MAX_OP_CNT];
+  /*
+   * Per-frame op list: beamformer ops, bg/fg ops, then the mel32 ops w/ the filterbank place-holder expanded in place.
+   * The beamformer fills buffers.fft, and the bg/fg ops share it with the window op, so they go 1st.
+   */
+  AxonOpHandle frame_op_handles[BEAMFORMER_OP_CNT+BGFG_MAX_OP_CNT+kMel32AxonOpCount+MEL32_FILTER_BANK_MAX_OP_CNT];
+  uint8_t frame_beamformer_op_cnt;  // beamformer ops at the start of frame_op_handles
+  uint8_t frame_bgfg_op_cnt;        // bg/fg ops following the beamformer ops
+  uint8_t frame_op_cnt;
+  uint8_t frame_beamformer_pending; // beamformer ops were submitted w/ the feature ops
+  uint8_t frame_bgfg_pending;       // bg/fg ops were submitted w/ the feature ops
+  AxonBoolEnum last_frame;
+  uint32_t op_list_cnt;             // op lists submitted since the last restart
   void (*frame_complete_callback_function)(AxonResultEnum result);
   uint32_t frame_cnt;
+  uint8_t gating_refresh_interval; // 0 => gating disabled
+  uint8_t gated_skips_in_a_row;   // slices filled from the cache since the last computed slice
+  uint8_t slices_since_foreground;
+  uint8_t slice_from_cache;       // current slice is being filled from the background cache
+  AxonBoolEnum background_cache_valid;
+  uint32_t gated_slice_cnt;       // total slices filled from the cache since the last restart
 } mel32_state_info;
 
+/*
+ * Gated mode keeps computing features for this many slices after the last foreground slice.
+ */
+#define MEL32_GATING_HANGOVER_SLICES 2
+
 /*
  * buffers in un-retained memory
  */
@@ -161,15 +215,69 @@ static union {
     int32_t fft_1st_half[AXON_AUDIO_FEATURE_FRAME_LEN]; // holds the 1st 256 complex numbers
     int32_t after_filter_banks[AXON_AUDIO_FEATURE_FILTERBANK_COUNT]; // filter bank and later results go here
     int32_t fft_energy[FILTER_BANK_EXTRA_COEFFS];
+    int32_t filter_banks_hi[AXON_AUDIO_FEATURE_FILTERBANK_COUNT+FILTER_BANK_EXTRA_COEFFS]; // filter banks over power_hi
+    int32_t power_lo[AXON_AUDIO_FEATURE_FRAME_LEN/AUDIO_OVERSAMPLE_RATE]; // lower FILTER_BANK_SW_ROUND bits of the fft power
   };
 } buffers;
+static_assert(sizeof(buffers)==sizeof(buffers.fft), "mel32 buffers overflow the fft buffer");
+
+/*
+ * Final features of the last computed background slice (log mel32 or mfcc coefficients, plus the
+ * log fft energy that follows them), used to fill skipped slices in gated mode.
+ */
+static int32_t background_cache[AXON_AUDIO_FEATURE_FILTERBANK_COUNT+FILTER_BANK_EXTRA_COEFFS];
+
+/*
+ * Spectral subtraction. Output is max(power - over_subtraction*noise, floor*power), computed as
+ *   floor*power + relu((1-floor)*power - over_subtraction*noise)
+ * The noise floor is updated as
+ *   noise = (1-alpha)*noise + alpha*power
+ * with the scalars read through pointers so that the update can be switched off
+ * (a=1, b=0) on foreground without redefining the op. All scalars are q.NOISE_FLOOR_Q.
+ */
+#define FFT_POWER_LEN (AXON_AUDIO_FEATURE_FRAME_LEN/AUDIO_OVERSAMPLE_RATE)
+#define NOISE_FLOOR_Q 8
+#define NOISE_FLOOR_ALPHA 32          // 0.125
+#define NOISE_OVER_SUBTRACTION 384    // 1.5
+#define NOISE_SPECTRAL_FLOOR 13       // 0.05
+
+/*
+ * The noise floor is re-learned at the start of each session (AxonAudioFeaturesRestart), so it
+ * doesn't need to be retained.
+ */
+static struct {
+  int32_t noise_floor[FFT_POWER_LEN];
+  int32_t update_a; // weight of the current noise floor
+  int32_t update_b; // weight of the current fft power
+  uint32_t update_cnt;
+} noise_floor_info;
+
+/*
+ * fft power only occupies the 1st FFT_POWER_LEN slots of buffers.fft, the rest is free
+ * to use as scratch by the spectral subtraction.
+ */
+#define NOISE_SUBTRACT_SCRATCH (buffers.fft+FFT_POWER_LEN)
+
+/*
+ * The filterbank sums are up to 32 bits and need to come down by FILTER_BANK_SW_ROUND, but axon ops only read
+ * 24 bit inputs. So the fft power x is split as
+ *   power_hi = floor(x/2^FILTER_BANK_SW_ROUND), power_lo = x - power_hi*2^FILTER_BANK_SW_ROUND
+ * and the filterbanks (and energy sum) run over both. The result is
+ *   sum(power_hi) + floor(sum(power_lo)/2^FILTER_BANK_SW_ROUND)
+ * which is the same as the full sum shifted down. Both terms fit 24 bits as long as the full sum fits 31, ie
+ * wherever the single Mar over x didn't overflow either. Past that sum(power_hi) wraps on the 24 bit read.
+ *
+ * Axon rounding is round half to even. floor(x/2^N) is computed as (2x - (2^N-1)) rounded by N+1, which never
+ * lands on a tie. axon_tools/mel32_rounding_check compares all of this against the full sum shifted down.
+ */
+#define FILTER_BANK_FLOOR_BIAS ((1<<FILTER_BANK_SW_ROUND)-1)
+#define POWER_HI (buffers.fft+FFT_POWER_LEN) // shares the spectral subtraction scratch, which is done by then
 
 /*
  * queued ops struct doesn't need to be
  * in retained memory.
  */
 static AxonMgrQueuedOpsStruct mel32_queued_ops;
-static AxonMgrQueuedOpsStruct filterbank_queued_ops;
 
 
 static inline void copy_raw_to_fft_buffer(
@@ -265,6 +373,106 @@ static const audio_feature_op_info_struct audio_feature_ops[]= {
             .q_stride = kAxonStride1,
         },
     },
+    {
+        .label = "NOISE FLOOR UPDATE",
+        .op_index = kMel32AxonOpNoiseFloorUpdateAxpby,
+        .define_op_function = AxonApiDefineOpAxpbyPointer,
+        .axon_input = {
+            .length = FFT_POWER_LEN,
+            .data_width = kAxonDataWidth24,
+            .data_packing = kAxonDataPackingDisabled,
+            .output_rounding = kAxonRoundingNone+NOISE_FLOOR_Q,
+            .output_af = kAxonAfDisabled,
+            .x_in = noise_floor_info.noise_floor,
+            .x_stride = kAxonStride1,
+            .y_in = buffers.fft,
+            .y_stride = kAxonStride1,
+            .q_out = noise_floor_info.noise_floor,
+            .q_stride = kAxonStride1,
+            .a_in = 0, // pointers supplied at prepare time
+            .b_in = 0,
+        },
+    },
+    {
+        .label = "NOISE SUBTRACT",
+        .op_index = kMel32AxonOpNoiseSubtractAxpby,
+        .define_op_function = AxonApiDefineOpAxpby,
+        .axon_input = {
+            .length = FFT_POWER_LEN,
+            .data_width = kAxonDataWidth24,
+            .data_packing = kAxonDataPackingDisabled,
+            .output_rounding = kAxonRoundingNone+NOISE_FLOOR_Q,
+            .output_af = kAxonAfRelu,
+            .x_in = buffers.fft,
+            .x_stride = kAxonStride1,
+            .y_in = noise_floor_info.noise_floor,
+            .y_stride = kAxonStride1,
+            .q_out = NOISE_SUBTRACT_SCRATCH,
+            .q_stride = kAxonStride1,
+            .a_in = (1<<NOISE_FLOOR_Q)-NOISE_SPECTRAL_FLOOR,
+            .b_in = -NOISE_OVER_SUBTRACTION,
+        },
+    },
+    {
+        .label = "NOISE SPECTRAL FLOOR",
+        .op_index = kMel32AxonOpNoiseSpectralFloorAxpby,
+        .define_op_function = AxonApiDefineOpAxpby,
+        .axon_input = {
+            .length = FFT_POWER_LEN,
+            .data_width = kAxonDataWidth24,
+            .data_packing = kAxonDataPackingDisabled,
+            .output_rounding = kAxonRoundingNone+NOISE_FLOOR_Q,
+            .output_af = kAxonAfDisabled,
+            .x_in = NOISE_SUBTRACT_SCRATCH,
+            .x_stride = kAxonStride1,
+            .y_in = buffers.fft,
+            .y_stride = kAxonStride1,
+            .q_out = buffers.fft,
+            .q_stride = kAxonStride1,
+            .a_in = 1<<NOISE_FLOOR_Q,
+            .b_in = NOISE_SPECTRAL_FLOOR,
+        },
+    },
+    {   // output is (2x - FILTER_BANK_FLOOR_BIAS) rounded by FILTER_BANK_SW_ROUND+1, same as x >> FILTER_BANK_SW_ROUND
+        .label = "FFT POWER HI",
+        .op_index = kMel32AxonOpPowerHiAxpb,
+        .define_op_function = AxonApiDefineOpAxpb,
+        .axon_input = {
+            .length = FFT_POWER_LEN,
+            .data_width = kAxonDataWidth24,
+            .data_packing = kAxonDataPackingDisabled,
+            .output_rounding = kAxonRoundingNone+FILTER_BANK_SW_ROUND+1,
+            .output_af = kAxonAfDisabled,
+            .x_in = buffers.fft,
+            .x_stride = kAxonStride1,
+            .y_in = NULL,
+            .y_stride = kAxonStride1,
+            .q_out = POWER_HI,
+            .q_stride = kAxonStride1,
+            .a_in = 2,
+            .b_in = -FILTER_BANK_FLOOR_BIAS,
+        },
+    },
+    {
+        .label = "FFT POWER LO",
+        .op_index = kMel32AxonOpPowerLoAxpby,
+        .define_op_function = AxonApiDefineOpAxpby,
+        .axon_input = {
+            .length = FFT_POWER_LEN,
+            .data_width = kAxonDataWidth24,
+            .data_packing = kAxonDataPackingDisabled,
+            .output_rounding = kAxonRoundingNone,
+            .output_af = kAxonAfDisabled,
+            .x_in = buffers.fft,
+            .x_stride = kAxonStride1,
+            .y_in = POWER_HI,
+            .y_stride = kAxonStride1,
+            .q_out = buffers.power_lo,
+            .q_stride = kAxonStride1,
+            .a_in = 1,
+            .b_in = -(1<<FILTER_BANK_SW_ROUND),
+        },
+    },
     // #  if MFCC_APPEND_ENERGY  // place mfcc_energies[32] with ln(sum(avg(fft_power())))
       {
           .label = "FFT ENERGY",
@@ -277,12 +485,29 @@ static const audio_feature_op_info_struct audio_feature_ops[]= {
               .data_packing = kAxonDataPackingDisabled,
               .output_rounding = kAxonRoundingNone,
               .output_af = kAxonAfDisabled,
-              .x_in = buffers.fft,
+              .x_in = buffers.power_lo,
               .x_stride = kAxonStride1,
               .q_out = buffers.fft_energy,
               .q_stride = kAxonStride1,
           },
       },
+      {
+          .label = "FFT ENERGY HI",
+          .op_index = kMfccAxonOpFftPowerHiSum,
+          .define_op_function = AxonApiDefineOpAcc,
+          .axon_input = {
+              .length = AXON_AUDIO_FEATURE_FRAME_LEN/AUDIO_OVERSAMPLE_RATE,
+              .y_length = 1,
+              .data_width = kAxonDataWidth24,
+              .data_packing = kAxonDataPackingDisabled,
+              .output_rounding = kAxonRoundingNone,
+              .output_af = kAxonAfDisabled,
+              .x_in = POWER_HI,
+              .x_stride = kAxonStride1,
+              .q_out = buffers.filter_banks_hi+AXON_AUDIO_FEATURE_FILTERBANK_COUNT,
+              .q_stride = kAxonStride1,
+          },
+      },
       // #  if MFCC_FFT_ENERGY_SQRT
       {
           .label = "kMfccAxonOpFftMagnitudeSqrt",
@@ -323,6 +548,44 @@ static const audio_feature_op_info_struct audio_feature_ops[]= {
             .q_stride = kAxonStride1,
         },
     },
+    {   // output is (2x - FILTER_BANK_FLOOR_BIAS) rounded by FILTER_BANK_SW_ROUND+1, same as x >> FILTER_BANK_SW_ROUND
+        .label = "filterbank lo round",
+        .op_index = kMel32AxonOpFilterBankRoundAxpb,
+        .define_op_function = AxonApiDefineOpAxpb,
+        .axon_input = {
+            .length = AXON_AUDIO_FEATURE_FILTERBANK_COUNT+FILTER_BANK_EXTRA_COEFFS,
+            .data_width = kAxonDataWidth24,
+            .data_packing = kAxonDataPackingDisabled,
+            .output_rounding = kAxonRoundingNone+FILTER_BANK_SW_ROUND+1,
+            .output_af = kAxonAfDisabled,
+            .x_in = buffers.after_filter_banks,
+            .x_stride = kAxonStride1,
+            .y_in = NULL,
+            .y_stride = kAxonStride1,
+            .q_out = buffers.after_filter_banks,
+            .q_stride = kAxonStride1,
+            .a_in = 2,
+            .b_in = -FILTER_BANK_FLOOR_BIAS,
+        },
+    },
+    {  // after_filter_banks holds sum(power_lo)>>FILTER_BANK_SW_ROUND, add sum(power_hi)
+        .label = "filterbank hi",
+        .op_index = kMel32AxonOpFilterBankHiXpy,
+        .define_op_function = AxonApiDefineOpXpy,
+        .axon_input = {
+            .length = AXON_AUDIO_FEATURE_FILTERBANK_COUNT+FILTER_BANK_EXTRA_COEFFS,
+            .data_width = kAxonDataWidth24,
+            .data_packing = kAxonDataPackingDisabled,
+            .output_rounding = kAxonRoundingNone,
+            .output_af = kAxonAfDisabled,
+            .x_in = buffers.after_filter_banks,
+            .x_stride = kAxonStride1,
+            .y_in = buffers.filter_banks_hi,
+            .y_stride = kAxonStride1,
+            .q_out = buffers.after_filter_banks,
+            .q_stride = kAxonStride1,
+        },
+    },
     {
         .label = "ln(mel power)",
         .op_index = kMel32AxonOpMelBinLog,
@@ -1140,6 +1403,20 @@ static const audio_feature_op_info_struct filter_bank_ops[] = {
  * ensure all operations are accounted for in the filterbank ops list.
  */
 static_assert( (sizeof(filter_bank_ops)/sizeof(filter_bank_ops[0]))==kMel32FilterBankAxonOpCnt, "filter_bank_ops mis-sized");
+static_assert(BEAMFORMER_OP_CNT+BGFG_MAX_OP_CNT+kMel32AxonOpCount+MEL32_FILTER_BANK_MAX_OP_CNT<=0xFF, "frame_op_cnt overflows");
+
+/*
+ * Defines a copy of one of the filter_bank_ops Mars that reads power instead of buffers.fft and writes
+ * to sums instead of buffers.after_filter_banks.
+ */
+static AxonResultEnum define_filter_bank_mar(void *axon_handle, const AxonInputStruct *filter_bank_input,
+    const int32_t *power, int32_t *sums, AxonOpHandle *op_handle) {
+  AxonInputStruct mar_input;
+  memcpy(&mar_input, filter_bank_input, sizeof(mar_input));
+  mar_input.x_in = power + (filter_bank_input->x_in - buffers.fft);
+  mar_input.q_out = sums + (filter_bank_input->q_out - buffers.after_filter_banks);
+  return AxonApiDefineOpMar(axon_handle, &mar_input, op_handle);
+}
 
 /*
  * API function to define all the operations for Mel32 feature calculation.
@@ -1173,10 +1450,30 @@ AxonResultEnum AxonAudioFeaturePrepare(
   }
 
   /*
-   * Prepare the filter bank ops. These are in a dedicated batch used by mel32 and mfcc separately
+   * prepare the beamformer. It only gets used on stereo input w/ a steering preset selected.
    */
+  if (kAxonResultSuccess > (result=AxonBeamformerPrepare(axon_handle, buffers.fft))) {
+    return result;
+  }
+
+  /*
+   * Prepare the filter bank ops. These are in a dedicated batch used by mel32 and mfcc separately.
+   * Unless the fft magnitude keeps them in range, the Mars run over power_lo, then again over power_hi
+   * (see FILTER_BANK_FLOOR_BIAS).
+   */
+  AxonBoolEnum split_power = (which_variant != kAxonAudioFeatureMfccFftMagOrtho) ? kAxonBoolTrue : kAxonBoolFalse;
+  mel32_state_info.filterbank_op_cnt = kMel32FilterBankAxonOpCnt;
   for (ndx=0;ndx<kMel32FilterBankAxonOpCnt;ndx++) {
-    if (kAxonResultSuccess > (result=filter_bank_ops[ndx].define_op_function(axon_handle, &filter_bank_ops[ndx].axon_input, mel32_state_info.filterbank_op_handles+filter_bank_ops[ndx].op_index))) {
+    const AxonInputStruct *axon_input = &filter_bank_ops[ndx].axon_input;
+    AxonOpHandle *op_handles = mel32_state_info.filterbank_op_handles;
+    if (!split_power || (filter_bank_ops[ndx].define_op_function != AxonApiDefineOpMar)) {
+      result = filter_bank_ops[ndx].define_op_function(axon_handle, axon_input, op_handles+filter_bank_ops[ndx].op_index);
+    } else if (kAxonResultSuccess <= (result=define_filter_bank_mar(axon_handle, axon_input, buffers.power_lo,
+            buffers.after_filter_banks, op_handles+filter_bank_ops[ndx].op_index))) {
+      result = define_filter_bank_mar(axon_handle, axon_input, POWER_HI,
+          buffers.filter_banks_hi, op_handles+mel32_state_info.filterbank_op_cnt++);
+    }
+    if (kAxonResultSuccess > result) {
       return result;
     }
   }
@@ -1189,7 +1486,34 @@ AxonResultEnum AxonAudioFeaturePrepare(
     // copy flash copy into ram in case modifications are needed.
     memcpy(&lo_input_struct, &audio_feature_ops[ndx].axon_input,sizeof(lo_input_struct));
     switch (ndx) {
+      case kMel32AxonOpNoiseFloorUpdateAxpby:
+        if (!MEL32_NOISE_SUPPRESSION) {
+          continue;
+        }
+        // scalars are updated each frame depending on background/foreground
+        lo_input_struct.a_in = (int32_t)&noise_floor_info.update_a;
+        lo_input_struct.b_in = (int32_t)&noise_floor_info.update_b;
+        break;
+
+      case kMel32AxonOpNoiseSubtractAxpby:
+      case kMel32AxonOpNoiseSpectralFloorAxpby:
+        if (!MEL32_NOISE_SUPPRESSION) {
+          continue;
+        }
+        break;
+
+      case kMel32AxonOpPowerHiAxpb:
+      case kMel32AxonOpPowerLoAxpby:
+      case kMel32AxonOpFilterBankRoundAxpb:
+      case kMel32AxonOpFilterBankHiXpy:
+        if (!split_power) {
+          // fft magnitude keeps the filterbank output in range.
+          continue;
+        }
+        break;
+
       case kMfccAxonOpFftPowerSum: // sum of the fft powers. Only for kAxonAudioFeatureMfccOrthoEnergyAppend
+      case kMfccAxonOpFftPowerHiSum:
         if (which_variant != kAxonAudioFeatureMfccOrthoEnergyAppend) {
           continue;
         }
@@ -1312,6 +1636,23 @@ AxonResultEnum AxonAudioFeaturePrepare(
     mel32_state_info.op_cnt++;
   }
 
+  /*
+   * build the per-frame op list, skipping over the filterbank place-holder
+   */
+  mel32_state_info.frame_beamformer_op_cnt = AxonBeamformerCopyOpHandles(mel32_state_info.frame_op_handles);
+  mel32_state_info.frame_op_cnt = mel32_state_info.frame_beamformer_op_cnt;
+  mel32_state_info.frame_bgfg_op_cnt = AxonBgFgCopyOpHandles(mel32_state_info.frame_op_handles+mel32_state_info.frame_op_cnt);
+  mel32_state_info.frame_op_cnt += mel32_state_info.frame_bgfg_op_cnt;
+  memcpy(mel32_state_info.frame_op_handles+mel32_state_info.frame_op_cnt, mel32_state_info.mel32_op_handles,
+      mel32_state_info.filterbank_op_ndx*sizeof(AxonOpHandle));
+  mel32_state_info.frame_op_cnt += mel32_state_info.filterbank_op_ndx;
+  memcpy(mel32_state_info.frame_op_handles+mel32_state_info.frame_op_cnt, mel32_state_info.filterbank_op_handles,
+      mel32_state_info.filterbank_op_cnt*sizeof(AxonOpHandle));
+  mel32_state_info.frame_op_cnt += mel32_state_info.filterbank_op_cnt;
+  memcpy(mel32_state_info.frame_op_handles+mel32_state_info.frame_op_cnt, mel32_state_info.mel32_op_handles+mel32_state_info.filterbank_op_ndx+1,
+      (mel32_state_info.op_cnt-mel32_state_info.filterbank_op_ndx-1)*sizeof(AxonOpHandle));
+  mel32_state_info.frame_op_cnt += mel32_state_info.op_cnt-mel32_state_info.filterbank_op_ndx-1;
+
   return result;
 }
 
@@ -1325,8 +1666,15 @@ AxonResultEnum AxonAudioFeaturePrepare(
  */
 void AxonAudioFeaturesRestart() {
   AxonBgFgRestart();
+  AxonBeamformerRestart();
   memcpy(hamming_buffer, mel32_window, AXON_AUDIO_FEATURE_FRAME_LEN * sizeof(int32_t) );
   mel32_state_info.frame_cnt = 0;
+  mel32_state_info.gated_skips_in_a_row = 0;
+  mel32_state_info.slices_since_foreground = 0;
+  mel32_state_info.background_cache_valid = kAxonBoolFalse;
+  mel32_state_info.gated_slice_cnt = 0;
+  mel32_state_info.op_list_cnt = 0;
+  noise_floor_info.update_cnt = 0;
   if (kAxonAudioFeatureMfccOrthoEnergyAppend==mel32_state_info.audio_feature_variant) {
     // the ln() energy has a different q offset from the rest of the filterbank output.
     for (uint8_t loNdx=0; loNdx < AXON_AUDIO_FEATURE_FILTERBANK_COUNT; loNdx++) {
@@ -1336,20 +1684,36 @@ void AxonAudioFeaturesRestart() {
   }
 }
 
-static void filterbank_software_rounding() {
-  // just like mel32, if no sqrt then need to do a software round
-  for (uint8_t filter_bank_coef=0;filter_bank_coef<(AXON_AUDIO_FEATURE_FILTERBANK_COUNT+FILTER_BANK_EXTRA_COEFFS);filter_bank_coef++) {
-    buffers.after_filter_banks[filter_bank_coef] = buffers.after_filter_banks[filter_bank_coef] >> FILTER_BANK_SW_ROUND;
-  }
-
-}
-
 /*
  * This gets called to perform the 3rd (and last) async set of processing.
  * If in async mode, it is expected to be in response to an axon interrupt, so
  * need to check the driver status.
  */
 static void all_ops_done_callback(AxonResultEnum result, void *callback_context) {
+  if (mel32_state_info.frame_beamformer_pending) {
+    // beamformer ops were at the very front of this list
+    mel32_state_info.frame_beamformer_pending = 0;
+    AxonBeamformerFrameComplete();
+  }
+
+  if (mel32_state_info.frame_bgfg_pending) {
+    // bg/fg ops were at the front of this list
+    mel32_state_info.frame_bgfg_pending = 0;
+    AxonBgFgFrameComplete(mel32_state_info.last_frame);
+  }
+
+  if (kAxonResultSuccess != result) {
+    // had a failure, short circuit the result.
+    mel32_state_info.frame_complete_callback_function(result);
+    return;
+  }
+
+  if (mel32_state_info.gating_refresh_interval && !mel32_state_info.slice_from_cache &&
+      !AxonAudioFeaturesBgSliceIsForeground()) {
+    // freshly computed background slice, hang on to it for gated slices.
+    memcpy(background_cache, buffers.after_filter_banks, sizeof(background_cache));
+    mel32_state_info.background_cache_valid = kAxonBoolTrue;
+  }
 
   switch (mel32_state_info.audio_feature_variant) {
   case kAxonAudioFeatureMel32: // copy 32 coefficients
@@ -1383,87 +1747,111 @@ static void all_ops_done_callback(AxonResultEnum result, void *callback_context)
 
 
 /*
- * This gets called after mfcc filterbanks are completed.
+ * not breaking this up into individual operations, everything goes in a single batch
+ * w/ a single callback: optionally the beamformer and bg/fg ops, then all the mel32 ops.
+ * The beamformer and bg/fg results are picked up in the same callback as the features.
+ * The beamformer can only be included along with the bg/fg ops as it feeds them.
  */
-static void filterbanks_done_callback(AxonResultEnum result, void *callback_context) {
+static AxonResultEnum queue_feature_ops(AxonBoolEnum include_beamformer, AxonBoolEnum include_bgfg) {
+  uint8_t first_ndx = mel32_state_info.frame_beamformer_op_cnt+mel32_state_info.frame_bgfg_op_cnt;
 
-  if (kAxonResultSuccess != result) {
-    // had a failure, short circuit the result.
-    mel32_state_info.frame_complete_callback_function(result);
+  include_beamformer = include_bgfg ? include_beamformer : kAxonBoolFalse;
+  if (include_bgfg) {
+    first_ndx = mel32_state_info.frame_beamformer_op_cnt;
+    AxonBgFgFrameStart();
   }
-#if MEL32_DEBUG_VECTORS > 0
-  print_int32_vector(mel32_state_info.axon_handle, "mfcc", buffers.after_filter_banks, AXON_AUDIO_FEATURE_FILTERBANK_COUNT, 1);
-#endif
-
-  if (mel32_state_info.audio_feature_variant != kAxonAudioFeatureMfccFftMagOrtho) {
-  // do a software round unless using fft magnitude
-    filterbank_software_rounding();
+  if (include_beamformer) {
+    first_ndx = 0;
+    AxonBeamformerFrameStart();
   }
-
-  // MFCC filterbank just finished up, so now add the remainder of the ops
-  // resume after the mel32 filterbanks.
-  mel32_queued_ops.op_handle_list = mel32_state_info.mel32_op_handles+mel32_state_info.filterbank_op_ndx+1;
-
+  mel32_state_info.frame_beamformer_pending = include_beamformer;
+  mel32_state_info.frame_bgfg_pending = include_bgfg;
+  mel32_state_info.op_list_cnt++;
   mel32_queued_ops.callback_function = all_ops_done_callback;
+  mel32_queued_ops.op_handle_list = mel32_state_info.frame_op_handles+first_ndx;
   mel32_queued_ops.callback_context = NULL;
-  mel32_queued_ops.op_handle_count = mel32_state_info.op_cnt-mel32_state_info.filterbank_op_ndx-1;
-
-  AxonApiQueueOpsList(mel32_state_info.axon_handle,&mel32_queued_ops);
-
+  mel32_queued_ops.op_handle_count = mel32_state_info.frame_op_cnt-first_ndx;
+  return AXON_KWS_STATS_QUEUE_OPS_LIST(mel32_state_info.axon_handle, &mel32_queued_ops);
 }
 
-
-#if (AXON_AUDIO_FEATURE_MEL32)
-
+#if MEL32_NOISE_SUPPRESSION
 /*
- * This gets called after mel32 filterbanks are completed.
+ * sets the noise floor update scalars for the next run of the feature ops.
+ * 1st frame of a session seeds the noise floor with the fft power, foreground freezes it.
  */
-static void mel32_filterbanks_done_callback(AxonResultEnum result, void *callback_context) {
+static void noise_floor_set_update(uint8_t foreground) {
+  if (0==noise_floor_info.update_cnt) {
+    noise_floor_info.update_a = 0;
+    noise_floor_info.update_b = 1<<NOISE_FLOOR_Q;
+    noise_floor_info.update_cnt++;
+  } else if (foreground) {
+    noise_floor_info.update_a = 1<<NOISE_FLOOR_Q;
+    noise_floor_info.update_b = 0;
+  } else {
+    noise_floor_info.update_a = (1<<NOISE_FLOOR_Q)-NOISE_FLOOR_ALPHA;
+    noise_floor_info.update_b = NOISE_FLOOR_ALPHA;
+    noise_floor_info.update_cnt++;
+  }
+}
+#endif
 
-  if (kAxonResultSuccess != result) {
-    // had a failure, short circuit the result.
+/*
+ * Gated mode: called when the bg/fg ops for the slice are done. Decides whether the feature
+ * ops are worth running, or if the slice can be filled from the background cache.
+ */
+static void gated_bg_fg_done_callback(AxonResultEnum result) {
+  if (kAxonResultSuccess > result) {
     mel32_state_info.frame_complete_callback_function(result);
+    return;
   }
-#if MEL32_DEBUG_VECTORS > 0
-  print_int32_vector(mel32_state_info.axon_handle, "mel32", buffers.after_filter_banks, AXON_AUDIO_FEATURE_FILTERBANK_COUNT, 1);
-#endif
 
+  if (AxonAudioFeaturesBgSliceIsForeground()) {
+    mel32_state_info.slices_since_foreground = 0;
+  } else if (mel32_state_info.slices_since_foreground < 0xFF) {
+    mel32_state_info.slices_since_foreground++;
+  }
 
-  // MEL32 filterbank just finished up...
-#if FILTER_BANK_SW_ROUND > 0
-  /*
-   * do the software round
-   */
-  filterbank_software_rounding();
+  if ( (mel32_state_info.slices_since_foreground <= MEL32_GATING_HANGOVER_SLICES) || // foreground is likely...
+       (!mel32_state_info.background_cache_valid) ||                                  // ...or nothing to fill in with...
+       (mel32_state_info.gated_skips_in_a_row >= mel32_state_info.gating_refresh_interval) ) { // ...or time to refresh the cache
+    mel32_state_info.gated_skips_in_a_row = 0;
+    mel32_state_info.slice_from_cache = 0;
+#if MEL32_NOISE_SUPPRESSION
+    // this slice's bg/fg decision is in, so the noise floor update can use it.
+    noise_floor_set_update(AxonAudioFeaturesBgSliceIsForeground());
 #endif
-  // resume after the mel32 filterbanks.
-  mel32_queued_ops.op_handle_list = mel32_state_info.mel32_op_handles+kMel32FilterBankPlaceHolder+1;
+    // bg/fg already ran
+    if (kAxonResultSuccess > (result=queue_feature_ops(kAxonBoolFalse, kAxonBoolFalse))) {
+      mel32_state_info.frame_complete_callback_function(result);
+    }
+    return;
+  }
 
-#if (AXON_AUDIO_FEATURE_MFCC)
-  // mel32s and mfccs are both enabled, need to execute up to the mfccs filterbank
-  mel32_queued_ops.callback_function = NULL; // don't need a callback
-  mel32_queued_ops.callback_context = NULL;
-  mel32_queued_ops.op_handle_count = kMfccFilterBankPlaceHolder-kMel32FilterBankPlaceHolder-1;
-  AxonApiQueueOpsList(mel32_state_info.axon_handle,&mel32_queued_ops);
-  // and also queue up the mfcc filterbanks.
-  filterbank_queued_ops.callback_function = mfcc_filterbanks_done_callback;
-  filterbank_queued_ops.op_handle_list = mel32_state_info.filterbank_op_handles;
-  filterbank_queued_ops.callback_context = NULL;
-  filterbank_queued_ops.op_handle_count = kMel32FilterBankAxonOpCnt;
-  AxonApiQueueOpsList(mel32_state_info.axon_handle,&filterbank_queued_ops);
+  // steady background, re-use the cached slice.
+  mel32_state_info.gated_skips_in_a_row++;
+  mel32_state_info.gated_slice_cnt++;
+  mel32_state_info.slice_from_cache = 1;
+  memcpy(buffers.after_filter_banks, background_cache, sizeof(background_cache));
+  all_ops_done_callback(kAxonResultSuccess, NULL);
+}
 
-#else
-  // no MFCCs, so just finish up the mel32s
-  mel32_queued_ops.callback_function = all_ops_done_callback;
-  mel32_queued_ops.op_handle_list = mel32_state_info.mel32_op_handles+kMel32FilterBankPlaceHolder+1;
-  mel32_queued_ops.callback_context = NULL;
-  mel32_queued_ops.op_handle_count = kMel32AxonOpCount-kMel32FilterBankPlaceHolder-1;
-  AxonApiQueueOpsList(mel32_state_info.axon_handle,&mel32_queued_ops);
-#endif
+/*
+ * API function
+ */
+void AxonAudioFeaturesSetGating(uint8_t refresh_interval) {
+  mel32_state_info.gating_refresh_interval = refresh_interval;
+}
 
+uint32_t AxonAudioFeaturesGatedSliceCount() {
+  return mel32_state_info.gated_slice_cnt;
+}
 
+/*
+ * API function
+ */
+uint32_t AxonAudioFeaturesOpListCount() {
+  return mel32_state_info.op_list_cnt;
 }
-#endif
 
 /*
  * API function
@@ -1477,6 +1865,7 @@ AxonResultEnum AxonAudioFeatureProcessFrame(
     void *output_buffer /**< stores the mel32 output vector */
     ){
   AxonResultEnum result;
+  AxonBoolEnum beamformer_active = AxonBeamformerIsActive(input_stride);
 #if MEL32_DEBUG_VECTORS > 1
   uint32_t start_time;
   uint32_t end_time;
@@ -1485,25 +1874,62 @@ AxonResultEnum AxonAudioFeatureProcessFrame(
 #endif
 
   mel32_state_info.output_buffer = output_buffer;
+  mel32_state_info.last_frame = last_frame;
+
+#if MEL32_NOISE_SUPPRESSION
+  if (!mel32_state_info.gating_refresh_interval) {
+    // BG/FG for this frame is still in flight, so gate the noise floor update on the last frame.
+    noise_floor_set_update(AxonAudioFeaturesBgSliceIsForeground());
+  }
+#endif
 
 #if MEL32_DEBUG_VECTORS > 4
   print_int16_vector(axon_handle, "raw_input_ping", raw_input_ping, ping_count, input_stride);
   //print_int16_vector(axon_handle, "raw_input_pong", raw_input_ping, AXON_AUDIO_FEATURE_FRAME_LEN-ping_count, input_stride);
 #endif
 
-  // copy raw input to our internal int32 buffer
-  copy_raw_to_fft_buffer( raw_input_ping, ping_count, raw_input_pong, buffers.fft, input_stride);
-
 #if MEL32_DEBUG_VECTORS > 1
   // need bg fg to run synchronously so that axon is free to be used upon return
 #  define BG_FG_ASYNC_MODE kAxonAsyncModeSynchronous
 #else
 #  define BG_FG_ASYNC_MODE kAxonAsyncModeAsynchronous
 #endif
-  // background/foreground needs the samples in buffers.fft
-  if (kAxonResultSuccess>(result=AxonBgFgProcessFrame(mel32_state_info.axon_handle, last_frame, BG_FG_ASYNC_MODE))) {
+
+  if (beamformer_active) {
+    // de-interleave both channels, the beamformer ops fill in buffers.fft ahead of bg/fg
+    AxonBeamformerCopyRawInput(raw_input_ping, ping_count, raw_input_pong, buffers.fft);
+#if MEL32_DEBUG_VECTORS > 1
+    if (kAxonResultSuccess>(result=AxonBeamformerProcessFrame(mel32_state_info.axon_handle, BG_FG_ASYNC_MODE))) {
+      return result; // error!
+    }
+#else
+    if (mel32_state_info.gating_refresh_interval) {
+      /*
+       * gated mode submits the bg/fg ops in their own list (owned by axon_bg_fg_vol.c) to decide
+       * whether the feature ops run at all, so the beamformer goes in its own list ahead of it.
+       */
+      mel32_state_info.op_list_cnt++;
+      if (kAxonResultSuccess>(result=AxonBeamformerProcessFrame(mel32_state_info.axon_handle, BG_FG_ASYNC_MODE))) {
+        return result; // error!
+      }
+    }
+#endif
+  } else {
+    // copy raw input to our internal int32 buffer
+    copy_raw_to_fft_buffer( raw_input_ping, ping_count, raw_input_pong, buffers.fft, input_stride);
+  }
+#if MEL32_DEBUG_VECTORS > 1
+  // background/foreground runs on its own so the feature ops can be stepped through below.
+  if (kAxonResultSuccess>(result=AxonBgFgProcessFrame(mel32_state_info.axon_handle, last_frame, BG_FG_ASYNC_MODE, NULL))) {
     return result; // error!
   }
+#else
+  if (mel32_state_info.gating_refresh_interval) {
+    // background/foreground runs on its own 1st, the feature ops get queued (or skipped) from its callback.
+    mel32_state_info.op_list_cnt++;
+    return AxonBgFgProcessFrame(mel32_state_info.axon_handle, last_frame, BG_FG_ASYNC_MODE, gated_bg_fg_done_callback);
+  }
+#endif
 
 #if MEL32_DEBUG_VECTORS > 3
   print_int32_vector(mel32_state_info.axon_handle, "shifted_input", buffers.fft, 512,2);
@@ -1523,14 +1949,13 @@ AxonResultEnum AxonAudioFeatureProcessFrame(
     /*
      * Look for special cases:
      * 1) filter bank (separate op group)
-     * 2) software round of mel32 fileter bank.
      */
 
     /*
      * handle the filter banks separately
      */
     if (op_enum==kMel32FilterBankPlaceHolder) { // filterbank operations
-      if (kAxonResultSuccess>(result=AxonApiExecuteOps(mel32_state_info.axon_handle, kMel32FilterBankAxonOpCnt, mel32_state_info.filterbank_op_handles,kAxonAsyncModeSynchronous ))) {
+      if (kAxonResultSuccess>(result=AXON_KWS_STATS_EXECUTE_OPS(mel32_state_info.axon_handle, mel32_state_info.filterbank_op_cnt, mel32_state_info.filterbank_op_handles,kAxonAsyncModeSynchronous ))) {
         break; // error!
       }
       AxonPrintf("%s elapsed %u ticks\r\n", audio_feature_ops[op_enum].label, elapsed_time);
@@ -1543,18 +1968,6 @@ AxonResultEnum AxonAudioFeatureProcessFrame(
       continue;
     }
 
-    // if this is the log operation, perform a software round 1st
-    if (op_enum==kMel32AxonOpMelBinLog) {
-      if (mel32_state_info.audio_feature_variant != kAxonAudioFeatureMfccFftMagOrtho) {
-        // software rounding required if filterbank inputs weren't fft maagnitude.
-        filterbank_software_rounding();
-
-#if MEL32_DEBUG_VECTORS > 2
-        print_int32_vector(mel32_state_info.axon_handle, "sw_round", buffers.after_filter_banks, AXON_AUDIO_FEATURE_FILTERBANK_COUNT+FILTER_BANK_EXTRA_COEFFS, 1);
-#endif
-      }
-    }
-
     /*
      *  the very last op needs to be queued so that
      * the execution can continue in the interrupt context. This means that the very last op won't get logged
@@ -1570,8 +1983,8 @@ AxonResultEnum AxonAudioFeatureProcessFrame(
       mel32_queued_ops.op_handle_list = mel32_state_info.mel32_op_handles+lo_ndx;
       mel32_queued_ops.callback_context = NULL;
       mel32_queued_ops.op_handle_count = op_cnt;
-      return AxonApiQueueOpsList(mel32_state_info.axon_handle, &mel32_queued_ops);
-    } else  if (kAxonResultSuccess>(result=AxonApiExecuteOps(mel32_state_info.axon_handle, op_cnt, &mel32_state_info.mel32_op_handles[lo_ndx],kAxonAsyncModeSynchronous ))) {
+      return AXON_KWS_STATS_QUEUE_OPS_LIST(mel32_state_info.axon_handle, &mel32_queued_ops);
+    } else  if (kAxonResultSuccess>(result=AXON_KWS_STATS_EXECUTE_OPS(mel32_state_info.axon_handle, op_cnt, &mel32_state_info.mel32_op_handles[lo_ndx],kAxonAsyncModeSynchronous ))) {
       break; // error!
     }
 
@@ -1588,33 +2001,9 @@ AxonResultEnum AxonAudioFeatureProcessFrame(
 
   }
 #else
-  /*
-   * not breaking this up into individual operations, but we do have at least 2 batches to
-   * execute.
-   *
-   * Batch 1:
-   * Starts at the beginning and either end w/ the mel32 filterbanks (if mel32 defined)
-   * or the mfcc filterbanks.
-   *
-   * Batch 2:
-   * queued along w/ Batch 1, consists of either the mel32 filterbanks (if mel32 defined)
-   * or the mfcc filterbanks.
-   */
-  mel32_queued_ops.callback_function = NULL; // don't need a callback, just proceed to batch 2
-  mel32_queued_ops.op_handle_list = mel32_state_info.mel32_op_handles;
-  mel32_queued_ops.callback_context = NULL;
-  // stop at the filter banks place-holder
-  mel32_queued_ops.op_handle_count = mel32_state_info.filterbank_op_ndx;
-  if (kAxonResultSuccess>(result=AxonApiQueueOpsList(mel32_state_info.axon_handle, &mel32_queued_ops))) {
-    return result;
-  }
-
-  // now queue up the filter banks
-  filterbank_queued_ops.callback_function = filterbanks_done_callback;
-  filterbank_queued_ops.op_handle_list = mel32_state_info.filterbank_op_handles;
-  filterbank_queued_ops.callback_context = NULL;
-  filterbank_queued_ops.op_handle_count = kMel32FilterBankAxonOpCnt;
-  return AxonApiQueueOpsList(mel32_state_info.axon_handle, &filterbank_queued_ops);
+  // beamformer and background/foreground ops lead the feature ops in a single submission
+  mel32_state_info.slice_from_cache = 0;
+  return queue_feature_ops(beamformer_active, kAxonBoolTrue);
 
 #endif
 }
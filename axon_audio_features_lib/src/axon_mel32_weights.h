@@ -59,7 +59,7 @@
 #define FILTER_BANK_NET_BITS \
         (FILTER_BANK_BITS-FILTER_BANK_RIGHT_SHIFT)  // net effect of the filter banks on the q position
 
-#  define FILTER_BANK_SW_ROUND     8 // rounding performed by software (really just a shift) after filterbank, before log.
+#  define FILTER_BANK_SW_ROUND     8 // shift applied after filterbank, before log (see FILTER_BANK_FLOOR_BIAS in axon_mel32.c).
 #  define MEL32_ADJUSTMENT_BIT_COUNT (AXON_LOG_FRACTION_BITS-(TARGET_ROUNDING-2*(HAMMING_ROUND-HAMMING_BITS)-FFT_POWER_ROUND+FILTER_BANK_NET_BITS-FILTER_BANK_SW_ROUND))
 static_assert(MEL32_ADJUSTMENT_BIT_COUNT==14, "\r\nADJUSTMENT BIT COUNT IS 14, RECALCULATE THE LOG OFFSET\r\n");
 
@@ -104,7 +104,7 @@ static_assert((MFCC_QFACTOR_BEFORE_SQRT & 1)==0, "QFACTOR UP TO SQRT MUST BE EVE
 static_assert(MFCC_ADJUSTMENT_BIT_COUNT==5, "\r\n MFCC ADJUSTMENT BIT COUNT IS 5, RECALCULATE THE LOG OFFSET\r\n");
 #      define MFCC_LN_OFFSET LN_2_TOTHE_5_11Q12
 #    else
-#      define FILTER_BANK_SW_ROUND     8 // rounding performed by software (really just a shift) after filterbank, before log.
+#      define FILTER_BANK_SW_ROUND     8 // shift applied after filterbank, before log (see FILTER_BANK_FLOOR_BIAS in axon_mel32.c).
 #      define MFCC_ADJUSTMENT_BIT_COUNT (AXON_LOG_FRACTION_BITS-(TARGET_ROUNDING-2*(HAMMING_ROUND-HAMMING_BITS)-FFT_POWER_ROUND+FILTER_BANK_NET_BITS-FILTER_BANK_SW_ROUND))
 static_assert(MFCC_ADJUSTMENT_BIT_COUNT==14, "\r\nADJUSTMENT BIT COUNT IS 14, RECALCULATE THE LOG OFFSET\r\n");
 #      define MFCC_LN_OFFSET LN_2_TOTHE_14_11Q12
@@ -22,6 +22,14 @@ int AxonAppRun(void *unused1, uint8_t unused2);
 void axon_app_gpio_irq_handler(void);
 void axon_app_gpio_risc1_irq_handler(void);
 void axon_app_timer0_irq_handler(void);
+void axon_app_dma_irq_handler(void);
+
+/*
+ * The host brackets the body of every interrupt handler (the axon one too) with these, so the library
+ * can tell interrupt context from task context in the RTOS build.
+ */
+void axon_app_irq_enter(void);
+void axon_app_irq_exit(void);
 
 /*
  * Call this upon exiting deepsleep.
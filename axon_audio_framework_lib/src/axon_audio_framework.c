@@ -17,11 +17,20 @@
  */
 
 #include "axon_audio_framework.h"
+#include "axon_audio_hal.h"
 #include "axon_audio_ml_api.h"
+#include "axon_deferred_log_api.h"
+#include "axon_kws_stats_api.h"
 #include "axon_dep.h"
 #include "axon_api.h"
 #include <assert.h>
 #include <string.h>
+#if AXON_APP_RTOS
+#  include "FreeRTOS.h"
+#  include "task.h"
+#  include "queue.h"
+#  include "stream_buffer.h"
+#endif
 
 /*
  * Audio record ti
@@ -48,9 +57,66 @@
 #  define AUDIO_SKIP_FRAME_CNT (0)
 #endif
 
+/*
+ * Button mode pre-roll: audio recorded while SW2 is held down is kept in a ring of the last AUDIO_PREROLL_MS.
+ * When SW2 is released the main loop replays the ring through feature extraction ahead of the live audio, faster
+ * than real time, so the start of a word spoken as the button comes up is in the window. 0 disables the ring and
+ * recording starts when SW2 is released.
+ * Always-on mode doesn't need it as its sniff frames already go through feature extraction, and the BLE sdk
+ * only reports the button coming up. In the RTOS build the capture task fills the ring and the features task
+ * replays it.
+ */
+#if TRIGGER_MODE_BUTTON_PRESS && !defined(BLE_SDK)
+#  define AUDIO_PREROLL_MS (256)
+#else
+#  define AUDIO_PREROLL_MS (0)
+#endif
+#define AUDIO_PREROLL_HALF_FRAME_CNT (AUDIO_PREROLL_MS/RECORD_HALF_FRAME_DURATION_MS)
+
+#if AUDIO_PREROLL_HALF_FRAME_CNT
+/*
+ * live half frames that can arrive while the pre-roll is being replayed.
+ */
+#  define AUDIO_PREROLL_CATCH_UP_HALF_FRAME_CNT (8)
+#  define AUDIO_PREROLL_RING_LEN (AUDIO_PREROLL_HALF_FRAME_CNT+AUDIO_PREROLL_CATCH_UP_HALF_FRAME_CNT)
+#endif
+
+/*
+ * Half frames are delivered by the rx DMA's transfer complete interrupt at the end of each half of the circle
+ * buffer (see AxonAudioHalRxStart()), and the polling timer is only a watchdog while recording. If no half
+ * frame has arrived for AUDIO_RX_WATCHDOG_MS, the rest of the recording polls the DMA write pointer every half
+ * frame, as it always does on a platform that can't deliver the interrupt.
+ */
+#define AUDIO_RX_WATCHDOG_MS (3*RECORD_HALF_FRAME_DURATION_MS)
+
+#if AXON_APP_RTOS
+/*
+ * RTOS build (AXON_APP_RTOS=1, FreeRTOS in core_drivers_v2p0/3rd-party/freertos-V5).
+ * The polling timer ISR only moves half frames into the capture stream buffer. The capture task runs the
+ * state machine and decides what to do with each half frame, the features task submits frames to
+ * AxonKwsProcessFrame() and the inference task starts the model and handles its result. The axon completion
+ * callbacks notify the features and inference tasks (see AxonMlDemoHostDeferCompletion()). The sleep task
+ * sits below them all, doing what the bare-metal main loop does between interrupts: it drains the deferred log
+ * and waits for interrupts, so the FreeRTOS idle task (and its hook) never runs.
+ */
+#  define AXON_APP_RTOS_CAPTURE_PRIORITY   (tskIDLE_PRIORITY+4)
+#  define AXON_APP_RTOS_FEATURES_PRIORITY  (tskIDLE_PRIORITY+3)
+#  define AXON_APP_RTOS_INFERENCE_PRIORITY (tskIDLE_PRIORITY+2)
+#  define AXON_APP_RTOS_SLEEP_PRIORITY     (tskIDLE_PRIORITY+1)
+#  define AXON_APP_RTOS_STACK_DEPTH (2*configMINIMAL_STACK_SIZE)
+#  define AXON_APP_RTOS_SLEEP_STACK_DEPTH (4*configMINIMAL_STACK_SIZE) // AxonDeferredLogDrain() formats with printf
+#  define AXON_APP_RTOS_CAPTURE_STREAM_HALF_FRAME_CNT (4) // half frames the ISR can get ahead of the capture task
+#  define AXON_APP_RTOS_FRAME_QUEUE_LEN (4)               // frames the capture task can get ahead of the features task
+/*
+ * the capture task's half frames. Each queued frame points at 2 of them, so there need to be enough for the queue,
+ * the frame being processed, the last half frame and the one being received.
+ */
+#  define AXON_APP_RTOS_HALF_FRAME_SLOT_CNT (AXON_APP_RTOS_FRAME_QUEUE_LEN+4)
+#  define AXON_APP_RTOS_BUTTON_POLL_MS (10)
+#  define AXON_APP_RTOS_PREROLL_NOTIFY_BIT (kAxonMlCompletionCount) // tells the features task the pre-roll ring has frames
+#endif
+
 extern void bsp_set_profiling_gpio(uint8_t high_or_low);
-extern void   bsp_power_up_mic();
-extern void   bsp_power_down_mic();
 
 
 #ifdef BLE_SDK
@@ -87,9 +153,6 @@ void audio_framework_print_usage() {
 
 #define KWS_ENABLED 1
 
-#define AMIC 0
-#define DMIC 1
-#define AUDIO_MIC AMIC
 /*
  * (super) simple state machine states.
  */
@@ -127,19 +190,20 @@ static volatile struct {
   uint8_t total_foregrounds_in_window;
   uint8_t consecutive_backgrounds;
 #endif
-#ifdef BLE_SDK
-  power_mgr_alarm_struct alarm_info;
-#endif
 } live_kws_state_info_struct;
 
 //fwd declarations
 //static void timer_stop(timer_type_e type);
 static void transition_state(LiveKwsDemoStateEnum new_state, const char *msg);
-static void button_init();
-static void audio_record_init(void);
 static void AxonHostAudioEn();
 static void AxonHostAudioDis();
-static void audio_timer_start();
+static void audio_framework_handle_timer();
+static void audio_framework_rx_half_complete(uint8_t half);
+static void audio_timer_start(uint32_t period_ms);
+#if AXON_APP_RTOS
+static void audio_framework_wake_capture_task();
+static void audio_framework_wake_capture_task_from_isr();
+#endif
 
 
 /***************************************************
@@ -154,35 +218,7 @@ void AxonHostEnableInterrupts(){
  * Function to disable Audio clocks when needed
  */
 static void AxonHostAudioDis(){
-
-  bsp_power_down_mic();
-  //disable the audio clock
-  reg_clk_en2 &= (~FLD_CLK2_AUD_EN);
-  //disable the dma clock
-  /*
-   * DON'T DISABLE DMA CLOCK; OTHERS MIGHT BE USING IT!!!
-   */
-#if 0
-  reg_clk_en1 &= (~FLD_CLK1_DMA_EN);
-#endif
-  //disable the audio
-  reg_rst2 &= (~FLD_RST2_AUD);
-  //disable the dma
-  /*
-   * DON'T DISABLE DMA CLOCK; OTHERS MIGHT BE USING IT!!!
-   */
-#if 0
-  reg_rst1 &= (~FLD_RST1_DMA);
-#endif
-  //disable the codec
-  reg_rst3 &= (~BIT(5));//codec is at bit 5
-
-#if AUDIO_MIC==DMIC
-  gpio_set_gpio_en(GPIO_PB2 | GPIO_PB3 | GPIO_PB4);
-  gpio_set_output_en(GPIO_PB2 | GPIO_PB3 | GPIO_PB4);
-  gpio_set_low_level(GPIO_PB2 | GPIO_PB3 | GPIO_PB4);
-  gpio_set_input_dis(GPIO_PB2 | GPIO_PB3 | GPIO_PB4);
-#endif
+  AxonAudioHalPowerDown();
 
   // ok to deepsleep.
   PowerMgrVoteForLowPowerState(audio_framework_retained_state.power_voter_id,kLowPowerDeepsleepRetention, 1);
@@ -192,18 +228,7 @@ static void AxonHostAudioDis(){
  * Function to enable Audio clocks when needed
  */
 static void AxonHostAudioEn(){
-  bsp_power_up_mic();
-  //enable the codec
-  reg_rst3 |= (BIT(5));//codec is at bit 5
-  //enable the dma
-  reg_rst1 |= (FLD_RST1_DMA);
-  //enable the audio
-  reg_rst2 |= (FLD_RST2_AUD);
-
-  //enable the dma clock
-  reg_clk_en1 |= (FLD_CLK1_DMA_EN);
-  //enable the audio clock
-  reg_clk_en2 |= (FLD_CLK2_AUD_EN);
+  AxonAudioHalPowerUp();
 
   /*
    * vote against sleep to keep audio going.
@@ -224,19 +249,6 @@ static void AxonHostAudioEn(){
 void AxonMlDemoHostAxonSetEnabled(AxonBoolEnum enabled){
 }
 
-static void timer_really_stop() {
-  // stop the polling timer.
-#ifdef BLE_SDK
-  // de-register this callback from power mgr
-  PowerMgrDeleteAlarm(&live_kws_state_info_struct.alarm_info);
-#else
-  // for core_drivers platform, we control timer0 directly
-  timer_stop(TIMER0);
-  // make sure the interrupt doesn't fire in case it is pending
-  reg_tmr_sta = FLD_TMR_STA_TMR0;
-  plic_interrupt_complete(IRQ4_TIMER0);
-#endif
-}
 #if TRIGGER_MODE_ALWAYS_ON
 
 /*
@@ -246,13 +258,9 @@ static void timer_really_stop() {
  * after a window has been recorded (and classified). This enables playback of the captured window.
  */
 static void audio_sniff_timer_init(uint8_t dont_start_the_sniff){
-  timer_really_stop();
+  AxonAudioHalTimerStop();
   if (!dont_start_the_sniff) {
-    timer_set_init_tick(TIMER0, 0);
-    timer_set_cap_tick(TIMER0, AUDIO_OFF_TIME_MS*sys_clk.pclk*1000);
-    timer_set_mode(TIMER0, TIMER_MODE_SYSCLK);
-    plic_interrupt_enable(IRQ4_TIMER0);
-    timer_start(TIMER0);
+    audio_timer_start(AUDIO_OFF_TIME_MS);
     live_kws_state_info_struct.total_foregrounds_in_window = 0;
     live_kws_state_info_struct.consecutive_backgrounds = 0;
   }
@@ -271,16 +279,7 @@ static void enable_audio_and_axon(){
    * @FIXME! NEED TO GET A REAL VOTE IN ORDER TO BE COMPATIBLE W/ OTHER AXON USERS!
    */
   AxonHostAxonEnableVote(0,0);
-#ifndef BLE_SDK
-  gpio_function_en( LED2 | LED3 | LED4);   // enable GPIO LEDs
-  gpio_output_en( LED2 | LED3 | LED4); // enable output
-  gpio_input_dis( LED2 | LED3 | LED4); // disable input
-  gpio_set_low_level( LED2 | LED3 | LED4); // turn LEDs OFF
-#endif
-
-#if AUDIO_MIC==DMIC
-  gpio_set_input_en(GPIO_PB2 | GPIO_PB3 | GPIO_PB4);
-#endif
+  AxonAudioHalLedInit();
 }
 /************************************************
  * Audio functions
@@ -292,15 +291,26 @@ static_assert(AUDIO_SAMPLE_BIT_WIDTH==16,"ONLY 16BIT AUDIO IS SUPPORTED IN THIS
 
 #if CAPTURE_AUDIO_PLAYBACK
 /*
- * @FIXME!!! SETTING PLAYBACK_BUFFER_SIZE TO 2s * 16kfps * 2bytes/sample was causing a hard fault in the button press ISR
+ * @FIXME!!! SETTING PLAYBACK_BUFFER_LEN TO 2s * 16kfps was causing a hard fault in the button press ISR
  * of all places (???!!!)
- * This macro is only used to configure DMA, so perhaps DMA has a size limit that is under 64000?
+ * The tx DMA is configured in bytes, so perhaps DMA has a size limit that is under 64000?
  */
-#define PLAYBACK_BUFFER_SIZE (PLAYBACK_BUFFER_LEN * AUDIO_SAMPLE_BIT_WIDTH/8)
 
 # if AUDIO_LOGGING == 0
 #   define AUDIO_LOGGING 1
 # endif
+
+/*
+ * PLAYBACK_TRIGGERED_ONLY keeps only windows that went on to classification in the playback buffer instead of
+ * everything recorded. Half frames are copied once a window has triggered, a window that ends without a
+ * classification is taken back out, and the buffer isn't cleared between recordings.
+ */
+# define PLAYBACK_TRIGGERED_ONLY 0
+# if PLAYBACK_TRIGGERED_ONLY
+#   define PLAYBACK_CAPTURE_HALF_FRAME() (live_kws_state_info_struct.current_state==kTriggered)
+# else
+#   define PLAYBACK_CAPTURE_HALF_FRAME() (1)
+# endif
 /*
    * playback buffer populated by audio ping pongs. Needs 4byte alignment but that is achieved
    * by following a 4byte field.
@@ -331,56 +341,117 @@ static struct {
    * "pong" buffer, upper half of the audio buffer
    */
   int16_t pong_buffer[RECORD_HALF_FRAME_LEN];
-
-  /*
-   * not sure if this needs to be retained but we'll declare non-local just in case.
-   */
-  dma_chain_config_t rx_dma_list_config;
-  dma_chain_config_t tx_dma_list_config;
+  uint8_t rx_polling;            // no rx DMA interrupt (or the watchdog fired), poll every half frame
+  uint8_t rx_watchdog_fired;     // in this recording
+  uint32_t rx_overruns;          // half frames overwritten before they were taken, in this recording
+  uint32_t timer_period_ms;
+  uint32_t ms_since_rx_complete; // polling timer time since the last rx DMA interrupt
 #if AUDIO_LOGGING > 0
   char log_buffer[80];
 #endif
 #if CAPTURE_AUDIO_PLAYBACK
   uint32_t playback_wrap; // # of times playback buffer has wrapped
   uint32_t playback_offset; // playback is a circular buffer. This is the location of the next write.
+#  if PLAYBACK_TRIGGERED_ONLY
+  uint32_t playback_window_wrap;   // playback_wrap at the start of the current window
+  uint32_t playback_window_offset; // playback_offset at the start of the current window
+#  endif
 #endif
 } audio_state_info;
 
 /*
- * Call this once at start up to configure audio and/or dma
+ * polling timer period while recording
  */
-static void audio_record_init(void) {
-  audio_rx_dma_config(AUDIO_RX_DMA_CH,(uint16_t*)&audio_state_info.audio_circle_buffer[0], RECORD_FRAME_SIZE, &audio_state_info.rx_dma_list_config);
-  audio_rx_dma_add_list_element(&audio_state_info.rx_dma_list_config, &audio_state_info.rx_dma_list_config,(uint16_t*)&audio_state_info.audio_circle_buffer[0], RECORD_FRAME_SIZE);
-  dma_chn_dis(AUDIO_RX_DMA_CH);
+#define AUDIO_RECORD_TIMER_PERIOD_MS() (audio_state_info.rx_polling ? RECORD_HALF_FRAME_DURATION_MS : AUDIO_RX_WATCHDOG_MS)
 
+/*
+ * starts the polling timer, keeping its period for the watchdog.
+ */
+static void audio_timer_start(uint32_t period_ms) {
+  audio_state_info.timer_period_ms = period_ms;
+  AxonAudioHalTimerStart(period_ms, audio_framework_handle_timer);
+}
+
+#if AUDIO_PREROLL_HALF_FRAME_CNT
+/*
+ * Every half frame goes through this ring when pre-roll is enabled. While waiting for the trigger it holds
+ * the last AUDIO_PREROLL_HALF_FRAME_CNT half frames. After the trigger, the oldest 2 half frames are
+ * the ping/pong of the next frame to process, and live half frames are added behind the pre-roll.
+ * Half frames are added in interrupt context and taken by the main loop, which updates
+ * oldest_ndx and count with interrupts disabled. In the RTOS build the capture task adds them and the
+ * features task takes them, which also keeps the capture task out while interrupts are disabled.
+ */
+static struct {
+  int16_t half_frames[AUDIO_PREROLL_RING_LEN][RECORD_HALF_FRAME_LEN];
+  uint8_t oldest_ndx;
+  uint8_t count;
+  uint8_t recording;               // SW2 is down and the ring is being filled
+  uint32_t half_frames_to_record;  // after the trigger, half frames still to record
+  uint32_t frames_processed;       // after the trigger, frames submitted for feature extraction
+} audio_preroll_info;
+#endif
+
+#if AXON_APP_RTOS
+/*
+ * a frame handed from the capture task to the features task.
+ */
+typedef struct {
+  const int16_t *ping;
+  const int16_t *pong;
+  KwsFirstOrLastAudioFrame first_or_last_frame;
+  KwsClassifyOptionEnum classify_option;
+} AudioFrameworkFrameStruct;
+
+static struct {
+  TaskHandle_t capture_task;
+  TaskHandle_t features_task;
+  TaskHandle_t inference_task;
+  StreamBufferHandle_t capture_stream;
+  QueueHandle_t frame_queue;
+  StaticTask_t capture_task_struct;
+  StaticTask_t features_task_struct;
+  StaticTask_t inference_task_struct;
+  StackType_t capture_task_stack[AXON_APP_RTOS_STACK_DEPTH];
+  StackType_t features_task_stack[AXON_APP_RTOS_STACK_DEPTH];
+  StackType_t inference_task_stack[AXON_APP_RTOS_STACK_DEPTH];
+  TaskHandle_t sleep_task;
+  StaticTask_t sleep_task_struct;
+  StackType_t sleep_task_stack[AXON_APP_RTOS_SLEEP_STACK_DEPTH];
+  StaticStreamBuffer_t capture_stream_struct;
+  uint8_t capture_stream_storage[AXON_APP_RTOS_CAPTURE_STREAM_HALF_FRAME_CNT*RECORD_HALF_FRAME_SIZE+1];
+  StaticQueue_t frame_queue_struct;
+  uint8_t frame_queue_storage[AXON_APP_RTOS_FRAME_QUEUE_LEN*sizeof(AudioFrameworkFrameStruct)];
+#  if TRIGGER_MODE_ALWAYS_ON
   /*
-   * microphone needs some help. don't think D_GAIN is used by AMIC but it doesn't seem
-   * to harm anything.
+   * the features task sends back each frame's foreground flag, one for every frame queued (plus the one
+   * it is processing). Only the capture task touches foreground_results_pending and last_frame_was_foreground.
    */
-  audio_set_codec_in_path_a_d_gain(CODEC_IN_D_GAIN_8_DB, CODEC_IN_A_GAIN_16_DB);
-#if AUDIO_MIC==AMIC
-//  audio_init(AMIC_IN_OUT,AUDIO_16K,MONO_BIT_16); // initialize audio AMIC with OUT
-  // audio_init(AMIC_INPUT,AUDIO_16K,MONO_BIT_16); // initialize audio AMIC
+  QueueHandle_t foreground_queue;
+  StaticQueue_t foreground_queue_struct;
+  uint8_t foreground_queue_storage[AXON_APP_RTOS_FRAME_QUEUE_LEN+1];
+  uint8_t foreground_results_pending;
+  uint8_t last_frame_was_foreground;
+#  endif
+  int16_t half_frames[AXON_APP_RTOS_HALF_FRAME_SLOT_CNT][RECORD_HALF_FRAME_LEN];
+  uint8_t half_frame_ndx;
+  AxonResultEnum completion_results[kAxonMlCompletionCount];
+  uint32_t capture_overruns; // half frames the ISR dropped
+  uint32_t frame_overruns;   // frames the capture task dropped
+} audio_framework_rtos_info;
 
- audio_init(AMIC_IN_TO_BUF,AUDIO_16K,MONO_BIT_16); // initialize audio AMIC
-#elif AUDIO_MIC==DMIC
-  audio_set_dmic_pin(DMIC_GROUPB_B2_DAT_B3_B4_CLK);
-  audio_init(DMIC_IN,AUDIO_16K,MONO_BIT_16); // initialize audio using DMIC
-#endif
-}
+/*
+ * Features task, waits for the features of the frame it just submitted and runs their completion.
+ */
+static void audio_framework_wait_for_features() {
+  uint32_t completions;
 
-static void audio_playback_init(void) {
-#if CAPTURE_AUDIO_PLAYBACK
-  AxonHostAudioDis();
-  AxonHostAudioEn();
-  audio_tx_dma_config(AUDIO_TX_DMA_CH,(uint16_t*)&audio_playback_buffer[0], PLAYBACK_BUFFER_SIZE, &audio_state_info.tx_dma_list_config);
-  audio_tx_dma_add_list_element(&audio_state_info.tx_dma_list_config, &audio_state_info.tx_dma_list_config,(uint16_t*)&audio_playback_buffer[0], PLAYBACK_BUFFER_SIZE);
-  dma_chn_dis(AUDIO_TX_DMA_CH);
-  audio_init(BUF_TO_LINE_OUT,AUDIO_16K,MONO_BIT_16); // initialize audio AMIC
+  do {
+    xTaskNotifyWait(0, 1<<kAxonMlCompletionFeatures, &completions, portMAX_DELAY);
+  } while (0==(completions & (1<<kAxonMlCompletionFeatures)));
+  AxonKwsRunCompletion(kAxonMlCompletionFeatures, audio_framework_rtos_info.completion_results[kAxonMlCompletionFeatures]);
+}
 #endif
 
-}
 /*
  * call this to start audio recording
  */
@@ -390,32 +461,42 @@ static void audio_record_start() {
    */
   audio_state_info.ping_count = 0;
   audio_state_info.pong_count = 0;
+  audio_state_info.rx_overruns = 0;
+  audio_state_info.rx_watchdog_fired = 0;
+  audio_state_info.ms_since_rx_complete = 0;
   /*
    * ...and this starts microphone recording
    */
-  audio_record_init();   // initialize audio circle buffer
-  audio_rx_dma_en();
+  audio_state_info.rx_polling = !AxonAudioHalRxStart(audio_state_info.audio_circle_buffer, RECORD_FRAME_LEN,
+      audio_framework_rx_half_complete);
 
 #if CAPTURE_AUDIO_PLAYBACK
+#  if PLAYBACK_TRIGGERED_ONLY
+  // nothing is copied until the window triggers, so this is where it will start.
+  audio_state_info.playback_window_offset = audio_state_info.playback_offset;
+  audio_state_info.playback_window_wrap = audio_state_info.playback_wrap;
+#  else
   // 0 out write buffer and offset
   audio_state_info.playback_offset = 0; // playback is a circular buffer. This is the location of the next write.
   audio_state_info.playback_wrap = 0;
   memset(audio_playback_buffer, 0, sizeof(audio_playback_buffer));
+#  endif
 #endif
-#ifndef BLE_SDK
-  gpio_set_high_level(LED1); // blue on
-#endif
+  AxonAudioHalSetLed(kAxonAudioHalLedRecording, 1); // blue on
 }
 
 /*
  * call this to stop audio recording
  */
 static void audio_record_stop() {
-  timer_really_stop();
-  dma_chn_dis(AUDIO_RX_DMA_CH);
-#ifndef BLE_SDK
-  gpio_set_low_level(LED1); // blue off
-#endif
+  AxonAudioHalTimerStop();
+  AxonAudioHalRxStop();
+  AxonAudioHalSetLed(kAxonAudioHalLedRecording, 0); // blue off
+  if (audio_state_info.rx_overruns || audio_state_info.rx_watchdog_fired) {
+    AxonDeferredLog(kAxonDeferredLogRxOverruns, audio_state_info.rx_overruns, audio_state_info.rx_watchdog_fired);
+    audio_state_info.rx_overruns = 0;
+    audio_state_info.rx_watchdog_fired = 0;
+  }
 }
 
 /*
@@ -423,11 +504,12 @@ static void audio_record_stop() {
  */
 static void audio_playback_start() {
 #if CAPTURE_AUDIO_PLAYBACK
-  audio_playback_init();
+  AxonHostAudioDis();
+  AxonHostAudioEn();
   /*
    * this starts playback
    */
-  audio_tx_dma_en();
+  AxonAudioHalTxStart(audio_playback_buffer, PLAYBACK_BUFFER_LEN);
 #endif
 }
 
@@ -436,7 +518,7 @@ static void audio_playback_start() {
  */
 static void audio_playback_stop() {
 #if CAPTURE_AUDIO_PLAYBACK
-  dma_chn_dis(AUDIO_TX_DMA_CH);
+  AxonAudioHalTxStop();
 #endif
 }
 
@@ -455,19 +537,61 @@ static void log_audio_playback(void){
 }
 
 #if CAPTURE_AUDIO_PLAYBACK
-static void copy_to_playback_buffer(int16_t *from_buf, uint32_t sample_count) {
-  while(sample_count--) {
-    audio_playback_buffer[audio_state_info.playback_offset++] = *from_buf;
-    from_buf++;
+/*
+ * appends samples to the playback circular buffer, a block copy up to the end of the buffer and
+ * another from the start.
+ */
+static void copy_to_playback_buffer(const int16_t *from_buf, uint32_t sample_count) {
+  uint32_t copy_count;
+
+  while(sample_count) {
+    copy_count = PLAYBACK_BUFFER_LEN-audio_state_info.playback_offset;
+    if (copy_count > sample_count) {
+      copy_count = sample_count;
+    }
+    memcpy(&audio_playback_buffer[audio_state_info.playback_offset], from_buf, copy_count*sizeof(int16_t));
+    from_buf += copy_count;
+    sample_count -= copy_count;
+    audio_state_info.playback_offset += copy_count;
     if (audio_state_info.playback_offset >= PLAYBACK_BUFFER_LEN) {
       audio_state_info.playback_wrap++;
       audio_state_info.playback_offset = 0;
     }
-
   }
 }
 #endif
 
+/*
+ * In triggered-only playback, takes a window that didn't get classified back out of the playback buffer.
+ */
+static void playback_discard_window() {
+#if CAPTURE_AUDIO_PLAYBACK && PLAYBACK_TRIGGERED_ONLY
+  audio_state_info.playback_offset = audio_state_info.playback_window_offset;
+  audio_state_info.playback_wrap = audio_state_info.playback_window_wrap;
+#endif
+}
+
+/*
+ * copies the 1st (half==0) or 2nd half of the circular buffer to the ping or pong buffer, respectively, and
+ * returns it.
+ */
+static int16_t *audio_take_half_frame(uint8_t half) {
+  int16_t *half_frame = half ? audio_state_info.pong_buffer : audio_state_info.ping_buffer;
+
+  if (half) {
+    audio_state_info.pong_count++;
+  } else {
+    audio_state_info.ping_count++;
+  }
+  memcpy(half_frame, &audio_state_info.audio_circle_buffer[half ? RECORD_HALF_FRAME_LEN : 0], RECORD_HALF_FRAME_SIZE);
+#if CAPTURE_AUDIO_PLAYBACK
+  if (PLAYBACK_CAPTURE_HALF_FRAME()) {
+    copy_to_playback_buffer(half_frame, RECORD_HALF_FRAME_LEN);
+  }
+#endif
+  return half_frame;
+}
+
 /*
  * monitors when 1st or 2nd half of circular buffer has
  * filled, and transfers contents to ping or pong buffer, respectively when
@@ -481,10 +605,9 @@ static int16_t *audio_buffer_monitoring(void)
    * be careful of logging in real-time systems. This logging could
    * cause us to lose audio!
    */
-  uint32_t next_audio_sample_ptr = audio_get_rx_dma_wptr(AUDIO_RX_DMA_CH);
-  uint32_t next_audio_sample_ndx = (next_audio_sample_ptr - (uint32_t)audio_state_info.audio_circle_buffer)>>1;
+  uint32_t next_audio_sample_ndx = AxonAudioHalRxWriteNdx();
 #if AUDIO_LOGGING > 1
-  snprintf(audio_state_info.log_buffer, sizeof(audio_state_info.log_buffer), "next audio:0x%x, offset %d\r\n",next_audio_sample_ptr,next_audio_sample_ndx);
+  snprintf(audio_state_info.log_buffer, sizeof(audio_state_info.log_buffer), "next audio offset %d\r\n",next_audio_sample_ndx);
   printf(audio_state_info.log_buffer);
 #endif
   /*
@@ -496,86 +619,22 @@ static int16_t *audio_buffer_monitoring(void)
   if ((RECORD_HALF_FRAME_LEN) <= next_audio_sample_ndx) {
     // cursor is in the 2nd half (pong section) of the buffer.
     if (audio_state_info.ping_count == audio_state_info.pong_count) {
-      // ping is ready. copy it over and return
-      audio_state_info.ping_count++;
-      memcpy(audio_state_info.ping_buffer, audio_state_info.audio_circle_buffer, RECORD_HALF_FRAME_SIZE);
-#if CAPTURE_AUDIO_PLAYBACK
-      copy_to_playback_buffer(audio_state_info.ping_buffer, RECORD_HALF_FRAME_LEN);
-#endif
-      return audio_state_info.ping_buffer;
+      // ping is ready.
+      return audio_take_half_frame(0);
     }
   } else {
     // cursor is in the 1st half (ping section) of the buffer.
     if (audio_state_info.ping_count > audio_state_info.pong_count) {
-      // pong is ready. copy it over and return
-      audio_state_info.pong_count++;
-      memcpy(audio_state_info.pong_buffer, &audio_state_info.audio_circle_buffer[RECORD_HALF_FRAME_LEN], RECORD_HALF_FRAME_SIZE);
-#if CAPTURE_AUDIO_PLAYBACK
-      copy_to_playback_buffer(audio_state_info.pong_buffer, RECORD_HALF_FRAME_LEN);
-#endif
-      return audio_state_info.pong_buffer;
+      // pong is ready.
+      return audio_take_half_frame(1);
     }
   }
   return NULL;
 }
 
-#ifndef BLE_SDK
 static uint8_t get_sw2_state() {
-  return gpio_get_level(GPIO_PC2);
-}
-
-static uint8_t get_sw5_state() {
-  return gpio_get_level(GPIO_PC0);
-}
-
-static void button_init()
-{
-
-  // TL Key1 is low input
-  gpio_function_en(GPIO_PC2);
-  gpio_input_en(GPIO_PC2);
-  gpio_output_dis(GPIO_PC2);
-  gpio_set_up_down_res(GPIO_PC2, GPIO_PIN_PULLDOWN_100K);
-  gpio_set_low_level(GPIO_PC2);
-
-  // TL Key3 is high output
-  gpio_function_en(GPIO_PC3);
-  gpio_output_en(GPIO_PC3);
-  gpio_input_dis(GPIO_PC3);
-  gpio_set_up_down_res(GPIO_PC3, GPIO_PIN_PULLUP_10K);
-  gpio_set_high_level(GPIO_PC3);
-
-  //core_enable_interrupt(); //enabled in user_init of main
-  gpio_irq_en(GPIO_PC2);
-  gpio_set_irq(GPIO_PC2, INTR_RISING_EDGE);
-  // clear any spurious int..
-  reg_gpio_irq_clr =FLD_GPIO_IRQ_CLR ;
-  plic_interrupt_complete(IRQ25_GPIO);
-  plic_interrupt_enable(IRQ25_GPIO); // GPIO_PC2
-
-  /****GPIO_IRQ POL_RISING   SW5 link PC0**/
-  gpio_function_en(GPIO_PC0);
-  gpio_input_en(GPIO_PC0);
-  gpio_output_dis(GPIO_PC0);
-  gpio_set_up_down_res(GPIO_PC0, GPIO_PIN_PULLDOWN_100K);
-  gpio_set_low_level(GPIO_PC0);
-
-  gpio_function_en(GPIO_PC1);
-  gpio_output_en(GPIO_PC1);
-  gpio_input_dis(GPIO_PC1);
-  gpio_set_up_down_res(GPIO_PC1, GPIO_PIN_PULLUP_10K);
-  gpio_set_high_level(GPIO_PC1);
-
-  //core_enable_interrupt();
-  gpio_gpio2risc1_irq_en(GPIO_PC0);
-  gpio_set_gpio2risc1_irq(GPIO_PC0,INTR_FALLING_EDGE);
-  plic_interrupt_enable(IRQ27_GPIO2RISC1); // GPIO_PC0
-
-  pm_set_gpio_wakeup(GPIO_PC2, WAKEUP_LEVEL_HIGH, 1);
-  pm_set_gpio_wakeup(GPIO_PC0, WAKEUP_LEVEL_HIGH, 1);
-
+  return AxonAudioHalGetButton(kAxonAudioHalButtonRecord);
 }
-#endif
 
 
 /******************************************************************
@@ -627,14 +686,16 @@ void AxonMlDemoHostStartWindowReady(uint32_t start_frame_no, uint32_t frame_cnt)
  * status functions for host to indicate that classification is occurring
  */
 void AxonMlDemoHostClassifyingStart(uint32_t start_frame_no, uint32_t frame_cnt) {
-#ifndef BLE_SDK
-  gpio_set_high_level(LED2); // green on
-#endif
+  AxonAudioHalSetLed(kAxonAudioHalLedClassifying, 1); // green on
   audio_record_stop(); // done w/ audio!
   //disable audio
   AxonHostAudioDis();
   transition_state(kRecordingStopped, "Classifying...\r\n");
   // AxonPrintf("Classifying...\r\n");
+#if AXON_APP_RTOS
+  // called by the features task, the capture task finishes the recording.
+  audio_framework_wake_capture_task();
+#endif
 
 }
 
@@ -643,9 +704,7 @@ void AxonMlDemoHostClassifyingStart(uint32_t start_frame_no, uint32_t frame_cnt)
  */
 void AxonMlDemoHostClassifyingEnd(uint32_t classification_number) {
 
-#ifndef BLE_SDK
-  gpio_set_low_level(LED2); // green off
-#endif
+  AxonAudioHalSetLed(kAxonAudioHalLedClassifying, 0); // green off
 
   const char *label;
   // print and clear the last result
@@ -684,9 +743,132 @@ void AxonMlDemoHostNoClassification() {
 #endif
   // clear out the previous result
   AxonKwsClearLastResult(NULL);
+  playback_discard_window();
   AxonPrintf("No Classification occurred\r\n");
 }
 
+#if AUDIO_PREROLL_HALF_FRAME_CNT
+/*
+ * adds a half frame to the ring. While waiting for the trigger the oldest is dropped to make room.
+ */
+static void audio_preroll_push(const int16_t *half_frame) {
+  uint8_t max_count = live_kws_state_info_struct.current_state==kWaitingForTrigger ? AUDIO_PREROLL_HALF_FRAME_CNT : AUDIO_PREROLL_RING_LEN;
+
+  if (audio_preroll_info.count >= max_count) {
+    if (live_kws_state_info_struct.current_state!=kWaitingForTrigger) {
+      AxonDeferredLog(kAxonDeferredLogPrerollOverrun, live_kws_state_info_struct.audio_frame_number);
+    }
+    audio_preroll_info.oldest_ndx = (audio_preroll_info.oldest_ndx+1) % AUDIO_PREROLL_RING_LEN;
+    audio_preroll_info.count--;
+  }
+  memcpy(audio_preroll_info.half_frames[(audio_preroll_info.oldest_ndx+audio_preroll_info.count) % AUDIO_PREROLL_RING_LEN],
+      half_frame, RECORD_HALF_FRAME_SIZE);
+  audio_preroll_info.count++;
+}
+
+/*
+ * Polling timer handler when pre-roll is enabled, interrupt context (the capture task in the RTOS build).
+ * Fills the ring until SW2 is released, then keeps adding live half frames behind the pre-roll until the
+ * recording is done. audio_preroll_service() submits the frames.
+ */
+static void audio_preroll_handle_timer(int16_t *current_frame) {
+  if (NULL != current_frame) {
+    live_kws_state_info_struct.audio_frame_number++;
+  }
+
+  if (live_kws_state_info_struct.current_state==kWaitingForTrigger) {
+    if (NULL != current_frame) {
+      audio_preroll_push(current_frame);
+    }
+    if (0!=get_sw2_state()) {
+      return; // still down
+    }
+    AxonAudioHalSetLed(kAxonAudioHalLedButtonDown, 0); // turn red off (not waiting for release)
+    audio_preroll_info.recording = 0;
+    // the pre-roll counts towards the recording time
+    audio_preroll_info.half_frames_to_record = MAX_HALF_FRAME_COUNT > audio_preroll_info.count ? MAX_HALF_FRAME_COUNT-audio_preroll_info.count : 1;
+    audio_preroll_info.frames_processed = 0;
+    transition_state(kTriggered, "Recording started\r\n");
+#if CAPTURE_AUDIO_PLAYBACK && PLAYBACK_TRIGGERED_ONLY
+    for (uint8_t ndx=0;ndx<audio_preroll_info.count;ndx++) {
+      copy_to_playback_buffer(audio_preroll_info.half_frames[(audio_preroll_info.oldest_ndx+ndx) % AUDIO_PREROLL_RING_LEN], RECORD_HALF_FRAME_LEN);
+    }
+#endif
+  } else if ((NULL != current_frame) && audio_preroll_info.half_frames_to_record) {
+    audio_preroll_push(current_frame);
+    if (0==--audio_preroll_info.half_frames_to_record) {
+      // done w/ audio, the main loop finishes the ring.
+      AxonAudioHalTimerStop();
+      AxonAudioHalRxStop();
+      AxonAudioHalSetLed(kAxonAudioHalLedRecording, 0); // blue off
+      AxonHostAudioDis();
+    }
+  }
+}
+
+/*
+ * Called from the main loop. After the trigger, submits frames from the ring for feature extraction until
+ * it has caught up with the live audio or the previous frame is still being processed. The axon interrupt
+ * at the end of each frame's features wakes the main loop for the next one.
+ * The RTOS build calls it from the features task, which waits for each frame's features before taking its
+ * half frame out of the ring.
+ */
+static void audio_preroll_service() {
+  uint32_t interrupt_state;
+  const int16_t *ping;
+  const int16_t *pong;
+  uint8_t is_last_frame;
+
+  while (live_kws_state_info_struct.current_state==kTriggered) {
+    interrupt_state = AxonHostDisableInterrupts();
+    if (audio_preroll_info.count < 2) {
+      AxonHostRestoreInterrupts(interrupt_state);
+      return; // caught up w/ the live audio
+    }
+    ping = audio_preroll_info.half_frames[audio_preroll_info.oldest_ndx];
+    pong = audio_preroll_info.half_frames[(audio_preroll_info.oldest_ndx+1) % AUDIO_PREROLL_RING_LEN];
+    is_last_frame = (0==audio_preroll_info.half_frames_to_record) && (2==audio_preroll_info.count);
+    AxonHostRestoreInterrupts(interrupt_state);
+
+    if (0 > AxonKwsProcessFrame(ping, RECORD_HALF_FRAME_LEN, pong, 1, // stride
+        0==audio_preroll_info.frames_processed ? kFirstFrame : is_last_frame ? kLastFrame : kMiddleFrame,
+        kClassifyOnValidWindow)) {
+      return; // previous frame is still being processed, try again when it's done.
+    }
+#if AXON_APP_RTOS
+    audio_framework_wait_for_features();
+#endif
+    audio_preroll_info.frames_processed++;
+    interrupt_state = AxonHostDisableInterrupts();
+    audio_preroll_info.oldest_ndx = (audio_preroll_info.oldest_ndx+1) % AUDIO_PREROLL_RING_LEN;
+    audio_preroll_info.count--;
+    AxonHostRestoreInterrupts(interrupt_state);
+
+    if (is_last_frame) {
+      audio_record_stop();
+      // the last frame's completion may have run already (and ended the session).
+      if (live_kws_state_info_struct.current_state==kTriggered) {
+        transition_state(kRecordingStopped, "Recording STOPPED\r\n");
+      }
+#if AXON_APP_RTOS
+      audio_framework_wake_capture_task(); // the capture task runs the state machine
+#endif
+    }
+  }
+}
+
+/*
+ * returns 1 if audio_preroll_service() has a frame it can submit now. Called with interrupts disabled
+ * before sleeping, as the interrupt that made it ready may already have been taken.
+ */
+static int audio_preroll_service_pending() {
+  return (live_kws_state_info_struct.current_state==kTriggered) && (audio_preroll_info.count >= 2) && AxonKwsReadyForFrame();
+}
+#  define AUDIO_PREROLL_SERVICE_PENDING() audio_preroll_service_pending()
+#else
+#  define AUDIO_PREROLL_SERVICE_PENDING() (0)
+#endif
+
 static void start_recording() {
   // AxonPrintf("Recording...\r\n");
 
@@ -704,9 +886,9 @@ static void start_recording() {
    */
   live_kws_state_info_struct.last_frame = NULL;
   /*
-   * start the polling timer
+   * start the polling timer, or the watchdog.
    */
-  audio_timer_start();
+  audio_timer_start(AUDIO_RECORD_TIMER_PERIOD_MS());
 }
 /*
  * This function processes the state machine.
@@ -730,19 +912,41 @@ static void process_state(){
 
 #if !TRIGGER_MODE_ALWAYS_ON
     case kWaitingForTrigger:
+#if AUDIO_PREROLL_HALF_FRAME_CNT
+    if (audio_preroll_info.recording) {
+      break; // the polling timer fills the pre-roll until SW2 is released
+    }
+#endif
     //switch to PLL clock to run Axon and Audio (and vote against deep sleep)
     enable_audio_and_axon();
 
     audio_playback_stop();
 
+#if AUDIO_PREROLL_HALF_FRAME_CNT
+    // record while SW2 is down, the timer triggers on release.
+    AxonAudioHalSetLed(kAxonAudioHalLedButtonDown, 1); // red while waiting for button to be released
+    audio_preroll_info.oldest_ndx = 0;
+    audio_preroll_info.count = 0;
+    audio_preroll_info.recording = 1;
+    start_recording();
+#else
 #ifndef BLE_SDK
-    gpio_set_high_level(LED4); // red while waiting for button to be released
-    delay_ms(10); // debounce timer...
-    while (0!=get_sw2_state()); // wait for it to rise
-    gpio_set_low_level(LED4); // turn red off (not waiting for release)
+    AxonAudioHalSetLed(kAxonAudioHalLedButtonDown, 1); // red while waiting for button to be released
+#if AXON_APP_RTOS
+    do {
+      vTaskDelay(pdMS_TO_TICKS(AXON_APP_RTOS_BUTTON_POLL_MS)); // debounce, and let the other tasks run
+    } while (0!=get_sw2_state()); // wait for it to rise
+#else
+    AxonAudioHalDelayMs(10); // debounce timer...
+    while (0!=get_sw2_state()) { // wait for it to rise
+      AxonAudioHalDelayMs(1);
+    }
+#endif
+    AxonAudioHalSetLed(kAxonAudioHalLedButtonDown, 0); // turn red off (not waiting for release)
 #endif
     start_recording();
     transition_state(kTriggered, "Recording started\r\n");
+#endif
     break;
 #endif
 
@@ -770,33 +974,65 @@ void CopyAudio() {
 
 
 
-static void audio_framework_handle_timer() {
-  if (live_kws_state_info_struct.current_state==kIdle) {
-#if TRIGGER_MODE_ALWAYS_ON
-    // start a trigger polling cycle.
-    start_recording();
-    live_kws_state_info_struct.current_state = kWaitingForTrigger;
-#endif
+#if !AUDIO_PREROLL_HALF_FRAME_CNT
+/*
+ * hands a frame to feature extraction.
+ */
+static void audio_framework_submit_frame(const int16_t *ping, const int16_t *pong,
+    KwsFirstOrLastAudioFrame first_or_last_frame, KwsClassifyOptionEnum classify_option) {
+#if AXON_APP_RTOS
+  AudioFrameworkFrameStruct frame = {
+    .ping = ping,
+    .pong = pong,
+    .first_or_last_frame = first_or_last_frame,
+    .classify_option = classify_option,
+  };
+  if (pdPASS != xQueueSend(audio_framework_rtos_info.frame_queue, &frame, 0)) {
+    audio_framework_rtos_info.frame_overruns++;
+    AXON_KWS_STATS_COUNT(kAxonKwsStatsFramesDropped, 1);
     return;
   }
+#  if TRIGGER_MODE_ALWAYS_ON
+  audio_framework_rtos_info.foreground_results_pending++;
+#  endif
+#else
+  if (0 > AxonKwsProcessFrame(ping, RECORD_HALF_FRAME_LEN, pong, 1, first_or_last_frame, classify_option)) {
+    AXON_KWS_STATS_COUNT(kAxonKwsStatsFramesDropped, 1); // still busy w/ the last one, or classifying
+  }
+#endif
+}
 
-  bsp_set_profiling_gpio(1);
-
-  // check to see if a valid audio frame has been captured.
-  int16_t *current_frame = audio_buffer_monitoring();
-  if(current_frame == NULL) {
-    bsp_set_profiling_gpio(0);
-    return; // no new audio to process.
+#if TRIGGER_MODE_ALWAYS_ON
+/*
+ * returns 1 if the last frame handed to feature extraction was foreground.
+ * In the RTOS build that frame may still be queued, so this waits for the features task to send back the
+ * flags of the frames in flight rather than reading the ml library's, which can be up to
+ * AXON_APP_RTOS_FRAME_QUEUE_LEN frames behind.
+ */
+static int audio_framework_last_frame_was_foreground() {
+#if AXON_APP_RTOS
+  while (audio_framework_rtos_info.foreground_results_pending) {
+    xQueueReceive(audio_framework_rtos_info.foreground_queue, &audio_framework_rtos_info.last_frame_was_foreground, portMAX_DELAY);
+    audio_framework_rtos_info.foreground_results_pending--;
   }
+  return audio_framework_rtos_info.last_frame_was_foreground;
+#else
+  return AxonKwsLastFrameWasForeground();
+#endif
+}
+#endif
 
+/*
+ * Processes a newly captured half frame. Called from the rx DMA interrupt (or the polling timer), or by the
+ * capture task in the RTOS build.
+ */
+static void audio_framework_process_half_frame(int16_t *current_frame) {
   live_kws_state_info_struct.audio_frame_number++;
   // AxonPrintf("frame no %d...", live_kws_state_info_struct.audio_frame_number);
 
   if (live_kws_state_info_struct.audio_frame_number<(AUDIO_SKIP_FRAME_CNT+2)) {
     // need 2 half-frames to do anything.
     live_kws_state_info_struct.last_frame = current_frame;
-    bsp_set_profiling_gpio(0);
-
     return;
   }
 
@@ -806,15 +1042,20 @@ static void audio_framework_handle_timer() {
 #if TRIGGER_MODE_ALWAYS_ON
   // have to wait for the start of the 3rd frame before BG/FG detect has occurred
   if (live_kws_state_info_struct.audio_frame_number>(2+AUDIO_SKIP_FRAME_CNT)) {
-    if (AxonKwsLastFrameWasForeground()) {
+    if (audio_framework_last_frame_was_foreground()) {
 
       // handle a foreground frame.
       live_kws_state_info_struct.total_foregrounds_in_window++; // count it.
       live_kws_state_info_struct.consecutive_backgrounds = 0;   // 0 out consecutive backgrounds
       if (live_kws_state_info_struct.current_state==kWaitingForTrigger) {
         // if we weren't trigged before, we are now.
-        AxonPrintf("triggered %d\r\n", live_kws_state_info_struct.audio_frame_number);
+        AxonDeferredLog(kAxonDeferredLogTriggered, live_kws_state_info_struct.audio_frame_number);
         live_kws_state_info_struct.current_state = kTriggered;
+#if CAPTURE_AUDIO_PLAYBACK && PLAYBACK_TRIGGERED_ONLY
+        // the window starts w/ the frame that triggered it
+        copy_to_playback_buffer(live_kws_state_info_struct.last_frame, RECORD_HALF_FRAME_LEN);
+        copy_to_playback_buffer(current_frame, RECORD_HALF_FRAME_LEN);
+#endif
       }
     } else {
       //  handle a background frame
@@ -839,7 +1080,8 @@ static void audio_framework_handle_timer() {
       if ((live_kws_state_info_struct.consecutive_backgrounds<12) ||
         (live_kws_state_info_struct.total_foregrounds_in_window<8)) {
         audio_sniff_timer_init(ALWAYS_ON_ONESHOT);
-        AxonPrintf("expired %d\r\n", live_kws_state_info_struct.audio_frame_number);
+        playback_discard_window();
+        AxonDeferredLog(kAxonDeferredLogExpired, live_kws_state_info_struct.audio_frame_number);
         return;
       }
       transition_state(kRecordingStopped, "Recording STOPPED\r\n");
@@ -848,11 +1090,9 @@ static void audio_framework_handle_timer() {
   }
 
   // process this audio frame
-  AxonKwsProcessFrame(
+  audio_framework_submit_frame(
     live_kws_state_info_struct.last_frame,
-    RECORD_HALF_FRAME_LEN,
     current_frame,
-    1, // stride
     live_kws_state_info_struct.audio_frame_number==(2+AUDIO_SKIP_FRAME_CNT) ? kFirstFrame : is_last_frame ? kLastFrame : kMiddleFrame, // first full frame is after 2nd slice
         is_last_frame ? kDoClassify + MAX_HALF_FRAME_COUNT-1: kDoNotClassify ); // by-pass BG/FG algo; if this is last frame then classify, otherwise don't/
 
@@ -871,35 +1111,118 @@ static void audio_framework_handle_timer() {
   }
 
   // process this audio frame
-  AxonKwsProcessFrame(
+  audio_framework_submit_frame(
     live_kws_state_info_struct.last_frame,
-    RECORD_HALF_FRAME_LEN,
     current_frame,
-    1, // stride
     live_kws_state_info_struct.audio_frame_number==2 ? kFirstFrame : is_last_frame ? kLastFrame : kMiddleFrame, // first full frame is after 2nd slice
     live_kws_state_info_struct.current_state!=kTriggered ? kDoNotClassify : kClassifyOnValidWindow);
 
   live_kws_state_info_struct.last_frame = current_frame;
+#endif
+}
+#endif
+
+#if AXON_APP_RTOS
+/*
+ * queues a half frame for the capture task.
+ */
+static void audio_framework_capture_from_isr(int16_t *current_frame) {
+  if (NULL==current_frame) {
+    return; // no new audio to process.
+  }
+  // only whole half frames go in
+  if (RECORD_HALF_FRAME_SIZE > xStreamBufferSpacesAvailable(audio_framework_rtos_info.capture_stream)) {
+    audio_framework_rtos_info.capture_overruns++;
+    AXON_KWS_STATS_COUNT(kAxonKwsStatsAudioOverruns, 1);
+    return;
+  }
+  xStreamBufferSendFromISR(audio_framework_rtos_info.capture_stream, current_frame, RECORD_HALF_FRAME_SIZE, NULL);
+  audio_framework_wake_capture_task_from_isr();
+}
+#endif
+
+/*
+ * Hands a newly captured half frame (or NULL, for a polling timer tick without one) on.
+ */
+static void audio_framework_deliver_half_frame(int16_t *current_frame) {
+  bsp_set_profiling_gpio(1);
+#if AXON_APP_RTOS
+  audio_framework_capture_from_isr(current_frame);
+#elif AUDIO_PREROLL_HALF_FRAME_CNT
+  audio_preroll_handle_timer(current_frame);
+#else
+  if (NULL != current_frame) {
+    audio_framework_process_half_frame(current_frame);
+  }
 #endif
   bsp_set_profiling_gpio(0);
+}
 
+/*
+ * rx DMA interrupt, half of the circular buffer has been filled.
+ */
+static void audio_framework_rx_half_complete(uint8_t half) {
+  if (audio_state_info.rx_polling) {
+    return; // the watchdog took over
+  }
+  audio_state_info.ms_since_rx_complete = 0;
+  if (half != (audio_state_info.ping_count==audio_state_info.pong_count ? 0 : 1)) {
+    // the other half was never taken, and is being overwritten now. skip it.
+    audio_state_info.rx_overruns++;
+    AXON_KWS_STATS_COUNT(kAxonKwsStatsAudioOverruns, 1);
+    audio_take_half_frame(!half);
+  }
+  audio_framework_deliver_half_frame(audio_take_half_frame(half));
 }
 
-#ifdef BLE_SDK
-void audio_poll_timer_callback(void *context, uint64_t timestamp) {
-  audio_framework_handle_timer();
+static void audio_framework_handle_timer() {
+  int16_t *current_frame = NULL;
+
+  if (live_kws_state_info_struct.current_state==kIdle) {
+#if TRIGGER_MODE_ALWAYS_ON
+    // start a trigger polling cycle.
+    start_recording();
+    live_kws_state_info_struct.current_state = kWaitingForTrigger;
+#endif
+    return;
+  }
+
+  if (!audio_state_info.rx_polling) {
+    audio_state_info.ms_since_rx_complete += audio_state_info.timer_period_ms;
+    if (audio_state_info.ms_since_rx_complete <= AUDIO_RX_WATCHDOG_MS) {
+#if AUDIO_PREROLL_HALF_FRAME_CNT && !AXON_APP_RTOS
+      audio_preroll_handle_timer(NULL); // watch for SW2 coming up
+#endif
+      return;
+    }
+    // the rx DMA interrupt has stopped, poll for the rest of the recording.
+    audio_state_info.rx_polling = 1;
+    audio_state_info.rx_watchdog_fired = 1;
+    if (audio_state_info.timer_period_ms > RECORD_HALF_FRAME_DURATION_MS) {
+      audio_timer_start(RECORD_HALF_FRAME_DURATION_MS);
+    }
+  }
+
+  // check to see if a valid audio frame has been captured.
+  current_frame = audio_buffer_monitoring();
+  audio_framework_deliver_half_frame(current_frame);
 }
 
-extern uint64_t SystemTimeGetTicks64();
-static void audio_timer_start(void){
-  // want a recurring alarm every 16ms, wh
-  live_kws_state_info_struct.alarm_info.recurrence = 16000000*(0.016);
-  live_kws_state_info_struct.alarm_info.alarm_time = live_kws_state_info_struct.alarm_info.recurrence +SystemTimeGetTicks64();
-  live_kws_state_info_struct.alarm_info.alarm_callback = audio_poll_timer_callback;
-  PowerMgrAddAlarm(&live_kws_state_info_struct.alarm_info);
+/*
+ * interrupt nesting depth, see axon_app_irq_enter(). A nested interrupt leaves it as it found it, so the
+ * outer handler's increment and decrement don't need interrupts disabled.
+ */
+static volatile uint8_t audio_framework_irq_nesting;
 
+void axon_app_irq_enter(void) {
+  audio_framework_irq_nesting++;
 }
 
+void axon_app_irq_exit(void) {
+  audio_framework_irq_nesting--;
+}
+
+#ifdef BLE_SDK
 /*
  * button up handler invoked by the bsp.
  */
@@ -913,23 +1236,6 @@ void bsp_user_btn_up_handler() {
 }
 #else
 
-// can't use timer0 directly w/ ml_ble_platform
-
-/*
- * configure timer0. This is used as the audio buffer polling
- * thread.  Note: sys_clk.pclk appears to the pclk frequency in Mhz.
- *
- */
-static void audio_timer_start(){
-  timer_set_init_tick(TIMER0, 0);
-
-
-  timer_set_cap_tick(TIMER0, 16*sys_clk.pclk*1000);
-  timer_set_mode(TIMER0, TIMER_MODE_SYSCLK);
-  plic_interrupt_enable(IRQ4_TIMER0);
-  timer_start(TIMER0);
-}
-
 /******************************************************************
  * button functions
  *
@@ -937,7 +1243,7 @@ static void audio_timer_start(){
  ******************************************************************/
 void axon_app_gpio_irq_handler(void)
 {
-  reg_gpio_irq_clr =FLD_GPIO_IRQ_CLR ;
+  AxonAudioHalButtonIrqClear(kAxonAudioHalButtonRecord);
 
   if (live_kws_state_info_struct.current_state != kIdle ) {
     // already busy, ignore it.
@@ -950,10 +1256,12 @@ void axon_app_gpio_irq_handler(void)
   /*
    * This starts "always on" mode.
    */
-  gpio_set_high_level(LED4); // red while waiting for button to be released
-  delay_ms(10); // debounce timer...
-  while (0!=get_sw2_state()); // wait for it to rise
-  gpio_set_low_level(LED4); // turn red off (not waiting for release)
+  AxonAudioHalSetLed(kAxonAudioHalLedButtonDown, 1); // red while waiting for button to be released
+  AxonAudioHalDelayMs(10); // debounce timer...
+  while (0!=get_sw2_state()) { // wait for it to rise
+    AxonAudioHalDelayMs(1);
+  }
+  AxonAudioHalSetLed(kAxonAudioHalLedButtonDown, 0); // turn red off (not waiting for release)
   audio_sniff_timer_init(0);
 #  endif
 
@@ -962,31 +1270,197 @@ void axon_app_gpio_irq_handler(void)
    * In button mode, record will be triggered by the button going back up.
    */
   transition_state(kWaitingForTrigger, "");
+#if AXON_APP_RTOS
+  audio_framework_wake_capture_task_from_isr();
+#else
   process_state();
 #endif
+#endif
 }
 
 // ml_ble_platform manages gpio IRQs
 
+void axon_app_gpio_risc1_irq_handler(void)
+{
+  AxonAudioHalButtonIrqClear(kAxonAudioHalButtonPlayback);
+  live_kws_state_info_struct.sw5_down_event_cnt++;
+#if AXON_APP_RTOS
+  audio_framework_wake_capture_task_from_isr();
+#endif
+}
+
+#endif
+
+#if AXON_APP_RTOS
+/*
+ * signals the capture task to run the state machine and empty the capture stream.
+ */
+static void audio_framework_wake_capture_task() {
+  xTaskNotifyGive(audio_framework_rtos_info.capture_task);
+}
+
+static void audio_framework_wake_capture_task_from_isr() {
+  BaseType_t higher_priority_task_woken = pdFALSE;
+
+  vTaskNotifyGiveFromISR(audio_framework_rtos_info.capture_task, &higher_priority_task_woken);
+  portYIELD_FROM_ISR(higher_priority_task_woken);
+}
+
+/*
+ * Capture task, highest priority. Runs the state machine and decides what to do with each half frame.
+ * Half frames are copied out of the stream buffer into slots that stay put while the features task
+ * uses them.
+ */
+static void audio_framework_capture_task(void *unused) {
+  int16_t *current_frame;
+
+  while(1) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    process_state();
+
+    while(1) {
+      current_frame = audio_framework_rtos_info.half_frames[audio_framework_rtos_info.half_frame_ndx];
+      if (RECORD_HALF_FRAME_SIZE != xStreamBufferReceive(audio_framework_rtos_info.capture_stream, current_frame, RECORD_HALF_FRAME_SIZE, 0)) {
+        break;
+      }
+      if ((live_kws_state_info_struct.current_state!=kWaitingForTrigger) && (live_kws_state_info_struct.current_state!=kTriggered)) {
+        continue; // left over from a recording that has stopped
+      }
+#if AUDIO_PREROLL_HALF_FRAME_CNT
+      // copied into the ring, which also watches for SW2 coming up.
+      audio_preroll_handle_timer(current_frame);
+      xTaskNotify(audio_framework_rtos_info.features_task, 1<<AXON_APP_RTOS_PREROLL_NOTIFY_BIT, eSetBits);
+#else
+      audio_framework_rtos_info.half_frame_ndx = (audio_framework_rtos_info.half_frame_ndx+1) % AXON_APP_RTOS_HALF_FRAME_SLOT_CNT;
+      audio_framework_process_half_frame(current_frame);
+#endif
+    }
+  }
+}
+
 /*
- * Timer 0 isr
- * - In "waiting for trigger" state, this is the trigger.
- * - In "recording audio" state, need to check-up on the audio buffer.
+ * Features task. Submits each frame and waits for its features before taking the next one, so
+ * AxonKwsProcessFrame() is never busy. With pre-roll it replays the ring instead of taking frames from
+ * the queue, whenever the capture task has added to it.
  */
-void axon_app_timer0_irq_handler(void) {
-  if(0==(reg_tmr_sta & FLD_TMR_STA_TMR0)) {
-    return; //???
+static void audio_framework_features_task(void *unused) {
+#if AUDIO_PREROLL_HALF_FRAME_CNT
+  while(1) {
+    xTaskNotifyWait(0, 1<<AXON_APP_RTOS_PREROLL_NOTIFY_BIT, NULL, portMAX_DELAY);
+    audio_preroll_service();
   }
-  reg_tmr_sta = FLD_TMR_STA_TMR0;
-  audio_framework_handle_timer();
+#else
+  AudioFrameworkFrameStruct frame;
+#if TRIGGER_MODE_ALWAYS_ON
+  uint8_t foreground;
+#endif
+
+  while(1) {
+    xQueueReceive(audio_framework_rtos_info.frame_queue, &frame, portMAX_DELAY);
+    if (0 > AxonKwsProcessFrame(frame.ping, RECORD_HALF_FRAME_LEN, frame.pong, 1, frame.first_or_last_frame, frame.classify_option)) {
+      // classifying, or feature extraction failed to start.
+      AXON_KWS_STATS_COUNT(kAxonKwsStatsFramesDropped, 1);
+    } else {
+      audio_framework_wait_for_features();
+    }
+#if TRIGGER_MODE_ALWAYS_ON
+    // every queued frame gets a flag back, a dropped one keeps the last frame's as it would in the bare-metal build.
+    foreground = AxonKwsLastFrameWasForeground();
+    xQueueSend(audio_framework_rtos_info.foreground_queue, &foreground, portMAX_DELAY);
+#endif
+  }
+#endif
 }
 
-void axon_app_gpio_risc1_irq_handler(void)
-{
-  reg_gpio_irq_clr = FLD_GPIO_IRQ_GPIO2RISC1_CLR ;
-  live_kws_state_info_struct.sw5_down_event_cnt++;
+/*
+ * Inference task, lowest priority. Starts the model on a valid window and handles the
+ * classification results. Axon does the work, so the CPU is free (or in the sleep task) meanwhile.
+ */
+static void audio_framework_inference_task(void *unused) {
+  uint32_t completions;
+
+  while(1) {
+    xTaskNotifyWait(0, UINT32_MAX, &completions, portMAX_DELAY);
+    for (AxonMlCompletionEnum completion=kAxonMlCompletionClassifyWindow;completion<kAxonMlCompletionCount;completion++) {
+      if (completions & (1<<completion)) {
+        AxonKwsRunCompletion(completion, audio_framework_rtos_info.completion_results[completion]);
+      }
+    }
+  }
+}
+
+/*
+ * Hands an ml completion stage to the task that runs it.
+ */
+void AxonMlDemoHostDeferCompletion(AxonMlCompletionEnum completion, AxonResultEnum result) {
+  BaseType_t higher_priority_task_woken = pdFALSE;
+  TaskHandle_t task = completion==kAxonMlCompletionFeatures ? audio_framework_rtos_info.features_task : audio_framework_rtos_info.inference_task;
+
+  if (taskSCHEDULER_NOT_STARTED==xTaskGetSchedulerState()) {
+    // AxonDemoRun() classifies the stored samples before the scheduler starts.
+    if (completion!=kAxonMlCompletionModelService) { // AxonDemoRun() polls for that one
+      AxonKwsRunCompletion(completion, result);
+    }
+    return;
+  }
+  audio_framework_rtos_info.completion_results[completion] = result;
+  if (0==audio_framework_irq_nesting) {
+    // the classify window stage, model service requests and error paths are raised by a task.
+    xTaskNotify(task, 1<<completion, eSetBits);
+    return;
+  }
+  // axon completions come from the axon ISR
+  xTaskNotifyFromISR(task, 1<<completion, eSetBits, &higher_priority_task_woken);
+  portYIELD_FROM_ISR(higher_priority_task_woken);
+}
+
+/*
+ * Sleep task, just above idle. Whenever no other task has work it drains the deferred log and waits for
+ * the next interrupt, the same as the bare-metal main loop.
+ */
+static void audio_framework_sleep_task(void *unused) {
+  uint32_t interrupt_state;
+
+  while(1) {
+    AxonDeferredLogDrain();
+    interrupt_state = AxonHostDisableInterrupts();
+    AxonHostWfi();
+    AxonHostRestoreInterrupts(interrupt_state);
+  }
 }
 
+/*
+ * creates the tasks and starts the scheduler, doesn't return.
+ */
+static void audio_framework_rtos_start() {
+  audio_framework_rtos_info.capture_stream = xStreamBufferCreateStatic(
+      sizeof(audio_framework_rtos_info.capture_stream_storage), RECORD_HALF_FRAME_SIZE,
+      audio_framework_rtos_info.capture_stream_storage, &audio_framework_rtos_info.capture_stream_struct);
+  audio_framework_rtos_info.frame_queue = xQueueCreateStatic(AXON_APP_RTOS_FRAME_QUEUE_LEN, sizeof(AudioFrameworkFrameStruct),
+      audio_framework_rtos_info.frame_queue_storage, &audio_framework_rtos_info.frame_queue_struct);
+#if TRIGGER_MODE_ALWAYS_ON
+  audio_framework_rtos_info.foreground_queue = xQueueCreateStatic(sizeof(audio_framework_rtos_info.foreground_queue_storage), 1,
+      audio_framework_rtos_info.foreground_queue_storage, &audio_framework_rtos_info.foreground_queue_struct);
+#endif
+  audio_framework_rtos_info.capture_task = xTaskCreateStatic(audio_framework_capture_task, "kws_capture",
+      AXON_APP_RTOS_STACK_DEPTH, NULL, AXON_APP_RTOS_CAPTURE_PRIORITY,
+      audio_framework_rtos_info.capture_task_stack, &audio_framework_rtos_info.capture_task_struct);
+  audio_framework_rtos_info.features_task = xTaskCreateStatic(audio_framework_features_task, "kws_features",
+      AXON_APP_RTOS_STACK_DEPTH, NULL, AXON_APP_RTOS_FEATURES_PRIORITY,
+      audio_framework_rtos_info.features_task_stack, &audio_framework_rtos_info.features_task_struct);
+  audio_framework_rtos_info.inference_task = xTaskCreateStatic(audio_framework_inference_task, "kws_inference",
+      AXON_APP_RTOS_STACK_DEPTH, NULL, AXON_APP_RTOS_INFERENCE_PRIORITY,
+      audio_framework_rtos_info.inference_task_stack, &audio_framework_rtos_info.inference_task_struct);
+  audio_framework_rtos_info.sleep_task = xTaskCreateStatic(audio_framework_sleep_task, "kws_sleep",
+      AXON_APP_RTOS_SLEEP_STACK_DEPTH, NULL, AXON_APP_RTOS_SLEEP_PRIORITY,
+      audio_framework_rtos_info.sleep_task_stack, &audio_framework_rtos_info.sleep_task_struct);
+
+#if TRIGGER_MODE_ALWAYS_ON
+  audio_sniff_timer_init(ALWAYS_ON_ONESHOT);
+#endif
+  vTaskStartScheduler();
+  while(1); // out of heap for the idle/timer tasks
+}
 #endif
 
 /*
@@ -999,16 +1473,8 @@ void axon_app_gpio_risc1_irq_handler(void)
  */
 void AudioFrameworkDeepsleepWakeInit() {
   live_kws_state_info_struct.current_state = kIdle;
-#ifndef BLE_SDK
-  button_init();
-  // check the buttons for pending interrupts.
-  if (gpio_get_level(GPIO_PC0)) {
-    plic_set_pending(IRQ27_GPIO2RISC1); // GPIO_PC0
-  }
-  if (gpio_get_level(GPIO_PC2)) {
-    plic_set_pending(IRQ25_GPIO); // GPIO_PC2
-  }
-#endif
+  // also raises the interrupt of a button that is already down.
+  AxonAudioHalButtonInit();
 }
 /*
  * Called one time, after power-on/reset.
@@ -1038,6 +1504,7 @@ int AxonAppPrepare() {
  */
 int AxonAppRun(void *unused1, uint8_t deepRetWakeUp) {
 #ifdef BLE_SDK
+  AxonDeferredLogDrain();
   if(!deepRetWakeUp){
     enable_audio_and_axon();
     AxonDemoRun(NULL, 0);
@@ -1054,6 +1521,9 @@ int AxonAppRun(void *unused1, uint8_t deepRetWakeUp) {
 #endif
   audio_framework_print_usage();
 
+#if AXON_APP_RTOS
+  audio_framework_rtos_start();
+#endif
 #if TRIGGER_MODE_ALWAYS_ON
   audio_sniff_timer_init(ALWAYS_ON_ONESHOT);
 #endif
@@ -1067,9 +1537,16 @@ int AxonAppRun(void *unused1, uint8_t deepRetWakeUp) {
   while(1) {
     // printf("loop cnt A %d\r\n", loop_cnt++);
     process_state();
+#if AUDIO_PREROLL_HALF_FRAME_CNT
+    audio_preroll_service();
+#endif
     // printf("loop cnt B %d\r\n", loop_cnt++);
+    AxonKwsServiceModel();
+    AxonDeferredLogDrain();
     uint32_t interrupt_state = AxonHostDisableInterrupts();
-    AxonHostWfi();
+    if (!AxonKwsModelServicePending() && !AUDIO_PREROLL_SERVICE_PENDING()) {
+      AxonHostWfi();
+    }
     AxonHostRestoreInterrupts(interrupt_state);
   }
 #endif
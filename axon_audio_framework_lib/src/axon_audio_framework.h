@@ -16,7 +16,13 @@
  *
  */
 #pragma once
-#include "driver.h"
+#if AXON_AUDIO_HAL_HOST
+#  include <stdio.h>
+#  include <stdint.h>
+#  include <stdbool.h>
+#else
+#  include "driver.h"
+#endif
 /* Enable C linkage for C++ Compilers: */
 #if defined(__cplusplus)
 extern "C" {
@@ -108,6 +114,7 @@ extern "C" {
 #define MAX_HALF_FRAME_COUNT (MAX_RECORDING_SEC * 1000 / RECORD_HALF_FRAME_DURATION_MS)       // convert time to audio half frames
 
 #define AUDIO_RX_DMA_CH DMA2
+#define AUDIO_RX_DMA_IRQ DMA_CHN2_IRQ
 #define AUDIO_TX_DMA_CH DMA3
 
 
@@ -0,0 +1,110 @@
+/**
+ *          Copyright (c) 2020-2022, Atlazo Inc.
+ *          All rights reserved.
+ *
+ *          Licensed under the Apache License, Version 2.0 (the "License");
+ *          you may not use this file except in compliance with the License.
+ *          You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *          Unless required by applicable law or agreed to in writing, software
+ *          distributed under the License is distributed on an "AS IS" BASIS,
+ *          WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *          See the License for the specific language governing permissions and
+ *          limitations under the License.
+ *
+ */
+#pragma once
+
+#include <stdint.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*
+ * Audio HAL
+ * Everything the audio framework needs from the platform: the codec and its rx/tx DMA, the polling timer,
+ * the LEDs and the buttons.
+ * axon_audio_hal_board.c implements it on the B91 (core_drivers, or the ml_ble_platform when BLE_SDK is
+ * defined). axon_tools/framework_host implements it on Linux (AXON_AUDIO_HAL_HOST=1), streaming WAV files
+ * through a simulated DMA write pointer and timer so the framework runs unmodified on recorded clips.
+ */
+
+typedef enum {
+  kAxonAudioHalLedRecording,    // blue
+  kAxonAudioHalLedClassifying,  // green
+  kAxonAudioHalLedButtonDown,   // red, waiting for SW2 to be released
+} AxonAudioHalLedEnum;
+
+typedef enum {
+  kAxonAudioHalButtonRecord,    // SW2
+  kAxonAudioHalButtonPlayback,  // SW5
+} AxonAudioHalButtonEnum;
+
+/*
+ * Powers the mic, codec and audio/dma clocks up or down.
+ */
+void AxonAudioHalPowerUp();
+void AxonAudioHalPowerDown();
+
+/*
+ * Configures the codec input and starts the rx DMA looping over circle_buffer (sample_count samples).
+ * half_complete_handler is invoked from the DMA interrupt each time half of the buffer has been filled,
+ * with 0 for the 1st half and 1 for the 2nd. Returns 0 if the platform can't do that, and the caller has to
+ * poll AxonAudioHalRxWriteNdx() instead.
+ */
+uint8_t AxonAudioHalRxStart(int16_t *circle_buffer, uint32_t sample_count, void (*half_complete_handler)(uint8_t half));
+void AxonAudioHalRxStop();
+
+/*
+ * Returns the index in the circle buffer of the next sample the rx DMA will write.
+ */
+uint32_t AxonAudioHalRxWriteNdx();
+
+/*
+ * Configures the codec output and starts the tx DMA looping over buffer (sample_count samples).
+ */
+void AxonAudioHalTxStart(const int16_t *buffer, uint32_t sample_count);
+void AxonAudioHalTxStop();
+
+/*
+ * Starts (or restarts) the periodic polling timer. timer_handler is invoked from the timer interrupt every
+ * period_ms.
+ */
+void AxonAudioHalTimerStart(uint32_t period_ms, void (*timer_handler)());
+
+/*
+ * Stops the polling timer, including an expiry that is already pending.
+ */
+void AxonAudioHalTimerStop();
+
+/*
+ * Sets up the LEDs and turns them off.
+ */
+void AxonAudioHalLedInit();
+void AxonAudioHalSetLed(AxonAudioHalLedEnum led, uint8_t on);
+
+/*
+ * Sets up the buttons and their interrupts (axon_app_gpio_irq_handler() for SW2 going down,
+ * axon_app_gpio_risc1_irq_handler() for SW5). A button that is already down, ie it woke the system,
+ * gets its interrupt raised.
+ */
+void AxonAudioHalButtonInit();
+
+/*
+ * Returns 1 if the button is down.
+ */
+uint8_t AxonAudioHalGetButton(AxonAudioHalButtonEnum button);
+
+/*
+ * Acknowledges a button interrupt. Called first thing by the button interrupt handlers.
+ */
+void AxonAudioHalButtonIrqClear(AxonAudioHalButtonEnum button);
+
+void AxonAudioHalDelayMs(uint32_t milliseconds);
+
+#if defined(__cplusplus)
+}
+#endif
@@ -0,0 +1,352 @@
+/**
+ *          Copyright (c) 2020-2022, Atlazo Inc.
+ *          All rights reserved.
+ *
+ *          Licensed under the Apache License, Version 2.0 (the "License");
+ *          you may not use this file except in compliance with the License.
+ *          You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *          Unless required by applicable law or agreed to in writing, software
+ *          distributed under the License is distributed on an "AS IS" BASIS,
+ *          WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *          See the License for the specific language governing permissions and
+ *          limitations under the License.
+ *
+ */
+/*
+ * B91 audio HAL: codec, audio DMA, timer0 (or a power manager alarm with the ml_ble_platform), LEDs
+ * and buttons.
+ */
+#if !AXON_AUDIO_HAL_HOST
+#include "axon_audio_framework.h"
+#include "axon_audio_framework_api.h"
+#include "axon_audio_hal.h"
+
+#define AMIC 0
+#define DMIC 1
+#define AUDIO_MIC AMIC
+
+extern void   bsp_power_up_mic();
+extern void   bsp_power_down_mic();
+
+#ifdef BLE_SDK
+#  include "power_mgr_api.h"
+#endif
+
+static struct {
+  void (*timer_handler)();
+  void (*rx_half_complete_handler)(uint8_t half);
+  int16_t *rx_buffer;
+  uint32_t rx_len;
+  /*
+   * not sure if this needs to be retained but we'll declare non-local just in case.
+   */
+  dma_chain_config_t rx_dma_list_config[2]; // 2nd half, then 1st half
+  dma_chain_config_t tx_dma_list_config;
+#ifdef BLE_SDK
+  power_mgr_alarm_struct alarm_info;
+#endif
+} audio_hal_info;
+
+void AxonAudioHalPowerUp() {
+  bsp_power_up_mic();
+  //enable the codec
+  reg_rst3 |= (BIT(5));//codec is at bit 5
+  //enable the dma
+  reg_rst1 |= (FLD_RST1_DMA);
+  //enable the audio
+  reg_rst2 |= (FLD_RST2_AUD);
+
+  //enable the dma clock
+  reg_clk_en1 |= (FLD_CLK1_DMA_EN);
+  //enable the audio clock
+  reg_clk_en2 |= (FLD_CLK2_AUD_EN);
+
+#if AUDIO_MIC==DMIC
+  gpio_set_input_en(GPIO_PB2 | GPIO_PB3 | GPIO_PB4);
+#endif
+}
+
+void AxonAudioHalPowerDown() {
+  bsp_power_down_mic();
+  //disable the audio clock
+  reg_clk_en2 &= (~FLD_CLK2_AUD_EN);
+  //disable the dma clock
+  /*
+   * DON'T DISABLE DMA CLOCK; OTHERS MIGHT BE USING IT!!!
+   */
+#if 0
+  reg_clk_en1 &= (~FLD_CLK1_DMA_EN);
+#endif
+  //disable the audio
+  reg_rst2 &= (~FLD_RST2_AUD);
+  //disable the dma
+  /*
+   * DON'T DISABLE DMA CLOCK; OTHERS MIGHT BE USING IT!!!
+   */
+#if 0
+  reg_rst1 &= (~FLD_RST1_DMA);
+#endif
+  //disable the codec
+  reg_rst3 &= (~BIT(5));//codec is at bit 5
+
+#if AUDIO_MIC==DMIC
+  gpio_set_gpio_en(GPIO_PB2 | GPIO_PB3 | GPIO_PB4);
+  gpio_set_output_en(GPIO_PB2 | GPIO_PB3 | GPIO_PB4);
+  gpio_set_low_level(GPIO_PB2 | GPIO_PB3 | GPIO_PB4);
+  gpio_set_input_dis(GPIO_PB2 | GPIO_PB3 | GPIO_PB4);
+#endif
+}
+
+/*
+ * The buffer is transferred as 2 halves so there is a transfer complete interrupt at the end of each. The
+ * channel starts on the 1st half, then the list alternates between the 2nd and the 1st. The list elements
+ * copy the channel control, so the interrupt is unmasked before they are added.
+ */
+uint8_t AxonAudioHalRxStart(int16_t *circle_buffer, uint32_t sample_count, void (*half_complete_handler)(uint8_t half)) {
+  uint32_t half_size = sample_count/2*sizeof(int16_t);
+
+  audio_hal_info.rx_buffer = circle_buffer;
+  audio_hal_info.rx_len = sample_count;
+  audio_hal_info.rx_half_complete_handler = half_complete_handler;
+  audio_rx_dma_config(AUDIO_RX_DMA_CH,(uint16_t*)circle_buffer, half_size, &audio_hal_info.rx_dma_list_config[0]);
+  audio_set_rx_buff_len(sample_count*sizeof(int16_t)); // the audio side still sees the whole buffer
+  dma_set_irq_mask(AUDIO_RX_DMA_CH, TC_MASK);
+  audio_rx_dma_add_list_element(&audio_hal_info.rx_dma_list_config[0], &audio_hal_info.rx_dma_list_config[1],(uint16_t*)&circle_buffer[sample_count/2], half_size);
+  audio_rx_dma_add_list_element(&audio_hal_info.rx_dma_list_config[1], &audio_hal_info.rx_dma_list_config[0],(uint16_t*)circle_buffer, half_size);
+  dma_chn_dis(AUDIO_RX_DMA_CH);
+  dma_clr_tc_irq_status(AUDIO_RX_DMA_IRQ);
+
+  /*
+   * microphone needs some help. don't think D_GAIN is used by AMIC but it doesn't seem
+   * to harm anything.
+   */
+  audio_set_codec_in_path_a_d_gain(CODEC_IN_D_GAIN_8_DB, CODEC_IN_A_GAIN_16_DB);
+#if AUDIO_MIC==AMIC
+//  audio_init(AMIC_IN_OUT,AUDIO_16K,MONO_BIT_16); // initialize audio AMIC with OUT
+  // audio_init(AMIC_INPUT,AUDIO_16K,MONO_BIT_16); // initialize audio AMIC
+
+ audio_init(AMIC_IN_TO_BUF,AUDIO_16K,MONO_BIT_16); // initialize audio AMIC
+#elif AUDIO_MIC==DMIC
+  audio_set_dmic_pin(DMIC_GROUPB_B2_DAT_B3_B4_CLK);
+  audio_init(DMIC_IN,AUDIO_16K,MONO_BIT_16); // initialize audio using DMIC
+#endif
+#ifdef BLE_SDK
+  // the ml_ble_platform owns the dma interrupt
+  dma_clr_irq_mask(AUDIO_RX_DMA_CH, TC_MASK);
+  audio_rx_dma_en();
+  return 0;
+#else
+  plic_interrupt_enable(IRQ5_DMA);
+  audio_rx_dma_en();
+  return 1;
+#endif
+}
+
+void AxonAudioHalRxStop() {
+  dma_chn_dis(AUDIO_RX_DMA_CH);
+  dma_clr_tc_irq_status(AUDIO_RX_DMA_IRQ);
+}
+
+uint32_t AxonAudioHalRxWriteNdx() {
+  return (audio_get_rx_dma_wptr(AUDIO_RX_DMA_CH) - (uint32_t)audio_hal_info.rx_buffer)>>1;
+}
+
+void AxonAudioHalTxStart(const int16_t *buffer, uint32_t sample_count) {
+  audio_tx_dma_config(AUDIO_TX_DMA_CH,(uint16_t*)buffer, sample_count*sizeof(int16_t), &audio_hal_info.tx_dma_list_config);
+  audio_tx_dma_add_list_element(&audio_hal_info.tx_dma_list_config, &audio_hal_info.tx_dma_list_config,(uint16_t*)buffer, sample_count*sizeof(int16_t));
+  dma_chn_dis(AUDIO_TX_DMA_CH);
+  audio_init(BUF_TO_LINE_OUT,AUDIO_16K,MONO_BIT_16); // initialize audio AMIC
+  audio_tx_dma_en();
+}
+
+void AxonAudioHalTxStop() {
+  dma_chn_dis(AUDIO_TX_DMA_CH);
+}
+
+#ifdef BLE_SDK
+/*
+ * can't use timer0 directly w/ ml_ble_platform, the power manager runs a recurring alarm instead.
+ */
+static void audio_hal_alarm_callback(void *context, uint64_t timestamp) {
+  audio_hal_info.timer_handler();
+}
+
+extern uint64_t SystemTimeGetTicks64();
+void AxonAudioHalTimerStart(uint32_t period_ms, void (*timer_handler)()) {
+  AxonAudioHalTimerStop();
+  audio_hal_info.timer_handler = timer_handler;
+  // alarm ticks are 16MHz
+  audio_hal_info.alarm_info.recurrence = 16000*period_ms;
+  audio_hal_info.alarm_info.alarm_time = audio_hal_info.alarm_info.recurrence +SystemTimeGetTicks64();
+  audio_hal_info.alarm_info.alarm_callback = audio_hal_alarm_callback;
+  PowerMgrAddAlarm(&audio_hal_info.alarm_info);
+}
+
+void AxonAudioHalTimerStop() {
+  // de-register this callback from power mgr
+  PowerMgrDeleteAlarm(&audio_hal_info.alarm_info);
+}
+
+/*
+ * the ml_ble_platform manages the LEDs and buttons.
+ */
+void AxonAudioHalLedInit() {
+}
+
+void AxonAudioHalSetLed(AxonAudioHalLedEnum led, uint8_t on) {
+}
+
+void AxonAudioHalButtonInit() {
+}
+
+uint8_t AxonAudioHalGetButton(AxonAudioHalButtonEnum button) {
+  return 0;
+}
+
+void AxonAudioHalButtonIrqClear(AxonAudioHalButtonEnum button) {
+}
+#else
+
+/*
+ * configure timer0. This is used as the audio buffer polling
+ * thread.  Note: sys_clk.pclk appears to the pclk frequency in Mhz.
+ */
+void AxonAudioHalTimerStart(uint32_t period_ms, void (*timer_handler)()) {
+  AxonAudioHalTimerStop();
+  audio_hal_info.timer_handler = timer_handler;
+  timer_set_init_tick(TIMER0, 0);
+  timer_set_cap_tick(TIMER0, period_ms*sys_clk.pclk*1000);
+  timer_set_mode(TIMER0, TIMER_MODE_SYSCLK);
+  plic_interrupt_enable(IRQ4_TIMER0);
+  timer_start(TIMER0);
+}
+
+void AxonAudioHalTimerStop() {
+  timer_stop(TIMER0);
+  // make sure the interrupt doesn't fire in case it is pending
+  reg_tmr_sta = FLD_TMR_STA_TMR0;
+  plic_interrupt_complete(IRQ4_TIMER0);
+}
+
+/*
+ * dma isr, the rx channel has filled half of the buffer. The half being written tells which one.
+ */
+void axon_app_dma_irq_handler(void) {
+  if (0==dma_get_tc_irq_status(AUDIO_RX_DMA_IRQ)) {
+    return;
+  }
+  dma_clr_tc_irq_status(AUDIO_RX_DMA_IRQ);
+  if (NULL != audio_hal_info.rx_half_complete_handler) {
+    audio_hal_info.rx_half_complete_handler(AxonAudioHalRxWriteNdx() < audio_hal_info.rx_len/2 ? 1 : 0);
+  }
+}
+
+/*
+ * Timer 0 isr
+ */
+void axon_app_timer0_irq_handler(void) {
+  if(0==(reg_tmr_sta & FLD_TMR_STA_TMR0)) {
+    return; //???
+  }
+  reg_tmr_sta = FLD_TMR_STA_TMR0;
+  if (NULL != audio_hal_info.timer_handler) {
+    audio_hal_info.timer_handler();
+  }
+}
+
+static const uint32_t audio_hal_leds[] = {
+  [kAxonAudioHalLedRecording] = LED1,
+  [kAxonAudioHalLedClassifying] = LED2,
+  [kAxonAudioHalLedButtonDown] = LED4,
+};
+
+void AxonAudioHalLedInit() {
+  gpio_function_en( LED2 | LED3 | LED4);   // enable GPIO LEDs
+  gpio_output_en( LED2 | LED3 | LED4); // enable output
+  gpio_input_dis( LED2 | LED3 | LED4); // disable input
+  gpio_set_low_level( LED2 | LED3 | LED4); // turn LEDs OFF
+}
+
+void AxonAudioHalSetLed(AxonAudioHalLedEnum led, uint8_t on) {
+  if (on) {
+    gpio_set_high_level(audio_hal_leds[led]);
+  } else {
+    gpio_set_low_level(audio_hal_leds[led]);
+  }
+}
+
+/*
+ * SW2 is the record button, SW5 is the playback button
+ */
+void AxonAudioHalButtonInit() {
+  // TL Key1 is low input
+  gpio_function_en(GPIO_PC2);
+  gpio_input_en(GPIO_PC2);
+  gpio_output_dis(GPIO_PC2);
+  gpio_set_up_down_res(GPIO_PC2, GPIO_PIN_PULLDOWN_100K);
+  gpio_set_low_level(GPIO_PC2);
+
+  // TL Key3 is high output
+  gpio_function_en(GPIO_PC3);
+  gpio_output_en(GPIO_PC3);
+  gpio_input_dis(GPIO_PC3);
+  gpio_set_up_down_res(GPIO_PC3, GPIO_PIN_PULLUP_10K);
+  gpio_set_high_level(GPIO_PC3);
+
+  //core_enable_interrupt(); //enabled in user_init of main
+  gpio_irq_en(GPIO_PC2);
+  gpio_set_irq(GPIO_PC2, INTR_RISING_EDGE);
+  // clear any spurious int..
+  reg_gpio_irq_clr =FLD_GPIO_IRQ_CLR ;
+  plic_interrupt_complete(IRQ25_GPIO);
+  plic_interrupt_enable(IRQ25_GPIO); // GPIO_PC2
+
+  /****GPIO_IRQ POL_RISING   SW5 link PC0**/
+  gpio_function_en(GPIO_PC0);
+  gpio_input_en(GPIO_PC0);
+  gpio_output_dis(GPIO_PC0);
+  gpio_set_up_down_res(GPIO_PC0, GPIO_PIN_PULLDOWN_100K);
+  gpio_set_low_level(GPIO_PC0);
+
+  gpio_function_en(GPIO_PC1);
+  gpio_output_en(GPIO_PC1);
+  gpio_input_dis(GPIO_PC1);
+  gpio_set_up_down_res(GPIO_PC1, GPIO_PIN_PULLUP_10K);
+  gpio_set_high_level(GPIO_PC1);
+
+  //core_enable_interrupt();
+  gpio_gpio2risc1_irq_en(GPIO_PC0);
+  gpio_set_gpio2risc1_irq(GPIO_PC0,INTR_FALLING_EDGE);
+  plic_interrupt_enable(IRQ27_GPIO2RISC1); // GPIO_PC0
+
+  pm_set_gpio_wakeup(GPIO_PC2, WAKEUP_LEVEL_HIGH, 1);
+  pm_set_gpio_wakeup(GPIO_PC0, WAKEUP_LEVEL_HIGH, 1);
+
+  /*
+   * If a button press was the source of the wake-up, an interrupt will not be generated.
+   * So we need to spoof the interrupt.
+   */
+  if (gpio_get_level(GPIO_PC0)) {
+    plic_set_pending(IRQ27_GPIO2RISC1); // GPIO_PC0
+  }
+  if (gpio_get_level(GPIO_PC2)) {
+    plic_set_pending(IRQ25_GPIO); // GPIO_PC2
+  }
+}
+
+uint8_t AxonAudioHalGetButton(AxonAudioHalButtonEnum button) {
+  return gpio_get_level(button==kAxonAudioHalButtonRecord ? GPIO_PC2 : GPIO_PC0);
+}
+
+void AxonAudioHalButtonIrqClear(AxonAudioHalButtonEnum button) {
+  reg_gpio_irq_clr = button==kAxonAudioHalButtonRecord ? FLD_GPIO_IRQ_CLR : FLD_GPIO_IRQ_GPIO2RISC1_CLR;
+}
+#endif
+
+void AxonAudioHalDelayMs(uint32_t milliseconds) {
+  delay_ms(milliseconds);
+}
+#endif
@@ -56,4 +56,12 @@ extern int AxonKwsHostGetNextAudioFeatureSlice(const AudioInputFeatureType **aud
  */
 AxonResultEnum AxonKwsModelGrnnInfer(uint8_t slice_count);
 
+/*
+ * Selects the width of the hidden state carried between slices, kAxonDataWidth16 (default) or kAxonDataWidth8.
+ * The int8 state halves the recurrent vector fed to the hidden matrix multiply; the gates stay wide
+ * because the sigmoids produce q1.8. Ops for both widths are defined by AxonKwsModelGrnnPrepare(),
+ * so this can be changed between inferences.
+ */
+AxonResultEnum AxonKwsModelGrnnSetHiddenStateWidth(AxonDataWidthEnum hidden_state_width);
+
 uint8_t AxonKwsModelGrnnGetClassification(int32_t *score, char **label);
@@ -23,6 +23,7 @@
 // #include "axon_grnn_weights.h"
 #include "axon_grnn.h"
 #include "axon_logging_api.h"
+#include "axon_kws_stats_api.h"
 
 // #include "axon_logging.h"
 
@@ -76,6 +77,32 @@ typedef enum {
 
 #define IS_FINAL_MEMCPY_OP(OP_NDX) (OP_NDX==kGrnnAxonOpFinalMemCpyBf)
 
+/*
+ * Operations performed per-frame with an int8 hidden state.
+ * The matrix multiplies take int8 x and h and produce 32 bits, so everything after them is 24 bit.
+ * Biases are widened into RAM once at prepare time, so there are no memcpy ops.
+ */
+typedef enum {
+  kGrnnAxonInt8PerFrameOpFirst,
+  kGrnnAxonInt8OpInputWeightsMatrixMult = kGrnnAxonInt8PerFrameOpFirst, // multiply int8 input and input weights into buff_z32[]
+  kGrnnAxonInt8OpHiddenWeightsMatrixMult,      // multiply int8 hidden and hidden weights into buff_h_hat32[]
+  kGrnnAxonInt8OpInputPlusHiddenXpy,           // add the results of previous 2 ops into buff_tmp32[]
+  kGrnnAxonInt8OpAddInputBiasXpySigmoid,       // add input bias to previous and take sigmoid. Result is Z(t) in buff_z32[]
+  kGrnnAxonInt8OpAddHiddenBiasXpySigmoid,      // add hidden bias to previous and take sigmoid. Result is h_hat(t) in buff_h_hat32[]
+  kGrnnAxonInt8OpHiddenTimesZXty,              // multiply Zt(in buff_z32) with ht-1 (in buff_h32), store in buff_h32[].
+  kGrnnAxonInt8Op1MinusZAxpb,                  // multiply Zt(in buff_z32) by -SIGMOID_ZETA (A) and add SIGMOID_ZETA+SIGMOID_NU(B), store in buff_z32[]
+  kGrnnAxonInt8Op1MinusZTimesHXty,             // multiply 1-Zt (in buff_z32) by h_hat (in buff_h_hat32) and store in buff_z32.
+  kGrnnAxonInt8OpZtimesHPlus1minusZTimesHhatXpy, // add (1-Zt)*h_hat (in buff_z32) to Z*Ht-1 (in buff_h32), final h stored in buff_h32
+  kGrnnAxonInt8PerFrameOpCount, // 7 operations
+} GrnnAxonInt8PerFrameOperationEnum;
+
+typedef enum {
+  kGrnnAxonInt8OpFinalFirst,
+  kGrnnAxonInt8OpFinalWeightsMatrixMult = kGrnnAxonInt8OpFinalFirst, // multiply final h stored in buff_h8 with GRNN_FINAL_FC_WEIGHTS into buff_final_outputs32
+  kGrnnAxonInt8OpFinalBiasesXpy,                                     // add biases in buff_bias_f32 to result of prior op.
+  kGrnnAxonInt8OpFinalCount
+} GrnnAxonInt8FinalOperationEnum;
+
 
 #ifndef RETAINED_MEMORY_SECTION_ATTRIBUTE
 static_assert(0, "PLEASE DEFINE RETAINED_MEMORY_SECTION_ATTRIBUTE IN BUILD SYSTEM");
@@ -90,6 +117,12 @@ static AxonOpHandle grnn_perframe_op_handles[kGrnnAxonPerFrameOpCount];
 RETAINED_MEMORY_SECTION_ATTRIBUTE
 static AxonOpHandle grnn_final_op_handles[kGrnnAxonOpFinalCount];
 
+RETAINED_MEMORY_SECTION_ATTRIBUTE
+static AxonOpHandle grnn_int8_perframe_op_handles[kGrnnAxonInt8PerFrameOpCount];
+
+RETAINED_MEMORY_SECTION_ATTRIBUTE
+static AxonOpHandle grnn_int8_final_op_handles[kGrnnAxonInt8OpFinalCount];
+
 
 static grnn_weight_type _Alignas(8) buff_bias[GRNN_HIDDEN_HT]; // holds biases(Bg, Bh, Bf)
 static grnn_weight_type _Alignas(8) buff_h[GRNN_HIDDEN_HT]; // holds hidden layer between calls
@@ -99,6 +132,21 @@ static grnn_weight_type _Alignas(8) buff_h_hat[GRNN_HIDDEN_HT]; // holds h_hat l
 static grnn_weight_type _Alignas(8) buff_tmp[GRNN_HIDDEN_HT]; // temporary buffer
 static grnn_weight_type _Alignas(8) buff_final_outputs[GRNN_CLASS_COUNT]; // holds the final result
 
+/*
+ * int8 hidden state buffers. x and h are int8 for the matrix multiplies, everything else is 24 bit.
+ * buff_h32 is requantized through buff_h8 after every slice so the state really is int8.
+ */
+static int8_t _Alignas(16) buff_i8[GRNN_INPUT_HT]; // holds input layer
+static int8_t _Alignas(16) buff_h8[GRNN_HIDDEN_HT]; // holds hidden layer between calls
+static int32_t buff_h32[GRNN_HIDDEN_HT];
+static int32_t buff_z32[GRNN_HIDDEN_HT];
+static int32_t buff_h_hat32[GRNN_HIDDEN_HT];
+static int32_t buff_tmp32[GRNN_HIDDEN_HT];
+static int32_t buff_bias_g32[GRNN_HIDDEN_HT]; // Bg, widened from flash at prepare
+static int32_t buff_bias_h32[GRNN_HIDDEN_HT]; // Bh, widened from flash at prepare
+static int32_t buff_bias_f32[GRNN_CLASS_COUNT]; // Bf, widened from flash at prepare
+static int32_t buff_final_outputs32[GRNN_CLASS_COUNT];
+
 RETAINED_MEMORY_SECTION_ATTRIBUTE
 static struct {
   void *axon_handle;
@@ -106,6 +154,7 @@ static struct {
   void (*result_callback_function)(AxonResultEnum result);
   uint8_t slice_count; // total number of slices to process
   uint8_t slice_ndx; // current slice being processed.
+  AxonDataWidthEnum hidden_state_width; // kAxonDataWidth8 selects the int8 ops, anything else the 16 bit ones.
 }grnn_state_info;
 
 /*
@@ -355,20 +404,279 @@ static AxonResultEnum axon_grnn_define_ops() {
   return result;
 }
 
+#if GRNN_8_BIT_SYMMETRIC_QUANT
+/*
+ * Define the per-frame and final operations for the int8 hidden state.
+ * Handles will be placed in grnn_int8_perframe_op_handles and grnn_int8_final_op_handles.
+ */
+static AxonResultEnum axon_grnn_define_int8_ops() {
+  AxonResultEnum result;
+  AxonInputStruct axon_input;
+  const GrnnLayerScaleStruct *fc_scales = &GRNN_INT8_LAYER_SCALES[kGrnnLayerInputHiddenFc];
+  const GrnnLayerScaleStruct *update_scales = &GRNN_INT8_LAYER_SCALES[kGrnnLayerHiddenUpdate];
+  const GrnnLayerScaleStruct *final_scales = &GRNN_INT8_LAYER_SCALES[kGrnnLayerFinalFc];
+
+  /*
+   * widen the biases once; 24 bit ops can't take them from flash as int16.
+   */
+  for (uint8_t ndx=0;ndx<GRNN_HIDDEN_HT;ndx++) {
+    buff_bias_g32[ndx] = GRNN_INPUT_FC_BIAS[ndx];
+    buff_bias_h32[ndx] = GRNN_HIDDEN_FC_BIAS[ndx];
+  }
+  for (uint8_t ndx=0;ndx<GRNN_CLASS_COUNT;ndx++) {
+    buff_bias_f32[ndx] = GRNN_FINAL_FC_BIAS[ndx];
+  }
+
+  axon_input.data_packing = kAxonDataPackingEnabled;
+  axon_input.output_af = kAxonAfDisabled;
+  axon_input.x_stride = kAxonStride1;
+  axon_input.y_stride = kAxonStride1;
+  axon_input.q_stride = kAxonStride1;
+
+  /*
+   * kGrnnAxonInt8OpInputWeightsMatrixMult, kGrnnAxonInt8OpHiddenWeightsMatrixMult
+   * each product is rounded to q.11 on its own, same as the 16 bit path.
+   */
+  axon_input.data_width = kAxonDataWidth8;
+  axon_input.length = GRNN_INPUT_HT;
+  axon_input.y_length = GRNN_INPUT_WT_HT;
+  axon_input.x_in = (int32_t*)buff_i8; // q2.5
+  axon_input.y_in = (int32_t*)GRNN_INPUT_FC_WEIGHTS; // q1.GRNN_INPUT_FC_WEIGHTS_Q
+  axon_input.output_rounding = kAxonRoundingNone+fc_scales->input_q+fc_scales->weights_q-fc_scales->output_q;
+  axon_input.q_out = buff_z32; // q.11
+  if (kAxonResultSuccess > (result=AxonApiDefineOpMatrixMult32BitOutput(grnn_state_info.axon_handle, &axon_input, &grnn_int8_perframe_op_handles[kGrnnAxonInt8OpInputWeightsMatrixMult]))) {
+    return result;
+  }
+  axon_input.length = GRNN_HIDDEN_HT;
+  axon_input.y_length = GRNN_HIDDEN_WT_HT;
+  axon_input.x_in = (int32_t*)buff_h8; // q2.5
+  axon_input.y_in = (int32_t*)GRNN_HIDDEN_FC_WEIGHTS; // q0.GRNN_HIDDEN_FC_WEIGHTS_Q
+  axon_input.q_out = buff_h_hat32; // q.11
+  if (kAxonResultSuccess > (result=AxonApiDefineOpMatrixMult32BitOutput(grnn_state_info.axon_handle, &axon_input, &grnn_int8_perframe_op_handles[kGrnnAxonInt8OpHiddenWeightsMatrixMult]))) {
+    return result;
+  }
+
+  /*
+   * kGrnnAxonInt8OpInputPlusHiddenXpy
+   */
+  axon_input.data_width = kAxonDataWidth24;
+  axon_input.length = GRNN_HIDDEN_HT;
+  axon_input.x_in = buff_z32; // q.11
+  axon_input.y_in = buff_h_hat32; // q.11
+  axon_input.output_rounding = kAxonRoundingNone;
+  axon_input.q_out = buff_tmp32; // q.11
+  if (kAxonResultSuccess > (result=AxonApiDefineOpXpy(grnn_state_info.axon_handle, &axon_input, &grnn_int8_perframe_op_handles[kGrnnAxonInt8OpInputPlusHiddenXpy]))) {
+    return result;
+  }
+
+  /*
+   * kGrnnAxonInt8OpAddInputBiasXpySigmoid, kGrnnAxonInt8OpAddHiddenBiasXpySigmoid
+   */
+  axon_input.data_width = kAxonDataWidth24;
+  axon_input.length = GRNN_HIDDEN_HT;
+  axon_input.x_in = buff_tmp32; // q.11
+  axon_input.y_in = buff_bias_g32; // q.11
+  axon_input.output_rounding = kAxonRoundingNone+fc_scales->output_q-update_scales->weights_q;
+  axon_input.output_af = kAxonAfQuantSigmoid;
+  axon_input.q_out = buff_z32; // q1.8
+  if (kAxonResultSuccess > (result=AxonApiDefineOpXpy(grnn_state_info.axon_handle, &axon_input, &grnn_int8_perframe_op_handles[kGrnnAxonInt8OpAddInputBiasXpySigmoid]))) {
+    return result;
+  }
+  axon_input.y_in = buff_bias_h32; // q.11
+  axon_input.q_out = buff_h_hat32; // q1.8
+  if (kAxonResultSuccess > (result=AxonApiDefineOpXpy(grnn_state_info.axon_handle, &axon_input, &grnn_int8_perframe_op_handles[kGrnnAxonInt8OpAddHiddenBiasXpySigmoid]))) {
+    return result;
+  }
+
+  /*
+   * kGrnnAxonInt8OpHiddenTimesZXty
+   */
+  axon_input.x_in = buff_z32; // q1.8
+  axon_input.y_in = buff_h32; // q2.5
+  axon_input.output_rounding = kAxonRoundingNone+update_scales->weights_q+update_scales->input_q-update_scales->output_q;
+  axon_input.output_af = kAxonAfDisabled;
+  axon_input.q_out = buff_h32; // q2.5
+  if (kAxonResultSuccess > (result=AxonApiDefineOpXty(grnn_state_info.axon_handle, &axon_input, &grnn_int8_perframe_op_handles[kGrnnAxonInt8OpHiddenTimesZXty]))) {
+    return result;
+  }
+
+  /*
+   * kGrnnAxonInt8Op1MinusZAxpb
+   */
+  axon_input.x_in = buff_z32; // q1.8
+  axon_input.a_in = MINUS_SIGMOID_ZETA_1Q7;   // Q1.7
+  axon_input.b_in = SIGMOID_NU_PLUS_ZETA_1Q15;  // q1.15
+  axon_input.output_rounding = kAxonRoundingNone+7; // round qx.15 to qx.8
+  axon_input.q_out = buff_z32; // q2.8
+  if (kAxonResultSuccess > (result=AxonApiDefineOpAxpb(grnn_state_info.axon_handle, &axon_input, &grnn_int8_perframe_op_handles[kGrnnAxonInt8Op1MinusZAxpb]))) {
+    return result;
+  }
+
+  /*
+   * kGrnnAxonInt8Op1MinusZTimesHXty
+   */
+  axon_input.x_in = buff_z32; // q2.8
+  axon_input.y_in = buff_h_hat32; // q1.8
+  axon_input.output_rounding = kAxonRoundingNone+2*update_scales->weights_q-update_scales->output_q;
+  axon_input.q_out = buff_z32; // q2.5
+  if (kAxonResultSuccess > (result=AxonApiDefineOpXty(grnn_state_info.axon_handle, &axon_input, &grnn_int8_perframe_op_handles[kGrnnAxonInt8Op1MinusZTimesHXty]))) {
+    return result;
+  }
+
+  /*
+   * kGrnnAxonInt8OpZtimesHPlus1minusZTimesHhatXpy
+   */
+  axon_input.x_in = buff_z32; // q2.5
+  axon_input.y_in = buff_h32; // q2.5
+  axon_input.output_rounding = kAxonRoundingNone;
+  axon_input.q_out = buff_h32; // q2.5, requantized to int8 in grnn_slice_ops_done_callback()
+  if (kAxonResultSuccess > (result=AxonApiDefineOpXpy(grnn_state_info.axon_handle, &axon_input, &grnn_int8_perframe_op_handles[kGrnnAxonInt8OpZtimesHPlus1minusZTimesHhatXpy]))) {
+    return result;
+  }
+
+  /*
+   * kGrnnAxonInt8OpFinalWeightsMatrixMult
+   */
+  axon_input.data_width = kAxonDataWidth8;
+  axon_input.length = GRNN_HIDDEN_HT;
+  axon_input.y_length = GRNN_FINAL_FC_HEIGHT;
+  axon_input.x_in = (int32_t*)buff_h8; // q2.5
+  axon_input.y_in = (int32_t*)GRNN_FINAL_FC_WEIGHTS;
+  axon_input.output_rounding = kAxonRoundingNone+final_scales->input_q+final_scales->weights_q-final_scales->output_q;
+  axon_input.q_out = buff_final_outputs32;
+  if (kAxonResultSuccess > (result=AxonApiDefineOpMatrixMult32BitOutput(grnn_state_info.axon_handle, &axon_input, &grnn_int8_final_op_handles[kGrnnAxonInt8OpFinalWeightsMatrixMult]))) {
+    return result;
+  }
+
+  /*
+   * kGrnnAxonInt8OpFinalBiasesXpy
+   */
+  axon_input.data_width = kAxonDataWidth24;
+  axon_input.length = GRNN_FINAL_FC_HEIGHT;
+  axon_input.x_in = buff_final_outputs32;
+  axon_input.y_in = buff_bias_f32;
+  axon_input.output_rounding = kAxonRoundingNone;
+  axon_input.q_out = buff_final_outputs32;
+  if (kAxonResultSuccess > (result=AxonApiDefineOpXpy(grnn_state_info.axon_handle, &axon_input, &grnn_int8_final_op_handles[kGrnnAxonInt8OpFinalBiasesXpy]))) {
+    return result;
+  }
+
+  return result;
+}
+#endif
+
 /*
  * API called once at start up
  */
 AxonResultEnum AxonKwsModelGrnnPrepare(void *axon_handle, void (*result_callback_function)(AxonResultEnum result)) {
+  AxonResultEnum result;
   grnn_state_info.result_callback_function = result_callback_function;
   grnn_state_info.axon_handle = axon_handle;
 
-  return axon_grnn_define_ops();
+  if (kAxonResultSuccess > (result=axon_grnn_define_ops())) {
+    return result;
+  }
+#if GRNN_8_BIT_SYMMETRIC_QUANT
+  result = axon_grnn_define_int8_ops();
+#endif
+  return result;
+}
+
+/*
+ * api function
+ */
+AxonResultEnum AxonKwsModelGrnnSetHiddenStateWidth(AxonDataWidthEnum hidden_state_width) {
+  switch (hidden_state_width) {
+  case kAxonDataWidth16:
+    break;
+  case kAxonDataWidth8:
+#if GRNN_8_BIT_SYMMETRIC_QUANT
+    break;
+#else
+    // the int8 matrix multiplies need int8 weights.
+    return kAxonResultFailureInputOutOfRange;
+#endif
+  default:
+    return kAxonResultFailureInputOutOfRange;
+  }
+  grnn_state_info.hidden_state_width = hidden_state_width;
+  return kAxonResultSuccess;
+}
+
+/*
+ * converts the q4.11 input features to the int8 input scale.
+ */
+static void grnn_quantize_input_int8(const AudioInputFeatureType *audio_features_in) {
+  const uint8_t shift = GRNN_INPUT_HIDDEN_Q-GRNN_INT8_LAYER_SCALES[kGrnnLayerInputHiddenFc].input_q;
+  for (uint8_t ndx=0;ndx<GRNN_INPUT_HT;ndx++) {
+    int32_t value = (audio_features_in[ndx] + (1<<(shift-1))) >> shift;
+    buff_i8[ndx] = value > INT8_MAX ? INT8_MAX : value < INT8_MIN ? INT8_MIN : value;
+  }
+}
+
+/*
+ * saturates h(t) to int8 and brings it back, so the next slice sees exactly the int8 state.
+ */
+static void grnn_requantize_hidden_int8() {
+  for (uint8_t ndx=0;ndx<GRNN_HIDDEN_HT;ndx++) {
+    int32_t value = buff_h32[ndx];
+    buff_h8[ndx] = value > INT8_MAX ? INT8_MAX : value < INT8_MIN ? INT8_MIN : value;
+    buff_h32[ndx] = buff_h8[ndx];
+  }
 }
 
 /*
  * forward declaration
  */
 static void  grnn_slice_ops_done_callback(AxonResultEnum result, void *callback_context);
+
+#if DEBUG_VECTORS_GRNN_UNIT > 1
+/*
+ * DEBUG! runs the int8 slice ops one at a time so the results can be compared to ground truth.
+ * None of them are memcpys, so the last one is queued on its own to get the on-complete callback.
+ */
+static AxonResultEnum grnn_process_frame_int8_debug() {
+  AxonResultEnum result;
+  print_int8_vector(grnn_state_info.axon_handle, "int8 h(t-1)", buff_h8, GRNN_HIDDEN_HT);
+  for (uint32_t ndx=kGrnnAxonInt8PerFrameOpFirst; ndx<kGrnnAxonInt8PerFrameOpCount; ndx++) {
+    if ((ndx+1)==kGrnnAxonInt8PerFrameOpCount) {
+      // last operation, queue it up.
+      grnn_queued_ops.op_handle_list = grnn_int8_perframe_op_handles + ndx;
+      grnn_queued_ops.callback_function = grnn_slice_ops_done_callback;
+      grnn_queued_ops.callback_context = NULL;
+      grnn_queued_ops.op_handle_count = 1;
+      return AXON_KWS_STATS_QUEUE_OPS_LIST(grnn_state_info.axon_handle,&grnn_queued_ops);
+    }
+
+    // intermediate operation, execute synchronously
+    if (kAxonResultSuccess>(result=AXON_KWS_STATS_EXECUTE_OPS(grnn_state_info.axon_handle, 1, grnn_int8_perframe_op_handles + ndx, kAxonAsyncModeSynchronous))) {
+      return result; // error!
+    }
+
+    switch (ndx) {
+    case kGrnnAxonInt8OpInputWeightsMatrixMult:
+      print_int32_vector(grnn_state_info.axon_handle, "int8 X(t) dot Wf", buff_z32, GRNN_INPUT_WT_HT, 1); break;
+    case kGrnnAxonInt8OpHiddenWeightsMatrixMult:
+      print_int32_vector(grnn_state_info.axon_handle, "int8 h(t-1) dot Wh", buff_h_hat32, GRNN_HIDDEN_WT_HT, 1); break;
+    case kGrnnAxonInt8OpInputPlusHiddenXpy:
+      print_int32_vector(grnn_state_info.axon_handle, "int8 Input+Hidden", buff_tmp32, GRNN_HIDDEN_WT_HT, 1); break;
+    case kGrnnAxonInt8OpAddInputBiasXpySigmoid:
+      print_int32_vector(grnn_state_info.axon_handle, "int8 Z(t)", buff_z32, GRNN_HIDDEN_WT_HT, 1); break;
+    case kGrnnAxonInt8OpAddHiddenBiasXpySigmoid:
+      print_int32_vector(grnn_state_info.axon_handle, "int8 h_hat(t)", buff_h_hat32, GRNN_HIDDEN_WT_HT, 1); break;
+    case kGrnnAxonInt8OpHiddenTimesZXty:
+      print_int32_vector(grnn_state_info.axon_handle, "int8 Z(t) x h(t-1)", buff_h32, GRNN_HIDDEN_WT_HT, 1); break;
+    case kGrnnAxonInt8Op1MinusZAxpb:
+      print_int32_vector(grnn_state_info.axon_handle, "int8 1-Z(t)", buff_z32, GRNN_HIDDEN_WT_HT, 1); break;
+    case kGrnnAxonInt8Op1MinusZTimesHXty:
+      print_int32_vector(grnn_state_info.axon_handle, "int8 (1-Z(t)) x h_hat", buff_z32, GRNN_HIDDEN_WT_HT, 1); break;
+    default:
+      break;
+    }
+  }
+  return kAxonResultFailure; // not reached, the last op is always queued.
+}
+#endif
 /*
  * API function to calculate the hidden vector for each audio frame.
  */
@@ -377,6 +685,21 @@ AxonResultEnum grnn_process_frame() {
     // get the slice data
     AxonKwsHostGetNextAudioFeatureSlice(&audio_features_in);
 
+    if (kAxonDataWidth8==grnn_state_info.hidden_state_width) {
+      grnn_quantize_input_int8(audio_features_in);
+#if (DEBUG_VECTORS_GRNN_UNIT > 0)
+      print_int8_vector(grnn_state_info.axon_handle, "int8 audio_features_input", buff_i8, GRNN_INPUT_HT);
+#endif
+#if DEBUG_VECTORS_GRNN_UNIT > 1
+      return grnn_process_frame_int8_debug();
+#endif
+      grnn_queued_ops.op_handle_list = grnn_int8_perframe_op_handles + kGrnnAxonInt8PerFrameOpFirst;
+      grnn_queued_ops.callback_function = grnn_slice_ops_done_callback;
+      grnn_queued_ops.callback_context = NULL;
+      grnn_queued_ops.op_handle_count = kGrnnAxonInt8PerFrameOpCount;
+      return AXON_KWS_STATS_QUEUE_OPS_LIST(grnn_state_info.axon_handle, &grnn_queued_ops);
+    }
+
     memcpy(buff_i, audio_features_in, GRNN_INPUT_HT * sizeof(AudioInputFeatureType) );
 
 
@@ -405,11 +728,11 @@ AxonResultEnum grnn_process_frame() {
       grnn_queued_ops.callback_function = grnn_slice_ops_done_callback;
       grnn_queued_ops.callback_context = NULL;
       grnn_queued_ops.op_handle_count = 1;
-      return AxonApiQueueOpsList(grnn_state_info.axon_handle,&grnn_queued_ops);
+      return AXON_KWS_STATS_QUEUE_OPS_LIST(grnn_state_info.axon_handle,&grnn_queued_ops);
     }
 
     // intermediate operation, execute synchronously
-    if (kAxonResultSuccess>(result=AxonApiExecuteOps(grnn_state_info.axon_handle, op_cnt, grnn_perframe_op_handles + ndx, kAxonAsyncModeSynchronous))) {
+    if (kAxonResultSuccess>(result=AXON_KWS_STATS_EXECUTE_OPS(grnn_state_info.axon_handle, op_cnt, grnn_perframe_op_handles + ndx, kAxonAsyncModeSynchronous))) {
       return result; // error!
     }
 
@@ -446,7 +769,7 @@ AxonResultEnum grnn_process_frame() {
   grnn_queued_ops.callback_function = grnn_slice_ops_done_callback;
   grnn_queued_ops.callback_context = NULL;
   grnn_queued_ops.op_handle_count = kGrnnAxonPerFrameOpCount;
-  return AxonApiQueueOpsList(grnn_state_info.axon_handle, &grnn_queued_ops);
+  return AXON_KWS_STATS_QUEUE_OPS_LIST(grnn_state_info.axon_handle, &grnn_queued_ops);
 
 #endif
 
@@ -459,13 +782,19 @@ AxonResultEnum AxonKwsModelGrnnInfer(uint8_t slice_count) {
   grnn_state_info.slice_ndx = 0;
 
   // clear out the hidden vector before starting.
-  memset(buff_h, 0, sizeof(buff_h));
+  memset(buff_h, 0, GRNN_HIDDEN_HT*sizeof(grnn_weight_type));
+  memset(buff_h8, 0, GRNN_HIDDEN_HT*sizeof(int8_t));
+  memset(buff_h32, 0, sizeof(buff_h32));
 
   return grnn_process_frame();
 }
 
 
 static void  grnn_result_ops_done_callback(AxonResultEnum result, void *callback_context) {
+  if (kAxonDataWidth8==grnn_state_info.hidden_state_width) {
+    // both widths produce q.11 scores; narrow them so the classification doesn't care which ran.
+    AxonApiCopySaturateVector(kAxonDataWidth24to16, buff_final_outputs, buff_final_outputs32, GRNN_CLASS_COUNT, 0);
+  }
   // call the callers callback
   grnn_state_info.result_callback_function(result);
 }
@@ -475,11 +804,32 @@ static void  grnn_result_ops_done_callback(AxonResultEnum result, void *callback
  * start final classification after all slices have been processed.
  */
 static AxonResultEnum grnn_calculate_results() {
+  if (kAxonDataWidth8==grnn_state_info.hidden_state_width) {
+#if DEBUG_VECTORS_GRNN_FINAL > 1
+    // DEBUG! run the final matrix multiply on its own so its result can be examined.
+    AxonResultEnum result;
+    if (kAxonResultSuccess>(result=AXON_KWS_STATS_EXECUTE_OPS(grnn_state_info.axon_handle, 1, grnn_int8_final_op_handles+kGrnnAxonInt8OpFinalWeightsMatrixMult, kAxonAsyncModeSynchronous))) {
+      return result; // error!
+    }
+    print_int32_vector(grnn_state_info.axon_handle, "int8 h(t) x w_final", buff_final_outputs32, GRNN_CLASS_COUNT, 1);
+    grnn_queued_ops.op_handle_list = grnn_int8_final_op_handles+kGrnnAxonInt8OpFinalBiasesXpy;
+    grnn_queued_ops.callback_function = grnn_result_ops_done_callback;
+    grnn_queued_ops.callback_context = NULL;
+    grnn_queued_ops.op_handle_count = kGrnnAxonInt8OpFinalCount-kGrnnAxonInt8OpFinalBiasesXpy;
+    return AXON_KWS_STATS_QUEUE_OPS_LIST(grnn_state_info.axon_handle,&grnn_queued_ops);
+#endif
+    grnn_queued_ops.op_handle_list = grnn_int8_final_op_handles;
+    grnn_queued_ops.callback_function = grnn_result_ops_done_callback;
+    grnn_queued_ops.callback_context = NULL;
+    grnn_queued_ops.op_handle_count = kGrnnAxonInt8OpFinalCount;
+    return AXON_KWS_STATS_QUEUE_OPS_LIST(grnn_state_info.axon_handle,&grnn_queued_ops);
+  }
   // run the operations
 #if DEBUG_VECTORS_GRNN_FINAL > 1
   /*
    * DEBUG! ONE AT A TIME SO WE CAN EXAMINE RESULTS!
    */
+  AxonResultEnum result;
   uint8_t op_cnt;
   for (uint32_t ndx=kGrnnAxonOpFinalFirst; ndx<kGrnnAxonOpFinalCount; ndx+=op_cnt) {
     /*
@@ -491,16 +841,16 @@ static AxonResultEnum grnn_calculate_results() {
 
     if ((ndx+op_cnt)==kGrnnAxonOpFinalCount) {
       // last operartion, queue it up.
-      grnn_queued_ops.op_handle_list = grnn_perframe_op_handles + ndx;
+      grnn_queued_ops.op_handle_list = grnn_final_op_handles + ndx;
       grnn_queued_ops.callback_function = grnn_result_ops_done_callback;
       grnn_queued_ops.callback_context = NULL;
       grnn_queued_ops.op_handle_count = op_cnt;
-      return AxonApiQueueOpsList(grnn_state_info.axon_handle,&grnn_queued_ops);
+      return AXON_KWS_STATS_QUEUE_OPS_LIST(grnn_state_info.axon_handle,&grnn_queued_ops);
     }
 
 
     // intermediate operation, execute synchronously
-    if (kAxonResultSuccess>(result=AxonApiExecuteOps(grnn_state_info.axon_handle, op_cnt, grnn_final_op_handles+ndx, kAxonAsyncModeSynchronous))) {
+    if (kAxonResultSuccess>(result=AXON_KWS_STATS_EXECUTE_OPS(grnn_state_info.axon_handle, op_cnt, grnn_final_op_handles+ndx, kAxonAsyncModeSynchronous))) {
       break; // error!
     }
 
@@ -515,13 +865,14 @@ static AxonResultEnum grnn_calculate_results() {
       break;
     }
   }
+  return result;
 #else
   // do them all at once
   grnn_queued_ops.op_handle_list = grnn_final_op_handles;
   grnn_queued_ops.callback_function = grnn_result_ops_done_callback;
   grnn_queued_ops.callback_context = NULL;
   grnn_queued_ops.op_handle_count = kGrnnAxonOpFinalCount;
-  return AxonApiQueueOpsList(grnn_state_info.axon_handle,&grnn_queued_ops);
+  return AXON_KWS_STATS_QUEUE_OPS_LIST(grnn_state_info.axon_handle,&grnn_queued_ops);
 
 #endif
 }
@@ -530,9 +881,16 @@ static AxonResultEnum grnn_calculate_results() {
  * called when slice ops are complete
  */
 static void  grnn_slice_ops_done_callback(AxonResultEnum result, void *callback_context) {
+  if (kAxonDataWidth8==grnn_state_info.hidden_state_width) {
+    grnn_requantize_hidden_int8();
+  }
 #if DEBUG_VECTORS_GRNN_UNIT > 0
   if (kAxonResultSuccess==grnn_state_info.result) {
-    print_int16_vector(grnn_state_info.axon_handle, "h(t)", buff_h, GRNN_HIDDEN_HT, 1);
+    if (kAxonDataWidth8==grnn_state_info.hidden_state_width) {
+      print_int8_vector(grnn_state_info.axon_handle, "int8 h(t)", buff_h8, GRNN_HIDDEN_HT);
+    } else {
+      print_int16_vector(grnn_state_info.axon_handle, "h(t)", buff_h, GRNN_HIDDEN_HT, 1);
+    }
   }
 #endif
 
@@ -72,6 +72,32 @@ extern const int32_t GRNN_INPUT_NORMALIZATION_INV_STDS_0Q7[];
   #define GRNN_FINAL_FC_WEIGHT_RIGHT_SHIFT 10
 #endif
 
+/*
+ * In the default 16 bit path the input features and hidden state are q4.11.
+ */
+#define GRNN_INPUT_HIDDEN_Q 11
+
+/*
+ * Per-layer scales for the int8 hidden state path (see AxonKwsModelGrnnSetHiddenStateWidth()).
+ * Each layer's output rounding is input_q+weights_q-output_q.
+ * The input and hidden products are added, so they share a q factor.
+ * For the hidden update "weights" are the gates (z and 1-z), which the sigmoids produce as q1.8.
+ */
+typedef enum {
+  kGrnnLayerInputHiddenFc, // x*W + h(t-1)*U, output must match the q of the input/hidden biases
+  kGrnnLayerHiddenUpdate,  // h(t) = z*h(t-1) + (1-z)*h_hat
+  kGrnnLayerFinalFc,       // h(t) * W_final, output must match the q of the final biases
+  kGrnnLayerCount,
+} GrnnLayerEnum;
+
+typedef struct {
+  uint8_t input_q;
+  uint8_t weights_q;
+  uint8_t output_q;
+} GrnnLayerScaleStruct;
+
+extern const GrnnLayerScaleStruct GRNN_INT8_LAYER_SCALES[kGrnnLayerCount];
+
 
 extern const int32_t GRNN_CLASSIFICATION_UNKNOWN_NDX;
 
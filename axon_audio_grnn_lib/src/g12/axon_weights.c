@@ -60,8 +60,12 @@ const uint8_t kInputAndHiddenBiasRightShift = INPUT_AND_HIDDEN_BIAS_RIGHT_SHIFT;
 #endif
 const uint8_t kGrnnInputFcWeightsQ = GRNN_INPUT_FC_WEIGHTS_Q;
 
+/*
+ * int8 weight tables are read directly by the int8 hidden state MatrixMults, and kAxonDataWidth8
+ * buffers must be 16 byte aligned.
+ */
 #if GRNN_8_BIT_SYMMETRIC_QUANT
-const grnn_weight_flash_type _Alignas(8) GRNN_INPUT_FC_WEIGHTS[GRNN_INPUT_WT_HT][GRNN_INPUT_HT] = {
+const grnn_weight_flash_type _Alignas(16) GRNN_INPUT_FC_WEIGHTS[GRNN_INPUT_WT_HT][GRNN_INPUT_HT] = {
     {5,19,9,9,32,-11,22,11,-51,-31,-42,-19,-6,-35,5,-15,11,6,-18,12,26,9,-23,-6,3,-3,-13,-5,-3,-6,-7,-14},
     {-12,17,-2,-10,-86,-49,-59,23,27,35,64,17,20,39,42,46,12,-38,-42,-32,-24,-26,-6,-7,7,-21,0,7,36,17,-20,20},
     {23,11,-11,11,2,19,14,33,37,-11,-41,-17,-28,-17,44,59,-4,-21,-14,-13,-20,-9,0,-12,26,14,17,-2,-5,-14,-24,-46},
@@ -381,7 +385,7 @@ const grnn_weight_type _Alignas(8) GRNN_INPUT_FC_BIAS[GRNN_INPUT_WT_HT] = {
 const uint8_t kGrnnHiddenFcWeightsQ = GRNN_HIDDEN_FC_WEIGHTS_Q;
 
 #if GRNN_8_BIT_SYMMETRIC_QUANT
-const grnn_weight_flash_type _Alignas(8) GRNN_HIDDEN_FC_WEIGHTS[GRNN_HIDDEN_WT_HT][GRNN_HIDDEN_HT] = {
+const grnn_weight_flash_type _Alignas(16) GRNN_HIDDEN_FC_WEIGHTS[GRNN_HIDDEN_WT_HT][GRNN_HIDDEN_HT] = {
     {7,-31,-41,-34,40,10,-12,-6,-32,14,16,13,-25,-13,-5,21,-46,-20,-14,30,-2,-35,-28,9,0,24,21,11,45,-36,-15,-5,27,-2,-5,-8,-3,15,20,-18,-15,10,2,-52,-21,16,-20,-14,-36,19,-22,61,12,1,-34,8,35,26,-6,-23,-30,23,14,-44,3,-9,35,-28,-3,14,14,21,-31,-12,-37,-5,1,11,-21,-27,-23,8,-23,-1,-30,20,-10,-33,16,3,24,-17,-38,36,-1,58,-17,-1,-8,22},
     {-27,-58,9,-25,33,10,-6,33,-13,48,-15,26,38,-39,27,7,-5,49,41,-5,25,-38,-33,-17,25,-12,61,11,-13,47,-5,45,19,-1,19,-5,-19,1,53,67,22,-55,19,26,-49,-36,-28,7,20,45,-1,-23,60,-27,23,10,-46,-4,-30,12,11,10,-17,-48,-16,12,-19,-6,-43,23,-39,-1,-1,-23,20,18,-25,64,40,-19,18,25,22,-28,-27,-34,-6,-59,3,32,-62,-5,22,-7,-69,55,-6,9,3,0},
     {22,-13,-8,9,-19,21,-16,32,-19,3,-57,10,35,36,-33,73,31,4,-44,0,13,-11,-39,-26,17,85,-29,9,47,79,34,1,-36,-10,-18,10,-3,-16,11,-22,-6,-57,32,-1,18,-2,22,-29,-34,-36,-34,-21,-8,24,-9,12,-5,-12,0,1,-22,-8,15,-16,22,-38,-59,46,11,2,-12,21,11,13,-3,-33,24,-17,-15,-5,-3,-52,12,-44,-11,16,29,-21,9,-24,15,39,-21,41,-2,-7,5,43,-1,-20},
@@ -692,7 +696,7 @@ const grnn_weight_type _Alignas(8) GRNN_HIDDEN_FC_BIAS[GRNN_HIDDEN_WT_HT] = {
   };
 
 #if GRNN_8_BIT_SYMMETRIC_QUANT
-const grnn_weight_flash_type _Alignas(8) GRNN_FINAL_FC_WEIGHTS[GRNN_FINAL_FC_HEIGHT][GRNN_FINAL_FC_WIDTH] = {
+const grnn_weight_flash_type _Alignas(16) GRNN_FINAL_FC_WEIGHTS[GRNN_FINAL_FC_HEIGHT][GRNN_FINAL_FC_WIDTH] = {
     /*
      * @FIXME! INSERTING A BLANK SILENCE ROW HERE BECAUSE ROW COUNT NEEDS TO BE EVEN!!!
      */
@@ -742,6 +746,7 @@ const grnn_weight_type _Alignas(8) GRNN_FINAL_FC_WEIGHTS[GRNN_FINAL_FC_HEIGHT][G
 #else
 #define GRNN_FINAL_FC_BIAS_SHIFT 5
 #endif
+#define GRNN_FINAL_FC_WEIGHTS_Q (GRNN_FINAL_FC_WEIGHT_RIGHT_SHIFT-GRNN_FINAL_FC_BIAS_SHIFT)
 const grnn_weight_type _Alignas(8) GRNN_FINAL_FC_BIAS[GRNN_FINAL_FC_HEIGHT] = {
     /*
      * @FIXME! INSERTING A BLANK SILENCE ROW HERE BECAUSE ROW COUNT NEEDS TO BE EVEN!!!
@@ -761,6 +766,21 @@ const grnn_weight_type _Alignas(8) GRNN_FINAL_FC_BIAS[GRNN_FINAL_FC_HEIGHT] = {
 };
 const int32_t GRNN_CLASSIFICATION_UNKNOWN_NDX = 1;
 
+/*
+ * int8 hidden state scales. x and h are q2.5, which covers +/-4 standard deviations of the
+ * normalized features and the 0..1 range of h. FC outputs stay q.11 to match the biases.
+ * W*x and U*h(t-1) are rounded to the output q separately and then added, so both products
+ * need the same weights q.
+ */
+#if GRNN_8_BIT_SYMMETRIC_QUANT
+static_assert(GRNN_INPUT_FC_WEIGHTS_Q==GRNN_HIDDEN_FC_WEIGHTS_Q, "int8 input and hidden weights must share a q factor");
+#endif
+const GrnnLayerScaleStruct GRNN_INT8_LAYER_SCALES[kGrnnLayerCount] = {
+  [kGrnnLayerInputHiddenFc] = { .input_q=5, .weights_q=GRNN_HIDDEN_FC_WEIGHTS_Q, .output_q=11-INPUT_AND_HIDDEN_BIAS_RIGHT_SHIFT },
+  [kGrnnLayerHiddenUpdate]  = { .input_q=5, .weights_q=8, .output_q=5 },
+  [kGrnnLayerFinalFc]       = { .input_q=5, .weights_q=GRNN_FINAL_FC_WEIGHTS_Q, .output_q=11-GRNN_FINAL_FC_BIAS_SHIFT },
+};
+
 /*
  * not only are the strings pointed to by this array constant, the array itself is too.
  */
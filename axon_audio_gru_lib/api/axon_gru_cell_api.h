@@ -0,0 +1,118 @@
+/**
+ *          Copyright (c) 2020-2022, Atlazo Inc.
+ *          All rights reserved.
+ *
+ *          Licensed under the Apache License, Version 2.0 (the "License");
+ *          you may not use this file except in compliance with the License.
+ *          You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *          Unless required by applicable law or agreed to in writing, software
+ *          distributed under the License is distributed on an "AS IS" BASIS,
+ *          WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *          See the License for the specific language governing permissions and
+ *          limitations under the License.
+ *
+ */
+#pragma once
+
+#include <assert.h>
+#include "axon_api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * GRU cell, the counterpart of AxonApiDefineOpListLstmCellWithStopStep() built from discrete axon ops.
+ * Gates follow the "reset after" form (the Keras/TFLite default):
+ *   z = sigmoid(Wz*x + Uz*h + bz)
+ *   r = sigmoid(Wr*x + Ur*h + br)
+ *   n = tanh(Wn*x + bin + r*(Un*h + bhn))
+ *   h = n + z*(h - n)
+ * which lets every product come from one matrix multiply over the int8 [x;h] vector, with weights
+ * stacked as 4*hidden_length rows:
+ *   [Wz|Uz], [Wr|Ur], [Wn|0], [0|Un]
+ * The zero blocks cost hidden_length*input_length multiply-accumulates but keep the cell to a single matrix multiply.
+ *
+ * Formats:
+ * - x and h are int8 with hidden_q fractional bits (hidden_q <= 8).
+ * - the matrix multiply output is rounded by weights_rounding to the q of the biases.
+ * - biased gate inputs are rounded by gate_rounding to q7.8, the activations return q1.8.
+ *
+ * Buffers:
+ * - gru_xh_buffer: int8 [x;h], 16 byte aligned. The caller writes x before each slice, and h from
+ *   ht_buff with AxonGruCellSaturateHiddenState() after each slice.
+ * - gru_buf1: 4*hidden_length, scratch for the gates. Doesn't need to be retained between slices.
+ * - gru_buf2: 4*hidden_length, bias copy. Only needed if axon can't read gru_bias where it is, otherwise can be NULL.
+ * - ht_buff: hidden_length, 24 bit h(t) in hidden_q. Retained between slices and cleared at the start of a window.
+ */
+typedef enum {
+  kGruDontStop,
+  kGruDotProd,          /**< [x;h]*W into gru_buf1 */
+  kGruAfGateZtRt,       /**< z and r, gru_buf1[0:2*hidden_length] */
+  kGruCandidateBiasAdd, /**< Wn*x+bin and Un*h+bhn, gru_buf1[2*hidden_length:4*hidden_length] */
+  kGruXtYRtHn,          /**< r*(Un*h+bhn), gru_buf1[3*hidden_length:] */
+  kGruAfCandidateNt,    /**< n, gru_buf1[2*hidden_length:3*hidden_length] */
+  kGruAxpbyHtMinusNt,   /**< h-n, gru_buf1[3*hidden_length:] */
+  kGruXtYZtHtMinusNt,   /**< z*(h-n), gru_buf1[3*hidden_length:] */
+  kGruXpYHt,            /**< h(t) in ht_buff */
+} AxonGruCellStopStepEnum;
+
+/*
+ * most op handles a gru cell uses.
+ */
+#define AXON_GRU_CELL_MAX_OP_CNT 9
+
+/*
+ * Defines a list of axon operations for a single gru cell on axon.
+ */
+AxonResultEnum AxonGruCellDefineOpListWithStopStep(void *axon_handle,
+    uint16_t input_length,              /**< features+hidden_length. Must be a multiple of 16 */
+    uint16_t hidden_length,             /**< must be a multiple of 4, and 2*hidden_length <= 512 */
+    int8_t *gru_xh_buffer,              /**< int8 [x;h], 16 byte aligned */
+    const int8_t *gru_weights,          /**< 4*hidden_length rows of input_length as above. Must be in RAM and 16 byte aligned */
+    const int32_t *gru_bias,            /**< bz, br, bin, bhn, 4*hidden_length in the q of the rounded matrix multiply */
+    uint8_t weights_rounding,           /**< rounds the matrix multiply output to the q of the biases */
+    uint8_t gate_rounding,              /**< rounds the biased gate inputs to q7.8 */
+    AxonAfEnum activation_function,     /**< n, nominally kAxonAfTanh */
+    AxonAfEnum recurrent_activation_function, /**< z and r, nominally kAxonAfSigmoid */
+    uint8_t hidden_q,                   /**< fractional bits of x and h */
+    int32_t *gru_buf1,
+    int32_t *gru_buf2,
+    int32_t *ht_buff,
+    uint16_t buf1_length,               /**< must be >= 4*hidden_length */
+    uint16_t buf2_length,               /**< must be >= 4*hidden_length if gru_buf2 is needed */
+    uint16_t ht_buff_length,            /**< must be >= hidden_length */
+    AxonOpHandle *axon_op_handles,
+    uint8_t *op_handle_cnt,             /**< Provided by the user as the length of axon_op_handles, returned with the number of handles actually used.*/
+    AxonGruCellStopStepEnum stop_step); /**< for bit-exact testing, can stop defining ops after this step */
+
+/*
+ * Saturates h(t) to int8 into the h half of gru_xh_buffer for the next slice, and writes the
+ * saturated values back to ht_buff so the next slice's update sees exactly what the matrix multiply did.
+ */
+void AxonGruCellSaturateHiddenState(int32_t *ht_buff, int8_t *xh_hidden, uint16_t hidden_length);
+
+/*
+ * Set to 1, in the library's and the application's builds, to build AxonGruCellReferenceCheck() and have the
+ * demo run it at prepare. Its parameters take about 16KB of RAM.
+ */
+#ifndef AXON_GRU_CELL_REFERENCE_CHECK
+# define AXON_GRU_CELL_REFERENCE_CHECK 0
+#endif
+
+#if AXON_GRU_CELL_REFERENCE_CHECK
+/*
+ * Runs the window in axon_gru_cell_reference.h (generated by axon_tools/gru_reference) through a gru cell,
+ * one synchronous slice at a time, and returns the largest difference between the final h(t) and the
+ * reference tool's in max_difference. The op handles are freed before returning.
+ * The driver's sigmoid and tanh aren't published, so a difference of an LSB or so is expected.
+ */
+AxonResultEnum AxonGruCellReferenceCheck(void *axon_handle, int32_t *max_difference);
+#endif
+
+#ifdef __cplusplus
+} // extern "C" {
+#endif
@@ -0,0 +1,253 @@
+/**
+ *          Copyright (c) 2020-2022, Atlazo Inc.
+ *          All rights reserved.
+ *
+ *          Licensed under the Apache License, Version 2.0 (the "License");
+ *          you may not use this file except in compliance with the License.
+ *          You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *          Unless required by applicable law or agreed to in writing, software
+ *          distributed under the License is distributed on an "AS IS" BASIS,
+ *          WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *          See the License for the specific language governing permissions and
+ *          limitations under the License.
+ *
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include "axon_api.h"
+#include "axon_dep.h"
+#include "axon_logging_api.h"
+#include "axon_gru_cell_api.h"
+
+/*
+ * longest vector a single axon op takes.
+ */
+#define GRU_CELL_MAX_VECTOR_LENGTH 512
+
+/*
+ * true if ops for step are to be defined.
+ */
+#define GRU_CELL_DEFINE_STEP(step) ((kGruDontStop==stop_step) || (stop_step >= (step)))
+
+AxonResultEnum AxonGruCellDefineOpListWithStopStep(void *axon_handle,
+    uint16_t input_length,
+    uint16_t hidden_length,
+    int8_t *gru_xh_buffer,
+    const int8_t *gru_weights,
+    const int32_t *gru_bias,
+    uint8_t weights_rounding,
+    uint8_t gate_rounding,
+    AxonAfEnum activation_function,
+    AxonAfEnum recurrent_activation_function,
+    uint8_t hidden_q,
+    int32_t *gru_buf1,
+    int32_t *gru_buf2,
+    int32_t *ht_buff,
+    uint16_t buf1_length,
+    uint16_t buf2_length,
+    uint16_t ht_buff_length,
+    AxonOpHandle *axon_op_handles,
+    uint8_t *op_handle_cnt,
+    AxonGruCellStopStepEnum stop_step) {
+  AxonResultEnum result;
+  AxonInputStruct axon_input;
+  const int32_t *bias = gru_bias;
+  uint8_t op_ndx = 0;
+  uint8_t ops_needed;
+
+  if ((NULL==gru_xh_buffer) || (NULL==gru_weights) || (NULL==gru_bias) || (NULL==gru_buf1) || (NULL==ht_buff) ||
+      (NULL==axon_op_handles) || (NULL==op_handle_cnt)) {
+    return kAxonResultFailureNullBuffer;
+  }
+  // int8 rows in RAM are multiples of 16, and 24 bit vector ops need even lengths.
+  if ((input_length & 15) || (0==hidden_length) || (hidden_length & 3) || (input_length <= hidden_length) ||
+      (2*hidden_length > GRU_CELL_MAX_VECTOR_LENGTH)) {
+    return kAxonResultFailureInvalidLength;
+  }
+  if (hidden_q > 8) {
+    return kAxonResultFailureInputOutOfRange;
+  }
+  if (((uint32_t)gru_xh_buffer & 15) || ((uint32_t)gru_weights & 15)) {
+    return kAxonResultFailureUnalignedBuffer;
+  }
+  if (!AxonHostAddressAvailableToAxon((uint32_t)gru_weights)) {
+    // the matrix multiply reads the weights in place, unlike the fully connected op list it doesn't copy rows from flash.
+    axon_printf(axon_handle, "gru weights must be in RAM\r\n");
+    return kAxonResultFailureInputOutOfRange;
+  }
+  if ((buf1_length < 4*hidden_length) || (ht_buff_length < hidden_length)) {
+    return kAxonResultBufferTooSmall;
+  }
+
+  // count the ops first so nothing is defined if there aren't enough handles.
+  ops_needed = 0;
+  for (uint8_t step=kGruDotProd;step<=kGruXpYHt;step++) {
+    if (GRU_CELL_DEFINE_STEP(step)) {
+      ops_needed++;
+    }
+  }
+  if (!AxonHostAddressAvailableToAxon((uint32_t)gru_bias) && GRU_CELL_DEFINE_STEP(kGruAfGateZtRt)) {
+    // biases are copied into gru_buf2 each slice
+    if (NULL==gru_buf2) {
+      return kAxonResultFailureNullBuffer;
+    }
+    if (buf2_length < 4*hidden_length) {
+      return kAxonResultBufferTooSmall;
+    }
+    bias = gru_buf2;
+    ops_needed++;
+  }
+  if (*op_handle_cnt < ops_needed) {
+    *op_handle_cnt = ops_needed;
+    return kAxonResultBufferTooSmall;
+  }
+
+  axon_input.data_packing = kAxonDataPackingEnabled;
+  axon_input.output_af = kAxonAfDisabled;
+  axon_input.x_stride = kAxonStride1;
+  axon_input.y_stride = kAxonStride1;
+  axon_input.q_stride = kAxonStride1;
+
+  // [x;h] * W => [z|r|Wn*x|Un*h]
+  axon_input.data_width = kAxonDataWidth8;
+  axon_input.length = input_length;
+  axon_input.y_length = 4*hidden_length;
+  axon_input.x_in = (int32_t *)gru_xh_buffer;
+  axon_input.y_in = (const int32_t *)gru_weights;
+  axon_input.output_rounding = kAxonRoundingNone+weights_rounding;
+  axon_input.q_out = gru_buf1;
+  if (kAxonResultSuccess > (result=AxonApiDefineOpMatrixMult32BitOutput(axon_handle, &axon_input, axon_op_handles+op_ndx))) {
+    return result;
+  }
+  op_ndx++;
+
+  // everything from here on is 24 bit
+  axon_input.data_width = kAxonDataWidth24;
+  axon_input.data_packing = kAxonDataPackingDisabled;
+  axon_input.y_length = 0;
+
+  if (GRU_CELL_DEFINE_STEP(kGruAfGateZtRt)) {
+    if (bias != gru_bias) {
+      axon_input.length = 4*hidden_length;
+      axon_input.x_in = gru_bias;
+      axon_input.output_rounding = kAxonRoundingNone;
+      axon_input.q_out = gru_buf2;
+      if (kAxonResultSuccess > (result=AxonApiDefineOpMemCpy(axon_handle, &axon_input, axon_op_handles+op_ndx))) {
+        AxonApiFreeOpHandles(axon_handle, op_ndx, axon_op_handles);
+        return result;
+      }
+      op_ndx++;
+    }
+    // z, r = af(gates + bz, br)
+    axon_input.length = 2*hidden_length;
+    axon_input.x_in = gru_buf1;
+    axon_input.y_in = bias;
+    axon_input.output_rounding = kAxonRoundingNone+gate_rounding;
+    axon_input.output_af = recurrent_activation_function;
+    axon_input.q_out = gru_buf1; // q1.8
+    if (kAxonResultSuccess > (result=AxonApiDefineOpXpy(axon_handle, &axon_input, axon_op_handles+op_ndx))) {
+      AxonApiFreeOpHandles(axon_handle, op_ndx, axon_op_handles);
+      return result;
+    }
+    op_ndx++;
+  }
+
+  if (GRU_CELL_DEFINE_STEP(kGruCandidateBiasAdd)) {
+    // Wn*x + bin, Un*h + bhn
+    axon_input.length = 2*hidden_length;
+    axon_input.x_in = gru_buf1+2*hidden_length;
+    axon_input.y_in = bias+2*hidden_length;
+    axon_input.output_rounding = kAxonRoundingNone;
+    axon_input.output_af = kAxonAfDisabled;
+    axon_input.q_out = gru_buf1+2*hidden_length;
+    if (kAxonResultSuccess > (result=AxonApiDefineOpXpy(axon_handle, &axon_input, axon_op_handles+op_ndx))) {
+      AxonApiFreeOpHandles(axon_handle, op_ndx, axon_op_handles);
+      return result;
+    }
+    op_ndx++;
+  }
+
+  axon_input.length = hidden_length;
+  if (GRU_CELL_DEFINE_STEP(kGruXtYRtHn)) {
+    // r*(Un*h + bhn), r is q1.8
+    axon_input.x_in = gru_buf1+hidden_length;
+    axon_input.y_in = gru_buf1+3*hidden_length;
+    axon_input.output_rounding = kAxonRoundingNone+8;
+    axon_input.output_af = kAxonAfDisabled;
+    axon_input.q_out = gru_buf1+3*hidden_length;
+    if (kAxonResultSuccess > (result=AxonApiDefineOpXty(axon_handle, &axon_input, axon_op_handles+op_ndx))) {
+      AxonApiFreeOpHandles(axon_handle, op_ndx, axon_op_handles);
+      return result;
+    }
+    op_ndx++;
+  }
+
+  if (GRU_CELL_DEFINE_STEP(kGruAfCandidateNt)) {
+    // n = af(Wn*x + bin + r*(Un*h + bhn))
+    axon_input.x_in = gru_buf1+2*hidden_length;
+    axon_input.y_in = gru_buf1+3*hidden_length;
+    axon_input.output_rounding = kAxonRoundingNone+gate_rounding;
+    axon_input.output_af = activation_function;
+    axon_input.q_out = gru_buf1+2*hidden_length; // q1.8
+    if (kAxonResultSuccess > (result=AxonApiDefineOpXpy(axon_handle, &axon_input, axon_op_handles+op_ndx))) {
+      AxonApiFreeOpHandles(axon_handle, op_ndx, axon_op_handles);
+      return result;
+    }
+    op_ndx++;
+  }
+
+  if (GRU_CELL_DEFINE_STEP(kGruAxpbyHtMinusNt)) {
+    // h - n, with h brought up to q.8
+    axon_input.x_in = ht_buff;
+    axon_input.y_in = gru_buf1+2*hidden_length;
+    axon_input.a_in = 1<<(8-hidden_q);
+    axon_input.b_in = -1;
+    axon_input.output_rounding = kAxonRoundingNone;
+    axon_input.output_af = kAxonAfDisabled;
+    axon_input.q_out = gru_buf1+3*hidden_length;
+    if (kAxonResultSuccess > (result=AxonApiDefineOpAxpby(axon_handle, &axon_input, axon_op_handles+op_ndx))) {
+      AxonApiFreeOpHandles(axon_handle, op_ndx, axon_op_handles);
+      return result;
+    }
+    op_ndx++;
+  }
+
+  if (GRU_CELL_DEFINE_STEP(kGruXtYZtHtMinusNt)) {
+    // z*(h - n)
+    axon_input.x_in = gru_buf1;
+    axon_input.y_in = gru_buf1+3*hidden_length;
+    axon_input.output_rounding = kAxonRoundingNone+8;
+    axon_input.q_out = gru_buf1+3*hidden_length;
+    if (kAxonResultSuccess > (result=AxonApiDefineOpXty(axon_handle, &axon_input, axon_op_handles+op_ndx))) {
+      AxonApiFreeOpHandles(axon_handle, op_ndx, axon_op_handles);
+      return result;
+    }
+    op_ndx++;
+  }
+
+  if (GRU_CELL_DEFINE_STEP(kGruXpYHt)) {
+    // h = n + z*(h - n), back to hidden_q
+    axon_input.x_in = gru_buf1+2*hidden_length;
+    axon_input.y_in = gru_buf1+3*hidden_length;
+    axon_input.output_rounding = kAxonRoundingNone+8-hidden_q;
+    axon_input.q_out = ht_buff; // saturated to int8 by AxonGruCellSaturateHiddenState()
+    if (kAxonResultSuccess > (result=AxonApiDefineOpXpy(axon_handle, &axon_input, axon_op_handles+op_ndx))) {
+      AxonApiFreeOpHandles(axon_handle, op_ndx, axon_op_handles);
+      return result;
+    }
+    op_ndx++;
+  }
+
+  *op_handle_cnt = op_ndx;
+  return kAxonResultSuccess;
+}
+
+void AxonGruCellSaturateHiddenState(int32_t *ht_buff, int8_t *xh_hidden, uint16_t hidden_length) {
+  for (uint16_t ndx=0;ndx<hidden_length;ndx++) {
+    xh_hidden[ndx] = ht_buff[ndx] > INT8_MAX ? INT8_MAX : ht_buff[ndx] < INT8_MIN ? INT8_MIN : ht_buff[ndx];
+    ht_buff[ndx] = xh_hidden[ndx];
+  }
+}
@@ -0,0 +1,91 @@
+/**
+ *          Copyright (c) 2020-2022, Atlazo Inc.
+ *          All rights reserved.
+ *
+ *          Licensed under the Apache License, Version 2.0 (the "License");
+ *          you may not use this file except in compliance with the License.
+ *          You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *          Unless required by applicable law or agreed to in writing, software
+ *          distributed under the License is distributed on an "AS IS" BASIS,
+ *          WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *          See the License for the specific language governing permissions and
+ *          limitations under the License.
+ *
+ */
+#include <stdint.h>
+#include <string.h>
+#include "axon_api.h"
+#include "axon_gru_cell_api.h"
+
+#if AXON_GRU_CELL_REFERENCE_CHECK
+#include "axon_gru_cell_reference.h"
+
+/*
+ * buffers for the reference cell, only needed while the check runs.
+ */
+static _Alignas(16) int8_t gru_cell_reference_xh_buffer[GRU_CELL_REFERENCE_INPUT_LENGTH];
+static int32_t gru_cell_reference_buf1[4*GRU_CELL_REFERENCE_HIDDEN_LENGTH];
+static int32_t gru_cell_reference_buf2[4*GRU_CELL_REFERENCE_HIDDEN_LENGTH];
+static int32_t gru_cell_reference_ht_buff[GRU_CELL_REFERENCE_HIDDEN_LENGTH];
+
+AxonResultEnum AxonGruCellReferenceCheck(void *axon_handle, int32_t *max_difference) {
+  AxonResultEnum result;
+  AxonOpHandle op_handles[AXON_GRU_CELL_MAX_OP_CNT];
+  uint8_t op_handle_cnt = AXON_GRU_CELL_MAX_OP_CNT;
+
+  result = AxonGruCellDefineOpListWithStopStep(
+      axon_handle,
+      GRU_CELL_REFERENCE_INPUT_LENGTH,
+      GRU_CELL_REFERENCE_HIDDEN_LENGTH,
+      gru_cell_reference_xh_buffer,
+      gru_cell_reference_weights[0],
+      gru_cell_reference_bias,
+      GRU_CELL_REFERENCE_WEIGHTS_ROUNDING,
+      GRU_CELL_REFERENCE_GATE_ROUNDING,
+      kAxonAfTanh,
+      kAxonAfSigmoid,
+      GRU_CELL_REFERENCE_HIDDEN_Q,
+      gru_cell_reference_buf1,
+      gru_cell_reference_buf2,
+      gru_cell_reference_ht_buff,
+      sizeof(gru_cell_reference_buf1)/sizeof(gru_cell_reference_buf1[0]),
+      sizeof(gru_cell_reference_buf2)/sizeof(gru_cell_reference_buf2[0]),
+      GRU_CELL_REFERENCE_HIDDEN_LENGTH,
+      op_handles,
+      &op_handle_cnt,
+      kGruDontStop);
+  if (kAxonResultSuccess != result) {
+    return result;
+  }
+
+  // h(0) is 0
+  memset(gru_cell_reference_xh_buffer, 0, sizeof(gru_cell_reference_xh_buffer));
+  memset(gru_cell_reference_ht_buff, 0, sizeof(gru_cell_reference_ht_buff));
+
+  for (uint8_t slice=0;slice<GRU_CELL_REFERENCE_SLICE_CNT;slice++) {
+    memcpy(gru_cell_reference_xh_buffer, gru_cell_reference_input[slice], GRU_CELL_REFERENCE_FEATURE_CNT);
+    if (kAxonResultSuccess > (result=AxonApiExecuteOps(axon_handle, op_handle_cnt, op_handles, kAxonAsyncModeSynchronous))) {
+      break;
+    }
+    AxonGruCellSaturateHiddenState(gru_cell_reference_ht_buff,
+        gru_cell_reference_xh_buffer+GRU_CELL_REFERENCE_FEATURE_CNT, GRU_CELL_REFERENCE_HIDDEN_LENGTH);
+  }
+  AxonApiFreeOpHandles(axon_handle, op_handle_cnt, op_handles);
+  if (kAxonResultSuccess > result) {
+    return result;
+  }
+
+  *max_difference = 0;
+  for (uint8_t ndx=0;ndx<GRU_CELL_REFERENCE_HIDDEN_LENGTH;ndx++) {
+    int32_t difference = gru_cell_reference_ht_buff[ndx] - gru_cell_reference_hidden[ndx];
+    difference = difference < 0 ? -difference : difference;
+    if (difference > *max_difference) {
+      *max_difference = difference;
+    }
+  }
+  return kAxonResultSuccess;
+}
+#endif
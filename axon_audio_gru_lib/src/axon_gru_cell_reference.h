@@ -0,0 +1,309 @@
+/**
+ *          Copyright (c) 2020-2022, Atlazo Inc.
+ *          All rights reserved.
+ *
+ *          Licensed under the Apache License, Version 2.0 (the "License");
+ *          you may not use this file except in compliance with the License.
+ *          You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *          Unless required by applicable law or agreed to in writing, software
+ *          distributed under the License is distributed on an "AS IS" BASIS,
+ *          WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *          See the License for the specific language governing permissions and
+ *          limitations under the License.
+ *
+ */
+/*
+ * Generated by axon_tools/gru_reference (seed 1). Test parameters for AxonGruCellReferenceCheck(),
+ * not a trained model.
+ */
+#include <stdint.h>
+#pragma once
+#define GRU_CELL_REFERENCE_SLICE_CNT 61
+#define GRU_CELL_REFERENCE_FEATURE_CNT 32
+#define GRU_CELL_REFERENCE_INPUT_LENGTH 80
+#define GRU_CELL_REFERENCE_HIDDEN_LENGTH 48
+#define GRU_CELL_REFERENCE_HIDDEN_Q 5
+#define GRU_CELL_REFERENCE_WEIGHTS_ROUNDING 3
+#define GRU_CELL_REFERENCE_GATE_ROUNDING 0
+/*
+ * [Wz|Uz], [Wr|Ur], [Wn|0], [0|Un]. Read in place by axon, so these stay in RAM.
+ */
+static _Alignas(16) int8_t gru_cell_reference_weights[4*GRU_CELL_REFERENCE_HIDDEN_LENGTH][GRU_CELL_REFERENCE_INPUT_LENGTH] = {
+{-5,3,5,4,-2,-13,7,-10,-13,-12,-10,-12,8,19,-7,-14,8,-11,-7,6,9,2,-7,0,-7,10,8,17,-2,12,8,-15,-17,13,17,16,6,4,7,10,13,1,-15,3,-16,2,3,-11,-11,7,-9,-6,0,-1,11,17,-2,20,12,10,8,20,4,15,-4,3,-14,16,1,-2,-15,-12,-11,5,5,0,-11,18,17,-9},
+{17,2,5,-1,0,-13,1,-8,-10,20,16,10,18,-6,-3,-11,13,15,2,20,-1,11,-6,0,-9,-7,9,4,-2,7,18,-10,-20,9,6,12,-5,8,-8,10,19,11,-3,-12,6,-12,18,-13,6,-14,11,-16,15,-18,16,-10,10,-7,20,-5,-16,-17,2,3,-14,9,-12,18,-12,-12,14,13,5,-4,16,13,-5,1,-15,1},
+{-15,-10,15,-6,-3,12,-17,-20,9,4,-1,-14,12,16,-4,-20,-5,-7,-13,15,-2,17,9,-20,-3,15,1,5,-20,7,7,-17,14,16,-4,16,-1,-18,-16,13,7,-7,11,-2,-11,-3,-4,6,2,17,-8,-10,12,2,12,7,-10,9,-8,-1,15,-17,-11,-9,-6,8,17,-7,-5,-18,-9,-10,-3,6,16,10,-14,20,-13,9},
+{8,-1,-17,9,-8,-12,13,9,14,3,-14,-5,3,-17,-15,-16,-10,-8,18,19,10,11,8,20,-8,-13,-6,-4,-15,11,17,-20,-10,-11,11,4,5,-12,14,11,17,-17,3,2,12,17,17,1,-9,3,3,7,-7,-15,-7,-19,10,16,8,-5,0,-8,-3,-18,16,1,-8,-1,-15,18,-13,4,7,-8,5,-16,7,19,10,0},
+{-11,11,-13,-12,12,0,-13,3,5,-20,-20,-18,-7,-18,11,11,-14,11,-6,-16,-12,-19,-5,11,-7,-16,7,12,6,13,-5,1,-14,8,-15,12,2,-8,0,18,-8,20,0,16,-2,-11,-8,18,-1,8,-17,-9,20,20,-12,-5,-8,20,-10,10,18,10,2,-16,-11,17,7,15,-16,-10,-18,17,1,-20,9,2,-6,-11,2,-12},
+{16,3,-4,-15,16,-5,5,-5,9,4,14,13,12,-1,-3,12,1,17,7,2,10,19,-9,8,7,19,-12,-16,-13,-16,4,19,-12,-16,10,-6,-10,-3,-7,12,-4,9,-1,13,-18,-3,-7,6,17,3,2,3,-3,18,-9,15,19,-7,12,1,3,10,-10,-3,16,-14,1,4,15,-6,-14,18,19,2,-19,-18,17,9,17,16},
+{-16,-6,-15,-20,-15,1,-9,-14,-9,12,18,-10,-18,0,8,-2,-16,-10,12,-11,20,-6,17,-10,-17,-16,-8,-20,6,-5,2,15,14,11,-12,18,10,10,6,-12,7,-17,-14,18,-20,9,6,4,2,20,-10,12,-12,-12,-3,-9,4,-9,-14,6,9,-8,-12,-20,-12,3,-17,11,-12,-14,-4,10,6,-19,-16,-7,-3,-9,5,-18},
+{-6,-1,8,11,5,20,-7,-10,-19,-1,-5,-14,15,17,-5,11,7,7,14,1,-3,17,-2,10,-19,-11,-1,-1,3,16,0,16,1,-19,13,-9,3,2,-12,9,-3,6,14,-10,15,-17,16,0,-2,-11,-18,2,5,-3,-18,-20,-18,-4,-12,-8,16,4,6,10,6,19,-7,8,13,-4,20,3,2,-10,-2,-13,-10,-3,4,-3},
+{9,-15,-18,-13,-1,-7,10,2,11,-11,5,-18,-18,14,2,-5,-20,10,17,15,1,15,-13,-2,9,-8,-11,-17,14,17,-15,-5,-4,-14,-7,20,1,3,13,5,20,10,-7,18,-13,-20,16,5,-15,-19,-5,-13,-8,19,8,10,12,-12,-3,9,7,15,19,-9,15,-10,-7,-9,15,-7,-18,-11,13,9,14,1,-2,-13,1,-7},
+{-12,-4,-11,13,13,16,2,7,1,16,16,2,-10,15,7,1,18,-6,-11,-18,-13,-15,-18,11,9,14,8,-1,-12,-8,19,-12,2,16,-9,3,0,-3,2,0,7,9,-2,-7,5,-16,-14,-8,-12,-19,-6,-19,4,11,-15,10,-6,5,4,11,-20,-15,16,-12,14,-20,-6,16,2,1,-14,-7,2,5,8,11,-10,20,8,-15},
+{12,8,16,-11,11,-13,13,-17,-3,5,-8,6,18,-12,-6,17,-14,13,6,9,-8,-20,-2,16,-4,-3,-17,-10,16,-16,2,-20,1,13,5,9,6,-8,7,3,-16,-7,-5,-13,9,-8,2,-8,16,20,10,4,15,-18,-3,-1,10,8,-11,-6,7,-4,13,-20,-4,11,-11,16,-1,-1,-14,-15,-8,-6,16,16,-6,13,10,9},
+{12,10,-7,-13,16,-12,18,0,-15,15,11,-2,4,-10,-15,13,20,-4,13,12,11,-6,-9,8,-1,8,-19,-15,-19,-7,8,12,10,-11,8,-2,-3,13,-4,-12,-12,-1,-18,15,6,19,16,14,-19,-17,16,-9,-7,4,6,-2,10,-16,-12,-9,19,14,7,-6,12,0,-3,11,13,-6,-13,-17,0,20,-5,-2,19,4,-1,-6},
+{-14,-3,9,-4,-20,-7,-12,3,1,1,14,9,15,-15,-16,14,-17,-12,12,-20,3,17,18,-1,-2,-18,-9,18,-2,3,-18,-8,1,-12,-10,7,-19,-14,16,-3,-11,-9,14,-10,7,-7,8,15,13,-4,19,-4,9,5,-16,-17,-8,4,-13,-5,-14,-17,-16,-12,-9,18,12,16,-14,20,17,-14,-15,0,-5,14,7,6,-16,-7},
+{-18,17,1,8,-9,-12,17,-4,2,-11,-2,-6,7,-16,-2,15,13,4,9,-18,17,-18,7,0,2,-8,-10,-6,3,18,-10,-6,-16,16,-19,8,-13,10,6,0,-9,-3,16,-19,7,-11,-9,-17,4,14,15,-11,-16,-5,16,-9,4,-2,11,3,14,9,1,20,10,9,-16,16,4,-11,12,-5,-7,-6,4,18,-20,-17,-4,6},
+{-15,-9,9,7,16,-11,5,7,7,-3,-2,7,-18,19,-9,9,18,20,7,14,-16,-3,-4,3,20,-9,19,-5,14,6,6,-18,-18,-5,13,-16,19,18,2,-11,20,4,15,15,-5,7,-12,15,-3,-10,14,-18,-16,4,8,16,-19,-16,11,18,13,-9,14,0,16,-10,7,-16,20,6,-2,-10,-16,-1,-5,-5,-7,20,7,-10},
+{-3,-11,8,13,-10,8,-2,-2,2,-18,-3,16,-15,-9,-10,-11,-15,-6,-1,-19,3,14,2,5,-2,11,18,4,-16,9,-8,14,-4,-7,-4,1,-3,15,-13,-17,2,17,-13,-6,1,1,1,10,-11,-4,-10,-15,-11,-17,8,10,-18,19,1,-2,-9,13,11,-2,9,-17,17,15,13,7,-6,-11,6,-20,-16,-14,-17,-12,-8,10},
+{14,-13,-5,1,-9,-20,-1,-12,-1,12,19,8,18,6,15,-17,8,-14,-8,-15,-5,10,-18,-7,-3,-16,11,8,-20,8,18,5,-5,16,20,-15,-3,10,7,3,20,-18,-11,-4,-2,2,-17,-16,-5,-7,15,2,16,-15,-11,7,11,9,-6,-20,-8,13,-8,4,7,-8,-6,11,11,1,-2,1,-4,-10,12,-2,-6,18,13,-20},
+{15,-16,-12,19,8,19,19,-2,-1,-20,8,0,4,6,19,-15,-17,4,13,0,2,18,9,-12,10,-5,14,11,0,4,-1,4,19,-17,-3,7,14,-17,-20,-16,-18,-15,7,5,-4,-10,18,-19,-8,0,-4,-5,0,-20,6,-1,-8,-11,19,-19,-1,-17,19,-4,19,10,1,-17,4,-16,-3,-6,14,9,-1,14,-18,-3,10,14},
+{18,5,8,2,-6,17,7,9,-5,-9,-12,-20,-14,2,1,4,-18,-5,3,9,-7,4,18,6,11,19,3,16,6,4,-3,-7,17,-9,-13,4,-9,-19,-16,-8,8,9,4,-8,-5,6,6,7,13,15,19,17,7,-17,16,-5,3,17,20,14,-4,-20,19,-2,-8,9,15,-11,18,-6,-19,6,-19,3,-16,-16,-13,-11,19,-3},
+{2,-1,15,13,7,10,8,-3,16,-8,14,-7,-4,4,-11,15,-18,-14,-13,17,6,-4,-9,-15,14,4,19,5,-16,-14,3,-20,1,-9,6,5,-10,-12,6,0,-2,2,20,-12,-18,-17,6,-17,15,-6,-18,11,-19,-10,17,2,12,15,-8,-16,-2,3,-10,-10,12,9,-13,-4,-7,15,17,9,12,19,8,19,0,-3,-16,2},
+{-13,14,2,-12,-16,-3,5,-15,15,14,19,-1,-19,-6,-5,16,7,14,0,2,-12,5,17,-5,-20,10,20,2,-10,-4,-9,-14,-16,1,2,1,-11,-11,6,-12,-19,-11,1,-14,-14,-20,5,19,-16,-6,6,-3,20,-18,15,-4,17,1,7,1,9,-12,15,-11,3,17,-20,-19,-20,-14,2,0,6,9,7,15,9,15,-1,18},
+{-17,14,16,16,6,-11,-14,-4,-11,15,7,-8,14,3,-1,-17,-10,17,1,-14,6,-8,-14,2,9,15,-20,-19,-16,-14,12,5,19,15,-14,-2,12,-8,-6,11,-7,-18,0,12,-18,-19,-19,-4,5,-14,-11,15,13,19,-20,-10,-4,13,15,-12,-12,-20,-6,14,14,0,-8,1,3,2,8,5,3,-20,-5,-10,-19,-12,-17,6},
+{-12,11,-7,-13,13,18,19,0,-16,-6,6,8,10,-18,18,4,7,-16,-10,9,11,-10,-19,-15,2,7,-17,10,-19,8,13,4,-1,0,-4,12,-5,-16,2,7,-8,-10,-3,9,19,-14,0,14,2,0,4,7,14,1,6,15,-15,9,2,-10,2,-3,-8,-18,18,-11,-10,-3,-13,17,13,-20,-13,18,-16,-14,17,-5,-1,-11},
+{12,-18,18,-16,3,-1,-7,9,4,-10,-17,-3,15,14,5,-10,-8,16,-4,0,-13,-19,10,-9,-8,13,4,13,-14,17,4,-14,9,-15,6,-17,-6,4,3,9,15,-5,6,-5,-12,15,20,-6,-11,11,19,-15,18,-14,6,-5,4,14,-18,-17,17,10,-6,-15,2,-19,-8,14,14,0,-17,-10,19,3,2,2,-17,-14,-19,6},
+{5,4,-5,0,1,-3,18,-6,-17,16,20,2,-18,-14,-20,-7,-9,-3,-15,14,-14,2,13,14,17,-16,-14,-18,-7,-5,3,-6,-4,16,3,8,-15,-9,-10,1,-9,5,-18,-16,16,-10,-17,14,6,8,13,11,19,-13,13,-12,-6,-8,10,-15,-20,0,-15,-16,7,20,-13,2,15,17,-17,4,16,5,-5,-19,8,-8,-14,13},
+{10,6,-12,-5,-17,8,16,6,-6,-13,10,19,1,-13,-15,-13,11,7,15,-19,10,2,8,-8,-8,-16,-14,6,-10,17,11,5,-14,14,-19,-11,18,4,-18,18,-7,0,15,5,15,13,4,-18,-11,10,-8,9,16,-9,11,9,-19,9,12,12,-5,4,-15,6,19,19,-9,-18,-9,15,1,-14,-12,-14,6,16,1,3,-7,-20},
+{9,-11,-9,-19,16,1,13,-16,-14,-11,-12,-9,-15,1,-17,-18,-18,7,-18,10,5,-6,12,0,12,3,15,-6,-12,-15,8,11,11,-10,6,20,-12,11,6,3,18,-8,-4,-8,-1,-6,15,6,-16,5,0,20,7,14,12,-1,15,-20,-11,12,19,-11,19,0,-15,-10,2,4,-5,-15,5,10,1,17,-13,6,-15,-13,-4,9},
+{-4,5,-8,2,-15,11,-17,-13,20,-6,1,-13,0,17,8,-16,5,9,19,-16,-20,20,-12,-17,-13,-3,6,-1,-15,6,-1,-15,16,11,7,-1,-6,-8,20,8,-1,-5,19,17,0,-6,10,6,-2,1,2,19,18,18,-14,-19,-5,-19,-14,-9,-3,7,16,6,17,10,2,6,17,-11,-6,4,-2,-2,5,17,3,3,-6,-17},
+{-7,-4,-2,11,-8,14,-17,10,-3,-3,6,6,-3,17,18,8,6,19,4,9,-10,-1,13,20,-3,-10,12,12,-11,-12,-7,-7,-6,16,-10,15,19,-16,-14,8,16,-12,10,-7,-16,14,-13,0,0,-9,-15,0,-11,11,-11,-12,-3,-20,7,11,8,5,-5,-9,-6,-15,6,2,1,4,3,3,-3,5,9,-1,-18,-14,-18,-20},
+{-8,4,-3,-9,8,-20,14,13,-10,-3,-19,10,12,-11,-17,14,-17,-19,-4,-8,6,0,3,-6,20,8,15,-15,-3,-9,6,4,-3,18,15,12,-18,-1,6,14,17,15,-10,14,-5,-3,-19,14,-5,-1,6,-19,0,-13,-18,1,-3,5,11,-13,-4,-8,-4,-17,-17,20,-18,-20,18,-6,-15,-8,-10,-12,-8,13,4,9,-7,-6},
+{-15,2,10,2,-12,10,-19,16,20,-18,12,-8,13,4,1,-11,6,-8,10,-18,11,-3,7,-3,13,14,3,-10,13,19,-14,-16,-5,-16,20,-19,-11,-13,7,1,2,8,13,13,-1,11,5,-17,3,14,1,-2,16,5,3,-8,3,-18,15,12,-6,11,4,10,17,16,19,9,-8,16,-4,8,-6,-1,-15,-1,-16,-19,-15,-4},
+{1,4,-8,-1,-17,-18,-12,-3,13,14,16,-19,-4,-16,1,-16,13,-10,3,11,-10,1,1,5,-18,-4,0,2,-11,13,-19,7,9,19,-1,14,13,16,15,9,18,-18,4,4,11,-4,-15,-12,-5,-9,-17,3,-7,1,-14,4,-8,15,-18,4,20,-2,18,-8,19,11,11,14,5,3,-16,-4,15,-20,17,3,-4,-1,-13,-13},
+{5,8,17,3,15,3,-8,-12,7,20,-9,-16,-10,5,-2,-10,-7,7,-13,7,14,9,-17,12,-16,0,18,-4,6,-9,10,-4,12,-20,-19,3,-3,8,8,12,-17,-18,2,-20,-15,-11,-9,16,16,4,-16,-16,15,-1,-10,-18,-20,12,1,10,-20,3,14,-9,7,-6,-1,-6,-11,7,-17,-14,7,-8,-13,7,-17,15,-16,-12},
+{14,7,-5,-10,-5,17,14,1,14,-10,19,10,-3,-4,2,-17,-12,19,-13,0,-8,0,5,-12,2,13,-3,2,11,12,-13,-1,13,0,-4,2,-20,18,-6,6,-9,-3,-4,-3,11,-15,-1,13,-7,-19,18,14,3,-2,4,10,-9,14,-19,13,-12,-13,-8,-14,2,-1,-14,13,8,18,1,-8,5,-1,14,12,3,-8,-8,4},
+{-11,-12,-12,17,1,0,-19,-5,-9,-3,5,-3,4,-4,2,-10,20,-11,2,-19,-20,-9,-14,20,11,-11,12,-6,-1,-15,20,18,7,-18,15,7,-1,6,15,17,-14,12,-7,8,14,-3,-1,-11,-7,14,13,18,-14,-6,-2,-13,2,-10,19,2,4,-16,-8,12,0,-5,-6,19,1,5,-15,-9,-4,10,-17,-7,11,-20,-12,-9},
+{-7,7,-10,-20,19,15,-2,17,-3,-10,15,5,9,12,2,15,6,12,9,-14,14,17,-8,19,-13,-19,-20,18,-10,1,-19,20,14,10,-5,0,2,-4,14,7,2,0,-15,-11,-5,-17,-7,-13,18,18,-3,13,-19,-10,14,-13,-16,-9,-8,-16,-3,16,-12,-9,17,-9,3,14,19,0,-16,20,3,-8,-13,-7,11,17,15,10},
+{-12,20,8,1,10,13,4,-6,20,2,1,16,-17,-8,-17,11,0,-6,2,5,2,-18,0,11,12,3,0,7,20,-7,-2,-12,5,-12,-19,10,-8,4,0,-20,6,-8,-17,-9,7,-8,10,-3,9,-9,-2,8,4,-6,-3,-18,19,-11,15,-7,18,-10,19,11,6,-6,-16,12,-2,-17,14,-1,18,-3,15,-4,-13,-12,-18,-1},
+{-5,17,4,6,-3,8,8,-4,12,4,9,0,7,-9,-4,8,10,-14,17,-11,-18,10,10,-5,-18,-13,-17,-18,14,6,-6,-4,0,-18,-17,16,-5,7,13,20,-6,-9,3,11,5,-8,-14,8,-16,11,1,4,15,20,-16,18,5,-5,5,0,-3,0,-19,-10,-15,7,-14,19,18,-5,-7,16,4,4,-6,18,5,-16,2,-19},
+{2,10,-19,-16,-16,14,11,14,-6,-19,-6,-20,-4,-9,-14,20,-10,9,19,-2,-7,-16,-6,1,18,-4,-16,-18,15,-17,-12,12,3,6,7,-18,-4,-11,-13,-8,-15,-13,1,4,14,12,-2,-5,19,-17,-19,-5,5,0,-3,-5,-13,-3,7,-3,-11,9,-5,13,3,-1,2,18,-14,-11,-16,18,-2,-14,-16,15,-2,15,17,7},
+{-10,9,12,17,-10,-3,-14,-16,10,-5,-4,3,18,-19,20,20,-5,-7,14,18,20,8,-16,1,1,0,0,4,3,6,-6,-14,12,13,15,5,-7,16,10,18,-6,19,13,3,-3,8,15,-8,-12,1,18,7,-14,8,-9,-15,-1,3,5,0,12,8,17,-11,4,-17,-14,-3,-8,8,-14,-4,9,7,2,4,3,-8,-2,15},
+{-6,8,-13,-11,-13,18,13,1,14,-17,-10,14,-12,16,-5,-1,14,6,4,-19,-2,-3,11,-7,18,-12,6,19,-16,-10,-10,13,-8,-20,-6,-7,2,3,8,-6,-17,20,14,-11,6,11,-18,-18,-12,20,6,-10,-2,18,-14,-5,3,-6,-2,20,-5,8,8,6,20,-16,-19,7,5,16,-17,-7,5,-2,19,11,0,20,14,-6},
+{5,-10,-18,-20,-3,14,9,6,-9,10,0,-15,-13,-9,8,-5,5,-11,16,-19,-18,14,5,18,-5,-14,20,9,17,-6,-15,18,-14,-15,3,16,-11,18,-11,-14,6,-15,-12,-4,-11,15,14,-14,-15,-14,3,-10,3,3,-2,6,18,-11,8,4,-6,2,-18,16,9,15,-15,4,-15,5,-6,-18,19,-15,11,17,-11,-10,9,6},
+{8,14,-19,-4,-2,6,-2,15,-13,-9,-7,0,8,-15,16,2,-10,-18,-16,11,-2,-3,-12,-15,-19,-11,0,-10,-2,1,13,12,18,11,19,3,9,12,14,-19,-19,-2,-3,-7,-4,-4,7,3,-3,-20,-1,-9,-6,3,12,12,-18,-12,-16,5,-9,-15,-20,14,-20,-19,4,3,-3,-3,13,-20,15,-11,18,2,-17,0,15,12},
+{-18,-19,17,-19,15,-9,-7,-2,9,18,13,-8,7,-1,-20,-12,11,0,-3,-7,19,-7,-10,-6,16,19,16,11,0,17,17,6,-13,-1,2,-19,5,-4,1,-16,16,2,7,3,-7,-19,1,17,9,5,-15,-6,-16,6,14,5,10,5,-9,-2,-20,-13,14,-19,13,8,19,5,-8,-10,2,-11,-19,19,11,-1,9,-18,3,19},
+{-6,5,-15,20,-6,4,-16,-12,-18,18,3,10,0,20,-13,-6,-20,-6,-5,-6,0,17,-3,-16,-11,11,-6,5,-19,14,6,-2,-8,-14,19,12,11,2,13,18,10,-20,14,-18,-2,1,-3,17,-19,-10,16,-16,12,-3,-5,-4,-20,-13,14,-3,5,17,-18,-17,-9,14,4,-17,-13,18,19,-2,-6,10,-7,8,2,17,-17,-3},
+{12,9,20,-15,-16,-1,7,4,-10,11,-20,5,3,14,12,12,-9,-7,-13,-19,-5,-16,-17,11,11,-11,16,16,2,-15,-10,-1,-13,13,-3,-5,-7,9,-15,-7,-3,12,16,16,-14,6,-4,-16,-12,13,5,-13,-12,18,4,-5,-7,-7,-1,6,7,-1,-9,-16,14,7,0,6,-1,16,15,20,-18,-19,-12,14,6,15,-15,-20},
+{-19,-16,-12,8,-13,-4,-10,-13,8,-14,18,1,5,-1,14,-13,6,18,0,1,-8,-12,10,-13,15,6,6,-6,-8,13,20,-14,-3,6,-7,17,20,-18,-1,-3,12,16,-5,-18,4,-16,0,11,-7,17,13,18,-12,2,11,7,-9,-5,-17,-17,-5,-20,-19,12,11,8,7,-15,3,-17,18,10,-16,-16,-5,20,-10,18,-18,-17},
+{-3,5,6,-19,-16,-20,13,8,-15,-19,15,1,4,-6,16,0,-8,-8,-2,-17,-6,-15,-4,-11,-8,1,-9,-3,19,-20,-20,15,-15,16,6,-19,-11,-19,18,15,17,-15,-4,-6,20,6,-4,-19,19,-1,-19,7,-13,-8,1,3,-3,-1,5,-11,-8,17,-1,-4,1,14,-7,-5,-4,-4,17,19,-9,1,-8,7,-14,-14,3,19},
+{-18,19,20,4,10,5,5,-6,15,2,6,4,-11,-19,4,13,12,6,-13,-2,0,13,18,6,-17,-8,-17,-9,10,-1,8,4,-2,-9,-4,-4,5,6,4,6,20,-2,17,6,2,-11,-13,8,14,1,11,15,-7,-14,14,-7,-19,3,3,13,-8,17,2,11,-19,3,-7,-6,-5,-9,-5,20,-20,20,-10,-16,-10,-13,-2,-2},
+{-6,14,-20,-4,20,-20,-8,0,-3,-5,-8,-5,-20,1,10,14,-7,10,-8,5,12,10,-15,12,10,15,-6,1,-7,-11,4,-6,0,13,1,17,-5,-8,9,-15,11,17,16,15,-10,-6,15,-9,-19,7,9,-18,2,-18,-1,-7,-8,-2,14,2,-16,9,-16,-3,-15,19,17,9,-19,3,-17,-15,9,18,-2,17,10,-12,-18,7},
+{-4,2,-14,-16,11,-13,5,17,-14,-19,-14,-12,-1,-19,1,-14,7,-13,-12,-10,2,19,-15,17,-9,16,3,-10,0,-10,-16,-8,-1,-15,3,7,14,2,3,17,-3,-10,-18,9,16,5,1,14,-11,2,19,13,9,4,15,-10,-4,5,-3,-9,-3,19,5,-8,-1,-17,13,18,-3,-14,-4,-4,-17,2,12,6,4,4,-15,-19},
+{5,-17,-13,-10,-2,-20,-6,-9,-20,-9,2,-12,-7,-20,-14,1,-4,-15,-10,15,-5,12,-13,-17,-6,-10,-18,3,-9,-14,-4,-13,11,-5,12,10,-20,20,14,-16,10,-3,14,12,-10,-13,15,4,-7,17,-15,-2,-4,-20,14,13,2,18,-12,-4,7,-5,15,11,-5,-19,2,-2,-10,-13,6,16,8,-3,8,6,17,18,5,-16},
+{-7,-12,-17,10,18,4,-6,13,5,-12,-2,-1,-3,1,-15,-7,-7,-18,-19,-4,19,1,-2,-15,-12,13,10,1,5,10,13,-5,-9,15,-1,13,-20,9,20,17,12,20,-13,9,8,13,8,4,2,14,7,17,0,-13,14,13,15,-3,1,0,-15,12,-19,-11,-12,19,13,18,8,9,2,-20,-15,-15,-14,-12,-2,2,5,-14},
+{19,-6,-8,-15,-10,-18,13,-1,16,-19,10,-15,-7,12,-5,12,5,6,13,2,-20,7,7,11,-12,16,6,1,-14,-12,11,-12,5,-10,-18,-10,-9,15,-6,-8,9,3,-17,2,-20,10,-15,10,-2,18,10,10,12,-8,-9,-5,-17,7,6,11,2,12,7,-6,-12,6,3,16,10,0,-20,7,-3,1,17,18,3,-11,18,-7},
+{-6,13,-2,-8,8,-17,-10,16,-17,-3,16,-2,6,4,-12,-10,10,0,10,-8,10,0,11,19,-10,16,-5,-12,-6,4,18,4,-10,-12,-4,-17,-18,-6,15,20,18,9,14,-3,3,-15,13,-7,3,13,5,-15,-14,-13,-16,-2,-13,-15,-18,-20,-11,9,-12,12,20,14,-18,-18,-6,-17,0,-14,2,-13,-5,16,15,-1,3,15},
+{18,-1,-18,1,-2,-19,3,5,-8,13,15,-3,-1,1,-14,-9,-4,-6,15,2,-7,-9,-2,-9,-10,-16,-5,-16,6,-4,-17,-12,-6,-16,-9,14,-11,-18,10,0,10,-19,-4,7,-19,0,4,-19,-6,-12,18,-7,-14,3,0,19,13,5,13,-19,-3,-8,-13,-20,1,-18,11,8,1,-17,-16,5,-20,6,-8,-8,10,-7,20,-4},
+{18,-17,-15,8,-18,-16,12,-1,-10,14,12,8,-11,11,-14,-11,1,3,-4,-9,-5,-1,14,-2,5,1,-16,20,8,3,11,19,-6,-2,-14,0,20,-10,-1,-2,-19,-9,12,-20,18,-6,7,-9,-3,-5,4,-18,11,-20,-11,-1,-10,8,13,13,-4,18,17,-1,9,-11,5,16,-17,-8,13,-7,1,12,-5,0,-13,-16,6,19},
+{-17,-11,14,-14,-1,-14,-6,12,14,2,-11,-7,6,-5,0,4,15,20,-17,14,-3,-9,-12,19,4,14,-4,17,11,17,10,-14,-4,-13,-19,2,-10,-14,-16,20,-9,-15,14,13,-19,16,-17,4,-2,-18,-4,4,0,17,3,10,-11,18,-19,-9,13,18,10,-14,3,-13,6,1,4,18,-11,-1,0,1,-15,-18,4,9,15,-3},
+{15,20,-13,3,-17,-6,7,2,-19,13,-12,-10,-14,17,5,12,-10,-15,13,-10,-10,-2,11,14,13,19,-9,13,1,-20,-16,11,17,-6,8,10,19,15,20,10,15,0,-19,4,2,18,20,-12,19,2,-13,-8,-4,-9,-5,5,2,-5,18,12,16,20,-16,-11,-13,20,17,-5,14,-19,-2,-3,-12,-18,-1,-19,15,13,7,4},
+{9,-7,-4,11,7,6,-1,-18,-8,5,11,11,5,-14,17,17,18,-20,-6,-2,15,-5,14,8,9,11,9,-19,14,13,-15,18,3,0,-20,12,8,-5,-14,-15,18,-16,-18,12,-9,-3,-9,18,-3,-4,19,13,10,18,9,-3,13,-14,-3,14,4,7,-5,-9,-2,20,5,-19,16,4,12,20,-6,17,-20,-4,-7,1,-15,16},
+{-3,2,4,11,-18,-5,-5,-20,7,13,16,12,14,7,4,4,13,18,-16,-4,-10,3,-6,17,14,14,0,-6,8,4,10,5,-1,-15,-12,20,10,0,-16,-14,-16,-19,13,-8,-3,-4,17,13,-7,-3,6,-12,-11,5,-17,-6,-5,17,13,-6,14,17,4,-11,12,-12,-15,9,10,-3,-5,19,-4,-10,-12,20,-20,0,10,18},
+{-18,0,12,10,4,-2,-3,-2,19,2,-1,13,-10,1,-6,-5,8,1,2,-2,19,-8,-16,3,-1,1,20,3,7,-16,-7,0,-6,-14,10,-6,18,9,-5,3,-3,-8,17,14,3,-6,16,-4,-5,-1,-3,5,-11,-18,-20,15,0,-19,-20,-16,7,3,-8,-13,-9,-20,-10,9,19,-1,14,-6,-5,4,15,8,13,15,-9,-6},
+{-9,8,-10,-1,5,0,15,-19,14,-13,0,16,17,11,2,-6,-3,8,-9,13,3,9,0,12,-18,12,-11,15,0,-18,12,15,-18,-4,14,9,-19,10,16,9,-13,-1,12,-13,-6,-2,-4,-3,7,-18,19,-6,-20,-18,-13,-17,0,10,-18,2,-1,-1,-1,-8,-20,10,9,16,-20,-5,2,-8,18,16,-7,5,-5,20,16,20},
+{-10,-14,-10,7,20,1,-7,10,5,6,-6,1,-2,-8,-3,9,15,1,12,2,6,-4,6,-14,1,8,-1,-13,-15,18,3,7,17,3,9,8,13,18,18,2,-1,4,17,19,-6,-14,-13,8,-19,15,-11,8,15,12,15,8,17,1,-9,-19,-3,-9,13,-2,15,15,18,6,-10,-7,7,-7,8,4,16,-6,-20,20,-18,20},
+{3,14,11,-16,0,17,16,-18,-14,7,4,17,-13,3,13,-5,-15,-1,-5,7,8,-5,4,4,-12,-6,6,10,-10,2,2,10,-13,-1,10,-13,12,-9,4,-1,3,6,-10,6,11,15,12,-18,2,11,-4,-19,18,-13,0,-15,7,5,18,18,-17,-2,10,-8,-13,3,0,-8,7,9,-10,-4,-9,13,20,2,-8,19,-8,-4},
+{-7,9,-10,-7,10,-16,18,9,-3,-15,10,-13,-2,17,12,-17,20,-20,-17,-15,-19,-9,-5,17,8,-2,-20,-7,-6,13,12,8,4,7,-6,20,-3,18,-4,1,2,4,5,-12,-20,9,-4,-5,7,18,6,18,17,17,-8,-20,15,-12,-15,-10,-5,19,-7,-12,-9,-2,-5,-20,12,-8,5,-11,13,14,-17,-12,5,-4,-16,18},
+{-14,-1,-1,1,9,-5,11,-18,-7,-19,-16,2,-1,-18,13,7,18,-8,-18,1,9,20,19,-20,15,-16,1,15,2,18,-3,1,5,18,5,12,4,-16,-9,-11,1,-7,-12,-13,5,0,-8,19,-13,18,-10,-12,-13,18,1,20,-14,16,4,20,-3,-19,-20,-14,-5,10,20,-5,-2,16,-11,-14,5,-14,17,12,10,10,14,8},
+{-3,-6,10,-4,-13,12,-5,2,12,-4,10,16,7,-17,-11,-3,-9,-1,9,19,3,16,-11,6,2,4,-15,-11,6,7,-8,14,15,19,-15,2,-1,-1,-10,8,-15,2,-10,1,-15,-19,2,-17,-2,14,18,1,18,12,-17,0,14,-6,-19,20,-13,6,-12,13,10,1,-9,-3,-19,-6,-17,20,-20,-12,19,2,-14,-9,-1,13},
+{-6,-10,12,12,-7,1,3,-15,-10,-3,-1,-17,-1,-7,-5,-8,-9,14,16,7,-14,17,1,-5,-17,19,-16,-9,9,3,1,6,-20,-16,-1,12,-7,-1,-13,20,-4,-18,7,1,-16,-13,-9,7,16,-19,8,-6,-14,18,14,6,2,-3,12,-17,19,4,18,-4,-2,-2,6,-3,13,16,-16,-15,2,19,13,-3,-17,-17,-9,-7},
+{0,0,-13,-7,-2,-8,0,-15,-10,-12,20,19,-13,-3,15,-9,-7,14,9,7,-19,4,3,13,11,13,16,14,-18,-15,5,-9,18,5,19,-18,10,7,-1,14,-3,15,17,6,1,3,-6,-13,4,4,-10,18,18,16,2,-14,-6,-8,-13,-4,17,11,-1,-4,16,10,-6,1,-13,1,-6,14,6,4,16,-20,14,-17,-5,4},
+{20,4,-17,-6,16,-18,10,0,2,7,-17,7,-18,5,-9,-6,-20,0,-14,16,-2,18,-19,7,-4,-2,-6,12,14,5,-18,-12,-8,7,-3,1,15,-7,-16,0,-14,-4,-7,6,-8,20,-2,14,-18,-14,-19,7,16,-6,-16,-18,20,5,-19,-9,-5,5,-12,-10,-16,-20,5,14,-14,-5,6,-1,-17,-13,8,20,8,2,1,19},
+{-4,-14,-16,2,-15,16,-1,0,13,-13,-3,-9,5,19,-15,17,-4,12,-2,13,-14,-4,9,10,14,-15,-11,3,-4,-20,14,-12,-3,4,-9,2,16,19,-15,7,2,-19,-2,-10,8,-4,2,13,2,-3,18,-2,-15,12,-12,5,6,7,4,20,-3,7,8,-1,18,-5,-12,7,4,-18,14,0,-8,7,-17,3,5,-3,3,-19},
+{2,-20,2,-5,-9,5,-14,2,-13,-12,3,-7,5,-18,5,9,7,4,-11,3,-4,-19,19,-13,-1,13,6,-3,9,-15,-17,-1,-1,-6,-7,18,-20,-12,-7,2,8,10,-11,6,-10,-13,18,5,2,18,-18,-12,7,14,2,-18,2,-19,-10,-10,0,5,-12,5,-17,-12,13,20,6,-7,15,-3,-5,-3,3,-13,-3,-10,11,3},
+{12,5,4,-11,12,-19,-8,4,-14,-17,7,0,-8,-6,12,14,13,-16,-20,12,-15,15,-12,10,18,1,4,-8,14,-20,-5,-11,-20,-17,-1,0,12,-6,-19,17,5,0,5,1,1,10,-13,-10,5,20,3,11,8,-9,13,6,-9,-17,15,-5,15,-16,17,-8,-6,4,12,4,9,-5,-5,19,6,14,-16,19,10,4,-5,8},
+{-11,-18,-11,9,-10,-19,9,-3,-14,-13,-6,8,-19,-20,-17,14,17,15,-3,11,-6,2,-7,-19,-9,-13,16,-9,-9,-2,8,-12,17,-12,-12,-16,11,11,4,6,19,-13,8,-1,-2,-6,7,-4,16,-16,-6,6,-16,3,18,-3,-17,-12,-6,10,-9,15,-11,-17,-13,-1,3,-14,3,-10,16,19,9,18,19,2,-14,-20,0,-13},
+{3,-18,-19,8,4,-6,-15,-19,-17,-19,3,2,-3,4,11,2,-11,3,-4,-20,17,-5,-16,-9,-2,-8,19,-18,-16,19,7,19,11,10,4,-20,-2,6,20,5,10,-5,9,16,-20,15,14,1,16,3,10,16,14,12,-4,-11,19,2,-1,-14,-1,19,-14,-3,-20,-18,-8,5,-5,-10,-13,-9,11,-7,11,12,-6,2,-3,-8},
+{-8,-20,14,11,20,0,-16,-1,12,-15,5,18,0,16,-1,18,8,13,19,-2,15,-14,-3,14,-13,17,18,12,5,19,11,20,-13,5,19,2,1,8,-5,-18,20,-8,-11,8,15,13,-17,3,20,-9,-11,-6,15,-20,17,-19,-3,-2,6,1,18,-13,1,8,17,13,2,-3,-10,-6,-4,20,-4,-18,-10,-14,-5,8,5,-19},
+{-9,4,-5,-14,0,-14,9,-5,2,8,7,19,8,18,10,15,0,2,6,14,0,-2,-7,0,-16,-5,12,-7,-15,-14,-14,-2,13,20,0,-1,11,-14,-7,4,-17,5,-8,-14,8,-8,16,-13,20,-14,7,-15,2,-20,19,17,2,16,-19,4,20,16,1,-14,-19,-13,-4,-5,2,12,13,-14,20,-8,-4,-17,-18,13,-10,20},
+{3,13,0,0,7,12,2,12,17,15,18,16,-13,-3,-7,4,-1,-9,9,-16,5,10,-18,12,-18,-13,-8,-16,13,6,-3,6,-9,-2,-1,11,5,-12,-18,-16,8,-12,13,20,-18,-1,18,-14,-18,15,-6,11,19,-3,9,-18,-14,-8,-12,14,-7,3,7,19,3,-12,-16,9,17,16,3,-7,6,-11,14,1,0,17,13,-7},
+{-4,14,10,-4,10,6,0,-7,5,-20,-13,13,-9,-11,5,15,-6,1,4,-2,-13,-14,18,-8,20,-1,-15,4,9,-7,10,20,-19,-20,-7,7,6,1,14,-6,-17,-16,-13,5,17,-10,4,-17,-5,-5,-11,-15,11,10,-13,12,18,-12,20,18,-15,20,7,13,17,-14,10,-4,9,-12,2,-16,-5,3,-7,12,13,12,-1,-10},
+{-15,11,-11,-20,-6,8,-7,3,0,-2,0,19,-13,-15,-2,4,5,-4,-7,-16,17,3,-14,-10,7,-18,-10,-10,-8,13,15,-12,1,0,-1,-19,-6,-14,13,6,-9,18,-20,-10,-6,15,19,17,4,8,6,17,-15,-5,-9,-6,15,-8,18,-1,4,3,-14,-19,5,15,9,1,6,-12,7,-19,12,-17,-4,-15,-19,-3,-6,12},
+{-3,17,-13,6,-16,-12,11,19,-9,-6,20,19,9,8,-2,-1,12,11,5,12,-18,4,-18,20,15,8,-10,14,-19,-12,-20,-3,18,-4,-20,-9,19,10,-9,-2,5,9,-12,-14,-13,15,-15,-10,-5,-9,-6,19,-3,7,0,10,2,18,20,17,6,10,-19,-3,-19,-15,-17,1,12,4,-8,17,-20,-2,-14,-20,0,-18,9,13},
+{12,4,4,6,16,13,20,19,-5,4,-7,-11,-17,-11,-19,-4,7,-18,17,-13,14,12,-9,1,-10,-6,19,-16,-13,8,5,-10,9,15,12,-19,-15,-15,19,4,10,-5,-14,-17,4,2,20,19,5,6,7,-9,-10,-19,-20,-16,2,-15,5,12,-14,3,1,-2,12,-8,1,7,-11,19,12,20,-7,-8,-7,20,18,-5,13,-13},
+{18,1,10,5,10,11,-13,-20,19,17,20,-18,9,-16,20,5,-3,16,-20,-14,-6,5,-8,-18,-4,4,-19,16,-12,20,8,3,-20,19,1,14,0,6,9,5,-5,6,-13,-11,18,-13,16,-12,-2,-6,3,-13,-16,20,2,-6,11,13,18,11,-5,15,-11,-16,5,-1,-1,-19,15,-13,-8,-8,6,0,-8,3,16,-18,-10,1},
+{-7,-5,9,-12,17,-11,1,9,18,12,17,5,6,3,-3,-2,0,-6,-12,-11,-1,20,1,7,7,-18,-8,-1,-8,-1,-12,15,-14,13,1,-9,-10,5,-13,10,-15,-20,18,13,-17,-8,-19,20,16,8,-8,-9,10,13,-11,20,-9,-3,5,20,5,15,-2,4,0,-8,-8,-10,2,8,5,-2,5,19,-2,-1,-16,16,-14,5},
+{19,15,5,14,20,15,-9,-18,-13,1,3,8,0,7,1,13,-19,-6,-8,-18,18,0,15,9,1,14,-13,-10,2,10,10,3,-16,3,13,-6,-15,14,-5,-1,-14,8,7,17,12,-11,-18,15,-13,-19,-17,-16,12,-1,8,16,2,14,16,-6,2,-6,3,13,-5,16,-20,-15,14,-11,-15,20,-10,19,-19,16,-5,-20,-6,-2},
+{5,-11,-13,8,12,-11,15,-17,-11,4,-18,-18,5,-3,18,-11,-5,9,-10,-16,0,4,8,3,-4,-5,4,9,8,13,-7,4,-6,7,-20,-2,3,-13,5,-14,-20,20,18,11,-6,-20,-13,12,-20,20,-20,17,-5,0,15,9,2,0,-12,-7,-15,-9,6,-2,-19,-16,0,0,1,-19,-5,5,6,-17,-18,4,-7,-4,-11,-18},
+{15,19,18,-15,-12,-20,-14,8,-3,-14,-18,7,15,8,17,-2,9,-20,9,-11,17,-15,-20,-1,-17,-20,6,-17,-5,-4,11,12,4,-12,9,-5,5,20,13,7,-18,-13,6,-12,20,15,-20,-4,6,2,-2,-16,18,-7,-17,-11,18,-13,13,-16,19,-6,15,-19,15,15,13,8,6,13,9,-5,-11,0,8,2,5,-10,-1,10},
+{-18,-13,13,-14,8,6,12,1,-12,6,-17,10,-2,-16,-4,7,-7,3,-9,-20,-20,15,2,8,8,-19,18,-19,-4,11,8,7,-5,17,13,11,7,15,-2,19,9,-16,-20,6,4,3,-3,-9,-13,-16,15,17,8,11,-3,17,-13,18,-18,-11,20,-8,16,13,-6,-10,-17,-16,18,8,-11,10,6,-7,-12,14,1,0,-5,-2},
+{-8,8,-17,2,11,16,-11,-18,2,10,17,-8,-20,-19,18,10,-2,-14,-15,-1,16,-5,18,13,3,-4,-2,-19,6,-18,1,12,-18,1,4,-5,-14,16,-1,-10,-4,-7,14,12,15,-18,-4,-12,-15,16,-9,-14,-14,-3,-6,17,17,-15,-3,4,3,-7,-18,10,7,-2,10,-19,20,18,-18,0,-17,-16,-13,0,-3,-1,-18,18},
+{-2,5,-2,16,19,-16,-6,0,-8,-17,13,-5,20,9,18,6,10,-19,0,-3,-7,-14,6,6,1,-18,-11,-5,-18,-8,5,19,-14,9,5,-14,-15,-4,-1,17,-12,-9,-2,14,-14,-17,9,5,6,6,6,-5,11,0,-7,4,12,15,-7,6,-20,-12,3,-20,6,0,-15,-15,16,16,-15,10,12,-3,12,2,-12,2,-20,-11},
+{-10,-20,-12,-9,-19,-2,-7,6,-2,-8,14,7,9,2,-19,2,-4,20,4,5,6,-17,-15,-10,-19,-9,-6,12,-14,-9,17,5,4,-6,-17,-20,7,14,6,3,20,-6,-12,-4,-18,10,1,-13,15,-12,6,-2,15,2,9,-9,10,-20,14,-10,12,7,-7,-8,15,10,-5,-15,6,13,-4,2,-14,2,-14,-14,-17,-12,-20,-5},
+{-16,16,11,-9,4,2,6,13,12,-13,12,12,-15,-11,-4,-11,-18,1,18,-2,-15,11,7,-7,-8,-5,10,-16,13,15,-7,-1,-8,19,4,-7,9,2,7,-13,17,-1,0,20,-20,-1,12,-10,6,1,9,15,13,6,14,6,14,2,4,-20,0,5,17,9,5,-5,-1,-12,15,16,-9,10,-12,1,11,-9,10,-12,-19,-7},
+{10,10,-17,10,-14,7,15,-6,10,-12,2,-12,-4,9,1,-4,13,-12,18,9,5,14,4,7,-15,-10,4,-10,-14,-16,16,-17,-5,13,-12,8,-18,1,-10,-8,-5,2,-19,13,-16,0,-8,-2,-1,-4,-13,-11,-13,19,-9,-8,-19,-20,-7,-16,-3,0,5,-17,-5,11,-3,-19,6,-11,-20,13,-15,-5,-2,-9,13,6,14,1},
+{-10,0,1,8,18,-15,-19,-12,-10,-15,12,-19,-14,-4,15,-20,-16,-19,-17,-8,13,-7,-8,8,6,8,-20,5,-13,4,-12,13,-20,15,20,-5,10,-13,11,-5,14,-9,-16,7,0,8,0,-1,3,-3,-4,-19,-9,3,0,-19,-1,-13,-6,12,19,9,12,7,-14,5,10,5,-20,-10,1,-7,13,9,7,-20,7,4,-20,-18},
+{-3,-1,1,-14,6,3,-11,14,-3,4,-18,-2,-18,-20,14,-17,-7,-2,0,5,-10,6,8,-4,-13,14,0,-8,9,-19,9,7,8,-9,-4,-5,-3,-8,10,-16,6,12,5,2,4,-15,16,12,-1,-15,18,-9,7,-6,7,-19,-8,-7,4,7,0,-10,-9,-6,14,0,-4,13,15,-19,-13,-6,-4,-5,16,9,20,18,-7,-6},
+{6,-16,17,7,20,19,20,2,4,16,-9,-13,18,3,14,7,-7,17,-1,20,-20,-18,7,1,-10,-19,19,16,13,-12,-3,14,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{-10,-10,20,15,0,-20,16,-2,-8,-3,3,15,13,17,-12,13,12,-7,-8,-17,3,-18,-2,12,-5,9,-13,11,-4,-10,-8,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{-5,2,7,17,3,-18,-19,8,-17,12,-18,-17,-18,-19,17,18,-18,16,10,12,-12,-5,0,2,9,-17,19,-5,7,-15,9,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{-19,2,-2,-9,12,18,18,-14,12,10,-12,7,-8,1,-7,-1,-4,16,14,-9,3,2,13,-6,-8,-14,-17,-19,-4,-12,3,-9,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{-19,-9,-8,-10,7,-18,-19,-13,12,-10,3,-13,-8,9,-12,2,-13,10,-15,-14,16,16,9,-6,8,-15,1,-7,-7,-13,-2,-19,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{18,1,9,0,18,16,-11,18,15,-9,7,16,11,-3,8,15,14,1,-6,3,5,-9,12,-6,9,-12,16,-20,14,-2,-13,13,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{20,-12,0,-7,7,7,-14,13,-1,8,-17,-16,20,6,-9,5,4,-5,-2,-1,-3,-16,-7,-1,-19,3,-14,-17,12,5,10,10,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{-17,-6,-4,-7,-6,-11,13,-6,2,-17,3,-13,-20,5,1,19,1,9,-19,4,15,-3,20,-8,-20,-19,7,-13,10,-1,-16,6,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{11,5,13,7,-9,18,-20,12,14,-17,6,-15,17,-4,-8,-7,13,-5,19,-6,1,7,-5,-7,-10,-13,-9,-20,-13,-6,8,-19,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{-1,11,-8,-10,-12,-4,17,3,12,0,-16,8,-6,9,-6,14,-10,7,20,-13,16,-15,-7,-12,0,-12,-17,-7,2,-5,-9,-1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{0,15,19,15,13,-8,-5,-2,9,5,20,-13,0,17,-4,14,-7,14,19,19,6,-18,-2,-18,-6,-13,1,-14,12,15,-18,11,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{13,10,16,-12,1,-5,-7,-16,19,17,-13,15,-11,17,-14,-12,20,-14,-19,11,15,-2,-2,2,-14,-15,14,4,15,5,-8,5,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{8,7,20,-9,-18,-16,-15,19,-7,-19,1,0,3,-11,-16,-1,-3,-12,4,-16,20,17,11,10,9,-17,5,18,3,1,-17,12,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{15,-18,-11,16,-14,19,-8,3,10,-16,-2,11,-3,-10,-6,-11,7,-14,13,14,8,16,15,-2,-6,-20,3,20,5,16,-12,5,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{8,-5,20,20,13,-5,12,-16,-9,-6,6,-6,12,-17,-11,12,-7,-9,-9,11,-18,15,7,12,0,-6,-19,-1,-16,9,-10,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{9,-3,-15,5,11,-20,13,18,7,13,-18,7,20,7,-15,-17,6,-8,-2,18,1,14,0,-7,-19,-15,-12,14,8,-2,-4,11,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{-20,-15,4,14,19,20,11,-15,-11,16,-18,3,-16,-7,5,12,-6,15,-3,-16,-11,20,13,1,-9,19,-18,17,-20,8,-8,-6,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{-1,5,20,-18,-6,-3,3,-1,-14,-2,14,17,18,-5,10,5,7,-17,15,-3,20,-11,11,18,-16,0,13,4,12,1,3,15,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{-14,-15,-9,-12,11,-5,7,-7,-15,8,-4,-12,-19,12,-5,9,-11,-12,-14,13,-15,1,17,9,-17,-18,-15,9,3,2,-11,16,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{-3,-13,12,-1,-17,2,16,-1,-5,-13,12,19,-7,-6,17,14,-6,-11,18,7,-11,-3,-15,-14,-13,12,-11,10,4,15,-2,-10,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{15,-13,17,-6,20,14,6,-7,-5,-5,11,1,-9,-9,16,14,13,-4,6,-4,19,19,-19,-19,20,2,-9,-3,11,-19,20,18,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{14,18,16,-7,-18,12,0,10,-1,13,-12,17,-1,8,11,13,5,-12,4,7,1,11,6,-2,20,1,19,8,1,13,-2,-5,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{20,8,2,-11,12,19,2,1,11,-18,-17,-7,-4,11,-6,-20,-6,4,18,-19,-3,-7,13,5,9,12,5,-15,-18,9,-9,20,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{-11,17,-6,11,15,4,-2,-4,10,7,4,-14,6,2,13,17,20,-16,17,8,-5,-16,-7,17,-7,-19,-18,-18,-8,3,-20,8,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{-20,-7,7,15,-15,20,19,-9,-9,5,7,18,-3,20,-13,-19,19,17,-7,16,8,13,7,6,1,14,18,-16,17,-17,-5,18,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{0,-3,3,-17,-20,-16,-15,14,7,-15,-1,-15,-14,-1,11,-3,-9,18,8,19,15,-16,3,7,11,-18,15,-4,-18,17,-20,-12,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{12,-6,10,-2,5,3,6,10,-19,2,-4,-12,-19,-18,-2,-9,-18,-13,-20,-9,9,-15,11,-2,13,-8,14,0,1,-5,3,8,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{9,-15,-14,-3,14,1,-13,3,9,-8,10,-11,-8,-19,-15,-15,-1,9,-8,-5,7,-6,2,-14,-15,4,-19,-11,-4,14,1,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{4,-11,-8,11,0,10,6,9,-14,12,-8,6,11,5,-15,-1,-4,14,14,-6,12,-11,0,-17,-9,-17,8,11,15,7,14,-17,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{-5,-17,-5,-2,4,4,17,-6,-7,-14,15,-1,20,-8,-11,15,10,18,-16,10,-17,11,-5,9,-19,8,-18,-5,-16,6,-2,12,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{-11,10,-7,18,-4,-7,-6,-14,-5,-6,-20,19,16,-9,-6,12,-8,18,-16,-5,-4,12,-2,8,-7,0,9,2,-13,-19,-6,-18,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{-9,-7,8,-10,17,20,-20,-2,7,10,5,-6,-15,10,-17,9,18,19,17,-14,0,9,-16,4,17,5,-9,-4,-20,-4,2,14,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{9,-5,-20,-8,1,6,18,12,7,-2,-14,-4,-7,-12,-8,-15,18,7,2,7,-15,17,-18,19,-2,-13,15,3,-7,-15,3,18,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{0,12,-20,-8,16,14,-9,-11,-15,-13,1,1,18,5,-10,19,4,-13,0,20,-20,-4,15,14,-10,-7,-1,16,-12,4,-17,9,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{-9,-7,1,-5,-6,0,3,6,1,-4,-8,15,-18,11,12,19,-7,-16,-15,11,11,-6,13,2,-3,11,-14,-17,-12,16,-14,-14,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{-5,-14,-13,0,10,18,11,20,-14,3,12,-13,4,-6,-6,-3,18,6,-3,9,-16,-4,19,-3,9,-12,8,16,-18,15,0,4,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{20,-2,-10,20,17,-9,15,10,-16,-14,-20,-18,10,-5,14,4,-2,-20,-17,-11,-15,4,11,19,-19,-5,20,-4,-16,11,7,-6,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{-19,7,-1,12,5,-8,-9,8,-20,10,17,-1,16,-16,20,5,17,18,7,1,-12,16,-17,-9,-1,10,-5,15,17,12,-15,-4,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{6,-12,3,16,-14,-13,16,-8,16,-19,20,-14,14,-10,1,0,17,-19,17,-16,-9,6,-7,18,1,15,-13,-4,-4,8,-14,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{-1,4,9,12,19,-8,-11,14,9,-18,19,17,9,-16,18,1,13,13,20,13,-20,-19,6,14,9,-2,-8,16,14,-7,3,-16,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{-1,-3,6,-20,-6,20,3,-14,6,16,20,4,-1,18,-3,-9,8,8,16,-14,-16,-5,-17,-4,10,-20,-16,16,6,8,13,17,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{14,12,-1,14,-11,-11,-14,13,-10,-11,-15,0,-15,12,-3,8,17,-17,17,-4,13,2,-9,20,16,17,18,-15,12,15,3,-18,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{-12,-18,20,-11,-17,-6,15,1,3,-12,-1,9,-7,-15,14,16,-19,-9,-7,3,-17,15,17,-1,-4,3,1,6,-6,19,-4,10,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{11,17,10,-13,-19,8,19,0,13,16,10,2,-16,-1,16,-3,16,0,-15,-1,6,14,-6,-10,7,-3,13,10,11,10,11,4,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{20,-2,-20,1,7,-11,-17,-5,5,-6,-19,6,17,-8,19,6,6,18,-16,-6,-16,-3,5,-1,18,4,18,-11,-10,-17,-17,14,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{19,-2,0,-11,-10,2,-13,-2,14,-15,-1,-9,-10,9,-10,0,15,-6,-14,20,15,-11,-5,-14,-18,12,-3,4,-20,0,4,-4,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{10,-10,13,-6,-18,-14,-13,-10,0,-17,14,4,8,3,4,18,-14,-12,-6,11,-5,-15,-5,-2,-12,8,-16,2,8,3,-5,-4,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{16,-16,-6,-17,1,18,-14,5,-7,-5,17,18,8,-19,20,-6,11,-15,9,-17,-12,-20,-2,7,1,20,15,8,-15,-18,8,5,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,11,2,4,11,-12,4,2,-14,14,-6,-8,7,2,8,0,-8,0,-17,-1,-11,-8,-10,8,-1,-14,-14,17,17,-10,1,-5,-17,20,3,-8,5,-2,3,20,8,17,-14,4,14,-12,13,-4,-16},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,-15,15,-5,11,-14,13,-16,16,19,-8,20,-12,2,-1,-13,18,-12,14,17,-10,-8,-5,-16,-7,18,12,15,-16,12,17,-12,-18,3,-10,12,-9,-7,13,15,-20,16,-9,20,-4,18,4,-20,1},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,10,14,-2,-16,-7,-12,12,0,-19,20,14,20,-3,19,20,-4,-9,18,8,-9,-9,1,4,18,-13,2,4,9,-18,2,6,-18,-15,12,-3,14,7,-12,-4,16,10,-13,-20,13,18,-2,19,-2},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,-20,-8,2,20,-6,9,-3,7,-8,8,19,8,-18,11,-9,7,11,-2,-13,-16,10,-7,-5,-1,-15,-6,17,12,-11,14,13,-8,-12,-14,7,-7,-17,19,-19,-20,4,0,17,6,14,-18,12,-3},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,-2,19,-10,-10,10,7,6,-9,-11,5,6,-2,-1,-4,-10,20,7,-13,18,18,-18,11,-2,0,9,-11,11,9,17,-19,-14,19,-6,-8,1,11,16,-5,0,14,14,-14,17,15,-17,-17,6,10},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,-3,19,13,-6,11,5,-11,10,8,13,2,-5,-9,6,-20,-4,15,0,3,-8,-7,-19,5,-20,-14,8,-12,16,-1,-8,-15,-16,-19,5,-12,11,0,1,-19,0,-1,6,4,-12,15,-1,-4,14},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,-10,-17,-11,15,-2,-12,-6,-10,16,-15,-5,8,-20,-13,7,15,1,-12,-19,4,-6,5,4,12,13,-13,-1,-1,-6,10,-17,-17,-7,16,19,16,1,9,3,12,9,18,10,6,20,16,-20,10},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,10,17,-10,1,-14,7,-15,-11,0,12,12,18,-6,-15,-13,7,15,0,-1,4,-15,-5,3,15,-15,17,-10,15,-19,-11,8,14,1,-19,4,-2,15,9,1,-1,1,-1,13,-18,16,13,-5,-13},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3,1,6,-19,-17,6,7,-12,19,5,-12,7,6,-16,14,20,-6,1,5,4,14,10,17,19,6,-16,-20,-7,-3,20,15,13,-19,-8,-19,0,-3,12,12,20,7,-5,19,-2,-16,15,-19,-16},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,11,16,11,12,-4,-14,-8,8,11,-11,-16,-8,6,-9,-9,-3,7,13,18,-13,7,-1,-5,8,20,17,3,19,-4,0,6,0,-7,9,-6,8,12,-11,-20,-9,-5,18,10,-14,5,-16,-4,-1},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,16,9,-19,-4,6,-4,-20,-3,-3,-20,-18,4,-7,3,5,8,7,2,-8,-17,-18,4,-9,1,-12,5,-14,18,15,-5,-20,-16,18,0,16,16,4,6,-16,-19,-5,-18,-4,-14,18,14,0,-16},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,0,20,-3,-8,-8,2,0,11,-12,7,-7,-10,19,-7,-17,-1,-3,10,-2,19,-18,-3,7,2,-12,8,-2,-15,11,1,-9,-14,20,4,4,-9,-4,-18,1,17,17,-1,-13,4,-9,-6,0},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,4,-13,-8,14,4,19,-19,16,10,-13,16,18,-5,-19,-3,-15,20,5,2,-4,-16,15,9,-4,-9,19,19,2,10,17,-16,-7,-5,18,1,-3,-12,17,20,-3,7,-18,-16,-19,19,-2,-19,-7},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,-2,-20,8,-10,10,3,-11,6,-8,-13,8,11,-9,-10,0,-6,8,9,-4,-9,-13,-7,-16,8,-14,17,11,4,-15,-11,1,14,7,9,9,18,7,8,18,3,-20,-5,-9,-16,-13,-16,20,16},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,-18,-1,18,15,15,1,9,15,-11,14,-6,16,-19,-13,6,9,4,-19,-9,-14,-5,19,4,-7,-2,-10,-5,-14,2,3,-19,-12,18,10,-5,-13,-7,-8,11,4,12,8,-20,10,-7,7,-16,-13},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,-18,5,11,5,6,-5,13,13,-17,5,-2,-7,-6,10,-9,9,14,4,16,-11,-19,-20,-1,14,-10,-3,11,-12,1,0,-10,14,0,18,10,-18,9,-16,-10,6,-7,-11,8,13,-14,-17,-18,-6},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,-3,8,-9,-13,-13,-3,-18,-7,0,14,15,19,3,5,-5,1,0,-1,20,7,-13,10,19,-13,-7,17,4,2,-9,1,14,-9,7,-17,5,-15,-15,-13,11,14,-17,-20,7,1,19,20,9,16},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3,4,-17,-5,-2,-15,10,11,19,-17,8,10,-3,-9,-9,-12,1,17,-7,9,-5,-5,4,12,9,4,-15,4,-16,14,0,18,5,7,-6,3,-3,-6,-14,-3,17,-1,-10,-18,17,-17,-7,4},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,-2,0,11,-10,20,-5,15,-8,9,18,8,-20,20,20,-19,-3,9,-7,-1,20,15,-17,-20,-15,17,-16,-18,-9,-10,-6,-1,9,-6,1,-15,12,-9,-11,15,-15,-7,-7,12,16,-8,4,-7,15},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,-13,15,-1,-8,-12,17,-14,18,-20,17,-3,-10,20,5,-19,-18,-20,-14,-14,2,-8,-15,-5,18,14,-11,-16,1,-10,-17,5,1,8,8,-17,-2,7,17,-2,10,15,1,-16,-4,-12,-5,-13,5},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,17,18,-19,5,14,13,-1,2,-2,9,-5,-18,-15,-3,11,-15,-16,-9,19,-5,-6,0,6,17,20,6,-14,-4,-6,19,10,7,-16,5,-4,-8,-14,19,-5,13,-1,-1,-3,20,6,13,-9,20},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,12,-12,5,2,-14,3,-5,-18,-2,11,5,-8,13,-11,8,-14,18,-14,1,-15,4,14,-13,15,-15,0,6,-3,-12,-10,4,20,5,9,-4,8,-10,19,-2,-15,3,6,-12,18,-6,0,-14,-4},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,15,-9,4,4,-1,12,-20,18,1,17,19,15,19,-14,10,15,-13,2,14,-1,20,20,-10,20,11,18,18,2,6,1,-17,3,-13,3,17,-18,-5,18,9,-8,18,20,0,-2,15,-7,-4,-3},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,-19,-14,15,7,-5,-3,13,8,-8,-6,-5,0,8,-12,-3,4,-8,1,9,-2,11,-20,9,19,-3,3,1,16,0,-7,-14,7,9,-14,-9,17,11,6,6,-3,-9,13,-5,-16,-18,3,1,-20},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,-19,7,-17,5,-9,-15,11,13,-14,-19,15,9,4,-19,-14,-6,19,-20,0,-3,-19,-6,12,-6,20,14,-8,5,-1,0,7,-6,1,-17,7,1,-14,2,13,-11,-8,2,-9,0,-13,-18,-7,5},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,-2,-11,14,10,-3,-12,-2,-16,10,-12,19,20,2,-2,2,7,-20,-1,20,11,13,-2,19,14,7,12,2,6,-7,4,14,6,-13,-11,8,19,-15,-20,-17,-8,20,-13,16,-20,11,-6,15,16},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,19,14,10,11,3,-9,-12,-19,15,-14,18,-5,-17,11,-10,16,20,-10,14,20,16,-2,-20,-8,-2,20,5,-15,-4,12,-19,-11,-7,-4,3,-9,-12,-1,4,-17,5,-15,-4,7,1,12,17,-1},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3,-2,-19,1,11,-3,-20,-6,-6,8,18,11,11,-13,-12,-16,-12,12,11,-3,-6,-10,-7,2,14,-15,5,-13,-20,-14,3,-2,16,7,0,-2,-15,6,-9,20,-12,4,-11,1,10,2,-13,13},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,-8,0,17,10,8,9,-7,18,9,17,20,5,16,7,-3,12,-15,19,7,-4,13,-20,-19,5,15,17,18,16,-3,-5,3,9,4,12,-7,-6,18,6,20,-5,14,-5,-14,-16,12,-6,-20,-3},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,-6,-15,20,-9,-11,10,4,10,6,-19,-9,-2,-9,-6,18,18,-17,-19,10,12,15,18,-9,-18,-5,6,-12,14,-9,1,8,5,8,-1,0,-18,20,-12,-20,15,-11,-7,-16,11,-20,-10,8,4},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,18,-17,-12,3,19,8,-7,17,2,7,0,-1,-20,-10,-17,-20,-3,5,-8,0,8,10,-7,15,-10,-19,-12,11,19,-20,10,0,-5,-1,1,4,-6,-13,-15,5,-18,-9,-11,6,20,7,5,13},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,-2,-5,-5,-11,-20,4,13,-7,-16,-16,10,-3,0,-14,-18,0,-10,6,-19,6,9,-3,18,14,8,-16,7,-3,4,6,4,4,9,10,-2,6,17,-10,7,14,0,8,14,-8,20,12,-20,-9},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,10,1,-1,8,-9,5,-11,7,9,10,15,-13,10,6,16,-20,-13,7,-7,19,20,12,6,-17,-13,8,8,-13,8,-3,-14,11,-8,-6,-18,-1,-14,11,5,3,7,-6,-7,-7,-5,13,-19},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,-1,-14,1,1,11,6,2,-15,-15,-7,8,-12,-4,12,10,-12,12,11,-9,-11,-19,5,-11,1,6,-8,11,-8,4,10,-1,2,-19,8,-9,-19,0,3,0,-5,9,9,4,-4,-19,-7,-18,-19},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,-15,-2,15,-11,17,12,-10,12,-5,-17,5,-5,17,20,-20,8,-8,-11,9,-6,13,18,-8,12,3,-13,7,9,1,-15,12,-11,12,1,-5,2,7,6,-5,-11,-1,9,12,-3,-19,4,-19},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,-1,4,-20,-14,-5,4,16,-2,15,18,11,11,-10,11,-20,1,-15,7,17,-15,3,2,-20,13,2,2,-15,-7,7,-13,19,10,12,-13,7,-20,-15,-10,-18,10,-14,11,-2,-8,-9,-18,-20,-6},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,11,-13,-8,-8,17,19,-18,9,16,-19,-8,10,11,-5,11,10,-8,18,-11,5,-13,-17,-10,19,-5,-4,17,-11,4,10,-18,-20,1,5,-19,-1,12,15,1,-19,13,-17,10,12,6,-16,-13,-13},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,19,-2,-15,11,15,10,-9,-20,4,3,20,16,14,6,-15,-19,20,-20,17,-14,14,12,17,-17,-6,0,-15,-8,3,-17,-13,19,-3,-17,-18,11,19,-3,7,-20,19,4,7,16,8,-7,15,6},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,-6,-4,19,-6,13,-15,-10,-3,19,4,8,-8,15,-12,19,18,6,0,7,11,-19,-18,2,1,11,-17,-10,4,-19,-7,-8,0,2,5,-5,12,-19,-3,12,-16,-15,19,-6,-5,14,19,-13,-15},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,18,-12,9,10,6,12,-4,4,2,-20,-2,-14,1,-16,-11,18,14,-19,19,2,-4,6,-2,-5,20,-3,-3,-9,-14,-11,10,6,9,-17,16,-10,15,17,10,-9,15,9,-20,8,-6,11,-7,-19},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,18,-18,-4,-7,-8,-16,9,9,5,19,-18,-14,-8,-19,-6,9,20,20,-18,-3,-6,10,0,-3,7,13,-12,6,-19,-15,-15,17,15,-13,-9,20,8,-6,5,-3,7,8,5,0,-3,-18,3,-16},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,9,1,20,2,-2,-11,-17,-17,-17,-9,13,-5,12,12,18,-5,-13,-3,5,-19,18,-19,-19,19,4,-9,0,19,-6,8,-3,8,18,-4,19,-12,-8,-14,20,19,13,16,-15,6,11,-19,-8,-15},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,16,-10,10,-6,1,-20,13,-16,-11,-15,20,-11,-9,5,11,12,-8,-20,7,20,-4,1,-14,-13,-5,-12,6,-3,4,-20,-1,17,-18,-2,-16,-8,0,-4,-5,-18,-1,-12,2,2,-1,18,-9,-4},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,5,-2,0,-12,19,-20,17,-1,3,-20,4,20,15,9,17,-14,-7,0,-9,-20,9,-11,14,-12,-20,-9,-2,-10,0,-17,-2,11,-11,12,1,-18,11,13,9,12,3,-16,-20,-14,-16,11,4,-6},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,-17,10,-11,17,-19,-11,15,12,8,18,2,-14,-11,-20,9,15,-5,-3,-10,-2,15,-4,18,-15,20,6,-10,-16,10,15,4,-4,13,-3,3,-19,5,0,8,-17,-12,-17,7,18,15,-18,-5,3},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,6,-12,-14,-18,-14,-10,-6,20,0,-18,-10,-20,3,-16,-12,-17,6,13,-11,13,-18,10,-8,16,-14,-19,-11,-10,4,-8,20,19,-11,-14,-6,-14,18,-6,14,-14,-16,-4,7,7,-13,-8,-7,-6},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,-9,15,8,-14,14,-10,1,7,-7,-9,-18,-20,-12,13,3,-20,-8,-11,2,11,1,16,-13,18,8,11,12,1,15,-5,-6,13,1,-10,16,-7,-2,18,9,15,1,-6,-13,16,13,18,4,7},
+{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,-15,-14,-12,4,-14,-18,-3,-1,-2,0,1,0,1,15,-8,16,15,10,13,-9,-18,-4,-5,-1,4,11,-14,10,-6,-6,14,14,1,-15,2,-13,-11,-15,18,-20,-10,3,14,-9,-15,-9,2,-16},
+};
+static const int32_t gru_cell_reference_bias[4*GRU_CELL_REFERENCE_HIDDEN_LENGTH] = {
+  49,-25,-32,63,-42,21,41,-3,-3,56,25,17,-55,63,-51,45,
+  -22,44,-58,-39,2,41,64,20,-60,-11,53,7,33,62,18,38,
+  -45,12,49,-43,42,25,64,38,5,48,61,0,53,13,-46,14,
+  33,-38,-44,10,55,-30,-21,-55,57,-51,34,-57,11,55,-22,-41,
+  -34,6,-60,2,11,-41,-14,-1,45,-55,-13,-51,-24,50,57,8,
+  -63,27,-48,-1,12,-59,-55,-40,22,-23,-7,-60,-36,32,-59,39,
+  38,11,3,5,6,40,-14,17,-27,29,20,-22,33,47,16,-61,
+  -6,-14,44,-49,28,32,-18,34,-46,-19,51,9,-45,7,-6,58,
+  1,16,22,41,-6,16,59,3,55,-28,6,11,-53,-16,-47,59,
+  12,-9,8,26,26,27,-53,-13,46,-50,23,-9,-57,30,64,5,
+  18,-64,-37,9,-19,24,-29,13,-19,-64,-29,-57,-46,26,-15,7,
+  -40,50,37,22,62,22,56,-59,1,2,40,34,-45,-20,37,37,
+};
+static const int8_t gru_cell_reference_input[GRU_CELL_REFERENCE_SLICE_CNT][GRU_CELL_REFERENCE_FEATURE_CNT] = {
+{15,1,-55,25,-36,-43,-58,-58,41,-41,-8,0,-16,41,37,23,-8,-46,-19,-13,4,-2,62,-12,4,-27,-49,-60,-11,10,30,-8},
+{-34,-26,49,40,44,-24,2,-53,13,24,-33,-5,20,12,44,-36,5,33,47,-18,12,19,8,64,58,-15,35,20,-5,-4,-9,-4},
+{25,-27,-59,9,50,-4,-43,2,-15,61,16,-38,-1,49,-29,-17,-44,50,-16,60,43,-26,9,61,1,2,-21,57,3,27,-33,-8},
+{-58,-62,4,53,3,13,-45,-9,-31,-44,25,61,-11,46,-45,55,-27,-56,49,56,-58,42,-31,-24,31,-14,39,52,64,-2,-37,-41},
+{34,59,16,6,-41,-54,2,19,39,56,44,-37,43,-45,-42,57,4,42,-9,36,55,15,-25,-55,-20,-26,-5,-7,-39,-20,9,13},
+{-41,22,-8,-43,-21,-38,17,61,50,-16,54,-15,-26,31,28,35,-58,49,-5,29,-9,35,13,-30,-36,58,24,16,-25,-48,-12,40},
+{31,19,39,-32,38,47,12,-15,28,58,-40,55,14,47,50,-49,-21,-29,63,17,30,43,-4,-24,64,25,-30,-7,-61,-16,-16,-1},
+{-53,36,53,-16,38,-61,61,9,54,-56,-27,16,23,-28,39,0,45,53,25,48,53,-51,-64,38,23,-21,33,48,55,2,-12,49},
+{-1,56,-24,-55,19,56,-49,43,61,48,-62,-1,20,-18,-5,21,41,41,15,-28,-59,-59,-21,-44,63,-32,12,-2,35,23,12,-63},
+{-52,-14,13,-54,-7,16,58,-12,44,-17,-33,-9,-25,46,43,-13,28,33,56,-64,17,17,-61,-60,35,-46,-44,61,-23,-27,-51,42},
+{56,-6,41,23,-20,-38,32,-34,55,32,44,56,35,-59,32,-38,-11,49,-46,-50,-20,-49,-55,-7,5,11,-26,-5,-33,-50,-46,-60},
+{17,-39,51,-31,-56,9,-6,50,-64,-10,60,-12,-26,46,27,-41,-38,29,-63,-9,28,-18,19,-17,33,-12,-61,0,36,50,27,8},
+{17,-56,29,27,-36,53,3,-25,-5,43,2,14,24,15,5,63,35,-36,-53,-19,-55,19,-1,-34,56,-38,37,4,7,18,31,14},
+{-59,3,51,-58,-40,-19,51,28,8,-10,24,-4,61,21,64,-25,6,34,-38,-4,-42,5,23,16,-25,37,37,58,15,17,-23,56},
+{61,-29,52,26,33,59,-29,53,-58,24,-10,-10,59,-3,23,54,-39,-12,23,-40,-31,31,47,6,-63,-46,-60,31,13,-44,18,-50},
+{9,0,5,-8,-5,-22,50,45,28,-28,7,14,51,48,42,-43,5,26,41,49,18,37,46,4,20,45,3,37,-54,-53,-30,-18},
+{-1,54,44,44,-9,14,-7,-38,22,-29,42,-56,-13,53,-21,64,30,32,-30,-62,18,-38,22,41,-51,33,-58,-30,-2,-1,-25,-2},
+{-35,17,-34,21,-17,-37,1,-14,45,23,8,53,53,-9,58,-35,-1,1,-6,-10,21,58,33,34,34,-40,-60,54,56,10,44,-39},
+{56,-27,58,-52,-26,-60,-41,16,-46,-57,-55,-6,32,48,57,-35,18,-45,31,9,4,22,64,53,48,33,3,15,-17,-35,61,3},
+{-2,2,-49,34,40,4,-22,9,53,33,36,-63,59,-44,55,-13,1,14,-9,4,29,24,60,-5,32,23,18,51,-56,-53,-25,55},
+{-58,16,61,0,-39,-63,-64,8,-29,-9,47,19,-61,-60,-36,-14,-47,43,38,-36,-16,47,37,6,32,50,-48,8,-42,41,-4,-60},
+{45,24,6,-56,-5,-57,33,27,-25,53,46,-44,55,-62,-4,-50,-27,-59,40,-5,-63,-51,56,-34,-49,0,28,55,29,22,31,-18},
+{-4,62,-3,-24,-24,-7,-11,-12,57,49,-26,-51,40,-25,-64,-38,50,5,-11,53,-55,-27,-40,3,-22,63,-63,21,-28,5,-30,23},
+{36,44,-6,-13,36,27,12,9,-40,-46,-9,61,41,29,-46,46,47,4,47,28,13,-46,10,-57,1,-14,9,23,-26,0,50,-32},
+{-39,-29,-35,-51,59,-58,-33,-35,42,23,41,-20,16,-47,-33,-19,-64,-14,58,21,-16,55,-63,-37,29,19,-17,-7,-16,-46,35,60},
+{52,1,-57,48,-23,5,64,32,-23,-6,-50,8,-2,-7,-46,-44,63,-46,37,1,-36,25,-20,-15,-5,-17,-50,-36,-1,25,35,-54},
+{31,25,34,31,-37,-20,-44,-22,-46,-31,-9,-52,42,7,64,-30,-51,-12,9,-31,-37,12,-45,-16,-33,-53,-31,-36,14,1,-37,38},
+{52,-45,-49,20,6,23,32,-22,-32,-49,9,59,-44,10,-24,59,-63,-59,25,-26,-63,-6,45,33,48,18,-53,-59,12,-62,-34,64},
+{-50,-19,10,-36,-12,6,0,-60,-6,15,5,49,-61,-34,-50,17,-22,-26,57,4,39,-1,45,-18,44,44,46,-5,-27,31,37,34},
+{32,46,-41,48,-5,30,-6,22,-35,36,32,33,14,41,51,-6,-16,-61,-40,-29,7,-27,60,-35,-5,64,-12,-31,1,50,45,-57},
+{52,42,33,-59,-13,-8,22,8,-18,62,44,55,-62,30,29,-32,-60,-23,58,13,51,-39,25,46,5,-45,-2,-43,-20,52,-7,-21},
+{-9,-50,28,-12,31,25,-28,-61,-4,-20,32,-62,-7,16,28,42,-8,-14,41,-6,55,-39,-31,-32,-12,47,-42,-47,9,-18,1,-48},
+{-17,11,-23,-7,15,12,26,-13,-29,-11,15,2,30,-46,57,31,57,55,31,49,17,8,-50,18,41,-13,-45,-8,-53,-56,62,31},
+{-45,-20,-54,36,-40,49,11,45,51,-5,56,-27,35,48,43,-3,-17,27,-4,-30,-45,5,18,64,54,-11,-58,30,-59,28,-19,31},
+{15,-1,-44,-64,2,-7,63,35,60,-25,55,-11,14,7,-36,-14,-49,26,20,25,-15,-7,58,38,27,-53,8,-30,14,39,61,-54},
+{-35,-3,-5,49,28,1,11,-3,23,-18,-32,-50,-5,24,56,-25,-40,35,9,-8,-15,-33,5,-25,-57,-56,56,23,3,1,-9,-54},
+{-9,-59,57,59,1,-43,-61,24,-46,19,-41,-61,4,53,23,45,-2,-14,-37,-11,33,-59,-19,-60,29,-40,57,32,2,-63,35,17},
+{44,-10,-56,-61,-60,62,47,-32,-4,-49,28,13,-25,63,-17,3,-59,22,52,9,10,14,-53,49,-53,22,61,2,-30,-14,62,-56},
+{19,42,30,-52,-40,-55,5,44,36,-42,-57,5,40,38,-60,35,-32,-52,-9,54,-51,-34,30,-32,51,-61,-59,-16,-11,39,36,7},
+{36,21,33,12,-30,4,-21,64,-42,-9,28,-6,25,-15,-40,64,-15,-17,6,57,-33,39,-24,3,31,-22,5,42,-6,-52,58,-15},
+{-10,19,-8,24,45,-35,-28,-34,50,19,-20,39,-4,42,-7,-32,58,-35,-48,-57,-6,8,-37,46,2,-18,48,-54,-39,7,38,52},
+{-34,7,22,33,47,17,10,33,-12,26,-10,46,29,-2,9,-61,11,-52,-33,-35,-56,-60,32,19,-45,1,-23,-31,-11,-22,-50,55},
+{4,-36,6,13,-41,-52,21,20,-36,54,-61,-39,31,-44,-27,-22,-53,26,-38,-22,10,-49,55,11,46,-25,-32,11,-56,57,-18,35},
+{39,-3,-42,-64,42,-17,7,-18,-61,48,28,-37,-3,20,-22,3,-59,-5,45,-22,-49,23,13,-64,-18,26,53,-42,-35,-38,31,38},
+{13,11,-56,-3,49,63,2,-20,-38,64,-34,28,-29,51,-1,-45,1,10,62,-39,-51,32,-2,-43,-14,61,-49,-39,9,-29,-5,-46},
+{-64,-41,13,53,-15,-35,-31,46,62,-35,-1,-8,-62,-1,-18,-19,5,-6,-31,-47,-16,-19,-7,-64,44,17,32,28,6,64,45,60},
+{59,19,-48,20,29,21,50,-20,9,-44,-48,-14,-50,51,33,-1,35,-59,4,38,2,31,47,25,51,-24,-9,49,59,60,62,54},
+{-16,40,-52,-12,-36,-33,-41,5,54,-12,58,-46,56,48,-4,-55,33,2,-46,56,-33,-58,-1,33,-47,49,37,-62,-32,-24,23,11},
+{-13,58,-45,-14,1,-2,57,14,51,62,-17,-32,-44,64,-5,13,-23,58,30,8,48,-36,-26,35,-44,2,58,-52,57,40,-23,-31},
+{6,-22,21,52,-44,25,-11,-57,21,41,40,-41,-46,16,48,-27,46,52,-23,26,-58,31,27,36,31,-63,32,-52,37,8,48,-60},
+{-51,20,27,-12,-35,13,-48,-49,25,32,11,40,-33,55,57,-16,37,-23,-15,-24,-8,-28,63,-55,40,-48,-23,-2,-5,-44,-35,-19},
+{-61,45,17,-62,-9,8,-43,12,-5,-36,38,-48,49,-10,22,-19,59,-19,9,0,45,17,17,36,-41,27,13,-26,10,-31,13,-36},
+{-31,63,-50,8,44,40,-53,37,-20,6,5,-9,-13,-4,39,44,-52,1,36,-53,-8,-40,41,-8,14,-6,6,41,-45,-20,-2,-19},
+{23,-28,-17,-35,-12,30,-1,34,54,55,-9,39,16,28,-53,31,31,57,0,23,-11,38,6,-64,7,-3,4,-39,28,38,-3,42},
+{-24,18,12,-64,28,-43,58,33,-16,-3,2,64,-29,44,64,44,35,-34,50,64,23,39,-19,-58,53,-45,24,-45,54,28,-4,34},
+{-33,-46,57,-30,-50,-14,-48,25,-58,-27,-25,53,44,33,-47,12,39,-7,5,-6,2,54,50,-40,27,-33,-61,-60,18,-17,45,-14},
+{-29,-55,-42,0,57,-14,-61,-53,11,58,-13,1,-54,-6,14,48,7,-27,31,-58,-40,9,13,-2,61,-62,-58,37,30,-60,18,49},
+{26,41,14,-53,25,32,-18,-2,-53,19,-41,57,-31,55,15,56,-26,-49,60,-23,61,29,-23,-18,-4,53,55,63,-36,45,48,-37},
+{-42,-47,56,24,60,21,0,-60,49,-51,47,43,-5,47,46,48,-26,-40,-57,-55,-1,6,33,-36,-1,11,-56,17,35,10,37,58},
+{-33,47,-20,-17,-18,54,34,-32,-43,39,42,-30,-32,0,-27,-58,-23,41,23,-29,-49,58,37,55,-59,-14,4,-62,48,49,3,-11},
+{-40,35,13,-55,-29,51,-13,-23,14,-6,33,18,20,-10,61,-48,1,51,60,-33,-63,34,5,10,33,55,64,5,-21,22,7,4},
+};
+static const int32_t gru_cell_reference_hidden[GRU_CELL_REFERENCE_HIDDEN_LENGTH] = {
+  -2,12,0,12,2,-10,-20,-14,-1,-15,-15,-26,-8,-6,-8,-19,
+  17,-1,-8,-4,22,14,27,2,18,-19,-18,3,-10,-6,-12,18,
+  10,9,-8,4,-19,14,11,1,20,-21,16,24,-5,-30,-15,10,
+};
@@ -22,6 +22,7 @@
 #include "axon_kws_model_lstm_1fc_api.h"  
 #include "axon_kws_model_lstm_1fc_const.h"
 #include "axon_logging_api.h"
+#include "axon_kws_stats_api.h"
 
 //NOTE : LSTM based models always have a final FC layer, the precompiler can define a final FC output length which can then be compared here!!!
 /*
@@ -64,7 +65,36 @@ static_assert(LSTM_1FC_L1_FC_L1_OUTPUT_LENGTH==LSTM_1FC_OUTPUT_LENGTH, "LSTM_1FC
 #define MAX_LSTM_CELL_OPS          (PER_LSTM_CELL_AXON_OP_CNT*NO_OF_LSTM_CELLS)
 #define MAX_FC_LAYER_OPS           (PER_FC_AXON_OP_CNT*NO_OF_FC_LAYERS)
 
-#define TOTAL_OP_HANDLES       (MAX_LSTM_CELL_OPS+MAX_FC_LAYER_OPS)
+/*
+ * Input normalization
+ * Each slice gets normalized to int8 as
+ *   -128 + 255*min(x-MIN, MAX)/MAX
+ * With LSTM_1FC_AXON_INPUT_NORMALIZATION set this is done by axon ops at the head of the per-slice op list, with
+ * the divide replaced by a reciprocal multiply. The CPU only copies the raw slice in, then sleeps until the slice is done.
+ *   1) t = x - MIN - MAX/510             the -0.5 output LSB turns the rounding below into the truncating divide
+ *   2) u = (t*SCALE) >> ROUNDING         SCALE = 255*2^ROUNDING/MAX
+ *   3) w = relu(255 - u)
+ *   4) out = 127 - w                     => min(u,255)-128, the clamp at MAX
+ * Output matches the CPU normalization to within 1 LSB, from the precision of the reciprocal.
+ * Otherwise the CPU normalizes the next slice while axon processes the current one.
+ */
+#define LSTM_1FC_AXON_INPUT_NORMALIZATION 1
+
+#if LSTM_1FC_AXON_INPUT_NORMALIZATION
+# define LSTM_1FC_INPUT_NORM_OP_CNT 4
+# define LSTM_1FC_INPUT_NORM_ROUNDING 28
+# define LSTM_1FC_INPUT_NORM_SCALE ((int32_t)((((int64_t)LSTM_1FC_L1_INPUT_QUANTIZE_INV_SCALING_FACTOR<<LSTM_1FC_INPUT_NORM_ROUNDING) \
+    + LSTM_1FC_L1_INPUT_NORM_MAX_VALUE/2)/LSTM_1FC_L1_INPUT_NORM_MAX_VALUE))
+# define LSTM_1FC_INPUT_NORM_OFFSET (-(LSTM_1FC_L1_INPUT_NORM_MIN_VALUE) \
+    - (LSTM_1FC_L1_INPUT_NORM_MAX_VALUE+LSTM_1FC_L1_INPUT_QUANTIZE_INV_SCALING_FACTOR)/(2*LSTM_1FC_L1_INPUT_QUANTIZE_INV_SCALING_FACTOR))
+static_assert(LSTM_1FC_INPUT_NORM_SCALE < (1<<23), "LSTM_1FC_INPUT_NORM_SCALE MUST FIT IN 24 BITS!");
+static_assert((LSTM_1FC_INPUT_NORM_OFFSET < (1<<23)) && (LSTM_1FC_INPUT_NORM_OFFSET >= -(1<<23)), "LSTM_1FC_INPUT_NORM_OFFSET MUST FIT IN 24 BITS!");
+static_assert(0==(AUDIO_INPUT_FEATURE_HEIGHT&1), "AXPB LENGTH MUST BE A MULTIPLE OF 2!");
+#else
+# define LSTM_1FC_INPUT_NORM_OP_CNT 0
+#endif
+
+#define TOTAL_OP_HANDLES       (LSTM_1FC_INPUT_NORM_OP_CNT+MAX_LSTM_CELL_OPS+MAX_FC_LAYER_OPS)
 
 /*
  * internal struct for the LSTM_1FC LSTM based model
@@ -106,11 +136,75 @@ int32_t lstm_1fc_buff2[LSTM_1FC_L1_OUTPUT_LENGTH];
  */
 int32_t ct_buff[LSTM_1FC_L1_HIDDEN_LAYER_LENGTH]; //FIXME this should be the maximum of all the hidden layers required in the LSTM model
 
+#if LSTM_1FC_AXON_INPUT_NORMALIZATION
+/*
+ * raw slice gets copied here, the normalization ops write it into io_buffer.
+ */
+static int32_t lstm_1fc_raw_slice[AUDIO_INPUT_FEATURE_HEIGHT];
+
+/*
+ * Defines the input normalization ops (see LSTM_1FC_AXON_INPUT_NORMALIZATION)
+ */
+static AxonResultEnum lstm_1fc_define_input_normalization(void *axon_handle, AxonOpHandle axon_op_handles[], int32_t *io_buffer) {
+  AxonResultEnum result;
+  AxonInputStruct axon_input;
+
+  axon_input.data_width = kAxonDataWidth24;
+  axon_input.data_packing = kAxonDataPackingDisabled;
+  axon_input.x_stride = kAxonStride1;
+  axon_input.y_stride = kAxonStride1;
+  axon_input.q_stride = kAxonStride1;
+  axon_input.length = AUDIO_INPUT_FEATURE_HEIGHT;
+  axon_input.y_in = NULL;
+  axon_input.y_length = 0;
+
+  // t = x - MIN - MAX/510
+  axon_input.x_in = lstm_1fc_raw_slice;
+  axon_input.q_out = io_buffer;
+  axon_input.a_in = 1;
+  axon_input.b_in = LSTM_1FC_INPUT_NORM_OFFSET;
+  axon_input.output_rounding = kAxonRoundingNone;
+  axon_input.output_af = kAxonAfDisabled;
+  if (kAxonResultSuccess > (result = AxonApiDefineOpAxpb(axon_handle, &axon_input, axon_op_handles+0))) {
+    return result;
+  }
+
+  // u = (t*SCALE) >> ROUNDING, in place from here on.
+  axon_input.x_in = io_buffer;
+  axon_input.a_in = LSTM_1FC_INPUT_NORM_SCALE;
+  axon_input.b_in = 0;
+  axon_input.output_rounding = LSTM_1FC_INPUT_NORM_ROUNDING;
+  if (kAxonResultSuccess > (result = AxonApiDefineOpAxpb(axon_handle, &axon_input, axon_op_handles+1))) {
+    AxonApiFreeOpHandles(axon_handle, 1, axon_op_handles);
+    return result;
+  }
+
+  // w = relu(255 - u)
+  axon_input.a_in = -1;
+  axon_input.b_in = LSTM_1FC_L1_INPUT_QUANTIZE_INV_SCALING_FACTOR;
+  axon_input.output_rounding = kAxonRoundingNone;
+  axon_input.output_af = kAxonAfRelu;
+  if (kAxonResultSuccess > (result = AxonApiDefineOpAxpb(axon_handle, &axon_input, axon_op_handles+2))) {
+    AxonApiFreeOpHandles(axon_handle, 2, axon_op_handles);
+    return result;
+  }
+
+  // out = 127 - w
+  axon_input.b_in = LSTM_1FC_L1_INPUT_QUANTIZE_INV_SCALING_FACTOR-128;
+  axon_input.output_af = kAxonAfDisabled;
+  if (kAxonResultSuccess > (result = AxonApiDefineOpAxpb(axon_handle, &axon_input, axon_op_handles+3))) {
+    AxonApiFreeOpHandles(axon_handle, 3, axon_op_handles);
+    return result;
+  }
+  return kAxonResultSuccess;
+}
+#else
 /*
  * arrays sized to the audio features height to
  * normalize the inputs for the next slice
  */
 int32_t input_buffer[AUDIO_INPUT_FEATURE_HEIGHT] = {0};
+#endif
 
 static int axon_kws_model_lstm_1fc_prepare(void * axon_handle,
     AxonOpHandle axon_op_handles[],
@@ -132,6 +226,16 @@ static int axon_kws_model_lstm_1fc_prepare(void * axon_handle,
   uint8_t total_ops_needed = 0;
   tmp_op_handle_cnt=*op_handle_count-total_ops_needed;
 
+#if LSTM_1FC_AXON_INPUT_NORMALIZATION
+  // normalization ops lead the per-slice op list
+  if (kAxonResultSuccess != (result = lstm_1fc_define_input_normalization(axon_handle, axon_op_handles, io_buffer))) {
+    axon_printf(axon_handle, "Define LSTM_1FC input normalization failed! %d\r\n" , result);
+    return result;
+  }
+  total_ops_needed += LSTM_1FC_INPUT_NORM_OP_CNT;
+  tmp_op_handle_cnt=*op_handle_count-total_ops_needed;
+#endif
+
   // define LSTM cell Layer1
 
   result = AxonApiDefineOpListLstmCellWithStopStep(
@@ -269,6 +373,7 @@ AxonResultEnum AxonKwsModelLstm1fcPrepare(void *axon_handle, void (*result_callb
       LSTM_1FC_L1_HIDDEN_LAYER_LENGTH);
 }
 
+#if !LSTM_1FC_AXON_INPUT_NORMALIZATION
 /*
  * get the input slice and normalize it
  */
@@ -286,6 +391,7 @@ static void lstm_1fc_get_input_slice_and_normalize(){
     input_buffer[ndx] = ((-128)+(((LSTM_1FC_L1_INPUT_QUANTIZE_INV_SCALING_FACTOR)*norm))/(LSTM_1FC_L1_INPUT_NORM_MAX_VALUE));
   }
 }
+#endif
 
 /*
 * callback function invoked when the classification has completed
@@ -308,7 +414,7 @@ static AxonResultEnum lstm_1fc_calculate_results() {
   lstm_1fc_queued_ops.callback_function = lstm_1fc_classify_complete_callback;
   lstm_1fc_queued_ops.callback_context = NULL;
   lstm_1fc_queued_ops.op_handle_count = lstm_1fc_retained_info.fc_layers_op_handle_count;
-  return AxonApiQueueOpsList(lstm_1fc_retained_info.axon_handle,&lstm_1fc_queued_ops);
+  return AXON_KWS_STATS_QUEUE_OPS_LIST(lstm_1fc_retained_info.axon_handle,&lstm_1fc_queued_ops);
 }
 
 static void lstm_1fc_slice_ops_done_callback(AxonResultEnum result, void *callback_context) {
@@ -328,24 +434,33 @@ AxonResultEnum lstm_1fc_process_frame() {
 
   AxonResultEnum result;
   
+#if LSTM_1FC_AXON_INPUT_NORMALIZATION
+  //copy the raw slice in, the normalization ops write it into the io_buffer
+  const AudioInputFeatureType *slice_ptr;
+  AxonKwsHostGetNextAudioFeatureSlice(&slice_ptr);
+  memcpy(lstm_1fc_raw_slice,slice_ptr,sizeof(AudioInputFeatureType)*AUDIO_INPUT_FEATURE_HEIGHT);
+#else
   //copy the normalized input vector into the io_buffer
   memcpy(lstm_1fc_io_buffer,input_buffer,sizeof(AudioInputFeatureType)*AUDIO_INPUT_FEATURE_HEIGHT);
+#endif
 
   lstm_1fc_queued_ops.op_handle_list = lstm_1fc_retained_info.axon_op_handles;
   lstm_1fc_queued_ops.callback_function = lstm_1fc_slice_ops_done_callback;
   lstm_1fc_queued_ops.callback_context = NULL;
   lstm_1fc_queued_ops.op_handle_count = lstm_1fc_retained_info.lstm_cell_op_handle_count;
-  result = AxonApiQueueOpsList(lstm_1fc_retained_info.axon_handle, &lstm_1fc_queued_ops);
+  result = AXON_KWS_STATS_QUEUE_OPS_LIST(lstm_1fc_retained_info.axon_handle, &lstm_1fc_queued_ops);
   if (result<kAxonResultSuccess) { //error
     return result;
   }
   
+#if !LSTM_1FC_AXON_INPUT_NORMALIZATION
   if(lstm_1fc_retained_info.slice_ndx<(lstm_1fc_retained_info.slice_count-1)){
     //as we are calculating the normalized inputs for the next frame before the function is called,
     //we do not have to calculate it for the very last one as we have already done it
     //so we call this for N-1 times
     lstm_1fc_get_input_slice_and_normalize();
   }
+#endif
 
   return kAxonResultSuccess;
 }
@@ -368,9 +483,11 @@ AxonResultEnum AxonKwsModelLstm1fcInfer(uint8_t slice_count){
   memset(lstm_1fc_io_buffer, 0, sizeof(AudioInputFeatureType)*LSTM_1FC_IO_BUFFER_SIZE);
   memset(ct_buff, 0, sizeof(AudioInputFeatureType)*LSTM_1FC_L1_HIDDEN_LAYER_LENGTH);
 
+#if !LSTM_1FC_AXON_INPUT_NORMALIZATION
   //get the normalized input for the first time,
   //the same function is called right after the axon operations are queued
   lstm_1fc_get_input_slice_and_normalize();
+#endif
   return lstm_1fc_process_frame();
 }
 
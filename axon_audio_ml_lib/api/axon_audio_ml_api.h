@@ -78,6 +78,12 @@ int AxonKwsClearLastResult(const char **result_label);
  */
 int AxonKwsLastFrameWasForeground();
 
+/**
+ * returns 1 once the previous frame's audio features are done, so AxonKwsProcessFrame() will take the next
+ * frame of the session. Check it with interrupts disabled before sleeping on a frame that was refused.
+ */
+int AxonKwsReadyForFrame();
+
 /**
  * Call-back function implemented by host. Invoked by library when the start of a valid
  * window of audio has been detected. Users should read in any audio features from this function
@@ -105,6 +111,44 @@ extern void AxonMlDemoHostClassifyingEnd(uint32_t classification_number);
  */
 extern void AxonMlDemoHostNoClassification();
 
+/*
+ * Completion stages of a KWS session. Normally each stage runs in the context it completed in
+ * (Axon ISR context in asynchronous mode). An RTOS host (AXON_APP_RTOS) has them handed to
+ * AxonMlDemoHostDeferCompletion() instead, and runs them from its tasks with AxonKwsRunCompletion().
+ */
+typedef enum {
+  kAxonMlCompletionFeatures,       /**< audio features for a frame are done, raised in Axon ISR context */
+  kAxonMlCompletionClassifyWindow, /**< a valid window was found, raised by the task running kAxonMlCompletionFeatures */
+  kAxonMlCompletionClassification, /**< final classification is done, raised in Axon ISR context */
+  kAxonMlCompletionModelService,   /**< the model has work for task context (FC4 weight tile reads), raised in Axon ISR context */
+  kAxonMlCompletionCount,
+} AxonMlCompletionEnum;
+
+/**
+ * Runs a completion stage. result is the one passed to AxonMlDemoHostDeferCompletion().
+ */
+void AxonKwsRunCompletion(AxonMlCompletionEnum completion, AxonResultEnum result);
+
+/**
+ * Does the work the model handed off from its Axon callbacks, if any. Runs as kAxonMlCompletionModelService
+ * on an RTOS host; other hosts call it from their main loop.
+ */
+void AxonKwsServiceModel();
+
+/**
+ * returns 1 if the model is waiting on AxonKwsServiceModel(). Check it with interrupts disabled before
+ * sleeping; axon may be idle until the work is done.
+ */
+int AxonKwsModelServicePending();
+
+#if AXON_APP_RTOS
+/**
+ * Call-back function implemented by an RTOS host, invoked in place of running a completion stage.
+ * The host is expected to call AxonKwsRunCompletion() from task context.
+ */
+extern void AxonMlDemoHostDeferCompletion(AxonMlCompletionEnum completion, AxonResultEnum result);
+#endif
+
 /**
  * Call-back function implemented by host to put axon in its lowest power state
  * enabled=True  : turns on the clock and power to Axon
@@ -0,0 +1,212 @@
+/**
+ *          Copyright (c) 2020-2022, Atlazo Inc.
+ *          All rights reserved.
+ *
+ *          Licensed under the Apache License, Version 2.0 (the "License");
+ *          you may not use this file except in compliance with the License.
+ *          You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *          Unless required by applicable law or agreed to in writing, software
+ *          distributed under the License is distributed on an "AS IS" BASIS,
+ *          WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *          See the License for the specific language governing permissions and
+ *          limitations under the License.
+ *
+ */
+#pragma once
+
+#include <assert.h>
+#include "axon_api.h"
+#include "axon_gru_cell_api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Layer graph executor
+ * Runs a sequential model described by a table of nodes instead of a hand written op list.
+ * AxonLayerGraphGetRequirements() sizes the op handles and buffers a graph needs, AxonLayerGraphPrepare()
+ * defines every node's ops back to back in one list, and AxonLayerGraphInfer() queues that list.
+ *
+ * Nodes pass their output to the next node in place in io_buffer, as int32s.
+ * Window graphs take the whole window of int8 features, flattened, and run every node once.
+ * Per-slice graphs start with one recurrent node (lstm, grnn or gru cell) that runs once per slice; the
+ * remaining nodes run once after the last slice on the final hidden vector. The recurrent node needs the
+ * CPU between slices to fetch the next slice, so per-slice graphs queue the slice ops and then the tail ops.
+ */
+
+typedef enum {
+  kAxonLayerNodeDense,      /**< quantized fully connected, see AxonApiDefineOpListFullyConnectedWithStopStep() */
+  kAxonLayerNodeLstmCell,   /**< see AxonApiDefineOpListLstmCellWithStopStep() */
+  kAxonLayerNodeGrnnCell,   /**< FastGRNN cell, int8 [x;h] and 24 bit gates */
+  kAxonLayerNodeActivation, /**< AxonApiDefineOpAf() over the previous node's output */
+  kAxonLayerNodeSoftmax,    /**< computed on the CPU when the output is read, must be the last node */
+  kAxonLayerNodeGruCell,    /**< see AxonGruCellDefineOpListWithStopStep(), int8 [x;h] */
+  kAxonLayerNodeTypeCount,
+} AxonLayerNodeTypeEnum;
+
+typedef enum {
+  kAxonLayerGraphExecuteWindow,   /**< every node runs once per window */
+  kAxonLayerGraphExecutePerSlice, /**< 1st node runs once per slice, the rest once per window */
+} AxonLayerGraphExecutionEnum;
+
+/*
+ * Field names follow AxonApiDefineOpListFullyConnectedWithStopStep().
+ */
+typedef struct {
+  uint16_t row_length;                 /**< weights per row, >= input_length. Rows in RAM must be a multiple of 16 */
+  const int8_t *weights;               /**< output_length rows of row_length */
+  const int32_t *bias_prime;
+  int32_t bias_add_multiplier;
+  uint16_t bias_add_rounding;
+  AxonAfEnum activation_function;
+  const int32_t *normalization_mult;   /**< NULL if none */
+  uint8_t norm_mult_rounding;
+  const int32_t *normalization_add;    /**< NULL if none */
+  uint8_t norm_add_rounding;
+  int32_t quantize_multiplier;
+  int32_t quantize_add;
+  uint8_t quantize_rounding;
+  int32_t standalone_quantize_add;
+} AxonLayerDenseParamsStruct;
+
+/*
+ * Field names follow AxonApiDefineOpListLstmCellWithStopStep().
+ */
+typedef struct {
+  const int8_t *weights;               /**< output_length rows of input_length */
+  const int32_t *bias_prime;
+  int32_t bias_add_multiplier;
+  uint16_t bias_add_rounding;
+  AxonAfEnum activation_function;
+  AxonAfEnum recurrent_activation_function;
+  uint8_t multiply_rounding;
+  uint8_t hidden_multiply_rounding;
+  int32_t hidden_multiplier;
+  int32_t hidden_add;
+  uint8_t hidden_rounding;
+} AxonLayerLstmParamsStruct;
+
+/*
+ * FastGRNN: z = af(W*x+U*h+Bg), h_hat = af(W*x+U*h+Bh), h = z*h + (zeta*(1-z)+nu)*h_hat.
+ * x and h share hidden_q. The gates are q1.8 as the sigmoids produce them.
+ */
+typedef struct {
+  const int8_t *weights;               /**< [W|U], hidden_length rows of input_length */
+  const int32_t *bias_g;               /**< hidden_length, same q as the matrix multiply output */
+  const int32_t *bias_h;               /**< hidden_length, same q as the matrix multiply output */
+  uint8_t weights_rounding;            /**< rounds the matrix multiply output to the q of the biases */
+  uint8_t gate_rounding;               /**< rounds the biased output to q.8 for the activation */
+  AxonAfEnum gate_af;                  /**< z */
+  AxonAfEnum candidate_af;             /**< h_hat */
+  int16_t minus_zeta_q7;
+  int32_t nu_plus_zeta_q15;
+  uint8_t hidden_q;
+} AxonLayerGrnnParamsStruct;
+
+/*
+ * Field names follow AxonGruCellDefineOpListWithStopStep(). x and h share hidden_q.
+ */
+typedef struct {
+  const int8_t *weights;               /**< 4*hidden_length rows of input_length. Must be in RAM and 16 byte aligned */
+  const int32_t *bias;                 /**< bz, br, bin, bhn */
+  uint8_t weights_rounding;
+  uint8_t gate_rounding;
+  AxonAfEnum activation_function;
+  AxonAfEnum recurrent_activation_function;
+  uint8_t hidden_q;
+} AxonLayerGruParamsStruct;
+
+typedef struct {
+  uint8_t node_type;                   /**< AxonLayerNodeTypeEnum */
+  uint8_t input_data_width;            /**< AxonDataWidthEnum, dense and lstm only. The 1st node's must be kAxonDataWidth8 for
+                                            window graphs (int8 features) and kAxonDataWidth24 for lstm (1 int32 per feature) */
+  uint16_t input_length;               /**< recurrent nodes: features + hidden length */
+  uint16_t output_length;              /**< lstm: 4 x hidden length. grnn/gru: hidden length. activation/softmax: same as input_length */
+  uint16_t hidden_length;              /**< recurrent nodes only */
+  union {
+    AxonLayerDenseParamsStruct dense;
+    AxonLayerLstmParamsStruct lstm;
+    AxonLayerGrnnParamsStruct grnn;
+    AxonLayerGruParamsStruct gru;
+    AxonAfEnum activation_function;    /**< activation */
+    uint8_t softmax_input_q;           /**< softmax, fractional bits of its input. Output is q.15 */
+  } params;
+} AxonLayerNodeStruct;
+
+typedef struct {
+  const AxonLayerNodeStruct *nodes;
+  uint8_t node_cnt;
+  uint8_t execution;                   /**< AxonLayerGraphExecutionEnum */
+  uint8_t input_width;                 /**< slices per window */
+  uint8_t input_height;                /**< int8 features per slice */
+} AxonLayerGraphStruct;
+
+/*
+ * What a graph needs, all lengths in int32s.
+ * op_handle_cnt is an upper bound; the number actually defined is in AxonLayerGraphInstanceStruct after prepare.
+ */
+typedef struct {
+  uint16_t op_handle_cnt;
+  uint16_t io_buffer_length;
+  uint16_t buf_length;                 /**< each of buf1 and buf2 */
+  uint16_t state_buffer_length;        /**< recurrent node state (lstm cell state, grnn/gru vectors) */
+} AxonLayerGraphRequirementsStruct;
+
+typedef struct {
+  /*
+   * supplied by the caller before AxonLayerGraphPrepare().
+   */
+  const AxonLayerGraphStruct *graph;   /**< graph and its nodes must stay valid while in use */
+  int32_t *io_buffer;                  /**< 16 byte aligned */
+  int32_t *buf1;
+  int32_t *buf2;
+  int32_t *state_buffer;               /**< 16 byte aligned */
+  AxonOpHandle *op_handles;            /**< must be in retained memory */
+  uint16_t io_buffer_length;
+  uint16_t buf_length;
+  uint16_t state_buffer_length;
+  uint16_t op_handle_length;
+  int (*get_next_slice)(const int8_t **slice); /**< returns 1 slice of input_height int8 features, negative on failure */
+  void (*result_callback_function)(AxonResultEnum result);
+  /*
+   * filled in by the executor.
+   */
+  void *axon_handle;
+  uint16_t op_handle_cnt;
+  uint16_t slice_op_handle_cnt;        /**< per-slice ops at the start of op_handles (per-slice graphs only) */
+  uint8_t slice_ndx;
+  volatile uint8_t softmax_pending;    /**< set when the output is ready, the softmax is applied when it is read */
+  AxonMgrQueuedOpsStruct queued_ops;
+} AxonLayerGraphInstanceStruct;
+
+/*
+ * Checks a graph's nodes fit together and fills in what it needs.
+ */
+AxonResultEnum AxonLayerGraphGetRequirements(const AxonLayerGraphStruct *graph, AxonLayerGraphRequirementsStruct *requirements);
+
+/*
+ * Checks the instance's buffers against the graph's requirements (kAxonResultBufferTooSmall)
+ * and defines the ops of every node.
+ */
+AxonResultEnum AxonLayerGraphPrepare(void *axon_handle, AxonLayerGraphInstanceStruct *instance);
+
+/*
+ * Runs the graph over one window, fetching slices with get_next_slice. result_callback_function
+ * is invoked when the output is ready.
+ */
+AxonResultEnum AxonLayerGraphInfer(AxonLayerGraphInstanceStruct *instance);
+
+/*
+ * Returns the last node's output (output_length int32s).
+ * A trailing softmax is computed here, the 1st time the output is read after an inference, so the float math
+ * runs in the caller's context rather than the axon callback.
+ */
+const int32_t *AxonLayerGraphOutput(AxonLayerGraphInstanceStruct *instance, uint16_t *output_length);
+
+#ifdef __cplusplus
+} // extern "C" {
+#endif
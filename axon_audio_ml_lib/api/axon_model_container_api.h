@@ -0,0 +1,165 @@
+/**
+ *          Copyright (c) 2020-2022, Atlazo Inc.
+ *          All rights reserved.
+ *
+ *          Licensed under the Apache License, Version 2.0 (the "License");
+ *          you may not use this file except in compliance with the License.
+ *          You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *          Unless required by applicable law or agreed to in writing, software
+ *          distributed under the License is distributed on an "AS IS" BASIS,
+ *          WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *          See the License for the specific language governing permissions and
+ *          limitations under the License.
+ *
+ */
+#pragma once
+
+#include <assert.h>
+#include <stddef.h>
+#include "axon_api.h"
+#include "axon_layer_graph_api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Binary model container
+ * A model's layer shapes, quantization parameters and weight blobs in one image that is read at run time
+ * instead of being compiled in. The image can be programmed into a flash region or read from a file on host builds.
+ *
+ * Layout (little endian):
+ *   AxonModelContainerHeaderStruct
+ *   AxonModelContainerLayerStruct[layer_cnt]
+ *   blobs, each starting on an AXON_MODEL_CONTAINER_ALIGNMENT boundary, located by offsets from the start of the container.
+ *
+ * crc32 (IEEE 802.3, as zlib) covers everything from header_length to the end of the container.
+ * Readers accept any minor version of their major version; minor versions only use reserved fields.
+ *
+ * Blobs are used in place. The driver reads weights that aren't available to axon (AxonHostAddressAvailableToAxon())
+ * through its line buffers. Weights that are available to axon are used directly, which requires rows that are a
+ * multiple of 16 long; writers pad fully connected rows with 0 weights to row_length (the padding inputs contribute nothing).
+ */
+#define AXON_MODEL_CONTAINER_MAGIC 0x434d5841 // "AXMC"
+#define AXON_MODEL_CONTAINER_VERSION_MAJOR 1
+#define AXON_MODEL_CONTAINER_VERSION_MINOR 0
+#define AXON_MODEL_CONTAINER_ALIGNMENT 16
+#define AXON_MODEL_CONTAINER_MAX_LAYERS 8
+
+/*
+ * container specific results, in addition to AxonResultEnum
+ */
+#define kAxonModelContainerResultBadMagic   (-100) /**< not a container */
+#define kAxonModelContainerResultBadVersion (-101) /**< unsupported major version */
+#define kAxonModelContainerResultBadCrc     (-102) /**< checksum mismatch */
+#define kAxonModelContainerResultBadLayout  (-103) /**< an offset, length or alignment is inconsistent */
+
+typedef enum {
+  kAxonModelLayerFullyConnected,
+  kAxonModelLayerLstmCell,
+} AxonModelLayerTypeEnum;
+
+typedef enum {
+  kAxonModelExecuteWindow = kAxonLayerGraphExecuteWindow,     /**< input is the whole window of features, flattened; layers run once per window (FC4) */
+  kAxonModelExecutePerSlice = kAxonLayerGraphExecutePerSlice, /**< leading recurrent layer runs once per slice, remaining layers once per window (LSTM_1FC) */
+} AxonModelExecutionEnum;
+
+typedef struct {
+  uint32_t magic;                      /**< AXON_MODEL_CONTAINER_MAGIC */
+  uint16_t version_major;
+  uint16_t version_minor;
+  uint32_t total_length;               /**< bytes, including this header */
+  uint32_t crc32;
+  uint16_t header_length;              /**< sizeof(AxonModelContainerHeaderStruct), layers follow */
+  uint8_t layer_cnt;
+  uint8_t execution;                   /**< AxonModelExecutionEnum */
+  uint8_t feature_variant;             /**< AxonAudioFeatureVariantsEnum */
+  uint8_t input_width;                 /**< slices per window */
+  uint8_t input_height;                /**< features per slice */
+  int8_t quantization_zero_point;      /**< feature quantization, see AxonAudioFeaturePrepare() */
+  int32_t quantization_inv_scale_factor;
+  uint8_t quantization_inv_scale_factor_q_factor;
+  uint8_t normalization_inv_std_devs_q_factor;
+  uint8_t label_cnt;                   /**< same as the last layer's output length */
+  uint8_t reserved;
+  uint32_t normalization_means_offset; /**< q11.12 means, 0 if none */
+  uint32_t normalization_inv_std_devs_offset; /**< 0 if none */
+  uint32_t labels_offset;              /**< label_cnt nul terminated strings back to back, 0 if none */
+} AxonModelContainerHeaderStruct;
+static_assert(0==(sizeof(AxonModelContainerHeaderStruct)&3), "CONTAINER HEADER MUST BE A MULTIPLE OF 4!");
+
+/*
+ * crc covers everything after the crc field.
+ */
+#define AXON_MODEL_CONTAINER_CRC_START offsetof(AxonModelContainerHeaderStruct, header_length)
+
+/*
+ * One per layer. Field names follow AxonApiDefineOpListFullyConnectedWithStopStep() and
+ * AxonApiDefineOpListLstmCellWithStopStep().
+ */
+typedef struct {
+  uint8_t layer_type;                  /**< AxonModelLayerTypeEnum */
+  uint8_t input_data_width;            /**< AxonDataWidthEnum */
+  uint8_t activation_function;         /**< AxonAfEnum */
+  uint8_t recurrent_activation_function; /**< AxonAfEnum, lstm only */
+  uint16_t input_length;               /**< lstm: features + hidden length */
+  uint16_t row_length;                 /**< weights per row, >= input_length */
+  uint16_t output_length;              /**< lstm: 4 x hidden length */
+  uint16_t hidden_length;              /**< lstm only */
+  int32_t bias_add_multiplier;
+  uint16_t bias_add_rounding;
+  uint8_t norm_mult_rounding;
+  uint8_t norm_add_rounding;
+  uint8_t quantize_rounding;           /**< lstm: hidden layer rounding */
+  uint8_t multiply_rounding;           /**< lstm only */
+  uint8_t hidden_multiply_rounding;    /**< lstm only */
+  uint8_t reserved;
+  int32_t quantize_multiplier;         /**< lstm: hidden layer multiplier */
+  int32_t quantize_add;                /**< lstm: hidden layer add */
+  int32_t standalone_quantize_add;
+  uint32_t weights_offset;             /**< output_length rows of row_length int8s */
+  uint32_t bias_prime_offset;          /**< output_length int32s */
+  uint32_t normalization_mult_offset;  /**< output_length int32s, 0 if none */
+  uint32_t normalization_add_offset;   /**< output_length int32s, 0 if none */
+} AxonModelContainerLayerStruct;
+static_assert(0==(sizeof(AxonModelContainerLayerStruct)&3), "CONTAINER LAYER MUST BE A MULTIPLE OF 4!");
+
+/*
+ * Validates a container of up to max_length bytes (magic, version, length, checksum, offsets and alignment)
+ * and returns its header and layers.
+ */
+AxonResultEnum AxonModelContainerOpen(const void *container, uint32_t max_length,
+    const AxonModelContainerHeaderStruct **header,
+    const AxonModelContainerLayerStruct **layers);
+
+/*
+ * Returns a pointer to a blob in the container, NULL for offset 0.
+ */
+const void *AxonModelContainerBlob(const AxonModelContainerHeaderStruct *header, uint32_t offset);
+
+/*
+ * Returns the nth label, or "" if the container has none.
+ */
+const char *AxonModelContainerLabel(const AxonModelContainerHeaderStruct *header, uint8_t label_ndx);
+
+/*
+ * Fills in the layer graph node for a container layer. Blobs are referenced in place.
+ */
+AxonResultEnum AxonModelContainerLayerToNode(const AxonModelContainerHeaderStruct *header,
+    const AxonModelContainerLayerStruct *layer,
+    AxonLayerNodeStruct *node);
+
+/*
+ * Used by container writers after laying out the container: fills in magic, version, total_length and crc32
+ * (AxonCrc32()).
+ * It lives in axon_model_container_writer.c, which has no driver dependencies so host tools can link it with
+ * axon_utils/src/axon_crc32.c.
+ */
+void AxonModelContainerFinalize(void *container, uint32_t total_length);
+
+#ifdef __cplusplus
+} // extern "C" {
+#endif
@@ -22,12 +22,15 @@
 #include "axon_audio_features_api.h"
 #include "axon_audio_framework_api.h"
 #include "axon_logging_api.h"
+#include "axon_kws_stats_api.h"
 #include "axon_audio_ml_api.h"
+#include "axon_gru_cell_api.h"
 
 extern AxonInstanceStruct *gl_axon_instance;
 #define AXON_GRNN 1
 #define AXON_FC4  2
 #define AXON_LSTM  3
+#define AXON_CONTAINER 4
 
 #if AXON_NN_TYPE==AXON_GRNN
 # include "axon_grnn_api.h"
@@ -41,14 +44,38 @@ extern AxonInstanceStruct *gl_axon_instance;
 # define AxonKwsModelGetClassification AxonKwsModelFc4GetClassification
 # define AxonKwsModelGetInputAttributes AxonKwsModelFc4GetInputAttributes
 # define AxonKwsModelPrepare AxonKwsModelFc4Prepare
+# define AxonKwsModelSetWeightLoadRequest AxonKwsModelFc4SetWeightLoadRequest
+# define AxonKwsModelLoadWeights AxonKwsModelFc4LoadWeights
 #elif AXON_NN_TYPE==AXON_LSTM
 # include "axon_kws_model_lstm_1fc_api.h"
 # define AxonKwsModelInfer AxonKwsModelLstm1fcInfer
 # define AxonKwsModelGetClassification AxonKwsModelLstm1fcGetClassification
 # define AxonKwsModelGetInputAttributes AxonKwsModelLstm1fcGetInputAttributes
 # define AxonKwsModelPrepare AxonKwsModelLstm1fcPrepare
+#elif AXON_NN_TYPE==AXON_CONTAINER
+# include "axon_kws_model_container_api.h"
+# define AxonKwsModelInfer AxonKwsModelContainerInfer
+# define AxonKwsModelGetClassification AxonKwsModelContainerGetClassification
+# define AxonKwsModelGetInputAttributes AxonKwsModelContainerGetInputAttributes
+# define AxonKwsModelPrepare AxonKwsModelContainerPrepare
+/*
+ * Where the model container lives, typically a flash region programmed separately from the firmware.
+ * Host builds can point this at a buffer the container file has been read into.
+ */
+# ifndef AXON_MODEL_CONTAINER_ADDRESS
+#  define AXON_MODEL_CONTAINER_ADDRESS 0x20080000
+# endif
+# ifndef AXON_MODEL_CONTAINER_MAX_LENGTH
+#  define AXON_MODEL_CONTAINER_MAX_LENGTH (256*1024)
+# endif
 #endif
 
+/*
+ * GRNN only: set to 1 to classify every test sample with both the 16 bit and int8 hidden state
+ * and print the classifications, nn times and how often the int8 result agrees with the 16 bit one.
+ */
+#define AXON_GRNN_COMPARE_HIDDEN_STATE_WIDTHS 0
+
 
 #define AUDIO_SAMPLE_GROUP_0 0
 #define AUDIO_SAMPLE_GROUP_DAN_DOWN 2
@@ -511,8 +538,21 @@ struct {
 } axon_nn_state_info;
 
 
-#if AXON_NN_TYPE==AXON_FC4
+/*
+ * only FC4 hands weight reads off to task context.
+ */
+#ifndef AxonKwsModelLoadWeights
+# define AxonKwsModelSetWeightLoadRequest(request_function) ((void)(request_function))
+# define AxonKwsModelLoadWeights() ((void)0)
+#endif
 
+/*
+ * Completion stages either run where they complete, or are handed to the RTOS host's tasks.
+ */
+#if AXON_APP_RTOS
+#  define KWS_COMPLETE(completion, result) AxonMlDemoHostDeferCompletion((completion), (result))
+#else
+#  define KWS_COMPLETE(completion, result) AxonKwsRunCompletion((completion), (result))
 #endif
 
 
@@ -521,6 +561,7 @@ struct {
  * Called when a final classification completes.
  */
 static void process_final_classification_complete(AxonResultEnum result) {
+  uint32_t elapsed_time;
 
   if (kAxonResultSuccess > axon_nn_state_info.result) {
     AxonPrintf(gl_axon_instance, "kws inference failed! %d \r\n", axon_nn_state_info.result);
@@ -533,8 +574,11 @@ static void process_final_classification_complete(AxonResultEnum result) {
   axon_nn_state_info.output_score.classification =
       AxonKwsModelGetClassification(&axon_nn_state_info.output_score.score, &axon_nn_state_info.output_score.label);
 
-  axon_nn_state_info.nn_final_elapsed_time += (AxonHostGetTime()-axon_nn_state_info.start_time);
+  elapsed_time = AxonHostGetTime()-axon_nn_state_info.start_time;
+  axon_nn_state_info.nn_final_elapsed_time += elapsed_time;
   axon_nn_state_info.total_classifications++;
+  AXON_KWS_STATS_STAGE(kAxonKwsStatsStageModel, elapsed_time);
+  AXON_KWS_STATS_COUNT(kAxonKwsStatsClassifications, 1);
 
 
   axon_nn_state_info.ml_async_state = kAxonMlAsyncStateComplete;
@@ -617,9 +661,12 @@ static void classify_window_start() {
  * Called synchronously and asynchronously when the audio feature calculation has completed.
  */
 static void process_feature_complete(AxonResultEnum result) {
+  uint32_t elapsed_time = AxonHostGetTime()-axon_nn_state_info.start_time;
+
   // increment audio_features circular buffer index
   axon_nn_state_info.audio_featues_buf_head_ndx = AXON_AUDIO_FEATURES_NEXT_NDX(axon_nn_state_info.audio_featues_buf_head_ndx, AXON_AUDIO_FEATURES_SLICE_CNT);
-  axon_nn_state_info.audio_features_elapsed_time += AxonHostGetTime()-axon_nn_state_info.start_time;
+  axon_nn_state_info.audio_features_elapsed_time += elapsed_time;
+  AXON_KWS_STATS_STAGE(kAxonKwsStatsStageFeatures, elapsed_time);
 
   // debug - print bg/fg stats to see sample energy
   // AxonBgFgPrintStats();
@@ -630,13 +677,15 @@ static void process_feature_complete(AxonResultEnum result) {
     // user can specify how many frames to classify on by adding that value to classify_option
     if (axon_nn_state_info.classify_option>kDoClassify) {
       axon_nn_state_info.bgfg_window_width = axon_nn_state_info.classify_option-kDoClassify;
+    } else if (axon_nn_state_info.classify_option==kClassifyOnValidWindow) {
+      AXON_KWS_STATS_COUNT(kAxonKwsStatsVadWindows, 1);
     }
 
     // if there was no early detect of the window start, alert now.
     // tell the caller that classification has started (and we'll be awhile)
     AxonMlDemoHostClassifyingStart(AxonAudioFeaturesBgFgWindowFirstFrame(), AxonAudioFeaturesBgFgWindowWidth());
 
-    classify_window_start(axon_nn_state_info.bgfg_window_width);
+    KWS_COMPLETE(kAxonMlCompletionClassifyWindow, kAxonResultSuccess);
   } else {
     //turn off Axon Clk and Power
     AxonMlDemoHostAxonSetEnabled(kAxonBoolFalse);
@@ -654,6 +703,64 @@ static void process_feature_complete(AxonResultEnum result) {
 
 }
 
+void AxonKwsRunCompletion(AxonMlCompletionEnum completion, AxonResultEnum result) {
+  switch (completion) {
+  case kAxonMlCompletionFeatures:
+    process_feature_complete(result);
+    break;
+  case kAxonMlCompletionClassifyWindow:
+    classify_window_start();
+    break;
+  case kAxonMlCompletionClassification:
+    process_final_classification_complete(result);
+    break;
+  case kAxonMlCompletionModelService:
+    AxonKwsServiceModel();
+    break;
+  default:
+    break;
+  }
+}
+
+/*
+ * callbacks given to the feature and model libraries.
+ */
+static void feature_complete_callback(AxonResultEnum result) {
+  KWS_COMPLETE(kAxonMlCompletionFeatures, result);
+}
+
+static void final_classification_complete_callback(AxonResultEnum result) {
+  KWS_COMPLETE(kAxonMlCompletionClassification, result);
+}
+
+static volatile uint8_t kws_model_service_pending;
+
+/*
+ * given to the model, invoked in Axon ISR context when it has work for task context.
+ */
+static void model_service_request_callback() {
+  kws_model_service_pending = 1;
+#if AXON_APP_RTOS
+  AxonMlDemoHostDeferCompletion(kAxonMlCompletionModelService, kAxonResultSuccess);
+#endif
+}
+
+void AxonKwsServiceModel() {
+  while (kws_model_service_pending) {
+    kws_model_service_pending = 0;
+    AxonKwsModelLoadWeights();
+  }
+}
+
+int AxonKwsModelServicePending() {
+  return kws_model_service_pending;
+}
+
+int AxonKwsReadyForFrame() {
+  return (axon_nn_state_info.ml_async_state==kAxonMlAsyncStateIdle) ||
+      (axon_nn_state_info.ml_async_state==kAxonMlAsyncStateFeatureWaitForAudio);
+}
+
 int AxonKwsLastFrameWasForeground() {
   // AxonBgFgPrintStats();
   return AxonAudioFeaturesBgSliceIsForeground() > 0;
@@ -681,6 +788,7 @@ int AxonKwsProcessFrame(
       (((first_or_last_frame!=kFirstFrame)) &&(axon_nn_state_info.ml_async_state == kAxonMlAsyncStateFeatureWaitForAudio)))) {
     return -1000;
   }
+  AXON_KWS_STATS_COUNT(kAxonKwsStatsFramesProcessed, 1);
   //turn on Axon Clk and Power
   AxonMlDemoHostAxonSetEnabled(kAxonBoolTrue);
   if (kFirstFrame==first_or_last_frame) {
@@ -814,12 +922,15 @@ static int AxonKwsClassifyAudio(const int16_t *audio_samples, uint32_t audio_sam
   for (frame_idx=0;frame_idx<((audio_sample_count/AXON_AUDIO_FEATURE_FRAME_SHIFT)-1);frame_idx++) {
 
     while(1) {
+      AxonKwsServiceModel();
       AxonHostDisableInterrupts();
       if ((axon_nn_state_info.ml_async_state != kAxonMlAsyncStateIdle) &&
           (axon_nn_state_info.ml_async_state != kAxonMlAsyncStateFeatureWaitForAudio) &&
           (axon_nn_state_info.ml_async_state != kAxonMlAsyncStateComplete)){
 
-        AxonHostWfi();
+        if (!kws_model_service_pending) {
+          AxonHostWfi();
+        }
         AxonHostEnableInterrupts();
       } else {
         AxonHostEnableInterrupts();
@@ -846,8 +957,11 @@ static int AxonKwsClassifyAudio(const int16_t *audio_samples, uint32_t audio_sam
   while((axon_nn_state_info.ml_async_state != kAxonMlAsyncStateComplete) &&
       (axon_nn_state_info.ml_async_state != kAxonMlAsyncStateFeatureWaitForAudio) &&
       (axon_nn_state_info.ml_async_state != kAxonMlAsyncStateIdle)){
+    AxonKwsServiceModel();
     AxonHostDisableInterrupts();
-    AxonHostWfi();
+    if (!kws_model_service_pending) {
+      AxonHostWfi();
+    }
     AxonHostEnableInterrupts();
   }
 
@@ -884,6 +998,9 @@ int AxonDemoPrepare(void *unused) {
   AxonDataWidthEnum output_saturation_packing_width;
 
   axon_nn_state_info.ml_async_state = kAxonMlAsyncStateIdle;
+#if AXON_NN_TYPE==AXON_CONTAINER
+  AxonKwsModelContainerSetSource((const void *)AXON_MODEL_CONTAINER_ADDRESS, AXON_MODEL_CONTAINER_MAX_LENGTH);
+#endif
   /*
    * prepare Axon for MFCC and nn operations.
    * Get the audio feature input requirements from the model.
@@ -901,7 +1018,7 @@ int AxonDemoPrepare(void *unused) {
 
   if (kAxonResultSuccess > (prepare_result=AxonAudioFeaturePrepare(
       gl_axon_instance,
-      process_feature_complete,
+      feature_complete_callback,
       bgfg_window_slice_cnt,
       which_variant,
       normalization_means_q11p12,
@@ -914,9 +1031,17 @@ int AxonDemoPrepare(void *unused) {
     AxonPrintf("AxonAudioFeaturePrepare: failed! %d\r\n", prepare_result);
   }
 
-  if (kAxonResultSuccess > (prepare_result=AxonKwsModelPrepare(gl_axon_instance, process_final_classification_complete))) {
+#if AXON_GRU_CELL_REFERENCE_CHECK
+  {
+    int32_t max_difference = 0;
+    AxonResultEnum check_result = AxonGruCellReferenceCheck(gl_axon_instance, &max_difference);
+    AxonPrintf("AxonGruCellReferenceCheck: %d, h(t) max difference %d\r\n", check_result, max_difference);
+  }
+#endif
+  if (kAxonResultSuccess > (prepare_result=AxonKwsModelPrepare(gl_axon_instance, final_classification_complete_callback))) {
     AxonPrintf("AxonKwsModelPrepare: failed! %d\r\n", prepare_result);
   }
+  AxonKwsModelSetWeightLoadRequest(model_service_request_callback);
   while(0 > prepare_result); // just hang here.
   wave_data_length = audio_sample_files[0].sample_count;
   wave_data_playback = audio_sample_files[0].wave_data;
@@ -926,9 +1051,57 @@ int AxonDemoPrepare(void *unused) {
 
 }
 
+#if (AXON_NN_TYPE==AXON_GRNN) && AXON_GRNN_COMPARE_HIDDEN_STATE_WIDTHS
+/*
+ * Classifies each test sample with the 16 bit hidden state, then the int8 one.
+ * The 16 bit classification is the reference for the int8 one.
+ */
+static void AxonGrnnCompareHiddenStateWidths() {
+  static const AxonDataWidthEnum hidden_state_widths[] = {kAxonDataWidth16, kAxonDataWidth8};
+  uint32_t nn_total_ticks[sizeof(hidden_state_widths)/sizeof(hidden_state_widths[0])] = {0};
+  int16_t classification[sizeof(hidden_state_widths)/sizeof(hidden_state_widths[0])];
+  int32_t score[sizeof(hidden_state_widths)/sizeof(hidden_state_widths[0])];
+  char *label[sizeof(hidden_state_widths)/sizeof(hidden_state_widths[0])];
+  uint32_t nn_ticks[sizeof(hidden_state_widths)/sizeof(hidden_state_widths[0])];
+  uint8_t agree_cnt = 0;
+  uint8_t audio_sample_ndx;
+  uint8_t width_ndx;
+
+  for(audio_sample_ndx=0;
+      audio_sample_ndx < sizeof(audio_sample_files)/sizeof(audio_sample_files[0]);
+      audio_sample_ndx++) {
+    AxonHostLog(gl_axon_instance, "\r\n\r\n");
+    AxonHostLog(gl_axon_instance, audio_sample_files[audio_sample_ndx].sample_label);
+    for (width_ndx=0;width_ndx<sizeof(hidden_state_widths)/sizeof(hidden_state_widths[0]);width_ndx++) {
+      AxonKwsModelGrnnSetHiddenStateWidth(hidden_state_widths[width_ndx]);
+      AxonKwsClassifyAudio(audio_sample_files[audio_sample_ndx].wave_data,
+          audio_sample_files[audio_sample_ndx].sample_count,
+          1);
+      classification[width_ndx] = axon_nn_state_info.output_score.classification;
+      score[width_ndx] = axon_nn_state_info.output_score.score;
+      label[width_ndx] = axon_nn_state_info.output_score.label;
+      nn_ticks[width_ndx] = axon_nn_state_info.nn_final_elapsed_time;
+      nn_total_ticks[width_ndx] += nn_ticks[width_ndx];
+    }
+    agree_cnt += classification[0]==classification[1];
+    axon_printf(gl_axon_instance, "hidden state int16: %s (%d) nn %u, int8: %s (%d) nn %u\r\n",
+        label[0], score[0], nn_ticks[0],
+        label[1], score[1], nn_ticks[1]);
+  }
+  axon_printf(gl_axon_instance, "int8 hidden state agrees on %d of %d samples, nn total int16 %u, int8 %u\r\n",
+      agree_cnt, (int)(sizeof(audio_sample_files)/sizeof(audio_sample_files[0])), nn_total_ticks[0], nn_total_ticks[1]);
+
+  AxonKwsModelGrnnSetHiddenStateWidth(kAxonDataWidth16);
+}
+#endif
+
 int AxonDemoRun(void *unused1, uint8_t unused2) {
 
   uint8_t audio_sample_ndx;
+#if (AXON_NN_TYPE==AXON_GRNN) && AXON_GRNN_COMPARE_HIDDEN_STATE_WIDTHS
+  AxonGrnnCompareHiddenStateWidths();
+  return 0;
+#endif
   for(audio_sample_ndx=0;
       audio_sample_ndx < sizeof(audio_sample_files)/sizeof(audio_sample_files[0]);
       audio_sample_ndx++) {
@@ -0,0 +1,199 @@
+/**
+ *          Copyright (c) 2020-2022, Atlazo Inc.
+ *          All rights reserved.
+ *
+ *          Licensed under the Apache License, Version 2.0 (the "License");
+ *          you may not use this file except in compliance with the License.
+ *          You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *          Unless required by applicable law or agreed to in writing, software
+ *          distributed under the License is distributed on an "AS IS" BASIS,
+ *          WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *          See the License for the specific language governing permissions and
+ *          limitations under the License.
+ *
+ */
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include "axon_api.h"
+#include "axon_kws_model_container_api.h"
+#include "axon_logging_api.h"
+#include "axon_audio_ml_api.h"
+
+/*
+ * Buffers are sized for the largest model a container may hold. Prepare fails with kAxonResultBufferTooSmall
+ * if the container needs more.
+ * io buffer holds the int8 window (or the slice + hidden vector) on input and each layer's int32 output.
+ */
+#define KWS_CONTAINER_IO_BUFFER_SIZE 400
+#define KWS_CONTAINER_BUF_SIZE 400     // >= the longest layer output
+#define KWS_CONTAINER_STATE_BUFFER_SIZE 128 // >= the lstm hidden length
+#define KWS_CONTAINER_OP_HANDLE_COUNT 80 // 12 per lstm cell, 10 per fully connected layer
+
+RETAINED_MEMORY_SECTION_ATTRIBUTE
+static struct {
+  AxonOpHandle axon_op_handles[KWS_CONTAINER_OP_HANDLE_COUNT];
+  AxonLayerNodeStruct nodes[AXON_MODEL_CONTAINER_MAX_LAYERS];
+  AxonLayerGraphStruct graph;
+  AxonLayerGraphInstanceStruct graph_instance;
+  const void *container;
+  uint32_t container_max_length;
+  const AxonModelContainerHeaderStruct *header;
+} container_retained_info;
+
+_Alignas(16) static int32_t container_io_buffer[KWS_CONTAINER_IO_BUFFER_SIZE];
+static int32_t container_buff1[KWS_CONTAINER_BUF_SIZE];
+static int32_t container_buff2[KWS_CONTAINER_BUF_SIZE];
+_Alignas(16) static int32_t container_state_buff[KWS_CONTAINER_STATE_BUFFER_SIZE];
+
+void AxonKwsModelContainerSetSource(const void *container, uint32_t max_length) {
+  container_retained_info.container = container;
+  container_retained_info.container_max_length = max_length;
+  container_retained_info.header = NULL;
+}
+
+/*
+ * checks the container's input fits this library's feature pipeline.
+ */
+static AxonResultEnum container_check_model(void *axon_handle, const AxonModelContainerHeaderStruct *header) {
+  if ((header->input_width > AXON_KWS_CONTAINER_MAX_SLICES) || (header->input_height != AUDIO_INPUT_FEATURE_HEIGHT)) {
+    axon_printf(axon_handle, "container input %dx%d unsupported\r\n", header->input_width, header->input_height);
+    return kAxonResultFailureInputOutOfRange;
+  }
+  return kAxonResultSuccess;
+}
+
+/*
+* API level prepare; use our internal buffers.
+*/
+AxonResultEnum AxonKwsModelContainerPrepare(void *axon_handle, void (*result_callback_function)(AxonResultEnum result)) {
+  AxonResultEnum result;
+  const AxonModelContainerHeaderStruct *header;
+  const AxonModelContainerLayerStruct *layers;
+  AxonLayerGraphInstanceStruct *instance = &container_retained_info.graph_instance;
+
+  if (kAxonResultSuccess != (result = AxonModelContainerOpen(container_retained_info.container, container_retained_info.container_max_length, &header, &layers))) {
+    axon_printf(axon_handle, "model container invalid! %d\r\n", result);
+    return result;
+  }
+  if (kAxonResultSuccess != (result = container_check_model(axon_handle, header))) {
+    return result;
+  }
+  axon_printf(axon_handle, "model container v%d.%d, %d layers, %d bytes\r\n", header->version_major, header->version_minor, header->layer_cnt, header->total_length);
+
+  for (uint8_t layer_ndx=0;layer_ndx<header->layer_cnt;layer_ndx++) {
+    if (kAxonResultSuccess != (result = AxonModelContainerLayerToNode(header, layers+layer_ndx, container_retained_info.nodes+layer_ndx))) {
+      axon_printf(axon_handle, "container layer %d unsupported! %d\r\n", layer_ndx, result);
+      return result;
+    }
+  }
+  container_retained_info.graph.nodes = container_retained_info.nodes;
+  container_retained_info.graph.node_cnt = header->layer_cnt;
+  container_retained_info.graph.execution = header->execution;
+  container_retained_info.graph.input_width = header->input_width;
+  container_retained_info.graph.input_height = header->input_height;
+
+  instance->graph = &container_retained_info.graph;
+  instance->io_buffer = container_io_buffer;
+  instance->io_buffer_length = KWS_CONTAINER_IO_BUFFER_SIZE;
+  instance->buf1 = container_buff1;
+  instance->buf2 = container_buff2;
+  instance->buf_length = KWS_CONTAINER_BUF_SIZE;
+  instance->state_buffer = container_state_buff;
+  instance->state_buffer_length = KWS_CONTAINER_STATE_BUFFER_SIZE;
+  instance->op_handles = container_retained_info.axon_op_handles;
+  instance->op_handle_length = KWS_CONTAINER_OP_HANDLE_COUNT;
+  instance->get_next_slice = AxonKwsHostGetNextAudioFeatureSlice;
+  instance->result_callback_function = result_callback_function;
+  if (kAxonResultSuccess != (result = AxonLayerGraphPrepare(axon_handle, instance))) {
+    return result;
+  }
+
+  container_retained_info.header = header;
+  return kAxonResultSuccess;
+}
+
+AxonResultEnum AxonKwsModelContainerInfer(uint8_t window_width) {
+  const AxonModelContainerHeaderStruct *header = container_retained_info.header;
+
+  if (NULL==header) {
+    return kAxonResultFailureNullBuffer; // not prepared
+  }
+  if (window_width != header->input_width) {
+    AxonPrintf("container inference invalid window length %d\r\n", window_width);
+    return kAxonResultFailureInputOutOfRange;
+  }
+
+  return AxonLayerGraphInfer(&container_retained_info.graph_instance);
+}
+
+AxonResultEnum AxonKwsModelContainerGetInputAttributes(
+    uint8_t *bgfg_window_slice_cnt,            /**< valid window width for background/foreground detection */
+    AxonAudioFeatureVariantsEnum *which_variant, /**< specify which variant to produce */
+    int32_t **normalization_means_q11p12,      /**< normalization subtracts means (as q11.12)... */
+    int32_t **normalization_inv_std_devs,      /**< ...then multiplies by the inverse std deviation... */
+    uint8_t *normalization_inv_std_devs_q_factor,  /**< ...then right shifts by the inverse std deviation q-factor */
+    int32_t *quantization_inv_scale_factor,    /**< quantization multiplies by the inverse scaling factor... */
+    uint8_t *quantization_inv_scale_factor_q_factor, /** ...then right shifts by the inverse scaling factor q-factor... */
+    int8_t *quantization_zero_point,          /**< ...then adds the zero point */
+    AxonDataWidthEnum *output_saturation_packing_width ) { /**< final output will be saturated/packed to this width (24 does nothing) */
+  const AxonModelContainerHeaderStruct *header;
+  AxonResultEnum result;
+
+  // attributes are needed before the model is prepared, so open the container here too.
+  if (kAxonResultSuccess != (result = AxonModelContainerOpen(container_retained_info.container, container_retained_info.container_max_length, &header, NULL))) {
+    return result;
+  }
+
+  if (NULL != bgfg_window_slice_cnt) {
+    *bgfg_window_slice_cnt = header->input_width;
+  }
+  if (NULL != which_variant) {
+    *which_variant = header->feature_variant;
+  }
+  if (NULL != normalization_means_q11p12) {
+    *normalization_means_q11p12 = (int32_t *)AxonModelContainerBlob(header, header->normalization_means_offset);
+  }
+  if (NULL != normalization_inv_std_devs) {
+    *normalization_inv_std_devs = (int32_t *)AxonModelContainerBlob(header, header->normalization_inv_std_devs_offset);
+  }
+  if (NULL != normalization_inv_std_devs_q_factor) {
+    *normalization_inv_std_devs_q_factor = header->normalization_inv_std_devs_q_factor;
+  }
+  if (NULL != quantization_inv_scale_factor) {
+    *quantization_inv_scale_factor = header->quantization_inv_scale_factor;
+  }
+  if (NULL != quantization_inv_scale_factor_q_factor) {
+    *quantization_inv_scale_factor_q_factor = header->quantization_inv_scale_factor_q_factor;
+  }
+  if (NULL != quantization_zero_point) {
+    *quantization_zero_point = header->quantization_zero_point;
+  }
+  if (NULL != output_saturation_packing_width) {
+    *output_saturation_packing_width = AXON_AUDIO_FEATURES_DATA_WIDTH;
+  }
+  return kAxonResultSuccess;
+}
+
+uint8_t AxonKwsModelContainerGetClassification(int32_t *score, char **label) {
+  const AxonModelContainerHeaderStruct *header = container_retained_info.header;
+  const int32_t *outputs = AxonLayerGraphOutput(&container_retained_info.graph_instance, NULL);
+  int32_t max_value = outputs[0];
+  uint8_t max_value_ndx = 0;
+  for (uint8_t ndx=1;ndx<header->label_cnt;ndx++) {
+    if (outputs[ndx]>max_value) {
+      max_value = outputs[ndx];
+      max_value_ndx = ndx;
+    }
+  }
+  if (NULL != score) {
+    *score = max_value;
+  }
+  if (NULL != label) {
+    *label = (char *)AxonModelContainerLabel(header, max_value_ndx);
+  }
+  return max_value_ndx;
+}
@@ -0,0 +1,640 @@
+/**
+ *          Copyright (c) 2020-2022, Atlazo Inc.
+ *          All rights reserved.
+ *
+ *          Licensed under the Apache License, Version 2.0 (the "License");
+ *          you may not use this file except in compliance with the License.
+ *          You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *          Unless required by applicable law or agreed to in writing, software
+ *          distributed under the License is distributed on an "AS IS" BASIS,
+ *          WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *          See the License for the specific language governing permissions and
+ *          limitations under the License.
+ *
+ */
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include "axon_api.h"
+#include "axon_dep.h"
+#include "axon_logging_api.h"
+#include "axon_kws_stats_api.h"
+#include "axon_layer_graph_api.h"
+
+/*
+ * most ops each node type can define.
+ */
+#define LAYER_GRAPH_DENSE_OP_CNT 10
+#define LAYER_GRAPH_LSTM_OP_CNT 12
+#define LAYER_GRAPH_GRNN_OP_CNT 9
+#define LAYER_GRAPH_GRU_OP_CNT AXON_GRU_CELL_MAX_OP_CNT
+#define LAYER_GRAPH_ACTIVATION_OP_CNT 1
+
+/*
+ * grnn and gru cell state lives in the state buffer as int8 [x;h] (rounded up to keep the vectors after it
+ * 16 byte aligned) followed by the 24 bit h, then for the grnn z, h_hat and the matrix multiply output.
+ */
+typedef enum {
+  kGrnnStateH,
+  kGrnnStateZ,
+  kGrnnStateHHat,
+  kGrnnStateTmp,
+  kGrnnStateVectorCount,
+} GrnnStateVectorEnum;
+
+static uint16_t x_h8_length(const AxonLayerNodeStruct *node) {
+  return ((node->input_length+15)/16)*4;
+}
+
+static int32_t *grnn_state_vector(const AxonLayerGraphInstanceStruct *instance, const AxonLayerNodeStruct *node, GrnnStateVectorEnum which) {
+  return instance->state_buffer+x_h8_length(node)+which*node->hidden_length;
+}
+
+static AxonBoolEnum node_has_x_h8(const AxonLayerNodeStruct *node) {
+  return (kAxonLayerNodeGrnnCell==node->node_type) || (kAxonLayerNodeGruCell==node->node_type);
+}
+
+static uint16_t max_u16(uint16_t a, uint16_t b) {
+  return a > b ? a : b;
+}
+
+/*
+ * int32s an input of length elements occupies in io_buffer.
+ */
+static uint16_t input_words(uint16_t length, AxonDataWidthEnum data_width) {
+  switch (data_width) {
+  case kAxonDataWidth8:
+    return (length+3)/4;
+  case kAxonDataWidth12:
+  case kAxonDataWidth16:
+    return (length+1)/2;
+  default:
+    return length;
+  }
+}
+
+static AxonBoolEnum node_is_recurrent(const AxonLayerNodeStruct *node) {
+  return (kAxonLayerNodeLstmCell==node->node_type) || node_has_x_h8(node);
+}
+
+AxonResultEnum AxonLayerGraphGetRequirements(const AxonLayerGraphStruct *graph, AxonLayerGraphRequirementsStruct *requirements) {
+  AxonLayerGraphRequirementsStruct needed = {0};
+
+  if ((NULL==graph) || (NULL==graph->nodes) || (NULL==requirements)) {
+    return kAxonResultFailureNullBuffer;
+  }
+  if (0==graph->node_cnt) {
+    return kAxonResultFailureInvalidLength;
+  }
+
+  for (uint8_t node_ndx=0;node_ndx<graph->node_cnt;node_ndx++) {
+    const AxonLayerNodeStruct *node = graph->nodes+node_ndx;
+
+    // only the leading node of a per-slice graph can be recurrent, and only it.
+    if (node_is_recurrent(node) != ((kAxonLayerGraphExecutePerSlice==graph->execution) && (0==node_ndx))) {
+      return kAxonResultFailureInputOutOfRange;
+    }
+    // every node takes the previous node's output.
+    if ((node_ndx > 0) && !node_is_recurrent(node) &&
+        (node->input_length != (node_is_recurrent(node-1) ? (node-1)->hidden_length : (node-1)->output_length))) {
+      return kAxonResultFailureInvalidLength;
+    }
+
+    switch (node->node_type) {
+    case kAxonLayerNodeDense:
+      if (node->params.dense.row_length < node->input_length) {
+        return kAxonResultFailureInvalidLength;
+      }
+      needed.op_handle_cnt += LAYER_GRAPH_DENSE_OP_CNT;
+      needed.io_buffer_length = max_u16(needed.io_buffer_length, max_u16(input_words(node->params.dense.row_length, node->input_data_width), node->output_length));
+      needed.buf_length = max_u16(needed.buf_length, node->output_length);
+      break;
+
+    case kAxonLayerNodeLstmCell:
+      if ((node->input_length != graph->input_height+node->hidden_length) || (node->output_length != 4*node->hidden_length)) {
+        return kAxonResultFailureInvalidLength;
+      }
+      needed.op_handle_cnt += LAYER_GRAPH_LSTM_OP_CNT;
+      needed.io_buffer_length = max_u16(needed.io_buffer_length, max_u16(input_words(node->input_length, node->input_data_width), node->output_length));
+      needed.buf_length = max_u16(needed.buf_length, node->output_length);
+      needed.state_buffer_length = max_u16(needed.state_buffer_length, node->hidden_length);
+      break;
+
+    case kAxonLayerNodeGrnnCell:
+      // int8 packing needs multiples of 4, 24 bit vectors need even lengths.
+      if ((node->input_length != graph->input_height+node->hidden_length) || (node->output_length != node->hidden_length) ||
+          (graph->input_height & 15) || (node->hidden_length & 3)) {
+        return kAxonResultFailureInvalidLength;
+      }
+      needed.op_handle_cnt += LAYER_GRAPH_GRNN_OP_CNT;
+      needed.io_buffer_length = max_u16(needed.io_buffer_length, max_u16(graph->input_height, node->hidden_length));
+      needed.buf_length = max_u16(needed.buf_length, node->hidden_length);
+      needed.state_buffer_length = max_u16(needed.state_buffer_length, x_h8_length(node)+kGrnnStateVectorCount*node->hidden_length);
+      break;
+
+    case kAxonLayerNodeGruCell:
+      if ((node->input_length != graph->input_height+node->hidden_length) || (node->output_length != node->hidden_length) ||
+          (node->input_length & 15) || (node->hidden_length & 3) || (2*node->hidden_length > 512)) {
+        return kAxonResultFailureInvalidLength;
+      }
+      needed.op_handle_cnt += LAYER_GRAPH_GRU_OP_CNT;
+      needed.io_buffer_length = max_u16(needed.io_buffer_length, node->hidden_length);
+      needed.buf_length = max_u16(needed.buf_length, 4*node->hidden_length);
+      needed.state_buffer_length = max_u16(needed.state_buffer_length, x_h8_length(node)+node->hidden_length);
+      break;
+
+    case kAxonLayerNodeActivation:
+      needed.op_handle_cnt += LAYER_GRAPH_ACTIVATION_OP_CNT;
+      // fall through
+    case kAxonLayerNodeSoftmax:
+      if ((0==node_ndx) || (node->output_length != node->input_length)) {
+        return kAxonResultFailureInvalidLength;
+      }
+      if ((kAxonLayerNodeSoftmax==node->node_type) && (node_ndx+1 != graph->node_cnt)) {
+        return kAxonResultFailureInputOutOfRange;
+      }
+      needed.io_buffer_length = max_u16(needed.io_buffer_length, node->output_length);
+      break;
+
+    default:
+      return kAxonResultFailureInputOutOfRange;
+    }
+  }
+
+  // the 1st node reads the slices as AxonLayerGraphInfer() lays them out.
+  switch (graph->execution) {
+  case kAxonLayerGraphExecuteWindow:
+    if (graph->nodes[0].input_length != graph->input_width*graph->input_height) {
+      return kAxonResultFailureInvalidLength;
+    }
+    if (kAxonDataWidth8 != graph->nodes[0].input_data_width) {
+      return kAxonResultFailureInvalidDataWidth; // flattened int8 features
+    }
+    break;
+  case kAxonLayerGraphExecutePerSlice:
+    if ((kAxonLayerNodeLstmCell==graph->nodes[0].node_type) && (kAxonDataWidth24 != graph->nodes[0].input_data_width)) {
+      return kAxonResultFailureInvalidDataWidth; // 1 int32 word per feature
+    }
+    break;
+  default:
+    return kAxonResultFailureInputOutOfRange;
+  }
+
+  *requirements = needed;
+  return kAxonResultSuccess;
+}
+
+/*
+ * Defines the FastGRNN cell ops. Same sequence as axon_grnn.c's int8 hidden state, except the biases
+ * are copied from wherever they are on each slice.
+ */
+static AxonResultEnum layer_graph_define_grnn_ops(void *axon_handle, AxonLayerGraphInstanceStruct *instance, const AxonLayerNodeStruct *node,
+    AxonOpHandle *axon_op_handles, uint8_t *op_handle_cnt) {
+  AxonResultEnum result;
+  AxonInputStruct axon_input;
+  const AxonLayerGrnnParamsStruct *params = &node->params.grnn;
+  int32_t *h32 = grnn_state_vector(instance, node, kGrnnStateH);
+  int32_t *z32 = grnn_state_vector(instance, node, kGrnnStateZ);
+  int32_t *h_hat32 = grnn_state_vector(instance, node, kGrnnStateHHat);
+  int32_t *tmp32 = grnn_state_vector(instance, node, kGrnnStateTmp);
+  uint8_t op_ndx = 0;
+
+  if (*op_handle_cnt < LAYER_GRAPH_GRNN_OP_CNT) {
+    *op_handle_cnt = LAYER_GRAPH_GRNN_OP_CNT;
+    return kAxonResultBufferTooSmall;
+  }
+
+  axon_input.data_packing = kAxonDataPackingEnabled;
+  axon_input.output_af = kAxonAfDisabled;
+  axon_input.x_stride = kAxonStride1;
+  axon_input.y_stride = kAxonStride1;
+  axon_input.q_stride = kAxonStride1;
+
+  // [x;h] * [W|U]
+  axon_input.data_width = kAxonDataWidth8;
+  axon_input.length = node->input_length;
+  axon_input.y_length = node->hidden_length;
+  axon_input.x_in = instance->state_buffer; // int8 [x;h]
+  axon_input.y_in = (const int32_t *)params->weights;
+  axon_input.output_rounding = kAxonRoundingNone+params->weights_rounding;
+  axon_input.q_out = tmp32;
+  if (kAxonResultSuccess > (result=AxonApiDefineOpMatrixMult32BitOutput(axon_handle, &axon_input, axon_op_handles+op_ndx++))) {
+    return result;
+  }
+
+  // z = af(tmp+Bg), h_hat = af(tmp+Bh)
+  axon_input.data_width = kAxonDataWidth24;
+  axon_input.length = node->hidden_length;
+  axon_input.y_length = 0;
+  axon_input.x_in = params->bias_g;
+  axon_input.q_out = instance->buf1;
+  if (kAxonResultSuccess > (result=AxonApiDefineOpMemCpy(axon_handle, &axon_input, axon_op_handles+op_ndx++))) {
+    return result;
+  }
+  axon_input.x_in = tmp32;
+  axon_input.y_in = instance->buf1;
+  axon_input.output_rounding = kAxonRoundingNone+params->gate_rounding;
+  axon_input.output_af = params->gate_af;
+  axon_input.q_out = z32; // q1.8
+  if (kAxonResultSuccess > (result=AxonApiDefineOpXpy(axon_handle, &axon_input, axon_op_handles+op_ndx++))) {
+    return result;
+  }
+  axon_input.x_in = params->bias_h;
+  axon_input.output_rounding = kAxonRoundingNone;
+  axon_input.output_af = kAxonAfDisabled;
+  axon_input.q_out = instance->buf1;
+  if (kAxonResultSuccess > (result=AxonApiDefineOpMemCpy(axon_handle, &axon_input, axon_op_handles+op_ndx++))) {
+    return result;
+  }
+  axon_input.x_in = tmp32;
+  axon_input.y_in = instance->buf1;
+  axon_input.output_rounding = kAxonRoundingNone+params->gate_rounding;
+  axon_input.output_af = params->candidate_af;
+  axon_input.q_out = h_hat32; // q1.8
+  if (kAxonResultSuccess > (result=AxonApiDefineOpXpy(axon_handle, &axon_input, axon_op_handles+op_ndx++))) {
+    return result;
+  }
+
+  // h = z*h
+  axon_input.x_in = z32;
+  axon_input.y_in = h32;
+  axon_input.output_rounding = kAxonRoundingNone+8;
+  axon_input.output_af = kAxonAfDisabled;
+  axon_input.q_out = h32;
+  if (kAxonResultSuccess > (result=AxonApiDefineOpXty(axon_handle, &axon_input, axon_op_handles+op_ndx++))) {
+    return result;
+  }
+
+  // z = zeta*(1-z)+nu
+  axon_input.x_in = z32;
+  axon_input.a_in = params->minus_zeta_q7;
+  axon_input.b_in = params->nu_plus_zeta_q15;
+  axon_input.output_rounding = kAxonRoundingNone+7;
+  axon_input.q_out = z32; // q2.8
+  if (kAxonResultSuccess > (result=AxonApiDefineOpAxpb(axon_handle, &axon_input, axon_op_handles+op_ndx++))) {
+    return result;
+  }
+
+  // h += z*h_hat
+  axon_input.x_in = z32;
+  axon_input.y_in = h_hat32;
+  axon_input.output_rounding = kAxonRoundingNone+16-params->hidden_q;
+  axon_input.q_out = z32;
+  if (kAxonResultSuccess > (result=AxonApiDefineOpXty(axon_handle, &axon_input, axon_op_handles+op_ndx++))) {
+    return result;
+  }
+  axon_input.x_in = z32;
+  axon_input.y_in = h32;
+  axon_input.output_rounding = kAxonRoundingNone;
+  axon_input.q_out = h32; // requantized to int8 in layer_graph_slice_done_callback()
+  if (kAxonResultSuccess > (result=AxonApiDefineOpXpy(axon_handle, &axon_input, axon_op_handles+op_ndx++))) {
+    return result;
+  }
+
+  *op_handle_cnt = op_ndx;
+  return kAxonResultSuccess;
+}
+
+/*
+ * Defines the ops for one node, appending to axon_op_handles.
+ */
+static AxonResultEnum layer_graph_define_node_ops(void *axon_handle, AxonLayerGraphInstanceStruct *instance, const AxonLayerNodeStruct *node,
+    AxonOpHandle *axon_op_handles, uint8_t *op_handle_cnt) {
+  AxonResultEnum result;
+  AxonInputStruct axon_input;
+
+  switch (node->node_type) {
+  case kAxonLayerNodeDense:
+    if (AxonHostAddressAvailableToAxon((uint32_t)(uintptr_t)node->params.dense.weights) && (node->params.dense.row_length & 15)) {
+      // axon would read these in place, but can't with this row length.
+      axon_printf(axon_handle, "dense weights in RAM need rows that are a multiple of 16, got %d\r\n", node->params.dense.row_length);
+      return kAxonResultFailureUnalignedBuffer;
+    }
+    // padded weights get multiplied by whatever follows the input, which doesn't matter as the padding weights are 0.
+    return AxonApiDefineOpListFullyConnectedWithStopStep(axon_handle,
+        node->params.dense.row_length,
+        node->output_length,
+        node->input_data_width,
+        instance->io_buffer,
+        instance->io_buffer_length,
+        node->params.dense.weights,
+        node->params.dense.bias_prime,
+        node->params.dense.bias_add_multiplier,
+        node->params.dense.bias_add_rounding,
+        node->params.dense.activation_function,
+        node->params.dense.normalization_mult,
+        node->params.dense.norm_mult_rounding,
+        node->params.dense.normalization_add,
+        node->params.dense.norm_add_rounding,
+        node->params.dense.quantize_multiplier,
+        node->params.dense.quantize_add,
+        node->params.dense.quantize_rounding,
+        node->params.dense.standalone_quantize_add,
+        instance->buf1,
+        instance->buf2,
+        instance->buf_length,
+        instance->buf_length,
+        axon_op_handles,
+        op_handle_cnt,
+        kDontStop);
+
+  case kAxonLayerNodeLstmCell:
+    return AxonApiDefineOpListLstmCellWithStopStep(axon_handle,
+        node->input_length,
+        node->output_length,
+        node->input_data_width,
+        instance->io_buffer,
+        instance->io_buffer_length,
+        node->params.lstm.weights,
+        node->params.lstm.bias_prime,
+        node->params.lstm.bias_add_multiplier,
+        node->params.lstm.bias_add_rounding,
+        node->params.lstm.activation_function,
+        node->params.lstm.recurrent_activation_function,
+        node->params.lstm.multiply_rounding,
+        node->params.lstm.hidden_multiply_rounding,
+        node->hidden_length,
+        node->params.lstm.hidden_multiplier,
+        node->params.lstm.hidden_add,
+        node->params.lstm.hidden_rounding,
+        instance->buf1,
+        instance->state_buffer,
+        instance->buf_length,
+        node->hidden_length,
+        axon_op_handles,
+        op_handle_cnt,
+        kLstmDontStop);
+
+  case kAxonLayerNodeGrnnCell:
+    return layer_graph_define_grnn_ops(axon_handle, instance, node, axon_op_handles, op_handle_cnt);
+
+  case kAxonLayerNodeGruCell:
+    // gru_buf2 holds the bias copy. h is carried in the state buffer after [x;h].
+    return AxonGruCellDefineOpListWithStopStep(axon_handle,
+        node->input_length,
+        node->hidden_length,
+        (int8_t *)instance->state_buffer,
+        node->params.gru.weights,
+        node->params.gru.bias,
+        node->params.gru.weights_rounding,
+        node->params.gru.gate_rounding,
+        node->params.gru.activation_function,
+        node->params.gru.recurrent_activation_function,
+        node->params.gru.hidden_q,
+        instance->buf1,
+        instance->buf2,
+        instance->state_buffer+x_h8_length(node),
+        instance->buf_length,
+        instance->buf_length,
+        node->hidden_length,
+        axon_op_handles,
+        op_handle_cnt,
+        kGruDontStop);
+
+  case kAxonLayerNodeActivation:
+    if (*op_handle_cnt < LAYER_GRAPH_ACTIVATION_OP_CNT) {
+      *op_handle_cnt = LAYER_GRAPH_ACTIVATION_OP_CNT;
+      return kAxonResultBufferTooSmall;
+    }
+    axon_input.data_width = kAxonDataWidth24;
+    axon_input.data_packing = kAxonDataPackingDisabled;
+    axon_input.output_rounding = kAxonRoundingNone;
+    axon_input.output_af = node->params.activation_function;
+    axon_input.length = node->output_length;
+    axon_input.x_in = instance->io_buffer;
+    axon_input.x_stride = kAxonStride1;
+    axon_input.q_out = instance->io_buffer;
+    axon_input.q_stride = kAxonStride1;
+    if (kAxonResultSuccess > (result=AxonApiDefineOpAf(axon_handle, &axon_input, axon_op_handles))) {
+      return result;
+    }
+    *op_handle_cnt = LAYER_GRAPH_ACTIVATION_OP_CNT;
+    return kAxonResultSuccess;
+
+  case kAxonLayerNodeSoftmax:
+    *op_handle_cnt = 0;
+    return kAxonResultSuccess;
+
+  default:
+    return kAxonResultFailureInputOutOfRange;
+  }
+}
+
+AxonResultEnum AxonLayerGraphPrepare(void *axon_handle, AxonLayerGraphInstanceStruct *instance) {
+  AxonResultEnum result;
+  AxonLayerGraphRequirementsStruct requirements;
+  const AxonLayerGraphStruct *graph = instance->graph;
+  uint16_t total_ops_needed = 0;
+  uint8_t tmp_op_handle_cnt;
+
+  if (kAxonResultSuccess != (result = AxonLayerGraphGetRequirements(graph, &requirements))) {
+    axon_printf(axon_handle, "layer graph invalid! %d\r\n", result);
+    return result;
+  }
+  if ((NULL==instance->io_buffer) || (NULL==instance->op_handles) || (NULL==instance->get_next_slice) ||
+      ((0!=requirements.buf_length) && ((NULL==instance->buf1) || (NULL==instance->buf2))) ||
+      ((0!=requirements.state_buffer_length) && (NULL==instance->state_buffer))) {
+    return kAxonResultFailureNullBuffer;
+  }
+  if (((uintptr_t)instance->io_buffer & 15) || ((uintptr_t)instance->state_buffer & 15)) {
+    return kAxonResultFailureUnalignedBuffer;
+  }
+  if ((instance->io_buffer_length < requirements.io_buffer_length) || (instance->buf_length < requirements.buf_length) ||
+      (instance->state_buffer_length < requirements.state_buffer_length)) {
+    axon_printf(axon_handle, "layer graph needs io %d, buf %d, state %d\r\n",
+        requirements.io_buffer_length, requirements.buf_length, requirements.state_buffer_length);
+    return kAxonResultBufferTooSmall;
+  }
+
+  instance->axon_handle = axon_handle;
+  instance->op_handle_cnt = 0;
+  instance->slice_op_handle_cnt = 0;
+  instance->softmax_pending = 0;
+
+  for (uint8_t node_ndx=0;node_ndx<graph->node_cnt;node_ndx++) {
+    uint16_t handles_left = instance->op_handle_length-total_ops_needed;
+    tmp_op_handle_cnt = handles_left > UINT8_MAX ? UINT8_MAX : handles_left;
+    if (kAxonResultSuccess != (result = layer_graph_define_node_ops(axon_handle, instance, graph->nodes+node_ndx,
+        instance->op_handles+total_ops_needed, &tmp_op_handle_cnt))) {
+      axon_printf(axon_handle, "Define layer graph node %d failed! %d\r\n", node_ndx, result);
+      AxonApiFreeOpHandles(axon_handle, total_ops_needed, instance->op_handles);
+      return result;
+    }
+    total_ops_needed += tmp_op_handle_cnt;
+    if ((kAxonLayerGraphExecutePerSlice==graph->execution) && (0==node_ndx)) {
+      instance->slice_op_handle_cnt = total_ops_needed;
+    }
+  }
+  // each list gets queued in one AxonMgrQueuedOpsStruct, which counts ops in a uint8_t.
+  if ((instance->slice_op_handle_cnt > UINT8_MAX) || (total_ops_needed-instance->slice_op_handle_cnt > UINT8_MAX) ||
+      ((kAxonLayerGraphExecuteWindow==graph->execution) && (total_ops_needed > UINT8_MAX))) {
+    axon_printf(axon_handle, "layer graph needs %d ops, more than can be queued at once\r\n", total_ops_needed);
+    AxonApiFreeOpHandles(axon_handle, total_ops_needed, instance->op_handles);
+    return kAxonResultNotEnoughOpHandles;
+  }
+  instance->op_handle_cnt = total_ops_needed;
+  return kAxonResultSuccess;
+}
+
+/*
+ * Softmax over the last node's input, q.softmax_input_q in and q.15 out.
+ * There are a handful of outputs, and axon has no divide and only takes positive inputs to exp.
+ */
+static void layer_graph_softmax(int32_t *values, uint16_t length, uint8_t input_q) {
+  const float scale = 1.0f/(1<<input_q);
+  int32_t max_value = values[0];
+  float sum = 0;
+
+  for (uint16_t ndx=1;ndx<length;ndx++) {
+    if (values[ndx] > max_value) {
+      max_value = values[ndx];
+    }
+  }
+  for (uint16_t ndx=0;ndx<length;ndx++) {
+    sum += expf((values[ndx]-max_value)*scale);
+  }
+  for (uint16_t ndx=0;ndx<length;ndx++) {
+    values[ndx] = (int32_t)(expf((values[ndx]-max_value)*scale)/sum*(1<<15)+0.5f);
+  }
+}
+
+/*
+ * callback function invoked when the last op has completed.
+ * A trailing softmax is left for AxonLayerGraphOutput(), out of the axon callback.
+ */
+static void layer_graph_complete_callback(AxonResultEnum result, void *callback_context) {
+  AxonLayerGraphInstanceStruct *instance = (AxonLayerGraphInstanceStruct *)callback_context;
+  const AxonLayerGraphStruct *graph = instance->graph;
+
+  instance->softmax_pending = (kAxonResultSuccess <= result) && (kAxonLayerNodeSoftmax==graph->nodes[graph->node_cnt-1].node_type);
+  instance->result_callback_function(result);
+}
+
+static AxonResultEnum layer_graph_process_slice(AxonLayerGraphInstanceStruct *instance);
+
+/*
+ * per-slice execution: brings the hidden state back for the next slice, or runs the remaining nodes after the last one.
+ */
+static void layer_graph_slice_done_callback(AxonResultEnum result, void *callback_context) {
+  AxonLayerGraphInstanceStruct *instance = (AxonLayerGraphInstanceStruct *)callback_context;
+  const AxonLayerGraphStruct *graph = instance->graph;
+  const AxonLayerNodeStruct *node = graph->nodes;
+
+  if (kAxonResultSuccess > result) {
+    instance->result_callback_function(result);
+    return;
+  }
+
+  if (kAxonLayerNodeGruCell==node->node_type) {
+    AxonGruCellSaturateHiddenState(instance->state_buffer+x_h8_length(node), (int8_t *)instance->state_buffer+graph->input_height, node->hidden_length);
+  } else if (kAxonLayerNodeGrnnCell==node->node_type) {
+    // the grnn carries its state as int8; saturate h and bring it back so the next slice sees exactly that.
+    int8_t *h8 = (int8_t *)instance->state_buffer+graph->input_height;
+    int32_t *h32 = grnn_state_vector(instance, node, kGrnnStateH);
+    for (uint16_t ndx=0;ndx<node->hidden_length;ndx++) {
+      h8[ndx] = h32[ndx] > INT8_MAX ? INT8_MAX : h32[ndx] < INT8_MIN ? INT8_MIN : h32[ndx];
+      h32[ndx] = h8[ndx];
+    }
+  }
+
+  if (++instance->slice_ndx < graph->input_width) {
+    if (kAxonResultSuccess > (result = layer_graph_process_slice(instance))) {
+      instance->result_callback_function(result);
+    }
+    return;
+  }
+
+  // the hidden vector is the input to the remaining nodes.
+  if (node_has_x_h8(node)) {
+    // h follows [x;h] for both cells
+    memcpy(instance->io_buffer, grnn_state_vector(instance, node, kGrnnStateH), node->hidden_length*sizeof(int32_t));
+  } else {
+    // hidden vector follows the slice
+    memmove(instance->io_buffer, instance->io_buffer+graph->input_height, node->hidden_length*sizeof(int32_t));
+  }
+  if (instance->op_handle_cnt==instance->slice_op_handle_cnt) {
+    layer_graph_complete_callback(kAxonResultSuccess, instance);
+    return;
+  }
+  instance->queued_ops.op_handle_list = instance->op_handles+instance->slice_op_handle_cnt;
+  instance->queued_ops.op_handle_count = instance->op_handle_cnt-instance->slice_op_handle_cnt;
+  instance->queued_ops.callback_context = instance;
+  instance->queued_ops.callback_function = layer_graph_complete_callback;
+  if (kAxonResultSuccess > (result = AXON_KWS_STATS_QUEUE_OPS_LIST(instance->axon_handle, &instance->queued_ops))) {
+    instance->result_callback_function(result);
+  }
+}
+
+/*
+ * per-slice execution: places the next slice ahead of the hidden vector and queues the recurrent node.
+ */
+static AxonResultEnum layer_graph_process_slice(AxonLayerGraphInstanceStruct *instance) {
+  const AxonLayerGraphStruct *graph = instance->graph;
+  const int8_t *slice_ptr;
+
+  if (0 > instance->get_next_slice(&slice_ptr)) {
+    return kAxonResultFailure;
+  }
+  if (node_has_x_h8(graph->nodes)) {
+    memcpy(instance->state_buffer, slice_ptr, graph->input_height);
+  } else {
+    for (uint8_t ndx=0;ndx<graph->input_height;ndx++) {
+      instance->io_buffer[ndx] = slice_ptr[ndx];
+    }
+  }
+
+  instance->queued_ops.op_handle_list = instance->op_handles;
+  instance->queued_ops.op_handle_count = instance->slice_op_handle_cnt;
+  instance->queued_ops.callback_context = instance;
+  instance->queued_ops.callback_function = layer_graph_slice_done_callback;
+  return AXON_KWS_STATS_QUEUE_OPS_LIST(instance->axon_handle, &instance->queued_ops);
+}
+
+AxonResultEnum AxonLayerGraphInfer(AxonLayerGraphInstanceStruct *instance) {
+  const AxonLayerGraphStruct *graph = instance->graph;
+
+  if (NULL==instance->axon_handle) {
+    return kAxonResultFailureNullBuffer; // not prepared
+  }
+
+  instance->softmax_pending = 0;
+  if (kAxonLayerGraphExecutePerSlice == graph->execution) {
+    memset(instance->io_buffer, 0, instance->io_buffer_length*sizeof(int32_t));
+    memset(instance->state_buffer, 0, instance->state_buffer_length*sizeof(int32_t));
+    instance->slice_ndx = 0;
+    return layer_graph_process_slice(instance);
+  }
+
+  // gather the whole window, flattened.
+  int8_t *io_buff = (int8_t *)instance->io_buffer;
+  for (uint8_t slice_ndx=0;slice_ndx<graph->input_width;slice_ndx++) {
+    const int8_t *slice_ptr;
+    if (0 > instance->get_next_slice(&slice_ptr)) {
+      return kAxonResultFailure;
+    }
+    memcpy(io_buff, slice_ptr, graph->input_height);
+    io_buff += graph->input_height;
+  }
+
+  instance->queued_ops.op_handle_list = instance->op_handles;
+  instance->queued_ops.op_handle_count = instance->op_handle_cnt;
+  instance->queued_ops.callback_context = instance;
+  instance->queued_ops.callback_function = layer_graph_complete_callback;
+  return AXON_KWS_STATS_QUEUE_OPS_LIST(instance->axon_handle, &instance->queued_ops);
+}
+
+const int32_t *AxonLayerGraphOutput(AxonLayerGraphInstanceStruct *instance, uint16_t *output_length) {
+  const AxonLayerNodeStruct *last_node = instance->graph->nodes+instance->graph->node_cnt-1;
+
+  if (instance->softmax_pending) {
+    layer_graph_softmax(instance->io_buffer, last_node->output_length, last_node->params.softmax_input_q);
+    instance->softmax_pending = 0;
+  }
+  if (NULL != output_length) {
+    *output_length = last_node->output_length;
+  }
+  return instance->io_buffer;
+}
@@ -0,0 +1,190 @@
+/**
+ *          Copyright (c) 2020-2022, Atlazo Inc.
+ *          All rights reserved.
+ *
+ *          Licensed under the Apache License, Version 2.0 (the "License");
+ *          you may not use this file except in compliance with the License.
+ *          You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *          Unless required by applicable law or agreed to in writing, software
+ *          distributed under the License is distributed on an "AS IS" BASIS,
+ *          WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *          See the License for the specific language governing permissions and
+ *          limitations under the License.
+ *
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "axon_api.h"
+#include "axon_crc32_api.h"
+#include "axon_model_container_api.h"
+
+/*
+ * checks that a blob of length bytes at offset is inside the container, after the layer table, and aligned.
+ * offset 0 is allowed if the blob is optional.
+ */
+static AxonBoolEnum container_blob_is_valid(const AxonModelContainerHeaderStruct *header, uint32_t offset, uint32_t length, AxonBoolEnum optional) {
+  if (0==offset) {
+    return optional;
+  }
+  if ((offset & (AXON_MODEL_CONTAINER_ALIGNMENT-1)) ||
+      (offset < header->header_length+header->layer_cnt*sizeof(AxonModelContainerLayerStruct)) ||
+      (offset > header->total_length) || (length > header->total_length-offset)) {
+    return kAxonBoolFalse;
+  }
+  return kAxonBoolTrue;
+}
+
+/*
+ * checks that the labels blob holds label_cnt nul terminated strings inside the container.
+ */
+static AxonBoolEnum container_labels_are_valid(const AxonModelContainerHeaderStruct *header) {
+  if (!container_blob_is_valid(header, header->labels_offset, header->label_cnt, kAxonBoolTrue)) {
+    return kAxonBoolFalse;
+  }
+  if (0==header->labels_offset) {
+    return kAxonBoolTrue;
+  }
+  const char *label = (const char *)header+header->labels_offset;
+  uint32_t remaining = header->total_length-header->labels_offset;
+  for (uint8_t label_ndx=0;label_ndx<header->label_cnt;label_ndx++) {
+    const char *nul = memchr(label, 0, remaining);
+    if (NULL==nul) {
+      return kAxonBoolFalse;
+    }
+    remaining -= nul+1-label;
+    label = nul+1;
+  }
+  return kAxonBoolTrue;
+}
+
+AxonResultEnum AxonModelContainerOpen(const void *container, uint32_t max_length,
+    const AxonModelContainerHeaderStruct **header_out,
+    const AxonModelContainerLayerStruct **layers_out) {
+  const AxonModelContainerHeaderStruct *header = (const AxonModelContainerHeaderStruct *)container;
+  const AxonModelContainerLayerStruct *layers;
+
+  if (NULL==container) {
+    return kAxonResultFailureNullBuffer;
+  }
+  if ((uintptr_t)container & (AXON_MODEL_CONTAINER_ALIGNMENT-1)) {
+    return kAxonResultFailureUnalignedBuffer;
+  }
+  if (max_length < sizeof(*header)) {
+    return kAxonResultFailureInvalidLength;
+  }
+  if (AXON_MODEL_CONTAINER_MAGIC != header->magic) {
+    return kAxonModelContainerResultBadMagic;
+  }
+  if (AXON_MODEL_CONTAINER_VERSION_MAJOR != header->version_major) {
+    return kAxonModelContainerResultBadVersion;
+  }
+  if ((header->total_length > max_length) || (header->header_length < sizeof(*header)) ||
+      (header->layer_cnt > AXON_MODEL_CONTAINER_MAX_LAYERS) || (0==header->layer_cnt) ||
+      (header->header_length+header->layer_cnt*sizeof(AxonModelContainerLayerStruct) > header->total_length)) {
+    return kAxonModelContainerResultBadLayout;
+  }
+  if (header->crc32 != AxonCrc32(0, (const uint8_t *)container+AXON_MODEL_CONTAINER_CRC_START, header->total_length-AXON_MODEL_CONTAINER_CRC_START)) {
+    return kAxonModelContainerResultBadCrc;
+  }
+
+  if (!container_blob_is_valid(header, header->normalization_means_offset, header->input_height*sizeof(int32_t), kAxonBoolTrue) ||
+      !container_blob_is_valid(header, header->normalization_inv_std_devs_offset, header->input_height*sizeof(int32_t), kAxonBoolTrue) ||
+      !container_labels_are_valid(header)) {
+    return kAxonModelContainerResultBadLayout;
+  }
+
+  layers = (const AxonModelContainerLayerStruct *)((const uint8_t *)container+header->header_length);
+  for (uint8_t layer_ndx=0;layer_ndx<header->layer_cnt;layer_ndx++) {
+    const AxonModelContainerLayerStruct *layer = layers+layer_ndx;
+    uint32_t vector_bytes = layer->output_length*sizeof(int32_t);
+    if ((layer->row_length < layer->input_length) ||
+        !container_blob_is_valid(header, layer->weights_offset, (uint32_t)layer->row_length*layer->output_length, kAxonBoolFalse) ||
+        !container_blob_is_valid(header, layer->bias_prime_offset, vector_bytes, kAxonBoolFalse) ||
+        !container_blob_is_valid(header, layer->normalization_mult_offset, vector_bytes, kAxonBoolTrue) ||
+        !container_blob_is_valid(header, layer->normalization_add_offset, vector_bytes, kAxonBoolTrue)) {
+      return kAxonModelContainerResultBadLayout;
+    }
+  }
+  if (header->label_cnt != layers[header->layer_cnt-1].output_length) {
+    return kAxonModelContainerResultBadLayout;
+  }
+
+  if (NULL != header_out) {
+    *header_out = header;
+  }
+  if (NULL != layers_out) {
+    *layers_out = layers;
+  }
+  return kAxonResultSuccess;
+}
+
+const void *AxonModelContainerBlob(const AxonModelContainerHeaderStruct *header, uint32_t offset) {
+  return 0==offset ? NULL : (const uint8_t *)header+offset;
+}
+
+const char *AxonModelContainerLabel(const AxonModelContainerHeaderStruct *header, uint8_t label_ndx) {
+  const char *label = AxonModelContainerBlob(header, header->labels_offset);
+  if ((NULL==label) || (label_ndx >= header->label_cnt)) {
+    return "";
+  }
+  while (label_ndx--) {
+    label += strlen(label)+1;
+  }
+  return label;
+}
+
+AxonResultEnum AxonModelContainerLayerToNode(const AxonModelContainerHeaderStruct *header,
+    const AxonModelContainerLayerStruct *layer,
+    AxonLayerNodeStruct *node) {
+  memset(node, 0, sizeof(*node));
+  node->input_data_width = layer->input_data_width;
+  node->input_length = layer->input_length;
+  node->output_length = layer->output_length;
+  node->hidden_length = layer->hidden_length;
+
+  switch (layer->layer_type) {
+  case kAxonModelLayerFullyConnected:
+    node->node_type = kAxonLayerNodeDense;
+    node->params.dense.row_length = layer->row_length;
+    node->params.dense.weights = AxonModelContainerBlob(header, layer->weights_offset);
+    node->params.dense.bias_prime = AxonModelContainerBlob(header, layer->bias_prime_offset);
+    node->params.dense.bias_add_multiplier = layer->bias_add_multiplier;
+    node->params.dense.bias_add_rounding = layer->bias_add_rounding;
+    node->params.dense.activation_function = layer->activation_function;
+    node->params.dense.normalization_mult = AxonModelContainerBlob(header, layer->normalization_mult_offset);
+    node->params.dense.norm_mult_rounding = layer->norm_mult_rounding;
+    node->params.dense.normalization_add = AxonModelContainerBlob(header, layer->normalization_add_offset);
+    node->params.dense.norm_add_rounding = layer->norm_add_rounding;
+    node->params.dense.quantize_multiplier = layer->quantize_multiplier;
+    node->params.dense.quantize_add = layer->quantize_add;
+    node->params.dense.quantize_rounding = layer->quantize_rounding;
+    node->params.dense.standalone_quantize_add = layer->standalone_quantize_add;
+    return kAxonResultSuccess;
+
+  case kAxonModelLayerLstmCell:
+    if (layer->row_length != layer->input_length) {
+      // the lstm cell has no notion of padding.
+      return kAxonModelContainerResultBadLayout;
+    }
+    node->node_type = kAxonLayerNodeLstmCell;
+    node->params.lstm.weights = AxonModelContainerBlob(header, layer->weights_offset);
+    node->params.lstm.bias_prime = AxonModelContainerBlob(header, layer->bias_prime_offset);
+    node->params.lstm.bias_add_multiplier = layer->bias_add_multiplier;
+    node->params.lstm.bias_add_rounding = layer->bias_add_rounding;
+    node->params.lstm.activation_function = layer->activation_function;
+    node->params.lstm.recurrent_activation_function = layer->recurrent_activation_function;
+    node->params.lstm.multiply_rounding = layer->multiply_rounding;
+    node->params.lstm.hidden_multiply_rounding = layer->hidden_multiply_rounding;
+    node->params.lstm.hidden_multiplier = layer->quantize_multiplier;
+    node->params.lstm.hidden_add = layer->quantize_add;
+    node->params.lstm.hidden_rounding = layer->quantize_rounding;
+    return kAxonResultSuccess;
+
+  default:
+    return kAxonResultFailureInputOutOfRange;
+  }
+}
@@ -0,0 +1,32 @@
+/**
+ *          Copyright (c) 2020-2022, Atlazo Inc.
+ *          All rights reserved.
+ *
+ *          Licensed under the Apache License, Version 2.0 (the "License");
+ *          you may not use this file except in compliance with the License.
+ *          You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *          Unless required by applicable law or agreed to in writing, software
+ *          distributed under the License is distributed on an "AS IS" BASIS,
+ *          WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *          See the License for the specific language governing permissions and
+ *          limitations under the License.
+ *
+ */
+#include <stdint.h>
+#include "axon_crc32_api.h"
+#include "axon_model_container_api.h"
+
+/*
+ * The part of the container shared by the on-target reader and host side writers.
+ */
+void AxonModelContainerFinalize(void *container, uint32_t total_length) {
+  AxonModelContainerHeaderStruct *header = (AxonModelContainerHeaderStruct *)container;
+  header->magic = AXON_MODEL_CONTAINER_MAGIC;
+  header->version_major = AXON_MODEL_CONTAINER_VERSION_MAJOR;
+  header->version_minor = AXON_MODEL_CONTAINER_VERSION_MINOR;
+  header->total_length = total_length;
+  header->crc32 = AxonCrc32(0, (const uint8_t *)container+AXON_MODEL_CONTAINER_CRC_START, total_length-AXON_MODEL_CONTAINER_CRC_START);
+}
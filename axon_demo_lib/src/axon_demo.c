@@ -46,6 +46,9 @@ void axon_app_gpio_risc1_irq_handler(void){
 void axon_app_timer0_irq_handler(void){
   //no handling
 }
+void axon_app_dma_irq_handler(void){
+  //no handling
+}
 
 /*
  *
@@ -24,6 +24,8 @@
 #include "axon_api.h"
 #include "axon_dep.h"
 #include "axon_demo_private.h"
+#include "axon_logging_api.h"
+#include "axon_deferred_log_api.h"
 
 
 /*
@@ -44,6 +46,52 @@ void axon_printf(void *axon_handle, char *fmt_string, ...) {
 }
 
 
+#if AXON_LOGGING_BINARY_DUMP
+/*
+ * The base demo links neither axon_utils nor the ml library, so the demo has its own copy of AxonCrc32() and
+ * of the contiguous case of dump_vector(). Frames are the same (axon_logging_api.h), so
+ * axon_tools/vector_dump decodes them.
+ */
+static uint32_t demo_crc32(uint32_t crc, const void *data, uint32_t length) {
+  const uint8_t *bytes = (const uint8_t *)data;
+  crc = ~crc;
+  while (length--) {
+    crc ^= *bytes++;
+    for (uint8_t bit=0;bit<8;bit++) {
+      crc = (crc >> 1) ^ (0xEDB88320 & (0-(crc & 1)));
+    }
+  }
+  return ~crc;
+}
+
+static void demo_dump_vector(const char *msg, const char *suffix, const void *vector_ptr, AxonLoggingDumpTypeEnum type,
+    uint32_t count) {
+  uint8_t bytes[AXON_LOGGING_DUMP_HEADER_SIZE+64]; // header, then tag
+  uint32_t tag_len;
+  uint32_t crc;
+
+  tag_len = snprintf((char *)bytes+AXON_LOGGING_DUMP_HEADER_SIZE, sizeof(bytes)-AXON_LOGGING_DUMP_HEADER_SIZE, "%s %s", msg, suffix);
+  if (tag_len >= sizeof(bytes)-AXON_LOGGING_DUMP_HEADER_SIZE) {
+    tag_len = sizeof(bytes)-AXON_LOGGING_DUMP_HEADER_SIZE-1;
+  }
+  bytes[0] = AXON_LOGGING_DUMP_MARKER;
+  bytes[1] = type;
+  bytes[2] = 0; // q
+  bytes[3] = tag_len;
+  for (uint8_t ndx=0;ndx<4;ndx++) {
+    bytes[4+ndx] = count >> (8*ndx);
+  }
+  crc = demo_crc32(0, bytes+1, AXON_LOGGING_DUMP_HEADER_SIZE-1+tag_len);
+  AxonHostLogWrite(bytes, AXON_LOGGING_DUMP_HEADER_SIZE+tag_len);
+  crc = demo_crc32(crc, vector_ptr, count*AXON_LOGGING_DUMP_ELEMENT_SIZE(type));
+  AxonHostLogWrite((const uint8_t *)vector_ptr, count*AXON_LOGGING_DUMP_ELEMENT_SIZE(type));
+  for (uint8_t ndx=0;ndx<4;ndx++) {
+    bytes[ndx] = crc >> (8*ndx);
+  }
+  AxonHostLogWrite(bytes, 4);
+}
+#endif
+
 #define my_abs(x) ((int32_t)x<0?-1*(int32_t)x:x)
 /*
  * Verifies output[] == expected_output[] with each value being within margin of each other.
@@ -57,12 +105,18 @@ int verify_vectors(char *msg, int32_t *output, int32_t* expected_output, uint32_
   for (int i = 0; i < count; i++) {
     error_dif = output[i] - expected_output[i];
     if (my_abs(error_dif) > margin) {
-      axon_printf(gl_axon_handle, " error @ %d: dif %d not less than %d: got 0x%.8lx, expected 0x%.8lx\r\n", i, error_dif, margin, output[i], expected_output[i]);
+      if (!AXON_LOGGING_BINARY_DUMP) {
+        axon_printf(gl_axon_handle, " error @ %d: dif %d not less than %d: got 0x%.8lx, expected 0x%.8lx\r\n", i, error_dif, margin, output[i], expected_output[i]);
+      }
       err_cnt++;
     }
   }
   // return error in case of mismatch
   if (err_cnt > 0) {
+#if AXON_LOGGING_BINARY_DUMP
+    demo_dump_vector(msg, "output", output, kAxonLoggingDumpInt32, count);
+    demo_dump_vector(msg, "expected", expected_output, kAxonLoggingDumpInt32, count);
+#endif
     axon_printf(gl_axon_handle, " FAILED!: %d mismatches!\r\n", err_cnt);
     return (-1);
   } else {
@@ -84,12 +138,18 @@ int verify_vectors_16(char *msg, int16_t *output, int16_t* expected_output, uint
   for (int i = 0; i < count; i++) {
     error_dif = output[i] - expected_output[i];
     if (my_abs(error_dif) > margin) {
-      axon_printf(gl_axon_handle, "error @ %d: dif %d not less than %d: got 0x%.8lx, expected 0x%.8lx\r\n", i, error_dif, margin, output[i], expected_output[i]);
+      if (!AXON_LOGGING_BINARY_DUMP) {
+        axon_printf(gl_axon_handle, "error @ %d: dif %d not less than %d: got 0x%.8lx, expected 0x%.8lx\r\n", i, error_dif, margin, output[i], expected_output[i]);
+      }
       err_cnt++;
     }
   }
   // return error in case of mismatch
   if (err_cnt > 0) {
+#if AXON_LOGGING_BINARY_DUMP
+    demo_dump_vector(msg, "output", output, kAxonLoggingDumpInt16, count);
+    demo_dump_vector(msg, "expected", expected_output, kAxonLoggingDumpInt16, count);
+#endif
     axon_printf(gl_axon_handle, " FAILED!: %d mismatches!\r\n", err_cnt);
     return (-1);
   } else {
@@ -111,12 +171,18 @@ int verify_vectors_8(char *msg, int8_t *output, int8_t* expected_output, uint32_
   for (int i = 0; i < count; i++) {
     error_dif = output[i] - expected_output[i];
     if (my_abs(error_dif) > margin) {
-      axon_printf(gl_axon_handle, "error @ %d: dif %d not less than %d: got 0x%.8lx, expected 0x%.8lx\r\n", i, error_dif, margin, output[i], expected_output[i]);
+      if (!AXON_LOGGING_BINARY_DUMP) {
+        axon_printf(gl_axon_handle, "error @ %d: dif %d not less than %d: got 0x%.8lx, expected 0x%.8lx\r\n", i, error_dif, margin, output[i], expected_output[i]);
+      }
       err_cnt++;
     }
   }
   // return error in case of mismatch
   if (err_cnt > 0) {
+#if AXON_LOGGING_BINARY_DUMP
+    demo_dump_vector(msg, "output", output, kAxonLoggingDumpInt8, count);
+    demo_dump_vector(msg, "expected", expected_output, kAxonLoggingDumpInt8, count);
+#endif
     axon_printf(gl_axon_handle, "FAILED!: %d mismatches!\r\n", err_cnt);
     return (-1);
   } else {
@@ -0,0 +1,346 @@
+/**
+ *          Copyright (c) 2020-2022, Atlazo Inc.
+ *          All rights reserved.
+ *
+ *          Licensed under the Apache License, Version 2.0 (the "License");
+ *          you may not use this file except in compliance with the License.
+ *          You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *          Unless required by applicable law or agreed to in writing, software
+ *          distributed under the License is distributed on an "AS IS" BASIS,
+ *          WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *          See the License for the specific language governing permissions and
+ *          limitations under the License.
+ *
+ */
+/*
+ * Host tool: checks the delay-and-sum beamformer (axon_audio_features_lib/src/axon_beamformer.c) against its
+ * floating point reference.
+ *
+ * The library is compiled as-is with AXON_BEAMFORMER_FLOAT_REFERENCE=1, on top of a model of the 2 axon ops it
+ * uses (FIR and Xpy, rounding as axon_api.h describes). Every frame the library compares the axon output with the
+ * float delay-and-sum of the same input and keeps the largest difference in its stats.
+ *
+ * For each steering preset a plane wave (a tone, or white noise with -n) is run in from source angles -90..90
+ * degrees, mics BEAMFORMER_MIC_SPACING_MM apart. Each row reports the output level relative to the input
+ * (ie, the beam pattern, 0dB where the beam points) and the max reference error in LSBs.
+ * With an input file, stereo 16 bit WAV or raw interleaved samples, that is run through every preset instead.
+ *
+ * Build (from this directory):
+ *   gcc -O2 -o axon_beamformer_reference axon_beamformer_reference.c ../../axon_audio_features_lib/src/axon_beamformer.c \
+ *     -DAXON_BEAMFORMER_FLOAT_REFERENCE=1 -DAXON_KWS_STATS=0 -DRETAINED_MEMORY_SECTION_ATTRIBUTE= \
+ *     -I ../../axon_driver_lib/api -I ../../axon_audio_features_lib/api -I ../../axon_audio_features_lib/src \
+ *     -I ../../axon_utils/api -lm
+ *
+ * Usage:
+ *   axon_beamformer_reference [-f tone_hz] [-a amplitude] [-n] [input.wav]
+ */
+#include <stdint.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "axon_api.h"
+#include "axon_audio_features_api.h"
+#include "axon_beamformer.h"
+
+#if !AXON_BEAMFORMER_FLOAT_REFERENCE
+#  error "build with AXON_BEAMFORMER_FLOAT_REFERENCE=1"
+#endif
+
+#define REF_SAMPLE_RATE 16000
+#define REF_SPEED_OF_SOUND_MM_PER_S 343000.0
+#define REF_MIC_SPACING_MM 40 // BEAMFORMER_MIC_SPACING_MM in axon_beamformer_weights.h
+#define REF_FRAME_CNT 100
+#define REF_SETTLE_FRAME_CNT 2 // frames before the fir history is full of signal
+#define REF_SAMPLE_CNT (AXON_AUDIO_FEATURE_FRAME_LEN+(REF_FRAME_CNT-1)*AXON_AUDIO_FEATURE_FRAME_SHIFT)
+
+static const char *ref_steering_names[kAxonAudioFeatureBeamformerSteerCount] = {
+  "off", "broadside", "left45", "right45", "left endfire", "right endfire",
+};
+
+static void ref_fail(const char *fmt, ...) {
+  va_list args;
+  va_start(args, fmt);
+  fprintf(stderr, "axon_beamformer_reference: ");
+  vfprintf(stderr, fmt, args);
+  fprintf(stderr, "\n");
+  va_end(args);
+  exit(1);
+}
+
+/*
+ * Host side of the library.
+ */
+void AxonPrintf(char *fmt_string, ...) {
+  va_list args;
+  va_start(args, fmt_string);
+  vprintf(fmt_string, args);
+  va_end(args);
+}
+
+uint32_t AxonHostGetTime() {
+  return 0;
+}
+
+/*
+ * Model of the axon ops the beamformer defines. An op handle points at a copy of the op's input struct.
+ */
+typedef enum {
+  kRefOpFir,
+  kRefOpXpy,
+} RefOpEnum;
+
+typedef struct {
+  RefOpEnum op;
+  AxonInputStruct input;
+} RefOpStruct;
+
+#define REF_MAX_OPS 8
+static RefOpStruct ref_ops[REF_MAX_OPS];
+static uint8_t ref_op_cnt;
+
+/*
+ * shift right, then add 1 if the last bit shifted out was a 1.
+ */
+static int32_t ref_axon_round(int64_t value, AxonRoundingEnum rounding) {
+  if (kAxonRoundingNone==rounding) {
+    return (int32_t)value;
+  }
+  return (int32_t)((value + ((int64_t)1<<(rounding-1))) >> rounding);
+}
+
+static AxonResultEnum ref_define_op(RefOpEnum op, const AxonInputStruct *axon_input, AxonOpHandle *axon_op_handle) {
+  if (ref_op_cnt >= REF_MAX_OPS) {
+    return kAxonResultFailure;
+  }
+  ref_ops[ref_op_cnt].op = op;
+  ref_ops[ref_op_cnt].input = *axon_input;
+  *axon_op_handle = &ref_ops[ref_op_cnt++];
+  return kAxonResultSuccess;
+}
+
+AxonResultEnum AxonApiDefineOpFir(void *axon_handle, const AxonInputStruct *axon_input, AxonOpHandle *axon_op_handle) {
+  return ref_define_op(kRefOpFir, axon_input, axon_op_handle);
+}
+
+AxonResultEnum AxonApiDefineOpXpy(void *axon_handle, const AxonInputStruct *axon_input, AxonOpHandle *axon_op_handle) {
+  return ref_define_op(kRefOpXpy, axon_input, axon_op_handle);
+}
+
+static void ref_run_op(const RefOpStruct *op) {
+  const AxonInputStruct *in = &op->input;
+  uint16_t ndx, tap;
+
+  switch (op->op) {
+  case kRefOpFir:
+    // q[n] = sum(y[k]*x[n+k]), length-y_length outputs
+    for (ndx=0;ndx<in->length-in->y_length;ndx++) {
+      int64_t acc = 0;
+      for (tap=0;tap<in->y_length;tap++) {
+        acc += (int64_t)in->y_in[tap*in->y_stride] * in->x_in[(ndx+tap)*in->x_stride];
+      }
+      in->q_out[ndx*in->q_stride] = ref_axon_round(acc, in->output_rounding);
+    }
+    break;
+  case kRefOpXpy:
+    for (ndx=0;ndx<in->length;ndx++) {
+      in->q_out[ndx*in->q_stride] =
+          ref_axon_round((int64_t)in->x_in[ndx*in->x_stride] + in->y_in[ndx*in->y_stride], in->output_rounding);
+    }
+    break;
+  }
+}
+
+AxonResultEnum AxonApiExecuteOps(void *axon_handle, uint32_t op_count, AxonOpHandle ops[], AxonAsyncModeEnum async_mode) {
+  for (uint32_t ndx=0;ndx<op_count;ndx++) {
+    ref_run_op((const RefOpStruct *)ops[ndx]);
+  }
+  return kAxonResultSuccess;
+}
+
+AxonResultEnum AxonApiQueueOpsList(void *axon_handle, AxonMgrQueuedOpsStruct *ops_info) {
+  AxonResultEnum result = AxonApiExecuteOps(axon_handle, ops_info->op_handle_count, ops_info->op_handle_list, kAxonAsyncModeAsynchronous);
+  ops_info->callback_function(result, ops_info->callback_context);
+  return result;
+}
+
+/*
+ * Test signals, interleaved stereo.
+ */
+static int16_t ref_input[REF_SAMPLE_CNT][2];
+static uint32_t ref_random_state = 1;
+
+static double ref_random_normal() {
+  // sum of 12 uniforms is close enough to gaussian for a test signal
+  double sum = 0;
+  for (uint8_t ndx=0;ndx<12;ndx++) {
+    ref_random_state ^= ref_random_state << 13;
+    ref_random_state ^= ref_random_state >> 17;
+    ref_random_state ^= ref_random_state << 5;
+    sum += (double)ref_random_state/UINT32_MAX;
+  }
+  return sum-6;
+}
+
+/*
+ * white noise is band limited to 7kHz and delayed with a long windowed sinc.
+ */
+#define REF_NOISE_HALF_TAPS 32
+#define REF_NOISE_PAD (REF_NOISE_HALF_TAPS+2) // delays are within +/-1 sample
+static double ref_noise[REF_SAMPLE_CNT+2*REF_NOISE_PAD];
+
+static double ref_noise_at(double t) {
+  double sum = 0;
+  int32_t center = (int32_t)floor(t);
+  for (int32_t ndx=center-REF_NOISE_HALF_TAPS+1;ndx<=center+REF_NOISE_HALF_TAPS;ndx++) {
+    double x = t-ndx;
+    double fc = 7000.0/REF_SAMPLE_RATE;
+    double sinc = 0==x ? 2*fc : sin(2*M_PI*fc*x)/(M_PI*x);
+    double window = 0.5+0.5*cos(M_PI*x/REF_NOISE_HALF_TAPS);
+    sum += ref_noise[ndx+REF_NOISE_PAD] * sinc * window;
+  }
+  return sum;
+}
+
+static void ref_make_plane_wave(double angle_deg, double tone_hz, double amplitude, int noise) {
+  // channel 1 is on the +90 side, so a source there reaches it first
+  double tau = REF_MIC_SPACING_MM*sin(angle_deg*M_PI/180)/REF_SPEED_OF_SOUND_MM_PER_S*REF_SAMPLE_RATE;
+  double delays[2] = { tau/2, -tau/2 };
+
+  for (uint32_t ndx=0;ndx<REF_SAMPLE_CNT;ndx++) {
+    for (uint8_t channel=0;channel<2;channel++) {
+      double t = ndx-delays[channel];
+      double value = noise ? amplitude*ref_noise_at(t) : amplitude*sin(2*M_PI*tone_hz*t/REF_SAMPLE_RATE);
+      value = value > INT16_MAX ? INT16_MAX : value < INT16_MIN ? INT16_MIN : value;
+      ref_input[ndx][channel] = (int16_t)lrint(value);
+    }
+  }
+}
+
+/*
+ * Runs sample_cnt samples of ref_input through the library, returns the output level relative to the input in dB.
+ * The reference error is in the library's stats.
+ */
+static int32_t _Alignas(16) ref_fft_buffer[2*AXON_AUDIO_FEATURE_FRAME_LEN];
+
+static double ref_run(AxonAudioFeatureBeamformerSteeringEnum steering, uint32_t sample_cnt) {
+  double input_energy = 0, output_energy = 0;
+  uint32_t frame;
+
+  ref_op_cnt = 0;
+  if (kAxonResultSuccess != AxonBeamformerPrepare(NULL, ref_fft_buffer)) {
+    ref_fail("AxonBeamformerPrepare failed");
+  }
+  if (kAxonResultSuccess != AxonAudioFeaturesBeamformerSetSteering(steering)) {
+    ref_fail("can't steer to %d", steering);
+  }
+  for (frame=0;frame*AXON_AUDIO_FEATURE_FRAME_SHIFT+AXON_AUDIO_FEATURE_FRAME_LEN<=sample_cnt;frame++) {
+    const int16_t *samples = ref_input[frame*AXON_AUDIO_FEATURE_FRAME_SHIFT];
+    // split at the shift point, as the framework's circle buffer does every other frame
+    AxonBeamformerCopyRawInput(samples, AXON_AUDIO_FEATURE_FRAME_SHIFT, samples+2*AXON_AUDIO_FEATURE_FRAME_SHIFT, ref_fft_buffer);
+    AxonBeamformerProcessFrame(NULL, kAxonAsyncModeSynchronous);
+    if (frame < REF_SETTLE_FRAME_CNT) {
+      continue;
+    }
+    // only the new half of each frame, compared against the same (delayed) span of channel 0
+    for (uint32_t ndx=AXON_AUDIO_FEATURE_FRAME_SHIFT;ndx<AXON_AUDIO_FEATURE_FRAME_LEN;ndx++) {
+      double in = samples[2*(ndx-BEAMFORMER_GROUP_DELAY_SAMPLES)];
+      double out = ref_fft_buffer[2*ndx];
+      input_energy += in*in;
+      output_energy += out*out;
+    }
+  }
+  return 0==input_energy ? 0 : 10*log10((output_energy+1e-9)/input_energy);
+}
+
+static uint32_t ref_read_input(const char *path) {
+  FILE *in = fopen(path, "rb");
+  uint8_t header[44];
+  uint32_t sample_cnt;
+
+  if (NULL==in) {
+    ref_fail("can't open %s", path);
+  }
+  // skip a canonical WAV header, otherwise the file is raw samples
+  if ((sizeof(header) != fread(header, 1, sizeof(header), in)) || (0 != memcmp(header, "RIFF", 4))) {
+    rewind(in);
+  } else if ((2 != (header[22] | header[23]<<8)) || (16 != header[34])) {
+    ref_fail("%s isn't 16 bit stereo", path);
+  }
+  sample_cnt = (uint32_t)fread(ref_input, sizeof(ref_input[0]), REF_SAMPLE_CNT, in);
+  fclose(in);
+  if (sample_cnt < AXON_AUDIO_FEATURE_FRAME_LEN*(REF_SETTLE_FRAME_CNT+1)) {
+    ref_fail("%s is too short", path);
+  }
+  return sample_cnt;
+}
+
+static void usage(void) {
+  fprintf(stderr, "usage: axon_beamformer_reference [-f tone_hz] [-a amplitude] [-n] [input.wav]\n");
+  exit(2);
+}
+
+int main(int argc, char **argv) {
+  double tone_hz = 2000, amplitude = 8000;
+  int noise = 0;
+  const char *input_path = NULL;
+  AxonAudioFeatureBeamformerSteeringEnum steering;
+  float worst_error = 0;
+
+  for (int ndx=1;ndx<argc;ndx++) {
+    if ('-' != argv[ndx][0]) {
+      input_path = argv[ndx];
+    } else if (0==strcmp(argv[ndx], "-n")) {
+      noise = 1;
+    } else if ((ndx+1 < argc) && (0==strcmp(argv[ndx], "-f"))) {
+      tone_hz = atof(argv[++ndx]);
+    } else if ((ndx+1 < argc) && (0==strcmp(argv[ndx], "-a"))) {
+      amplitude = atof(argv[++ndx]);
+    } else {
+      usage();
+    }
+  }
+
+  if (NULL != input_path) {
+    uint32_t sample_cnt = ref_read_input(input_path);
+    printf("%-14s %8s %10s\n", "steering", "gain dB", "max err");
+    for (steering=kAxonAudioFeatureBeamformerBroadside;steering<kAxonAudioFeatureBeamformerSteerCount;steering++) {
+      double gain = ref_run(steering, sample_cnt);
+      float error = AxonBeamformerGetStats()->max_reference_error;
+      printf("%-14s %8.2f %10.3f\n", ref_steering_names[steering], gain, error);
+      worst_error = error > worst_error ? error : worst_error;
+    }
+  } else {
+    for (uint32_t ndx=0;ndx<sizeof(ref_noise)/sizeof(ref_noise[0]);ndx++) {
+      ref_noise[ndx] = ref_random_normal()/4;
+    }
+    if (noise) {
+      printf("white noise, amplitude %.0f\n", amplitude);
+    } else {
+      printf("%.0fHz tone, amplitude %.0f\n", tone_hz, amplitude);
+    }
+    printf("%-14s", "source deg");
+    for (int angle=-90;angle<=90;angle+=15) {
+      printf(" %6d", angle);
+    }
+    printf(" %8s\n", "max err");
+    for (steering=kAxonAudioFeatureBeamformerBroadside;steering<kAxonAudioFeatureBeamformerSteerCount;steering++) {
+      float error = 0;
+      printf("%-14s", ref_steering_names[steering]);
+      for (int angle=-90;angle<=90;angle+=15) {
+        ref_make_plane_wave(angle, tone_hz, amplitude, noise);
+        printf(" %6.2f", ref_run(steering, REF_SAMPLE_CNT));
+        error = AxonBeamformerGetStats()->max_reference_error > error ? AxonBeamformerGetStats()->max_reference_error : error;
+      }
+      printf(" %8.3f\n", error);
+      worst_error = error > worst_error ? error : worst_error;
+    }
+  }
+  // each fir rounds once (0.5 LSB) and the average rounds again
+  printf("worst reference error %.3f LSB (%s)\n", worst_error, worst_error <= 1.0f ? "ok" : "FAIL");
+  return worst_error <= 1.0f ? 0 : 1;
+}
@@ -0,0 +1,123 @@
+/**
+ *          Copyright (c) 2020-2022, Atlazo Inc.
+ *          All rights reserved.
+ *
+ *          Licensed under the Apache License, Version 2.0 (the "License");
+ *          you may not use this file except in compliance with the License.
+ *          You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *          Unless required by applicable law or agreed to in writing, software
+ *          distributed under the License is distributed on an "AS IS" BASIS,
+ *          WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *          See the License for the specific language governing permissions and
+ *          limitations under the License.
+ *
+ */
+/*
+ * Host tool: renders binary deferred log records (axon_deferred_log_api.h, AXON_DEFERRED_LOG_BINARY=1).
+ *
+ * Reads a capture of the debug port (or stdin) and copies it to stdout, replacing each record with its
+ * formatted text. With -t the text is prefixed with the record's timestamp in ms. Bytes that don't make a
+ * valid record are passed through as they are.
+ * It has to be built from the same axon_deferred_log_formats.h as the firmware that produced the log.
+ *
+ * Build (from this directory):
+ *   gcc -O2 -o axon_deferred_log_decode axon_deferred_log_decode.c -I ../../axon_utils/api
+ *
+ * Usage:
+ *   axon_deferred_log_decode [-t ticks_per_ms] [capture.bin]
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "axon_deferred_log_api.h"
+
+static const struct {
+  const char *format;
+  uint8_t arg_cnt;
+} decode_formats[kAxonDeferredLogFormatCount] = {
+#define AXON_DEFERRED_LOG_FORMAT(id, arg_cnt, format) { format, arg_cnt },
+#include "axon_deferred_log_formats.h"
+#undef AXON_DEFERRED_LOG_FORMAT
+};
+
+static uint32_t decode_le32(const uint8_t *bytes) {
+  return bytes[0] | bytes[1]<<8 | bytes[2]<<16 | (uint32_t)bytes[3]<<24;
+}
+
+static void usage(void) {
+  fprintf(stderr, "usage: axon_deferred_log_decode [-t ticks_per_ms] [capture.bin]\n");
+  exit(2);
+}
+
+int main(int argc, char **argv) {
+  uint8_t record[AXON_DEFERRED_LOG_HEADER_SIZE+4*AXON_DEFERRED_LOG_MAX_ARG_CNT];
+  int32_t args[AXON_DEFERRED_LOG_MAX_ARG_CNT];
+  uint32_t ticks_per_ms = 0;
+  uint32_t byte_cnt = 0;
+  uint32_t record_size;
+  uint16_t format;
+  FILE *file = stdin;
+  int ndx;
+  int byte;
+
+  for (ndx=1;(ndx<argc) && ('-'==argv[ndx][0]);ndx++) {
+    if ((0 != strcmp(argv[ndx], "-t")) || (ndx+1 >= argc)) {
+      usage();
+    }
+    ticks_per_ms = strtoul(argv[++ndx], NULL, 0);
+  }
+  if (ndx+1 < argc) {
+    usage();
+  }
+  if ((ndx < argc) && (NULL==(file=fopen(argv[ndx], "rb")))) {
+    perror(argv[ndx]);
+    return 1;
+  }
+
+  while (EOF != (byte=fgetc(file))) {
+    if (0==byte_cnt) {
+      if (AXON_DEFERRED_LOG_RECORD_MARKER==byte) {
+        record[byte_cnt++] = byte;
+      } else {
+        putchar(byte);
+      }
+      continue;
+    }
+    record[byte_cnt++] = byte;
+    if (byte_cnt < AXON_DEFERRED_LOG_HEADER_SIZE) {
+      continue;
+    }
+    format = record[2] | record[3]<<8;
+    if ((format >= kAxonDeferredLogFormatCount) || (record[1] != decode_formats[format].arg_cnt)) {
+      // not a record, pass the marker through and look for another one in the rest.
+      putchar(record[0]);
+      byte_cnt--;
+      memmove(record, record+1, byte_cnt);
+      while ((0 < byte_cnt) && (AXON_DEFERRED_LOG_RECORD_MARKER != record[0])) {
+        putchar(record[0]);
+        byte_cnt--;
+        memmove(record, record+1, byte_cnt);
+      }
+      continue;
+    }
+    record_size = AXON_DEFERRED_LOG_HEADER_SIZE+4*record[1];
+    if (byte_cnt < record_size) {
+      continue;
+    }
+    memset(args, 0, sizeof(args));
+    for (uint8_t arg=0;arg<record[1];arg++) {
+      args[arg] = (int32_t)decode_le32(&record[AXON_DEFERRED_LOG_HEADER_SIZE+4*arg]);
+    }
+    if (ticks_per_ms) {
+      printf("[%10.3f] ", (double)decode_le32(&record[4])/ticks_per_ms);
+    }
+    printf(decode_formats[format].format, args[0], args[1], args[2], args[3]);
+    byte_cnt = 0;
+  }
+  fwrite(record, 1, byte_cnt, stdout); // truncated record at the end
+  return 0;
+}
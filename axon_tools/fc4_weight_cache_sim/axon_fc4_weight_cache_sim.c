@@ -0,0 +1,378 @@
+/**
+ *          Copyright (c) 2020-2022, Atlazo Inc.
+ *          All rights reserved.
+ *
+ *          Licensed under the Apache License, Version 2.0 (the "License");
+ *          you may not use this file except in compliance with the License.
+ *          You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *          Unless required by applicable law or agreed to in writing, software
+ *          distributed under the License is distributed on an "AS IS" BASIS,
+ *          WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *          See the License for the specific language governing permissions and
+ *          limitations under the License.
+ *
+ */
+/*
+ * Host tool: runs the FC4 layer 1 weight cache (FC4_L1_WEIGHT_CACHE in axon_kws_model_fc4.c) against a
+ * simulated axon and a slow weight store.
+ *
+ * axon_kws_model_fc4.c is compiled in with the cache enabled, over stubs of the axon driver. A queued op list
+ * takes axon_ticks of simulated time per tile, then its callback runs in "ISR context". The weight reader
+ * takes read_ticks per row, and axon interrupts are delivered between rows unless they are disabled, the same
+ * as they would preempt a real read. The main loop services AxonKwsModelFc4LoadWeights() whenever the model
+ * has asked for it, and otherwise sleeps until the next axon interrupt. Inference is started in ISR context,
+ * as the bare-metal app does from the audio features callback.
+ *
+ * The run fails if a tile is read in ISR context, if axon is handed a tile whose weight buffer doesn't hold
+ * that tile's rows from flash, if an op list is queued while one is running, or if axon goes idle with the
+ * model waiting on a read that nobody was asked to do. Otherwise it prints the stalls, read time and total
+ * time per inference for each read speed.
+ *
+ * Without -r, read_ticks sweeps from 0 to 4x the time axon spends on a tile.
+ * -i leaves the request function unset so tiles are read in the callback, which is counted rather than
+ * treated as a failure.
+ *
+ * Build (from the repo root):
+ *   gcc -O2 -DRETAINED_MEMORY_SECTION_ATTRIBUTE= -DAXON_KWS_STATS=0 -I axon_audio_fc4_lib/src -I axon_audio_fc4_lib/api \
+ *     -I axon_driver_lib/api -I axon_audio_features_lib/api -I axon_utils/api \
+ *     -o axon_fc4_weight_cache_sim axon_tools/fc4_weight_cache_sim/axon_fc4_weight_cache_sim.c
+ *
+ * Usage:
+ *   axon_fc4_weight_cache_sim [-n inferences] [-a axon_ticks] [-r read_ticks] [-i]
+ */
+#include <stdint.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FC4_L1_WEIGHT_CACHE 1
+#include "axon_kws_model_fc4.c"
+
+#define FC4SIM_OP_CNT 256
+#define FC4SIM_FC_OPS 10 // handles a fully connected op list takes
+
+typedef enum {
+  kFc4SimOpMemCpy,
+  kFc4SimOpFullyConnected,
+} Fc4SimOpKindEnum;
+
+typedef struct {
+  Fc4SimOpKindEnum kind;
+  const int8_t *weights;
+  uint16_t input_length;
+  uint16_t output_length;
+} Fc4SimOpStruct;
+
+static struct {
+  Fc4SimOpStruct ops[FC4SIM_OP_CNT];
+  uint16_t op_cnt;
+  uint64_t now;
+  uint32_t axon_ticks;          // per tile, the remaining layers take the same
+  uint32_t read_ticks;          // per row
+  uint8_t interrupts_disabled;
+  uint8_t in_isr;
+  uint8_t inline_reads;         // -i
+  AxonMgrQueuedOpsStruct *running;
+  uint64_t running_done;
+  uint8_t expected_tile;        // next layer 1 tile axon should see
+  uint8_t service_requested;
+  uint8_t inference_done;
+  AxonResultEnum inference_result;
+  uint32_t isr_reads;
+  uint32_t tiles_checked;
+} fc4sim;
+
+static void fc4sim_fail(const char *fmt, ...) {
+  va_list args;
+  va_start(args, fmt);
+  fprintf(stderr, "FAIL: ");
+  vfprintf(stderr, fmt, args);
+  fprintf(stderr, "\n");
+  va_end(args);
+  exit(1);
+}
+
+/*
+ * axon driver and host stubs.
+ */
+uint32_t AxonHostGetTime() {
+  return (uint32_t)fc4sim.now;
+}
+
+static void fc4sim_deliver_interrupts();
+
+uint32_t AxonHostDisableInterrupts() {
+  uint32_t previous = fc4sim.interrupts_disabled;
+  fc4sim.interrupts_disabled = 1;
+  return previous;
+}
+
+void AxonHostRestoreInterrupts(uint32_t restore_value) {
+  fc4sim.interrupts_disabled = restore_value;
+  fc4sim_deliver_interrupts();
+}
+
+void AxonPrintf(char *fmt_string, ...) {
+  va_list args;
+  va_start(args, fmt_string);
+  vprintf(fmt_string, args);
+  va_end(args);
+}
+
+void axon_printf(void *axon_handle, char *fmt_string, ...) {
+  va_list args;
+  (void)axon_handle;
+  va_start(args, fmt_string);
+  vprintf(fmt_string, args);
+  va_end(args);
+}
+
+static AxonOpHandle fc4sim_new_op(Fc4SimOpKindEnum kind) {
+  if (fc4sim.op_cnt >= FC4SIM_OP_CNT) {
+    fc4sim_fail("out of simulated op handles");
+  }
+  fc4sim.ops[fc4sim.op_cnt].kind = kind;
+  return &fc4sim.ops[fc4sim.op_cnt++];
+}
+
+AxonResultEnum AxonApiDefineOpMemCpy(void *axon_handle, const AxonInputStruct *axon_input, AxonOpHandle *axon_op_handle) {
+  (void)axon_handle;
+  (void)axon_input;
+  *axon_op_handle = fc4sim_new_op(kFc4SimOpMemCpy);
+  return kAxonResultSuccess;
+}
+
+AxonResultEnum AxonApiDefineOpListFullyConnectedWithStopStep(void *axon_handle, uint16_t input_length, uint16_t output_length,
+    AxonDataWidthEnum input_data_width, int32_t *io_buffer, uint16_t io_buffer_length, const int8_t *weights,
+    const int32_t *bias_prime, int32_t bias_add_multiplier, uint16_t bias_add_rounding, AxonAfEnum activation_function,
+    const int32_t *normalization_mult, uint8_t normalization_mult_rounding, const int32_t *normalization_add,
+    uint8_t normalization_add_rounding, int32_t quantize_multiplier, int32_t quantize_add, uint8_t quantize_rounding,
+    int32_t standalone_quantize_add, int32_t *buf1, int32_t *buf2, uint16_t buf1_length, uint16_t buf2_length,
+    AxonOpHandle *axon_op_handles, uint8_t *op_handle_cnt, AxonFullyConnectedStopStepEnum stop_step) {
+  if (*op_handle_cnt < FC4SIM_FC_OPS) {
+    return kAxonResultBufferTooSmall;
+  }
+  for (uint8_t ndx=0;ndx<FC4SIM_FC_OPS;ndx++) {
+    axon_op_handles[ndx] = fc4sim_new_op(kFc4SimOpFullyConnected);
+    fc4sim.ops[fc4sim.op_cnt-1].weights = weights;
+    fc4sim.ops[fc4sim.op_cnt-1].input_length = input_length;
+    fc4sim.ops[fc4sim.op_cnt-1].output_length = output_length;
+  }
+  *op_handle_cnt = FC4SIM_FC_OPS;
+  return kAxonResultSuccess;
+}
+
+AxonResultEnum AxonApiFreeOpHandles(void *axon_handle, uint32_t op_count, AxonOpHandle ops[]) {
+  (void)axon_handle;
+  (void)op_count;
+  (void)ops;
+  return kAxonResultSuccess;
+}
+
+/*
+ * checks the weights of a layer 1 tile against flash as it is handed to axon.
+ */
+static void fc4sim_check_tile(const AxonMgrQueuedOpsStruct *ops_info) {
+  const Fc4SimOpStruct *fc_op = NULL;
+  uint8_t tile_ndx = fc4sim.expected_tile;
+
+  for (uint8_t ndx=0;ndx<ops_info->op_handle_count;ndx++) {
+    const Fc4SimOpStruct *op = ops_info->op_handle_list[ndx];
+    if (kFc4SimOpFullyConnected==op->kind) {
+      fc_op = op;
+      break;
+    }
+  }
+  if ((NULL==fc_op) || (FC4_L1_TILE_ROWS!=fc_op->output_length)) {
+    fc4sim_fail("expected layer 1 tile %d", tile_ndx);
+  }
+  for (uint16_t row=0;row<FC4_L1_TILE_ROWS;row++) {
+    if (memcmp(fc_op->weights+row*FC4_L1_PADDED_INPUT_LENGTH, fc4_l1_weights[tile_ndx*FC4_L1_TILE_ROWS+row], FC4_L1_INPUT_LENGTH)) {
+      fc4sim_fail("tile %d queued without its weights (row %d differs)", tile_ndx, row);
+    }
+  }
+  fc4sim.tiles_checked++;
+  fc4sim.expected_tile = tile_ndx+1 < FC4_L1_TILE_CNT ? tile_ndx+1 : 0;
+}
+
+AxonResultEnum AxonApiQueueOpsList(void *axon_handle, AxonMgrQueuedOpsStruct *ops_info) {
+  (void)axon_handle;
+  if (NULL != fc4sim.running) {
+    fc4sim_fail("op list queued while axon is busy");
+  }
+  if (fc4_l1_tile_complete_callback==ops_info->callback_function) {
+    fc4sim_check_tile(ops_info);
+  } else if (0 != fc4sim.expected_tile) {
+    fc4sim_fail("remaining layers queued before layer 1 finished");
+  }
+  fc4sim.running = ops_info;
+  fc4sim.running_done = fc4sim.now+fc4sim.axon_ticks;
+  return kAxonResultSuccess;
+}
+
+/*
+ * runs the callback of an op list that has finished, in "ISR context".
+ */
+static void fc4sim_deliver_interrupts() {
+  AxonMgrQueuedOpsStruct *done = fc4sim.running;
+
+  if (fc4sim.interrupts_disabled || fc4sim.in_isr || (NULL==done) || (fc4sim.now < fc4sim.running_done)) {
+    return;
+  }
+  fc4sim.running = NULL;
+  fc4sim.in_isr = 1;
+  done->callback_function(kAxonResultSuccess, done->callback_context);
+  fc4sim.in_isr = 0;
+}
+
+/*
+ * reads a row, letting time pass and axon interrupt along the way.
+ */
+static void fc4sim_slow_read(const int8_t *flash_src, int8_t *ram_dst, uint32_t length) {
+  if (fc4sim.in_isr) {
+    if (!fc4sim.inline_reads) {
+      fc4sim_fail("weights read in ISR context");
+    }
+    fc4sim.isr_reads++;
+  }
+  for (uint32_t tick=0;tick<fc4sim.read_ticks;tick++) {
+    fc4sim.now++;
+    fc4sim_deliver_interrupts();
+  }
+  memcpy(ram_dst, flash_src, length);
+}
+
+static void fc4sim_request_service() {
+  fc4sim.service_requested = 1;
+}
+
+static void fc4sim_inference_complete(AxonResultEnum result) {
+  fc4sim.inference_done = 1;
+  fc4sim.inference_result = result;
+}
+
+int AxonKwsHostGetNextAudioFeatureSlice(const AudioInputFeatureType **audio_features_in) {
+  static const AudioInputFeatureType silence[AUDIO_INPUT_FEATURE_HEIGHT];
+  *audio_features_in = silence;
+  return 0;
+}
+
+/*
+ * the host's main loop for one inference.
+ */
+static void fc4sim_infer() {
+  AxonResultEnum result;
+
+  // the bare-metal app starts inference from the audio features callback.
+  fc4sim.inference_done = 0;
+  fc4sim.in_isr = 1;
+  result = AxonKwsModelFc4Infer(FC4_L1_INPUT_WIDTH);
+  fc4sim.in_isr = 0;
+  if (kAxonResultSuccess > result) {
+    fc4sim_fail("infer returned %d", result);
+  }
+  while (!fc4sim.inference_done) {
+    if (fc4sim.service_requested) {
+      fc4sim.service_requested = 0;
+      AxonKwsModelFc4LoadWeights();
+      continue;
+    }
+    if (NULL==fc4sim.running) {
+      fc4sim_fail("axon is idle and nothing was requested (waiting tile %d)", fc4_retained_info.l1_waiting_tile);
+    }
+    // wfi
+    if (fc4sim.now < fc4sim.running_done) {
+      fc4sim.now = fc4sim.running_done;
+    }
+    fc4sim_deliver_interrupts();
+  }
+  if (kAxonResultSuccess > fc4sim.inference_result) {
+    fc4sim_fail("inference failed %d", fc4sim.inference_result);
+  }
+}
+
+static void fc4sim_run(uint32_t inference_cnt) {
+  uint32_t load_ticks;
+  uint32_t stall_cnt;
+  uint64_t start;
+
+  memset(&fc4_weight_cache_stats, 0, sizeof(fc4_weight_cache_stats));
+  memset(fc4_l1_weight_tiles, 0, sizeof(fc4_l1_weight_tiles));
+  fc4sim.op_cnt = 0;
+  fc4sim.expected_tile = 0;
+  fc4sim.service_requested = 0;
+  fc4sim.isr_reads = 0;
+  fc4sim.tiles_checked = 0;
+  AxonKwsModelFc4SetWeightReader(fc4sim_slow_read);
+  AxonKwsModelFc4SetWeightLoadRequest(fc4sim.inline_reads ? NULL : fc4sim_request_service);
+  if (kAxonResultSuccess > AxonKwsModelFc4Prepare(NULL, fc4sim_inference_complete)) {
+    fc4sim_fail("prepare failed");
+  }
+
+  start = fc4sim.now;
+  for (uint32_t ndx=0;ndx<inference_cnt;ndx++) {
+    fc4sim_infer();
+  }
+  // let the read of tile 0 for the next inference finish.
+  while (fc4sim.service_requested) {
+    fc4sim.service_requested = 0;
+    AxonKwsModelFc4LoadWeights();
+  }
+  if (fc4sim.tiles_checked != inference_cnt*FC4_L1_TILE_CNT) {
+    fc4sim_fail("%u tiles ran, expected %u", fc4sim.tiles_checked, inference_cnt*FC4_L1_TILE_CNT);
+  }
+  AxonKwsModelFc4GetWeightCacheStats(&load_ticks, &stall_cnt);
+  printf("%10u %10u %10u %12.1f %12.1f %10u\n", fc4sim.read_ticks*FC4_L1_TILE_ROWS, fc4sim.axon_ticks, stall_cnt,
+      (double)load_ticks/inference_cnt, (double)(fc4sim.now-start)/inference_cnt, fc4sim.isr_reads);
+}
+
+static void usage() {
+  fprintf(stderr, "usage: axon_fc4_weight_cache_sim [-n inferences] [-a axon_ticks] [-r read_ticks] [-i]\n");
+  fprintf(stderr, "  -n  inferences per read speed (default 8)\n");
+  fprintf(stderr, "  -a  simulated ticks axon takes per tile (default 1000)\n");
+  fprintf(stderr, "  -r  simulated ticks per weight row read (default sweeps 0 to 4x a tile)\n");
+  fprintf(stderr, "  -i  read tiles in the callback instead of handing them to the main loop\n");
+  exit(2);
+}
+
+int main(int argc, char *argv[]) {
+  uint32_t inference_cnt = 8;
+  int32_t read_ticks = -1;
+
+  fc4sim.axon_ticks = 1000;
+  for (int ndx=1;ndx<argc;ndx++) {
+    if (!strcmp(argv[ndx], "-n") && (ndx+1<argc)) {
+      inference_cnt = strtoul(argv[++ndx], NULL, 0);
+    } else if (!strcmp(argv[ndx], "-a") && (ndx+1<argc)) {
+      fc4sim.axon_ticks = strtoul(argv[++ndx], NULL, 0);
+    } else if (!strcmp(argv[ndx], "-r") && (ndx+1<argc)) {
+      read_ticks = strtol(argv[++ndx], NULL, 0);
+    } else if (!strcmp(argv[ndx], "-i")) {
+      fc4sim.inline_reads = 1;
+    } else {
+      usage();
+    }
+  }
+  if (0==inference_cnt) {
+    usage();
+  }
+
+  printf("%d tiles of %d rows, %d inferences per line\n", FC4_L1_TILE_CNT, FC4_L1_TILE_ROWS, inference_cnt);
+  printf("%10s %10s %10s %12s %12s %10s\n", "read/tile", "axon/tile", "stalls", "read/infer", "total/infer", "isr reads");
+  if (0 <= read_ticks) {
+    fc4sim.read_ticks = read_ticks;
+    fc4sim_run(inference_cnt);
+  } else {
+    static const uint8_t tile_multiples_x4[] = { 0, 1, 2, 3, 4, 6, 8, 16 };
+    for (uint8_t ndx=0;ndx<sizeof(tile_multiples_x4)/sizeof(tile_multiples_x4[0]);ndx++) {
+      fc4sim.read_ticks = fc4sim.axon_ticks*tile_multiples_x4[ndx]/4/FC4_L1_TILE_ROWS;
+      fc4sim_run(inference_cnt);
+    }
+  }
+  printf("PASS\n");
+  return 0;
+}
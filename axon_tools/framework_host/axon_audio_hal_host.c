@@ -0,0 +1,617 @@
+/**
+ *          Copyright (c) 2020-2022, Atlazo Inc.
+ *          All rights reserved.
+ *
+ *          Licensed under the Apache License, Version 2.0 (the "License");
+ *          you may not use this file except in compliance with the License.
+ *          You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *          Unless required by applicable law or agreed to in writing, software
+ *          distributed under the License is distributed on an "AS IS" BASIS,
+ *          WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *          See the License for the specific language governing permissions and
+ *          limitations under the License.
+ *
+ */
+/*
+ * Host tool: runs the audio framework (axon_audio_framework_lib) on Linux over WAV clips.
+ *
+ * This is the host implementation of axon_audio_hal.h plus the platform functions the board's app.c
+ * provides (AxonHostGetTime(), AxonHostWfi(), ...) and a main() that calls AxonAppPrepare()/AxonAppRun().
+ * The clips are laid end to end on a simulated timeline, separated by gap_ms of near silence. The "codec" is
+ * always producing that audio at 16kHz; while the rx DMA is running the circle buffer is filled up to the
+ * current time, so AxonAudioHalRxWriteNdx() moves exactly as the DMA write pointer does, and the rx half
+ * complete handler is called as each half of it fills (-n leaves it out, so the framework polls). The polling
+ * timer fires every period_ms of simulated time.
+ *
+ * Time only moves when the framework waits: AxonHostWfi() jumps to the next rx, timer or button event
+ * (which is dispatched when interrupts are restored), and AxonAudioHalDelayMs() runs the timeline forward.
+ * By default that is as fast as possible; -r paces it against the wall clock.
+ *
+ * In button mode SW2 is pressed press_ms before each clip and released as it starts. Always-on mode just
+ * sniffs the timeline. A line is printed as each clip starts so the classifications that follow can be
+ * attributed to it, and with -o the playback buffer is written to a WAV file whenever playback starts.
+ * The run ends (printing simulated vs wall time) gap_ms after the last clip, or sooner once nothing is left to happen.
+ *
+ * The axon driver in axon_driver_lib is RISC-V only, so the ml library is replaced by axon_ml_host_stub.c,
+ * which runs the same session and callbacks on a simple energy detector (see there). Build from the repo
+ * root with one of TRIGGER_MODE_BUTTON_PRESS=1 or TRIGGER_MODE_ALWAYS_ON=1, as the board build does. Either
+ * pipe the output through axon_tools/deferred_log or define AXON_DEFERRED_LOG_BINARY=0 to get the deferred
+ * log as text. eg:
+ *   gcc -O2 -std=gnu11 -DAXON_AUDIO_HAL_HOST=1 -DRETAINED_MEMORY_SECTION_ATTRIBUTE= -DTRIGGER_MODE_BUTTON_PRESS=1 \
+ *     -DAXON_DEFERRED_LOG_BINARY=0 -I axon_audio_framework_lib/src -I axon_audio_framework_lib/api \
+ *     -I axon_audio_ml_lib/api -I axon_utils/api -I axon_driver_lib/api \
+ *     axon_tools/framework_host/axon_audio_hal_host.c axon_tools/framework_host/axon_ml_host_stub.c \
+ *     axon_audio_framework_lib/src/axon_audio_framework.c axon_utils/src/axon_deferred_log.c \
+ *     axon_utils/src/axon_kws_stats.c -lm -o axon_framework_host
+ *
+ * The RTOS build (AXON_APP_RTOS=1) runs the board's FreeRTOS kernel on the single threaded host port in
+ * freertos_host (see portmacro.h there), with the tick driven from the simulated timeline. Add to the above:
+ *   -DAXON_APP_RTOS=1 -I axon_tools/framework_host/freertos_host -I core_drivers_v2p0/3rd-party/freertos-V5/include \
+ *     axon_tools/framework_host/freertos_host/port.c core_drivers_v2p0/3rd-party/freertos-V5/tasks.c \
+ *     core_drivers_v2p0/3rd-party/freertos-V5/queue.c core_drivers_v2p0/3rd-party/freertos-V5/list.c \
+ *     core_drivers_v2p0/3rd-party/freertos-V5/stream_buffer.c core_drivers_v2p0/3rd-party/freertos-V5/timers.c \
+ *     core_drivers_v2p0/3rd-party/freertos-V5/portable/MemMang/heap_4.c \
+ *     core_drivers_v2p0/3rd-party/freertos-V5/portable/MemMang/memory_impl.c
+ *
+ * Usage:
+ *   axon_framework_host [-r] [-n] [-g gap_ms] [-p press_ms] [-o playback.wav] clip.wav ...
+ */
+#define _POSIX_C_SOURCE 199309L
+#include <stdint.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "axon_audio_framework.h"
+#include "axon_audio_framework_api.h"
+#include "axon_audio_hal.h"
+#include "axon_api.h"
+#include "axon_dep.h"
+#include "axon_deferred_log_api.h"
+#if AXON_APP_RTOS
+#  include "FreeRTOS.h"
+#  include "task.h"
+#endif
+
+#if !AXON_AUDIO_HAL_HOST
+#  error "build with AXON_AUDIO_HAL_HOST=1"
+#endif
+
+#define HOST_SAMPLES_PER_MS AUDIO_SAMPLE_RATE_KHZ
+#define HOST_NEVER UINT64_MAX
+
+extern int AxonAppPrepare();
+
+typedef struct {
+  const char *path;
+  int16_t *samples;
+  uint64_t start_sample;  // on the timeline
+  uint32_t sample_cnt;
+} HostClipStruct;
+
+static struct {
+  HostClipStruct *clips;
+  uint32_t clip_cnt;
+  uint32_t next_clip_ndx;      // next clip start to announce
+  uint64_t end_sample;         // end of the timeline
+  uint32_t gap_ms;
+  uint32_t press_ms;
+  uint8_t realtime;
+  uint8_t no_rx_irq;
+  const char *playback_path;
+  struct timespec wall_start;
+
+  uint64_t now_us;
+  uint32_t interrupts_enabled;
+  uint32_t dither;
+
+  // rx "dma"
+  int16_t *rx_buffer;
+  uint32_t rx_len;
+  uint64_t rx_start_sample;    // timeline sample at rx_buffer[0]
+  uint64_t rx_written;         // samples written since the rx started, 0 when stopped
+  void (*rx_half_complete_handler)(uint8_t half);
+  uint64_t rx_halves_signalled;
+
+  // polling timer
+  void (*timer_handler)();
+  uint64_t timer_period_us;
+  uint64_t timer_next_us;
+
+  // buttons
+  uint8_t button_down[2];
+  uint32_t next_button_event; // even is SW2 down before clip n/2, odd is SW2 up at its start
+
+  // axon, see AxonHostSimulateAxonInterrupt()
+  uint64_t axon_irq_us;
+  void (*axon_irq_handler)();
+
+#if AXON_APP_RTOS
+  uint64_t tick_next_us;       // FreeRTOS tick
+  uint32_t irq_depth;          // simulated interrupts being handled
+#endif
+} host_info;
+
+static void host_fail(const char *fmt, ...) __attribute__((noreturn, format(printf, 1, 2)));
+
+static void host_fail(const char *fmt, ...) {
+  va_list args;
+  va_start(args, fmt);
+  fprintf(stderr, "axon_framework_host: ");
+  vfprintf(stderr, fmt, args);
+  fprintf(stderr, "\n");
+  va_end(args);
+  exit(1);
+}
+
+/*
+ * reads a 16kHz 16 bit mono WAV file, returns the sample count.
+ */
+static uint32_t host_read_wav(const char *path, int16_t **samples) {
+  FILE *in = fopen(path, "rb");
+  uint8_t header[12];
+  uint8_t chunk[8];
+  uint8_t fmt_ok = 0;
+
+  if (NULL==in) {
+    host_fail("can't open %s", path);
+  }
+  if ((sizeof(header) != fread(header, 1, sizeof(header), in)) || memcmp(header, "RIFF", 4) || memcmp(header+8, "WAVE", 4)) {
+    host_fail("%s is not a WAV file", path);
+  }
+  while (sizeof(chunk)==fread(chunk, 1, sizeof(chunk), in)) {
+    uint32_t chunk_length = chunk[4] | chunk[5]<<8 | chunk[6]<<16 | (uint32_t)chunk[7]<<24;
+    if (0==memcmp(chunk, "fmt ", 4)) {
+      uint8_t fmt[16];
+      if ((chunk_length < sizeof(fmt)) || (sizeof(fmt) != fread(fmt, 1, sizeof(fmt), in))) {
+        host_fail("%s: bad fmt chunk", path);
+      }
+      fmt_ok = (1==(fmt[2] | fmt[3]<<8)) && (1000*AUDIO_SAMPLE_RATE_KHZ==(fmt[4] | fmt[5]<<8 | fmt[6]<<16)) &&
+          (AUDIO_SAMPLE_BIT_WIDTH==(fmt[14] | fmt[15]<<8));
+      fseek(in, chunk_length-sizeof(fmt)+(chunk_length & 1), SEEK_CUR);
+    } else if (0==memcmp(chunk, "data", 4)) {
+      if (!fmt_ok) {
+        host_fail("%s: need 16kHz 16 bit mono", path);
+      }
+      chunk_length &= ~1u;
+      *samples = malloc(chunk_length);
+      if ((NULL==*samples) || (chunk_length != fread(*samples, 1, chunk_length, in))) {
+        host_fail("can't read %u bytes from %s", chunk_length, path);
+      }
+      fclose(in);
+      return chunk_length/2;
+    } else {
+      fseek(in, chunk_length+(chunk_length & 1), SEEK_CUR);
+    }
+  }
+  host_fail("%s: no data chunk", path);
+}
+
+static void host_write_wav(const char *path, const int16_t *samples, uint32_t sample_cnt) {
+  FILE *out = fopen(path, "wb");
+  uint32_t data_size = sample_cnt*sizeof(int16_t);
+  uint32_t byte_rate = 1000*AUDIO_SAMPLE_RATE_KHZ*sizeof(int16_t);
+  uint8_t header[44] = {
+    'R','I','F','F', 0,0,0,0, 'W','A','V','E',
+    'f','m','t',' ', 16,0,0,0, 1,0, 1,0,
+    (1000*AUDIO_SAMPLE_RATE_KHZ) & 0xff, (1000*AUDIO_SAMPLE_RATE_KHZ)>>8, 0,0,
+    byte_rate & 0xff, (byte_rate>>8) & 0xff, byte_rate>>16, 0,
+    2,0, AUDIO_SAMPLE_BIT_WIDTH,0,
+    'd','a','t','a', 0,0,0,0,
+  };
+
+  if (NULL==out) {
+    host_fail("can't create %s", path);
+  }
+  for (int ndx=0;ndx<4;ndx++) {
+    header[4+ndx] = (data_size+36)>>(8*ndx);
+    header[40+ndx] = data_size>>(8*ndx);
+  }
+  fwrite(header, 1, sizeof(header), out);
+  fwrite(samples, sizeof(int16_t), sample_cnt, out);
+  fclose(out);
+}
+
+static uint64_t host_wall_us() {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint64_t)(now.tv_sec-host_info.wall_start.tv_sec)*1000000+(now.tv_nsec-host_info.wall_start.tv_nsec)/1000;
+}
+
+static void host_finish() {
+  double wall_s = host_wall_us()/1e6;
+  double sim_s = host_info.now_us/1e6;
+
+  printf("\r\n%u clips, %.1f s of audio in %.2f s (%.1fx real time)\r\n",
+      host_info.clip_cnt, sim_s, wall_s, wall_s > 0 ? sim_s/wall_s : 0);
+  exit(0);
+}
+
+/*
+ * the codec's sample at a point on the timeline, +/-1 lsb of dither between the clips.
+ */
+static int16_t host_timeline_sample(uint64_t sample) {
+  static uint32_t clip_ndx;
+
+  // the timeline only moves forward, so the clip is either the last one used or a later one.
+  while ((clip_ndx < host_info.clip_cnt) && (sample >= host_info.clips[clip_ndx].start_sample+host_info.clips[clip_ndx].sample_cnt)) {
+    clip_ndx++;
+  }
+  if ((clip_ndx < host_info.clip_cnt) && (sample >= host_info.clips[clip_ndx].start_sample)) {
+    return host_info.clips[clip_ndx].samples[sample-host_info.clips[clip_ndx].start_sample];
+  }
+  host_info.dither = host_info.dither*1664525+1013904223;
+  return (int16_t)(host_info.dither>>30)-1;
+}
+
+/*
+ * "DMA" the samples up to now into the circle buffer.
+ */
+static void host_fill_rx() {
+  if (NULL==host_info.rx_buffer) {
+    return;
+  }
+  uint64_t target = host_info.now_us*HOST_SAMPLES_PER_MS/1000-host_info.rx_start_sample;
+  for (;host_info.rx_written<target;host_info.rx_written++) {
+    host_info.rx_buffer[host_info.rx_written % host_info.rx_len] = host_timeline_sample(host_info.rx_start_sample+host_info.rx_written);
+  }
+}
+
+static uint64_t host_button_event_us(uint32_t event) {
+#if TRIGGER_MODE_ALWAYS_ON
+  return HOST_NEVER;
+#else
+  if (event >= 2*host_info.clip_cnt) {
+    return HOST_NEVER;
+  }
+  uint64_t clip_start_us = host_info.clips[event/2].start_sample*1000/HOST_SAMPLES_PER_MS;
+  return event & 1 ? clip_start_us : clip_start_us-host_info.press_ms*1000;
+#endif
+}
+
+/*
+ * when the next half of the circle buffer will have filled.
+ */
+static uint64_t host_rx_event_us() {
+  if ((NULL==host_info.rx_buffer) || (NULL==host_info.rx_half_complete_handler)) {
+    return HOST_NEVER;
+  }
+  uint64_t sample = host_info.rx_start_sample+(host_info.rx_halves_signalled+1)*(host_info.rx_len/2);
+  return (sample*1000+HOST_SAMPLES_PER_MS-1)/HOST_SAMPLES_PER_MS;
+}
+
+static uint64_t host_next_event_us() {
+  uint64_t next = host_button_event_us(host_info.next_button_event);
+
+  if (host_rx_event_us() < next) {
+    next = host_rx_event_us();
+  }
+  if (host_info.timer_next_us < next) {
+    next = host_info.timer_next_us;
+  }
+  if (host_info.axon_irq_us < next) {
+    next = host_info.axon_irq_us;
+  }
+#if AXON_APP_RTOS
+  if (host_info.tick_next_us < next) {
+    next = host_info.tick_next_us;
+  }
+#endif
+  if (host_info.next_clip_ndx < host_info.clip_cnt) {
+    uint64_t clip_us = host_info.clips[host_info.next_clip_ndx].start_sample*1000/HOST_SAMPLES_PER_MS;
+    if (clip_us < next) {
+      next = clip_us;
+    }
+  }
+  return next;
+}
+
+/*
+ * moves the simulated time forward to to_us, pacing it w/ the wall clock in real-time mode.
+ */
+static void host_set_time(uint64_t to_us) {
+  if (to_us <= host_info.now_us) {
+    return;
+  }
+  if (to_us >= host_info.end_sample*1000/HOST_SAMPLES_PER_MS) {
+    host_finish();
+  }
+  if (host_info.realtime) {
+    uint64_t wall_us = host_wall_us();
+    if (to_us > wall_us) {
+      struct timespec delay = {
+        .tv_sec = (to_us-wall_us)/1000000,
+        .tv_nsec = (to_us-wall_us)%1000000*1000,
+      };
+      nanosleep(&delay, NULL);
+    }
+  }
+  host_info.now_us = to_us;
+  host_fill_rx();
+}
+
+/*
+ * Dispatches everything due up to until_us. Each event is consumed before its handler runs, so handlers
+ * that wait (and run this again) don't see it twice.
+ */
+static void host_run_until(uint64_t until_us) {
+  uint64_t next_us;
+
+  while ((next_us=host_next_event_us()) <= until_us) {
+    host_set_time(next_us);
+#if AXON_APP_RTOS
+    host_info.irq_depth++;
+#endif
+    if ((host_info.next_clip_ndx < host_info.clip_cnt) &&
+        (next_us==host_info.clips[host_info.next_clip_ndx].start_sample*1000/HOST_SAMPLES_PER_MS)) {
+      printf("\r\nclip %u: %s @%llu ms\r\n", host_info.next_clip_ndx, host_info.clips[host_info.next_clip_ndx].path,
+          (unsigned long long)(next_us/1000));
+      host_info.next_clip_ndx++;
+    } else if (next_us==host_button_event_us(host_info.next_button_event)) {
+      uint8_t down = 0==(host_info.next_button_event & 1);
+      host_info.next_button_event++;
+      host_info.button_down[kAxonAudioHalButtonRecord] = down;
+      if (down) {
+        axon_app_irq_enter();
+        axon_app_gpio_irq_handler();  // rising edge
+        axon_app_irq_exit();
+      }
+    } else if (next_us==host_info.axon_irq_us) {
+      host_info.axon_irq_us = HOST_NEVER;
+      axon_app_irq_enter();
+      host_info.axon_irq_handler();
+      axon_app_irq_exit();
+    } else if (next_us==host_rx_event_us()) {
+      axon_app_irq_enter();
+      host_info.rx_half_complete_handler(host_info.rx_halves_signalled++ % 2);
+      axon_app_irq_exit();
+#if AXON_APP_RTOS
+    } else if (next_us==host_info.tick_next_us) {
+      host_info.tick_next_us += portTICK_PERIOD_MS*1000;
+      vPortHostTick();
+#endif
+    } else {
+      host_info.timer_next_us += host_info.timer_period_us;
+      axon_app_irq_enter();
+      host_info.timer_handler();
+      axon_app_irq_exit();
+    }
+#if AXON_APP_RTOS
+    if (0==--host_info.irq_depth) {
+      vPortHostInterruptExit(); // switches to a task the interrupt woke
+    }
+#endif
+  }
+  host_set_time(until_us);
+}
+
+/***************************************************
+ * audio HAL
+ ***************************************************/
+void AxonAudioHalPowerUp() {
+}
+
+void AxonAudioHalPowerDown() {
+}
+
+uint8_t AxonAudioHalRxStart(int16_t *circle_buffer, uint32_t sample_count, void (*half_complete_handler)(uint8_t half)) {
+  host_info.rx_buffer = circle_buffer;
+  host_info.rx_len = sample_count;
+  host_info.rx_start_sample = host_info.now_us*HOST_SAMPLES_PER_MS/1000;
+  host_info.rx_written = 0;
+  host_info.rx_halves_signalled = 0;
+  host_info.rx_half_complete_handler = host_info.no_rx_irq ? NULL : half_complete_handler;
+  return NULL != host_info.rx_half_complete_handler;
+}
+
+void AxonAudioHalRxStop() {
+  host_info.rx_buffer = NULL;
+}
+
+uint32_t AxonAudioHalRxWriteNdx() {
+  host_fill_rx();
+  return host_info.rx_written % host_info.rx_len;
+}
+
+void AxonAudioHalTxStart(const int16_t *buffer, uint32_t sample_count) {
+  if (NULL != host_info.playback_path) {
+    host_write_wav(host_info.playback_path, buffer, sample_count);
+    printf("playback written to %s\r\n", host_info.playback_path);
+  }
+}
+
+void AxonAudioHalTxStop() {
+}
+
+void AxonAudioHalTimerStart(uint32_t period_ms, void (*timer_handler)()) {
+  host_info.timer_handler = timer_handler;
+  host_info.timer_period_us = period_ms*1000;
+  host_info.timer_next_us = host_info.now_us+host_info.timer_period_us;
+}
+
+void AxonAudioHalTimerStop() {
+  host_info.timer_next_us = HOST_NEVER;
+}
+
+void AxonAudioHalLedInit() {
+}
+
+void AxonAudioHalSetLed(AxonAudioHalLedEnum led, uint8_t on) {
+}
+
+void AxonAudioHalButtonInit() {
+}
+
+uint8_t AxonAudioHalGetButton(AxonAudioHalButtonEnum button) {
+  return host_info.button_down[button];
+}
+
+void AxonAudioHalButtonIrqClear(AxonAudioHalButtonEnum button) {
+}
+
+void AxonAudioHalDelayMs(uint32_t milliseconds) {
+  host_run_until(host_info.now_us+milliseconds*1000);
+}
+
+/***************************************************
+ * platform functions (app.c on the board)
+ ***************************************************/
+uint32_t AxonHostDisableInterrupts() {
+  uint32_t state = host_info.interrupts_enabled;
+  host_info.interrupts_enabled = 0;
+  return state;
+}
+
+void AxonHostRestoreInterrupts(uint32_t restore_value) {
+  if (restore_value) {
+    host_info.interrupts_enabled = 1;
+    // take the interrupts that came in while disabled
+    host_run_until(host_info.now_us);
+  }
+}
+
+/*
+ * sleeps until the next interrupt, which is taken when interrupts are restored.
+ */
+void AxonHostWfi() {
+  uint64_t next_us = host_next_event_us();
+
+  if (HOST_NEVER==next_us) {
+    host_finish(); // nothing will ever happen again
+  }
+  host_set_time(next_us);
+  if (host_info.interrupts_enabled) {
+    host_run_until(host_info.now_us);
+  }
+}
+
+void AxonHostLog(AxonInstanceStruct *axon, char *msg) {
+  (void)axon;
+  fputs(msg, stdout);
+}
+
+/*
+ * binary deferred log records (AXON_DEFERRED_LOG_BINARY=1), pipe the output through axon_tools/deferred_log.
+ */
+void AxonHostLogWrite(const uint8_t *bytes, uint32_t byte_cnt) {
+  fwrite(bytes, 1, byte_cnt, stdout);
+}
+
+/*
+ * 16MHz ticks, as stimer_get_tick() on the board.
+ */
+uint32_t AxonHostGetTime() {
+  return (uint32_t)(host_info.now_us*16);
+}
+
+uint8_t AxonHostAddressAvailableToAxon(uint32_t addr) {
+  return 1;
+}
+
+uint32_t AxonHostTransformAddress(uint32_t from_addr) {
+  return from_addr;
+}
+
+void AxonHostEnableAxonInterrupt() {
+}
+
+void AxonHostDisableAxonInterrupt() {
+}
+
+void AxonHostAxonEnable(uint8_t power_on_reset) {
+}
+
+void AxonHostAxonDisable() {
+}
+
+uint16_t AxonHostGetVoteId() {
+  return 1;
+}
+
+void AxonHostAxonEnableVote(uint8_t power_on_reset, uint16_t voter_id) {
+}
+
+void AxonHostAxonDisableVote(uint16_t voter_id) {
+}
+
+void AxonHostSetProfilingGpio(uint8_t level) {
+}
+
+/*
+ * For axon_ml_host_stub.c: handler is called from the simulated axon interrupt after_us from now, in
+ * place of any still pending.
+ */
+void AxonHostSimulateAxonInterrupt(uint32_t after_us, void (*handler)()) {
+  host_info.axon_irq_handler = handler;
+  host_info.axon_irq_us = host_info.now_us+after_us;
+}
+
+void bsp_set_profiling_gpio(uint8_t high_or_low) {
+}
+
+static void usage(void) {
+  fprintf(stderr, "usage: axon_framework_host [-r] [-n] [-g gap_ms] [-p press_ms] [-o playback.wav] clip.wav ...\n");
+  exit(2);
+}
+
+int main(int argc, char **argv) {
+  uint64_t timeline_sample;
+  int ndx;
+
+  host_info.gap_ms = 1000*MAX_RECORDING_SEC;
+  host_info.press_ms = 200;
+  for (ndx=1;(ndx<argc) && ('-'==argv[ndx][0]);ndx++) {
+    if (0==strcmp(argv[ndx], "-r")) {
+      host_info.realtime = 1;
+      continue;
+    }
+    if (0==strcmp(argv[ndx], "-n")) {
+      host_info.no_rx_irq = 1;
+      continue;
+    }
+    if ((ndx+1 >= argc) || (0 != argv[ndx][2])) {
+      usage();
+    }
+    switch (argv[ndx++][1]) {
+    case 'g': host_info.gap_ms = strtoul(argv[ndx], NULL, 0); break;
+    case 'p': host_info.press_ms = strtoul(argv[ndx], NULL, 0); break;
+    case 'o': host_info.playback_path = argv[ndx]; break;
+    default:
+      usage();
+    }
+  }
+  if (ndx>=argc) {
+    usage();
+  }
+  if (host_info.press_ms >= host_info.gap_ms) {
+    host_fail("press_ms has to be less than gap_ms");
+  }
+
+  host_info.clip_cnt = argc-ndx;
+  host_info.clips = calloc(host_info.clip_cnt, sizeof(HostClipStruct));
+  timeline_sample = (uint64_t)host_info.gap_ms*HOST_SAMPLES_PER_MS;
+  for (uint32_t clip=0;clip<host_info.clip_cnt;clip++) {
+    host_info.clips[clip].path = argv[ndx+clip];
+    host_info.clips[clip].sample_cnt = host_read_wav(argv[ndx+clip], &host_info.clips[clip].samples);
+    host_info.clips[clip].start_sample = timeline_sample;
+    timeline_sample += host_info.clips[clip].sample_cnt+(uint64_t)host_info.gap_ms*HOST_SAMPLES_PER_MS;
+  }
+  host_info.end_sample = timeline_sample;
+  host_info.timer_next_us = HOST_NEVER;
+  host_info.axon_irq_us = HOST_NEVER;
+#if AXON_APP_RTOS
+  host_info.tick_next_us = portTICK_PERIOD_MS*1000;
+#endif
+  host_info.interrupts_enabled = 1;
+  clock_gettime(CLOCK_MONOTONIC, &host_info.wall_start);
+
+  if (kAxonResultSuccess > AxonAppPrepare()) {
+    host_fail("AxonAppPrepare failed");
+  }
+  AxonAppRun(NULL, 0); // doesn't return, host_finish() exits
+  return 0;
+}
@@ -0,0 +1,259 @@
+/**
+ *          Copyright (c) 2020-2022, Atlazo Inc.
+ *          All rights reserved.
+ *
+ *          Licensed under the Apache License, Version 2.0 (the "License");
+ *          you may not use this file except in compliance with the License.
+ *          You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *          Unless required by applicable law or agreed to in writing, software
+ *          distributed under the License is distributed on an "AS IS" BASIS,
+ *          WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *          See the License for the specific language governing permissions and
+ *          limitations under the License.
+ *
+ */
+/*
+ * Host tool: stand-in for axon_audio_ml_lib (axon_audio_ml_api.h) so the audio framework can run on Linux
+ * without axon. The prebuilt driver is RISC-V only, so the features and model libraries can't be linked.
+ *
+ * It keeps the ml library's session rules (AxonKwsProcessFrame() refuses a frame while the last one is
+ * being processed or a window is being classified), raises the same host callbacks in the same order, and
+ * hands its completion stages to AxonMlDemoHostDeferCompletion() in the RTOS build. The features of a frame
+ * and the model each complete in a simulated axon interrupt, STUB_FEATURES_US and STUB_MODEL_US after they
+ * start, so completions arrive in interrupt context as they do on the board. The times are placeholders,
+ * not measurements.
+ *
+ * A frame is foreground when its mean absolute sample is above STUB_FOREGROUND_FLOOR and
+ * STUB_FOREGROUND_RATIO times the background estimate. A window is valid once at least
+ * STUB_WINDOW_MIN_FOREGROUND_CNT foreground frames have been followed by STUB_WINDOW_END_BACKGROUND_CNT
+ * background frames, or has reached STUB_WINDOW_MAX_FRAME_CNT. The "classification" is always index 0,
+ * labelled with the window's first frame and width, so a run shows when and over what the framework
+ * would have classified.
+ */
+#include <stdint.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "axon_api.h"
+#include "axon_dep.h"
+#include "axon_audio_ml_api.h"
+
+#define STUB_FRAME_LEN (512)                    // 32ms at 16kHz
+#define STUB_FOREGROUND_FLOOR (64)
+#define STUB_FOREGROUND_RATIO (4)
+#define STUB_WINDOW_MIN_FOREGROUND_CNT (4)
+#define STUB_WINDOW_END_BACKGROUND_CNT (8)
+#define STUB_WINDOW_MAX_FRAME_CNT (62)          // 1s of 16ms frames
+#define STUB_FEATURES_US (1000)
+#define STUB_MODEL_US (10000)
+
+void AxonHostSimulateAxonInterrupt(uint32_t after_us, void (*handler)());
+
+#if AXON_APP_RTOS
+#  define STUB_COMPLETE(completion, result) AxonMlDemoHostDeferCompletion((completion), (result))
+#else
+#  define STUB_COMPLETE(completion, result) AxonKwsRunCompletion((completion), (result))
+#endif
+
+typedef enum {
+  kStubStateIdle,
+  kStubStateFeatureCalc,
+  kStubStateWaitForAudio,
+  kStubStateClassifying,
+  kStubStateComplete,
+} StubStateEnum;
+
+static struct {
+  StubStateEnum state;
+  KwsClassifyOptionEnum classify_option;
+  KwsFirstOrLastAudioFrame first_or_last_frame;
+  uint32_t frame_ndx;               // frames in this session
+  uint32_t background_level;        // mean absolute sample, follows the room across sessions
+  uint8_t last_frame_was_foreground;
+  uint32_t window_first_frame;      // first foreground frame of the window being built, 0 if none
+  uint32_t window_foreground_cnt;
+  uint32_t window_background_cnt;   // consecutive background frames since the last foreground
+  uint32_t window_width;            // width of the window being classified
+  char label[48];
+  char log_buffer[256];
+} stub_info;
+
+void AxonPrintf(char *fmt_string, ...) {
+  va_list arg_list;
+
+  va_start(arg_list, fmt_string);
+  vsnprintf(stub_info.log_buffer, sizeof(stub_info.log_buffer), fmt_string, arg_list);
+  va_end(arg_list);
+  AxonHostLog(NULL, stub_info.log_buffer);
+}
+
+/*
+ * axon_kws_stats.c wraps these, nothing on the host calls them.
+ */
+AxonResultEnum AxonApiQueueOpsList(void *axon_handle, AxonMgrQueuedOpsStruct *ops_info) {
+  return kAxonResultFailure;
+}
+
+AxonResultEnum AxonApiExecuteOps(void *axon_handle, uint32_t op_count, AxonOpHandle ops[], AxonAsyncModeEnum async_mode) {
+  return kAxonResultFailure;
+}
+
+int AxonDemoPrepare(void *unused) {
+  stub_info.state = kStubStateIdle;
+  return 0;
+}
+
+/*
+ * the real one classifies the stored clips, the stub has none.
+ */
+int AxonDemoRun(void *unused1, uint8_t unused2) {
+  AxonPrintf("axon ml stub: no axon, the ml library is simulated\r\n");
+  return 0;
+}
+
+/*
+ * tracks the background and the window through one frame. Returns the width of a window that has just
+ * become valid, 0 if none.
+ */
+static uint32_t stub_update_window(uint32_t level) {
+  uint32_t threshold = STUB_FOREGROUND_RATIO*stub_info.background_level;
+
+  stub_info.last_frame_was_foreground = (level > STUB_FOREGROUND_FLOOR) && (level > threshold);
+  if (stub_info.last_frame_was_foreground) {
+    if (0==stub_info.window_foreground_cnt++) {
+      stub_info.window_first_frame = stub_info.frame_ndx;
+    }
+    stub_info.window_background_cnt = 0;
+  } else {
+    stub_info.background_level += ((int32_t)level-(int32_t)stub_info.background_level)/8;
+    if (stub_info.window_foreground_cnt) {
+      stub_info.window_background_cnt++;
+    }
+  }
+  if (0==stub_info.window_foreground_cnt) {
+    return 0;
+  }
+  uint32_t width = stub_info.frame_ndx-stub_info.window_first_frame+1;
+  if ((width >= STUB_WINDOW_MAX_FRAME_CNT) ||
+      ((stub_info.window_foreground_cnt >= STUB_WINDOW_MIN_FOREGROUND_CNT) &&
+       (stub_info.window_background_cnt >= STUB_WINDOW_END_BACKGROUND_CNT))) {
+    return width;
+  }
+  if (stub_info.window_background_cnt >= STUB_WINDOW_END_BACKGROUND_CNT) {
+    stub_info.window_foreground_cnt = 0; // too short, start over
+  }
+  return 0;
+}
+
+static void stub_features_irq_handler() {
+  STUB_COMPLETE(kAxonMlCompletionFeatures, kAxonResultSuccess);
+}
+
+static void stub_model_irq_handler() {
+  STUB_COMPLETE(kAxonMlCompletionClassification, kAxonResultSuccess);
+}
+
+static void stub_feature_complete(AxonResultEnum result) {
+  uint32_t width = stub_info.window_width;
+
+  if ((stub_info.classify_option>=kDoClassify) ||
+      ((stub_info.classify_option==kClassifyOnValidWindow) && width)) {
+    if (stub_info.classify_option>kDoClassify) {
+      width = stub_info.classify_option-kDoClassify;
+    }
+    stub_info.window_width = width;
+    stub_info.state = kStubStateClassifying;
+    AxonMlDemoHostClassifyingStart(stub_info.window_first_frame, width);
+    STUB_COMPLETE(kAxonMlCompletionClassifyWindow, kAxonResultSuccess);
+  } else {
+    AxonMlDemoHostAxonSetEnabled(kAxonBoolFalse);
+    if (stub_info.first_or_last_frame==kLastFrame) {
+      stub_info.state = kStubStateComplete;
+      AxonMlDemoHostNoClassification();
+    } else {
+      stub_info.state = kStubStateWaitForAudio;
+    }
+  }
+}
+
+void AxonKwsRunCompletion(AxonMlCompletionEnum completion, AxonResultEnum result) {
+  switch (completion) {
+  case kAxonMlCompletionFeatures:
+    stub_feature_complete(result);
+    break;
+  case kAxonMlCompletionClassifyWindow:
+    snprintf(stub_info.label, sizeof(stub_info.label), "stub window %u+%u", stub_info.window_first_frame, stub_info.window_width);
+    AxonHostSimulateAxonInterrupt(STUB_MODEL_US, stub_model_irq_handler);
+    break;
+  case kAxonMlCompletionClassification:
+    stub_info.state = kStubStateComplete;
+    AxonMlDemoHostClassifyingEnd(0);
+    break;
+  default:
+    break;
+  }
+}
+
+int AxonKwsProcessFrame(
+    const int16_t *raw_input_ping,
+    uint32_t ping_count,
+    const int16_t *raw_input_pong,
+    uint8_t input_stride,
+    KwsFirstOrLastAudioFrame first_or_last_frame,
+    KwsClassifyOptionEnum classify_option) {
+  uint32_t sum = 0;
+
+  if (!(((stub_info.state==kStubStateIdle) && (first_or_last_frame==kFirstFrame)) ||
+      ((first_or_last_frame!=kFirstFrame) && (stub_info.state==kStubStateWaitForAudio)))) {
+    return -1000;
+  }
+  AxonMlDemoHostAxonSetEnabled(kAxonBoolTrue);
+  if (kFirstFrame==first_or_last_frame) {
+    stub_info.frame_ndx = 0;
+    stub_info.window_foreground_cnt = 0;
+    stub_info.window_background_cnt = 0;
+    stub_info.window_first_frame = 0;
+  }
+  stub_info.state = kStubStateFeatureCalc;
+  stub_info.classify_option = classify_option;
+  stub_info.first_or_last_frame = first_or_last_frame;
+
+  for (uint32_t ndx=0;ndx<STUB_FRAME_LEN;ndx++) {
+    int16_t sample = ndx<ping_count ? raw_input_ping[ndx*input_stride] : raw_input_pong[(ndx-ping_count)*input_stride];
+    sum += abs(sample);
+  }
+  stub_info.frame_ndx++;
+  stub_info.window_width = stub_update_window(sum/STUB_FRAME_LEN);
+
+  AxonHostSimulateAxonInterrupt(STUB_FEATURES_US, stub_features_irq_handler);
+  return 0;
+}
+
+int AxonKwsClearLastResult(const char **result_label) {
+  if ((stub_info.state==kStubStateWaitForAudio) || (stub_info.state==kStubStateComplete) ||
+      (stub_info.state==kStubStateIdle)) {
+    stub_info.state = kStubStateIdle;
+  }
+  if (NULL != result_label) {
+    *result_label = stub_info.label;
+  }
+  return 0;
+}
+
+int AxonKwsLastFrameWasForeground() {
+  return stub_info.last_frame_was_foreground;
+}
+
+int AxonKwsReadyForFrame() {
+  return (stub_info.state==kStubStateIdle) || (stub_info.state==kStubStateWaitForAudio);
+}
+
+void AxonKwsServiceModel() {
+}
+
+int AxonKwsModelServicePending() {
+  return 0;
+}
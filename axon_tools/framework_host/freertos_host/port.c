@@ -0,0 +1,141 @@
+/**
+ *          Copyright (c) 2020-2022, Atlazo Inc.
+ *          All rights reserved.
+ *
+ *          Licensed under the Apache License, Version 2.0 (the "License");
+ *          you may not use this file except in compliance with the License.
+ *          You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *          Unless required by applicable law or agreed to in writing, software
+ *          distributed under the License is distributed on an "AS IS" BASIS,
+ *          WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *          See the License for the specific language governing permissions and
+ *          limitations under the License.
+ *
+ */
+/*
+ * FreeRTOS port for the framework host tool, see portmacro.h.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <ucontext.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*
+ * Task stacks on the host are separate from the ones the application gives the kernel, which are sized
+ * for the board and too small for glibc. The kernel's stack only holds the pointer to this.
+ */
+#define HOST_TASK_STACK_SIZE (256*1024)
+
+typedef struct {
+  ucontext_t context;
+  TaskFunction_t code;
+  void *parameters;
+} HostTaskStruct;
+
+/*
+ * the 1st member of the kernel's TCB is its pxTopOfStack, which is where pxPortInitialiseStack()'s
+ * HostTaskStruct goes.
+ */
+extern void * volatile pxCurrentTCB;
+#define HOST_CURRENT_TASK() (*(HostTaskStruct **)pxCurrentTCB)
+
+static struct {
+  uint8_t scheduler_running;
+  uint8_t interrupts_disabled;
+  uint8_t yield_pending;
+} port_info;
+
+static void host_task_entry(void) {
+  HostTaskStruct *task = HOST_CURRENT_TASK();
+
+  task->code(task->parameters);
+  fprintf(stderr, "freertos host port: a task returned\n");
+  abort();
+}
+
+StackType_t *pxPortInitialiseStack(StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters) {
+  HostTaskStruct *task = calloc(1, sizeof(HostTaskStruct));
+
+  if ((NULL==task) || (NULL==(task->context.uc_stack.ss_sp = malloc(HOST_TASK_STACK_SIZE)))) {
+    fprintf(stderr, "freertos host port: out of memory\n");
+    abort();
+  }
+  task->code = pxCode;
+  task->parameters = pvParameters;
+  getcontext(&task->context);
+  task->context.uc_stack.ss_size = HOST_TASK_STACK_SIZE;
+  task->context.uc_link = NULL;
+  makecontext(&task->context, host_task_entry, 0);
+  return (StackType_t *)task;
+}
+
+/*
+ * switches to the task the kernel picks, if it's another one.
+ */
+static void host_switch_context(void) {
+  HostTaskStruct *from = HOST_CURRENT_TASK();
+  HostTaskStruct *to;
+
+  vTaskSwitchContext();
+  to = HOST_CURRENT_TASK();
+  if (to != from) {
+    swapcontext(&from->context, &to->context);
+  }
+}
+
+BaseType_t xPortStartScheduler(void) {
+  // vTaskStartScheduler() masks interrupts, the first task starts with them unmasked.
+  port_info.interrupts_disabled = 0;
+  port_info.scheduler_running = 1;
+  setcontext(&HOST_CURRENT_TASK()->context);
+  return pdFAIL;
+}
+
+void vPortEndScheduler(void) {
+  abort();
+}
+
+void vPortYield(void) {
+  if (port_info.interrupts_disabled) {
+    port_info.yield_pending = 1; // taken when the critical section ends
+    return;
+  }
+  port_info.yield_pending = 0;
+  host_switch_context();
+}
+
+void vPortYieldFromISR(void) {
+  port_info.yield_pending = 1;
+}
+
+void vPortDisableInterrupts(void) {
+  port_info.interrupts_disabled = 1;
+}
+
+void vPortEnableInterrupts(void) {
+  port_info.interrupts_disabled = 0;
+  if (port_info.yield_pending && port_info.scheduler_running) {
+    vPortYield();
+  }
+}
+
+void vPortHostTick(void) {
+  if (port_info.scheduler_running && (pdFALSE != xTaskIncrementTick())) {
+    port_info.yield_pending = 1;
+  }
+}
+
+void vPortHostInterruptExit(void) {
+  if (port_info.yield_pending && port_info.scheduler_running && !port_info.interrupts_disabled) {
+    vPortYield();
+  }
+}
+
+void vAssertCalled(const char *pcFile, unsigned long ulLine) {
+  fprintf(stderr, "freertos host port: assert failed at %s:%lu\n", pcFile, ulLine);
+  abort();
+}
@@ -0,0 +1,105 @@
+/**
+ *          Copyright (c) 2020-2022, Atlazo Inc.
+ *          All rights reserved.
+ *
+ *          Licensed under the Apache License, Version 2.0 (the "License");
+ *          you may not use this file except in compliance with the License.
+ *          You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *          Unless required by applicable law or agreed to in writing, software
+ *          distributed under the License is distributed on an "AS IS" BASIS,
+ *          WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *          See the License for the specific language governing permissions and
+ *          limitations under the License.
+ *
+ */
+/*
+ * FreeRTOS port for the framework host tool (axon_audio_hal_host.c with AXON_APP_RTOS=1).
+ *
+ * The kernel (core_drivers_v2p0/3rd-party/freertos-V5) and its FreeRTOSConfig.h are the board's. The
+ * port is single threaded: each task runs on its own ucontext stack and only one runs at a time, so the
+ * run is as repeatable as the bare-metal one. Interrupts are the host HAL's simulated ones. They only
+ * happen when the HAL dispatches them, which it never does inside a critical section, so masking them
+ * here only has to hold back context switches. A switch asked for from an interrupt waits until the HAL
+ * calls vPortHostInterruptExit() as the outermost one returns, and the HAL calls vPortHostTick() every
+ * tick of simulated time.
+ */
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Type definitions. */
+#define portSTACK_TYPE        uintptr_t
+#define portBASE_TYPE         long
+#define portPOINTER_SIZE_TYPE uintptr_t
+
+typedef portSTACK_TYPE StackType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define portMAX_DELAY ( TickType_t ) 0xffffffffUL
+#define portTICK_TYPE_IS_ATOMIC 1
+
+#define portCHAR   char
+#define portFLOAT  float
+#define portDOUBLE double
+#define portLONG   long
+#define portSHORT  short
+
+/* Architecture specifics. */
+#define portSTACK_GROWTH    ( -1 )
+#define portTICK_PERIOD_MS  ( ( TickType_t ) 1000 / configTICK_RATE_HZ )
+#define portBYTE_ALIGNMENT  16
+
+/* Scheduler utilities. */
+extern void vPortYield( void );
+extern void vPortYieldFromISR( void );
+
+#define portYIELD() vPortYield()
+#define portEND_SWITCHING_ISR( xSwitchRequired ) if( xSwitchRequired ) vPortYieldFromISR()
+#define portYIELD_FROM_ISR( x ) portEND_SWITCHING_ISR( x )
+
+/* Critical section management. */
+#define portCRITICAL_NESTING_IN_TCB 1
+extern void vTaskEnterCritical( void );
+extern void vTaskExitCritical( void );
+extern void vPortDisableInterrupts( void );
+extern void vPortEnableInterrupts( void );
+
+#define portSET_INTERRUPT_MASK_FROM_ISR() 0
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedStatusValue ) ( ( void ) ( uxSavedStatusValue ) )
+#define portDISABLE_INTERRUPTS() vPortDisableInterrupts()
+#define portENABLE_INTERRUPTS()  vPortEnableInterrupts()
+#define portENTER_CRITICAL()     vTaskEnterCritical()
+#define portEXIT_CRITICAL()      vTaskExitCritical()
+
+/* The sleep task keeps the idle task from ever running, so there is nothing to suppress. */
+#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime ) ( ( void ) ( xExpectedIdleTime ) )
+
+#define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) void vFunction( void *pvParameters )
+#define portTASK_FUNCTION( vFunction, pvParameters ) void vFunction( void *pvParameters )
+
+#define portNOP()
+#define portINLINE __inline
+#ifndef portFORCE_INLINE
+  #define portFORCE_INLINE inline __attribute__(( always_inline))
+#endif
+#define portMEMORY_BARRIER() __asm volatile( "" ::: "memory" )
+
+/* Called by the host HAL. */
+extern void vPortHostTick( void );
+extern void vPortHostInterruptExit( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PORTMACRO_H */
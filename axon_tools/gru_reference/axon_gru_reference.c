@@ -0,0 +1,361 @@
+/**
+ *          Copyright (c) 2020-2022, Atlazo Inc.
+ *          All rights reserved.
+ *
+ *          Licensed under the Apache License, Version 2.0 (the "License");
+ *          you may not use this file except in compliance with the License.
+ *          You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *          Unless required by applicable law or agreed to in writing, software
+ *          distributed under the License is distributed on an "AS IS" BASIS,
+ *          WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *          See the License for the specific language governing permissions and
+ *          limitations under the License.
+ *
+ */
+/*
+ * Host tool: reference outputs for the gru cell composite (axon_audio_gru_lib).
+ *
+ * Generates a cell's parameters and runs a model of the axon arithmetic of AxonGruCellDefineOpListWithStopStep()
+ * over one window, op by op. It emits the reference header (axon_gru_cell_reference.h) with the cell's parameters,
+ * the window's input and the final hidden state, which AxonGruCellReferenceCheck() runs the cell against.
+ * The parameters are seeded test values, not a trained model; the check is of the arithmetic, not of keyword spotting.
+ *
+ * Build (from this directory):
+ *   gcc -O2 -o axon_gru_reference axon_gru_reference.c -I ../../axon_driver_lib/api -I ../../axon_audio_gru_lib/api -lm
+ *
+ * Usage:
+ *   axon_gru_reference [-o reference.h] [-i window.bin] [-s seed] [-d slice]
+ *
+ * -i reads one window of int8 features (GRU_REF_SLICE_CNT x GRU_REF_FEATURE_CNT bytes, slice by slice), otherwise
+ * a seeded random window is used. -d prints every cell step's vector for that slice, named after
+ * AxonGruCellStopStepEnum, to compare against the cell defined with that stop_step.
+ *
+ * The driver's sigmoid and tanh are table based and unpublished; here they are computed in double precision and
+ * rounded to q1.8, so expect gates to differ by an LSB now and then. Everything else is bit exact, rounding half to even
+ * as the driver guide specifies.
+ */
+#include <stdint.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "axon_api.h"
+#include "axon_gru_cell_api.h"
+
+/*
+ * cell dimensions and formats
+ */
+#define GRU_REF_SLICE_CNT 61
+#define GRU_REF_FEATURE_CNT 32      // mel32
+#define GRU_REF_HIDDEN_LENGTH 48
+#define GRU_REF_INPUT_LENGTH (GRU_REF_FEATURE_CNT+GRU_REF_HIDDEN_LENGTH)
+#define GRU_REF_HIDDEN_Q 5          // x and h are q2.5
+#define GRU_REF_WEIGHTS_Q 6         // gru weights are q1.6
+#define GRU_REF_GATE_Q 8            // activations take q7.8
+#define GRU_REF_WEIGHTS_ROUNDING (GRU_REF_HIDDEN_Q+GRU_REF_WEIGHTS_Q-GRU_REF_GATE_Q)
+#define GRU_REF_GATE_ROUNDING 0
+
+/*
+ * names of AxonGruCellStopStepEnum, in order from kGruDotProd.
+ */
+static const char *gru_ref_step_names[] = {
+  "kGruDotProd", "kGruAfGateZtRt", "kGruCandidateBiasAdd", "kGruXtYRtHn", "kGruAfCandidateNt",
+  "kGruAxpbyHtMinusNt", "kGruXtYZtHtMinusNt", "kGruXpYHt",
+};
+
+static struct {
+  int8_t weights[4*GRU_REF_HIDDEN_LENGTH][GRU_REF_INPUT_LENGTH];
+  int32_t bias[4*GRU_REF_HIDDEN_LENGTH];
+} gru_ref_model;
+
+static void gru_ref_fail(const char *fmt, ...) __attribute__((noreturn, format(printf, 1, 2)));
+
+static void gru_ref_fail(const char *fmt, ...) {
+  va_list args;
+  va_start(args, fmt);
+  fprintf(stderr, "error: ");
+  vfprintf(stderr, fmt, args);
+  fprintf(stderr, "\n");
+  va_end(args);
+  exit(1);
+}
+
+/*
+ * xorshift32, so the generated model doesn't depend on the host's rand().
+ */
+static uint32_t gru_ref_random_state;
+
+static int32_t gru_ref_random(int32_t min, int32_t max) {
+  gru_ref_random_state ^= gru_ref_random_state << 13;
+  gru_ref_random_state ^= gru_ref_random_state >> 17;
+  gru_ref_random_state ^= gru_ref_random_state << 5;
+  return min + (int32_t)(gru_ref_random_state % (uint32_t)(max-min+1));
+}
+
+/*
+ * Axon rounding: divide by 2^rounding, ties to even.
+ */
+static int64_t axon_round(int64_t value, uint8_t rounding) {
+  if (0==rounding) {
+    return value;
+  }
+  int64_t quotient = value >> rounding;
+  int64_t remainder = value - (quotient << rounding);
+  int64_t half = (int64_t)1 << (rounding-1);
+  if ((remainder > half) || ((remainder == half) && (quotient & 1))) {
+    quotient++;
+  }
+  return quotient;
+}
+
+static int32_t saturate_int8(int64_t value) {
+  return value > INT8_MAX ? INT8_MAX : value < INT8_MIN ? INT8_MIN : (int32_t)value;
+}
+
+/*
+ * q7.8 in, q1.8 out.
+ */
+static int32_t axon_activation(AxonAfEnum af, int64_t value) {
+  double x = (double)value/(1<<GRU_REF_GATE_Q);
+  switch (af) {
+  case kAxonAfSigmoid:
+    return (int32_t)lrint(ldexp(1/(1+exp(-x)), GRU_REF_GATE_Q));
+  case kAxonAfTanh:
+    return (int32_t)lrint(ldexp(tanh(x), GRU_REF_GATE_Q));
+  case kAxonAfQuantSigmoid:
+    value = axon_round(value, 1) + (1<<(GRU_REF_GATE_Q-1));
+    return value < 0 ? 0 : value > (1<<GRU_REF_GATE_Q) ? (1<<GRU_REF_GATE_Q) : (int32_t)value;
+  case kAxonAfRelu:
+    return value < 0 ? 0 : (int32_t)value;
+  default:
+    return (int32_t)value;
+  }
+}
+
+/*
+ * Seeded test parameters. Weights are spread so the gates neither saturate nor sit at 0.5.
+ */
+static void gru_ref_generate_model(void) {
+  for (uint16_t row=0;row<4*GRU_REF_HIDDEN_LENGTH;row++) {
+    uint8_t block = row/GRU_REF_HIDDEN_LENGTH;
+    for (uint16_t col=0;col<GRU_REF_INPUT_LENGTH;col++) {
+      // [Wn|0] and [0|Un]
+      uint8_t zero = ((2==block) && (col >= GRU_REF_FEATURE_CNT)) || ((3==block) && (col < GRU_REF_FEATURE_CNT));
+      gru_ref_model.weights[row][col] = zero ? 0 : gru_ref_random(-20, 20);
+    }
+    gru_ref_model.bias[row] = gru_ref_random(-64, 64);
+  }
+}
+
+static void gru_ref_dump(int dump, uint8_t step, const int32_t *values, uint16_t length) {
+  if (!dump) {
+    return;
+  }
+  printf("%s:", gru_ref_step_names[step-1]);
+  for (uint16_t ndx=0;ndx<length;ndx++) {
+    printf(" %d", values[ndx]);
+  }
+  printf("\n");
+}
+
+/*
+ * One gru cell time step, op by op as AxonGruCellDefineOpListWithStopStep() defines them.
+ * xh is [x;h] as int8 values, ht is the 24 bit h(t).
+ */
+static void gru_ref_cell_step(const int32_t *xh, int32_t *ht, int dump) {
+  const uint16_t hl = GRU_REF_HIDDEN_LENGTH;
+  int32_t buf1[4*GRU_REF_HIDDEN_LENGTH];
+
+  for (uint16_t row=0;row<4*hl;row++) {
+    int64_t acc = 0;
+    for (uint16_t col=0;col<GRU_REF_INPUT_LENGTH;col++) {
+      acc += (int64_t)xh[col]*gru_ref_model.weights[row][col];
+    }
+    buf1[row] = (int32_t)axon_round(acc, GRU_REF_WEIGHTS_ROUNDING);
+  }
+  gru_ref_dump(dump, kGruDotProd, buf1, 4*hl);
+
+  for (uint16_t ndx=0;ndx<2*hl;ndx++) {
+    buf1[ndx] = axon_activation(kAxonAfSigmoid, axon_round((int64_t)buf1[ndx]+gru_ref_model.bias[ndx], GRU_REF_GATE_ROUNDING));
+  }
+  gru_ref_dump(dump, kGruAfGateZtRt, buf1, 4*hl);
+
+  for (uint16_t ndx=2*hl;ndx<4*hl;ndx++) {
+    buf1[ndx] += gru_ref_model.bias[ndx];
+  }
+  gru_ref_dump(dump, kGruCandidateBiasAdd, buf1, 4*hl);
+
+  for (uint16_t ndx=0;ndx<hl;ndx++) {
+    buf1[3*hl+ndx] = (int32_t)axon_round((int64_t)buf1[hl+ndx]*buf1[3*hl+ndx], 8);
+  }
+  gru_ref_dump(dump, kGruXtYRtHn, buf1, 4*hl);
+
+  for (uint16_t ndx=0;ndx<hl;ndx++) {
+    buf1[2*hl+ndx] = axon_activation(kAxonAfTanh, axon_round((int64_t)buf1[2*hl+ndx]+buf1[3*hl+ndx], GRU_REF_GATE_ROUNDING));
+  }
+  gru_ref_dump(dump, kGruAfCandidateNt, buf1, 4*hl);
+
+  for (uint16_t ndx=0;ndx<hl;ndx++) {
+    buf1[3*hl+ndx] = ht[ndx]*(1<<(8-GRU_REF_HIDDEN_Q)) - buf1[2*hl+ndx];
+  }
+  gru_ref_dump(dump, kGruAxpbyHtMinusNt, buf1, 4*hl);
+
+  for (uint16_t ndx=0;ndx<hl;ndx++) {
+    buf1[3*hl+ndx] = (int32_t)axon_round((int64_t)buf1[ndx]*buf1[3*hl+ndx], 8);
+  }
+  gru_ref_dump(dump, kGruXtYZtHtMinusNt, buf1, 4*hl);
+
+  for (uint16_t ndx=0;ndx<hl;ndx++) {
+    ht[ndx] = (int32_t)axon_round((int64_t)buf1[2*hl+ndx]+buf1[3*hl+ndx], 8-GRU_REF_HIDDEN_Q);
+  }
+  gru_ref_dump(dump, kGruXpYHt, ht, hl);
+
+  // AxonGruCellSaturateHiddenState()
+  for (uint16_t ndx=0;ndx<hl;ndx++) {
+    ht[ndx] = saturate_int8(ht[ndx]);
+  }
+}
+
+static void write_license(FILE *out) {
+  fprintf(out,
+      "/**\n"
+      " *          Copyright (c) 2020-2022, Atlazo Inc.\n"
+      " *          All rights reserved.\n"
+      " *\n"
+      " *          Licensed under the Apache License, Version 2.0 (the \"License\");\n"
+      " *          you may not use this file except in compliance with the License.\n"
+      " *          You may obtain a copy of the License at\n"
+      " *\n"
+      " *              http://www.apache.org/licenses/LICENSE-2.0\n"
+      " *\n"
+      " *          Unless required by applicable law or agreed to in writing, software\n"
+      " *          distributed under the License is distributed on an \"AS IS\" BASIS,\n"
+      " *          WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.\n"
+      " *          See the License for the specific language governing permissions and\n"
+      " *          limitations under the License.\n"
+      " *\n"
+      " */\n");
+}
+
+static void write_int32_array(FILE *out, const char *declaration, const int32_t *values, uint16_t length) {
+  fprintf(out, "%s = {\n", declaration);
+  for (uint16_t ndx=0;ndx<length;ndx++) {
+    fprintf(out, "%s%d,%s", 0==ndx%16 ? "  " : "", values[ndx], (15==ndx%16) || (ndx+1==length) ? "\n" : "");
+  }
+  fprintf(out, "};\n");
+}
+
+static void write_int8_matrix(FILE *out, const char *declaration, const int8_t *values, uint16_t rows, uint16_t cols) {
+  fprintf(out, "%s = {\n", declaration);
+  for (uint16_t row=0;row<rows;row++) {
+    fprintf(out, "{");
+    for (uint16_t col=0;col<cols;col++) {
+      fprintf(out, "%d%s", values[row*cols+col], col+1==cols ? "" : ",");
+    }
+    fprintf(out, "},\n");
+  }
+  fprintf(out, "};\n");
+}
+
+static void gru_ref_write_reference_header(const char *path, unsigned seed, const int8_t *window, const int32_t *hidden) {
+  FILE *out = fopen(path, "w");
+  if (NULL==out) {
+    gru_ref_fail("can't write %s", path);
+  }
+  write_license(out);
+  fprintf(out,
+      "/*\n"
+      " * Generated by axon_tools/gru_reference (seed %u). Test parameters for AxonGruCellReferenceCheck(),\n"
+      " * not a trained model.\n"
+      " */\n"
+      "#include <stdint.h>\n"
+      "#pragma once\n", seed);
+  fprintf(out, "#define GRU_CELL_REFERENCE_SLICE_CNT %d\n", GRU_REF_SLICE_CNT);
+  fprintf(out, "#define GRU_CELL_REFERENCE_FEATURE_CNT %d\n", GRU_REF_FEATURE_CNT);
+  fprintf(out, "#define GRU_CELL_REFERENCE_INPUT_LENGTH %d\n", GRU_REF_INPUT_LENGTH);
+  fprintf(out, "#define GRU_CELL_REFERENCE_HIDDEN_LENGTH %d\n", GRU_REF_HIDDEN_LENGTH);
+  fprintf(out, "#define GRU_CELL_REFERENCE_HIDDEN_Q %d\n", GRU_REF_HIDDEN_Q);
+  fprintf(out, "#define GRU_CELL_REFERENCE_WEIGHTS_ROUNDING %d\n", GRU_REF_WEIGHTS_ROUNDING);
+  fprintf(out, "#define GRU_CELL_REFERENCE_GATE_ROUNDING %d\n", GRU_REF_GATE_ROUNDING);
+  fprintf(out, "/*\n * [Wz|Uz], [Wr|Ur], [Wn|0], [0|Un]. Read in place by axon, so these stay in RAM.\n */\n");
+  write_int8_matrix(out, "static _Alignas(16) int8_t gru_cell_reference_weights[4*GRU_CELL_REFERENCE_HIDDEN_LENGTH][GRU_CELL_REFERENCE_INPUT_LENGTH]",
+      &gru_ref_model.weights[0][0], 4*GRU_REF_HIDDEN_LENGTH, GRU_REF_INPUT_LENGTH);
+  write_int32_array(out, "static const int32_t gru_cell_reference_bias[4*GRU_CELL_REFERENCE_HIDDEN_LENGTH]", gru_ref_model.bias, 4*GRU_REF_HIDDEN_LENGTH);
+  write_int8_matrix(out, "static const int8_t gru_cell_reference_input[GRU_CELL_REFERENCE_SLICE_CNT][GRU_CELL_REFERENCE_FEATURE_CNT]",
+      window, GRU_REF_SLICE_CNT, GRU_REF_FEATURE_CNT);
+  write_int32_array(out, "static const int32_t gru_cell_reference_hidden[GRU_CELL_REFERENCE_HIDDEN_LENGTH]", hidden, GRU_REF_HIDDEN_LENGTH);
+  fclose(out);
+}
+
+static void usage(void) {
+  fprintf(stderr, "usage: axon_gru_reference [-o reference.h] [-i window.bin] [-s seed] [-d slice]\n");
+  exit(2);
+}
+
+int main(int argc, char **argv) {
+  const char *reference_path = NULL, *input_path = NULL;
+  unsigned seed = 1;
+  int dump_slice = -1;
+  static int8_t window[GRU_REF_SLICE_CNT][GRU_REF_FEATURE_CNT];
+  int32_t xh[GRU_REF_INPUT_LENGTH] = {0};
+  int32_t ht[GRU_REF_HIDDEN_LENGTH] = {0};
+
+  for (int ndx=1;ndx<argc;ndx++) {
+    if (('-' != argv[ndx][0]) || (ndx+1 >= argc) || (0 != argv[ndx][2])) {
+      usage();
+    }
+    const char *value = argv[++ndx];
+    switch (argv[ndx-1][1]) {
+    case 'o': reference_path = value; break;
+    case 'i': input_path = value; break;
+    case 's': seed = strtoul(value, NULL, 0); break;
+    case 'd': dump_slice = atoi(value); break;
+    default:
+      usage();
+    }
+  }
+
+  gru_ref_random_state = 0==seed ? 1 : seed;
+  gru_ref_generate_model();
+
+  if (NULL != input_path) {
+    FILE *in = fopen(input_path, "rb");
+    if ((NULL==in) || (1 != fread(window, sizeof(window), 1, in))) {
+      gru_ref_fail("can't read %d bytes from %s", (int)sizeof(window), input_path);
+    }
+    fclose(in);
+  } else {
+    // roughly what normalized mel32s look like at q2.5: mostly within +/-2 standard deviations
+    for (uint8_t slice=0;slice<GRU_REF_SLICE_CNT;slice++) {
+      for (uint8_t feature=0;feature<GRU_REF_FEATURE_CNT;feature++) {
+        window[slice][feature] = gru_ref_random(-64, 64);
+      }
+    }
+  }
+
+  for (uint8_t slice=0;slice<GRU_REF_SLICE_CNT;slice++) {
+    for (uint8_t feature=0;feature<GRU_REF_FEATURE_CNT;feature++) {
+      xh[feature] = window[slice][feature];
+    }
+    if (slice==dump_slice) {
+      printf("slice %d\n", slice);
+    }
+    gru_ref_cell_step(xh, ht, slice==dump_slice);
+    memcpy(xh+GRU_REF_FEATURE_CNT, ht, sizeof(ht));
+  }
+
+  printf("hidden:");
+  for (uint8_t ndx=0;ndx<GRU_REF_HIDDEN_LENGTH;ndx++) {
+    printf(" %d", ht[ndx]);
+  }
+  printf("\n");
+
+  if (NULL != reference_path) {
+    gru_ref_write_reference_header(reference_path, seed, &window[0][0], ht);
+  }
+  return 0;
+}
@@ -0,0 +1,165 @@
+/**
+ *          Copyright (c) 2020-2022, Atlazo Inc.
+ *          All rights reserved.
+ *
+ *          Licensed under the Apache License, Version 2.0 (the "License");
+ *          you may not use this file except in compliance with the License.
+ *          You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *          Unless required by applicable law or agreed to in writing, software
+ *          distributed under the License is distributed on an "AS IS" BASIS,
+ *          WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *          See the License for the specific language governing permissions and
+ *          limitations under the License.
+ *
+ */
+/*
+ * Host tool: sweeps the LSTM_1FC input normalization done by axon ops (LSTM_1FC_AXON_INPUT_NORMALIZATION in
+ * axon_audio_lstm_lib/src/axon_kws_model_lstm_1fc.c) against the CPU normalization it replaced:
+ *   -128 + (255*min(x-MIN, MAX))/MAX          truncating divide
+ * The 4 Axpb ops are modelled w/ axon integer semantics: 24 bit inputs, round half up on output rounding.
+ * The constants are computed from axon_kws_model_lstm_1fc_const.h the same way the model does.
+ *
+ * Every input in the calibrated range [MIN, MIN+MAX] is checked, plus margin inputs below and above it.
+ * Reports the values that differ by 1 LSB and by more, inside and outside the calibrated range.
+ * Exits 1 if any value inside the calibrated range differs by more than 1 LSB.
+ *
+ * Build (from this directory):
+ *   gcc -O2 -o axon_lstm_norm_sweep axon_lstm_norm_sweep.c -I ../../axon_audio_lstm_lib/src
+ *
+ * Usage:
+ *   axon_lstm_norm_sweep [-m margin] [-v]
+ * margin defaults to MAX/16. -v prints each input that differs by more than 1 LSB.
+ */
+#include <stdint.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "axon_kws_model_lstm_1fc_const.h"
+
+#define SWEEP_MIN LSTM_1FC_L1_INPUT_NORM_MIN_VALUE
+#define SWEEP_MAX LSTM_1FC_L1_INPUT_NORM_MAX_VALUE
+#define SWEEP_SCALE_FACTOR LSTM_1FC_L1_INPUT_QUANTIZE_INV_SCALING_FACTOR
+
+// LSTM_1FC_INPUT_NORM_ROUNDING, _SCALE and _OFFSET in axon_kws_model_lstm_1fc.c
+#define SWEEP_NORM_ROUNDING 28
+#define SWEEP_NORM_SCALE ((int32_t)((((int64_t)SWEEP_SCALE_FACTOR<<SWEEP_NORM_ROUNDING) + SWEEP_MAX/2)/SWEEP_MAX))
+#define SWEEP_NORM_OFFSET (-(SWEEP_MIN) - (SWEEP_MAX+SWEEP_SCALE_FACTOR)/(2*SWEEP_SCALE_FACTOR))
+
+typedef struct {
+  uint32_t value_cnt;
+  uint32_t one_lsb_cnt;
+  uint32_t over_one_lsb_cnt;
+  int32_t max_diff;
+} sweep_stats_struct;
+
+static void sweep_fail(const char *fmt, ...) {
+  va_list args;
+  va_start(args, fmt);
+  fprintf(stderr, "axon_lstm_norm_sweep: ");
+  vfprintf(stderr, fmt, args);
+  fprintf(stderr, "\n");
+  va_end(args);
+  exit(1);
+}
+
+static void usage() {
+  fprintf(stderr, "usage: axon_lstm_norm_sweep [-m margin] [-v]\n");
+  exit(1);
+}
+
+/*
+ * axon output rounding: shift, then add 1 if the last bit shifted out was a 1.
+ */
+static int64_t sweep_round(int64_t value, uint8_t rounding) {
+  return rounding ? (value + ((int64_t)1 << (rounding-1))) >> rounding : value;
+}
+
+/*
+ * axon op inputs are 24 bits.
+ */
+static int64_t sweep_read24(int64_t value) {
+  return (int64_t)((int32_t)((uint32_t)value << 8) >> 8);
+}
+
+/*
+ * q = af(round(a*x + b)), x read as 24 bits.
+ */
+static int64_t sweep_axpb(int64_t x, int32_t a, int32_t b, uint8_t rounding, int relu) {
+  int64_t q = sweep_round(sweep_read24(x)*a + b, rounding);
+  return relu && (q < 0) ? 0 : q;
+}
+
+static int32_t sweep_cpu_normalize(int32_t x) {
+  int32_t norm = (x-(SWEEP_MIN)) >= (SWEEP_MAX) ? (SWEEP_MAX) : (x-(SWEEP_MIN));
+  return (-128)+((SWEEP_SCALE_FACTOR*norm))/(SWEEP_MAX);
+}
+
+static int32_t sweep_axon_normalize(int32_t x) {
+  int64_t t = sweep_axpb(x, 1, SWEEP_NORM_OFFSET, 0, 0);
+  int64_t u = sweep_axpb(t, SWEEP_NORM_SCALE, 0, SWEEP_NORM_ROUNDING, 0);
+  int64_t w = sweep_axpb(u, -1, SWEEP_SCALE_FACTOR, 0, 1);
+  return (int32_t)sweep_axpb(w, -1, SWEEP_SCALE_FACTOR-128, 0, 0);
+}
+
+static void sweep_range(sweep_stats_struct *stats, int32_t first, int32_t last, int verbose) {
+  for (int32_t x = first; x <= last; x++) {
+    int32_t cpu = sweep_cpu_normalize(x);
+    int32_t diff = abs(sweep_axon_normalize(x) - cpu);
+    stats->value_cnt++;
+    if (1 == diff) {
+      stats->one_lsb_cnt++;
+    } else if (diff > 1) {
+      stats->over_one_lsb_cnt++;
+      if (verbose) {
+        printf("  x %d: cpu %d axon %d\n", x, cpu, sweep_axon_normalize(x));
+      }
+    }
+    if (diff > stats->max_diff) {
+      stats->max_diff = diff;
+    }
+  }
+}
+
+static void sweep_print(const char *name, const sweep_stats_struct *stats) {
+  printf("%-12s %10u %10u %8.4f%% %10u %8d\n", name, stats->value_cnt, stats->one_lsb_cnt,
+      stats->value_cnt ? 100.0*stats->one_lsb_cnt/stats->value_cnt : 0.0, stats->over_one_lsb_cnt, stats->max_diff);
+}
+
+int main(int argc, char *argv[]) {
+  int32_t margin = SWEEP_MAX/16;
+  int verbose = 0;
+  sweep_stats_struct below = {0}, calibrated = {0}, above = {0};
+
+  for (int arg = 1; arg < argc; arg++) {
+    if (!strcmp(argv[arg], "-m") && (arg + 1 < argc)) {
+      margin = atoi(argv[++arg]);
+    } else if (!strcmp(argv[arg], "-v")) {
+      verbose = 1;
+    } else {
+      usage();
+    }
+  }
+  if ((margin < 0) || ((int64_t)SWEEP_MIN + SWEEP_MAX + margin >= (1 << 23)) || ((int64_t)SWEEP_MIN - margin < -(1 << 23))) {
+    sweep_fail("margin %d takes the input outside 24 bits", margin);
+  }
+
+  printf("MIN %d MAX %d SCALE %d ROUNDING %d OFFSET %d\n", SWEEP_MIN, SWEEP_MAX, SWEEP_NORM_SCALE, SWEEP_NORM_ROUNDING, SWEEP_NORM_OFFSET);
+  printf("%-12s %10s %10s %9s %10s %8s\n", "range", "values", "1 lsb", "", ">1 lsb", "max");
+  sweep_range(&below, SWEEP_MIN-margin, SWEEP_MIN-1, verbose);
+  sweep_range(&calibrated, SWEEP_MIN, SWEEP_MIN+SWEEP_MAX, verbose);
+  sweep_range(&above, SWEEP_MIN+SWEEP_MAX+1, SWEEP_MIN+SWEEP_MAX+margin, verbose);
+  sweep_print("below", &below);
+  sweep_print("calibrated", &calibrated);
+  sweep_print("above", &above);
+
+  if (calibrated.over_one_lsb_cnt) {
+    printf("FAIL\n");
+    return 1;
+  }
+  printf("PASS\n");
+  return 0;
+}
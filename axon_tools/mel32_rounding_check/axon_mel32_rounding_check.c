@@ -0,0 +1,292 @@
+/**
+ *          Copyright (c) 2020-2022, Atlazo Inc.
+ *          All rights reserved.
+ *
+ *          Licensed under the Apache License, Version 2.0 (the "License");
+ *          you may not use this file except in compliance with the License.
+ *          You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *          Unless required by applicable law or agreed to in writing, software
+ *          distributed under the License is distributed on an "AS IS" BASIS,
+ *          WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *          See the License for the specific language governing permissions and
+ *          limitations under the License.
+ *
+ */
+/*
+ * Host tool: checks the axon filterbank rounding in axon_audio_features_lib/src/axon_mel32.c against the
+ * software shift it replaced (filterbank sum >> FILTER_BANK_SW_ROUND).
+ *
+ * The filterbank Mar ops produce 32 bit sums, but axon ops read their inputs as 24 bits, so the sums can't be
+ * shifted on axon directly. axon_mel32.c splits the fft power x into
+ *   hi = floor(x/256) and lo = x - 256*hi
+ * runs the filterbanks (and the energy sum) over each and adds hi_sum + floor(lo_sum/256), which is exactly
+ * floor((256*hi_sum + lo_sum)/256). That only fits 24 bits while the full sum is below 2^31. Above that the
+ * single Mar over x overflows as well, so those sums are counted separately and not compared.
+ *
+ * The front end up to the fft power (window, 512 point fft, power rounding) is modelled in floating point, only
+ * to get realistic power spectra. Everything from the power on is modelled with axon integer semantics: 24 bit
+ * inputs, round half to even on output rounding (Axon Driver User Guide, 3.1.1.4). Per filterbank value
+ * (32 banks + the energy sum) this reports, against the old software shift:
+ *   - a single Axpb over the 32 bit sums (24 bit input read), what the 1st version of the axon rounding did,
+ *   - the hi/lo split w/ floor as (x - 128) rounded by 8, what the 2nd version did,
+ *   - the hi/lo split w/ floor as (2x - 255) rounded by 9, what axon_mel32.c does now,
+ * and the number of log mel features (modelled as round(ln(v)*2^12)) that differ.
+ * Exits 1 if any feature of the current split differs from the software shift.
+ *
+ * Build (from this directory):
+ *   gcc -O2 -o axon_mel32_rounding_check axon_mel32_rounding_check.c \
+ *     -I ../../axon_audio_features_lib/src -I ../../axon_audio_features_lib/api -I ../../axon_driver_lib/api \
+ *     -I ../../axon_audio_ml_lib/src -lm
+ *
+ * Usage:
+ *   axon_mel32_rounding_check [-g gain]
+ * The input is the test audio in axon_audio_ml_lib/src/test_audio/rawSampleon.h, scaled by gain (default 1).
+ */
+#include <stdint.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "axon_mel32_weights_common.h"
+#include "test_audio/rawSampleon.h"
+
+#define CHK_FRAME_LEN 512
+#define CHK_FRAME_SHIFT 256
+#define CHK_POWER_LEN 256
+#define CHK_FILTERBANK_CNT 32
+#define CHK_HAMMING_ROUND 8   // HAMMING_ROUND in axon_mel32_weights.h
+#define CHK_FFT_POWER_ROUND 11 // FFT_POWER_ROUND in axon_mel32_weights.h (mel32)
+#define CHK_SW_ROUND 8         // FILTER_BANK_SW_ROUND in axon_mel32_weights.h
+#define CHK_LOG_FRACTION_BITS 12
+#define CHK_FLOOR_BIAS ((1 << CHK_SW_ROUND) - 1) // FILTER_BANK_FLOOR_BIAS in axon_mel32.c
+
+#define CHK_BIN_1ST_TAP(N) MEL32_BIN##N##_1ST_TAP
+#define CHK_BIN_TAP_CNT(N) MEL32_BIN##N##_TAP_COUNT
+
+static const uint16_t chk_bin_1st_tap[CHK_FILTERBANK_CNT] = {
+  CHK_BIN_1ST_TAP(0), CHK_BIN_1ST_TAP(1), CHK_BIN_1ST_TAP(2), CHK_BIN_1ST_TAP(3),
+  CHK_BIN_1ST_TAP(4), CHK_BIN_1ST_TAP(5), CHK_BIN_1ST_TAP(6), CHK_BIN_1ST_TAP(7),
+  CHK_BIN_1ST_TAP(8), CHK_BIN_1ST_TAP(9), CHK_BIN_1ST_TAP(10), CHK_BIN_1ST_TAP(11),
+  CHK_BIN_1ST_TAP(12), CHK_BIN_1ST_TAP(13), CHK_BIN_1ST_TAP(14), CHK_BIN_1ST_TAP(15),
+  CHK_BIN_1ST_TAP(16), CHK_BIN_1ST_TAP(17), CHK_BIN_1ST_TAP(18), CHK_BIN_1ST_TAP(19),
+  CHK_BIN_1ST_TAP(20), CHK_BIN_1ST_TAP(21), CHK_BIN_1ST_TAP(22), CHK_BIN_1ST_TAP(23),
+  CHK_BIN_1ST_TAP(24), CHK_BIN_1ST_TAP(25), CHK_BIN_1ST_TAP(26), CHK_BIN_1ST_TAP(27),
+  CHK_BIN_1ST_TAP(28), CHK_BIN_1ST_TAP(29), CHK_BIN_1ST_TAP(30), CHK_BIN_1ST_TAP(31),
+};
+
+static const uint16_t chk_bin_tap_cnt[CHK_FILTERBANK_CNT] = {
+  CHK_BIN_TAP_CNT(0), CHK_BIN_TAP_CNT(1), CHK_BIN_TAP_CNT(2), CHK_BIN_TAP_CNT(3),
+  CHK_BIN_TAP_CNT(4), CHK_BIN_TAP_CNT(5), CHK_BIN_TAP_CNT(6), CHK_BIN_TAP_CNT(7),
+  CHK_BIN_TAP_CNT(8), CHK_BIN_TAP_CNT(9), CHK_BIN_TAP_CNT(10), CHK_BIN_TAP_CNT(11),
+  CHK_BIN_TAP_CNT(12), CHK_BIN_TAP_CNT(13), CHK_BIN_TAP_CNT(14), CHK_BIN_TAP_CNT(15),
+  CHK_BIN_TAP_CNT(16), CHK_BIN_TAP_CNT(17), CHK_BIN_TAP_CNT(18), CHK_BIN_TAP_CNT(19),
+  CHK_BIN_TAP_CNT(20), CHK_BIN_TAP_CNT(21), CHK_BIN_TAP_CNT(22), CHK_BIN_TAP_CNT(23),
+  CHK_BIN_TAP_CNT(24), CHK_BIN_TAP_CNT(25), CHK_BIN_TAP_CNT(26), CHK_BIN_TAP_CNT(27),
+  CHK_BIN_TAP_CNT(28), CHK_BIN_TAP_CNT(29), CHK_BIN_TAP_CNT(30), CHK_BIN_TAP_CNT(31),
+};
+
+/*
+ * Coefficients of all the bins, back to back in bin order.
+ */
+static const int32_t chk_coefs[] = {
+  MEL32_COEFS_BIN0 MEL32_COEFS_BIN1 MEL32_COEFS_BIN2 MEL32_COEFS_BIN3 MEL32_COEFS_BIN4 MEL32_COEFS_BIN5
+  MEL32_COEFS_BIN6 MEL32_COEFS_BIN7 MEL32_COEFS_BIN8 MEL32_COEFS_BIN9 MEL32_COEFS_BIN10 MEL32_COEFS_BIN11
+  MEL32_COEFS_BIN12 MEL32_COEFS_BIN13 MEL32_COEFS_BIN14 MEL32_COEFS_BIN15 MEL32_COEFS_BIN16 MEL32_COEFS_BIN17
+  MEL32_COEFS_BIN18 MEL32_COEFS_BIN19 MEL32_COEFS_BIN20 MEL32_COEFS_BIN21 MEL32_COEFS_BIN22 MEL32_COEFS_BIN23
+  MEL32_COEFS_BIN24 MEL32_COEFS_BIN25 MEL32_COEFS_BIN26 MEL32_COEFS_BIN27 MEL32_COEFS_BIN28 MEL32_COEFS_BIN29
+  MEL32_COEFS_BIN30 MEL32_COEFS_BIN31
+};
+
+typedef struct {
+  uint32_t value_cnt;
+  uint32_t value_mismatch_cnt;
+  uint32_t feature_mismatch_cnt;
+  int32_t feature_max_diff;
+} chk_stats_struct;
+
+static void chk_fail(const char *fmt, ...) {
+  va_list args;
+  va_start(args, fmt);
+  fprintf(stderr, "axon_mel32_rounding_check: ");
+  vfprintf(stderr, fmt, args);
+  fprintf(stderr, "\n");
+  va_end(args);
+  exit(1);
+}
+
+static void usage() {
+  fprintf(stderr, "usage: axon_mel32_rounding_check [-g gain]\n");
+  exit(1);
+}
+
+static int64_t chk_saturate(int64_t value, uint8_t bits) {
+  int64_t max = ((int64_t)1 << (bits-1)) - 1;
+  return value > max ? max : value < -max-1 ? -max-1 : value;
+}
+
+/*
+ * axon output rounding: shift, then add 1 if the remainder is over half, or exactly half and the quotient is odd.
+ */
+static int64_t chk_round(int64_t value, uint8_t rounding) {
+  if (!rounding) {
+    return value;
+  }
+  int64_t quotient = value >> rounding;
+  int64_t remainder = value - (quotient << rounding);
+  int64_t half = (int64_t)1 << (rounding-1);
+  return quotient + ((remainder > half) || ((remainder == half) && (quotient & 1)));
+}
+
+/*
+ * axon op inputs are 24 bits.
+ */
+static int64_t chk_read24(int64_t value) {
+  return (int64_t)((int32_t)((uint32_t)value << 8) >> 8);
+}
+
+/*
+ * floor(value/2^CHK_SW_ROUND) the way axon_mel32.c does it, and the way the 2nd version did it.
+ */
+static int64_t chk_floor(int64_t value) {
+  return chk_round(2 * chk_read24(value) - CHK_FLOOR_BIAS, CHK_SW_ROUND + 1);
+}
+
+static int64_t chk_floor_biased(int64_t value) {
+  return chk_round(chk_read24(value) - (1 << (CHK_SW_ROUND-1)), CHK_SW_ROUND);
+}
+
+static int32_t chk_feature(int64_t value) {
+  if (value < 1) {
+    value = 1;
+  }
+  return (int32_t)llround(log((double)value) * (1 << CHK_LOG_FRACTION_BITS));
+}
+
+static void chk_compare(chk_stats_struct *stats, int64_t value, int64_t reference) {
+  int32_t diff = abs(chk_feature(value) - chk_feature(reference));
+  stats->value_cnt++;
+  if (value != reference) {
+    stats->value_mismatch_cnt++;
+  }
+  if (diff) {
+    stats->feature_mismatch_cnt++;
+    if (diff > stats->feature_max_diff) {
+      stats->feature_max_diff = diff;
+    }
+  }
+}
+
+/*
+ * fft power of one frame, as the windowed fft + Xspys produce it.
+ */
+static void chk_frame_power(const int16_t *samples, double gain, int64_t power[CHK_POWER_LEN]) {
+  int64_t windowed[CHK_FRAME_LEN];
+  for (int ndx = 0; ndx < CHK_FRAME_LEN; ndx++) {
+    int64_t sample = chk_saturate(llround(samples[ndx] * gain), 16);
+    windowed[ndx] = chk_round(sample * mel32_window[ndx], CHK_HAMMING_ROUND);
+  }
+  for (int bin = 0; bin < CHK_POWER_LEN; bin++) {
+    double real = 0, imag = 0;
+    for (int ndx = 0; ndx < CHK_FRAME_LEN; ndx++) {
+      real += windowed[ndx] * cos(2 * M_PI * bin * ndx / CHK_FRAME_LEN);
+      imag -= windowed[ndx] * sin(2 * M_PI * bin * ndx / CHK_FRAME_LEN);
+    }
+    int64_t re = chk_saturate(llround(real), 24);
+    int64_t im = chk_saturate(llround(imag), 24);
+    power[bin] = chk_saturate(chk_round(re * re + im * im, CHK_FFT_POWER_ROUND), 24);
+  }
+}
+
+/*
+ * Splits the fft power into hi/lo w/ the given floor, runs the filterbanks over both and combines them.
+ */
+static void chk_split(const int64_t power[CHK_POWER_LEN], int64_t (*floor_fn)(int64_t),
+    int64_t out[CHK_FILTERBANK_CNT+1]) {
+  int64_t power_hi[CHK_POWER_LEN], power_lo[CHK_POWER_LEN];
+  for (int bin = 0; bin < CHK_POWER_LEN; bin++) {
+    power_hi[bin] = floor_fn(power[bin]);
+    power_lo[bin] = chk_read24(power[bin]) - (chk_read24(power_hi[bin]) << CHK_SW_ROUND);
+  }
+  uint32_t coef_ndx = 0;
+  for (int bank = 0; bank <= CHK_FILTERBANK_CNT; bank++) {
+    int64_t sum_hi = 0, sum_lo = 0;
+    int first = bank < CHK_FILTERBANK_CNT ? chk_bin_1st_tap[bank] : 0;
+    int tap_cnt = bank < CHK_FILTERBANK_CNT ? chk_bin_tap_cnt[bank] : CHK_POWER_LEN;
+    for (int tap = 0; tap < tap_cnt; tap++) {
+      int64_t coef = bank < CHK_FILTERBANK_CNT ? chk_coefs[coef_ndx++] : 1;
+      sum_hi += power_hi[first + tap] * coef;
+      sum_lo += power_lo[first + tap] * coef;
+    }
+    out[bank] = chk_read24(floor_fn(chk_saturate(sum_lo, 32))) + chk_read24(chk_saturate(sum_hi, 32));
+  }
+}
+
+int main(int argc, char *argv[]) {
+  double gain = 1;
+  for (int arg = 1; arg < argc; arg++) {
+    if (!strcmp(argv[arg], "-g") && (arg + 1 < argc)) {
+      gain = atof(argv[++arg]);
+    } else {
+      usage();
+    }
+  }
+  if (gain <= 0) {
+    chk_fail("gain must be positive");
+  }
+
+  uint32_t sample_cnt = sizeof(wave_data_on) / sizeof(wave_data_on[0]);
+  chk_stats_struct single_axpb = {0}, split_biased = {0}, split = {0};
+  uint32_t wide_sum_cnt = 0, overflow_sum_cnt = 0;
+  int64_t max_sum = 0;
+
+  for (uint32_t start = 0; start + CHK_FRAME_LEN <= sample_cnt; start += CHK_FRAME_SHIFT) {
+    int64_t power[CHK_POWER_LEN], biased[CHK_FILTERBANK_CNT+1], floored[CHK_FILTERBANK_CNT+1];
+    chk_frame_power(wave_data_on + start, gain, power);
+    chk_split(power, chk_floor_biased, biased);
+    chk_split(power, chk_floor, floored);
+
+    // 32 filterbanks, then the energy sum (Acc, ie all coefficients 1)
+    uint32_t coef_ndx = 0;
+    for (int bank = 0; bank <= CHK_FILTERBANK_CNT; bank++) {
+      int64_t sum = 0;
+      int first = bank < CHK_FILTERBANK_CNT ? chk_bin_1st_tap[bank] : 0;
+      int tap_cnt = bank < CHK_FILTERBANK_CNT ? chk_bin_tap_cnt[bank] : CHK_POWER_LEN;
+      for (int tap = 0; tap < tap_cnt; tap++) {
+        int64_t coef = bank < CHK_FILTERBANK_CNT ? chk_coefs[coef_ndx++] : 1;
+        sum += power[first + tap] * coef;
+      }
+      if (sum > max_sum) {
+        max_sum = sum;
+      }
+      if (sum >= (1 << 23)) {
+        wide_sum_cnt++;
+      }
+      if (sum > INT32_MAX) {
+        // the Mar over the unsplit power overflows too, nothing to compare against
+        overflow_sum_cnt++;
+        continue;
+      }
+
+      int64_t reference = sum >> CHK_SW_ROUND; // the old software shift
+      int64_t single = chk_saturate(chk_round(chk_read24(sum) - (1 << (CHK_SW_ROUND-1)), CHK_SW_ROUND), 24);
+      chk_compare(&single_axpb, single, reference);
+      chk_compare(&split_biased, biased[bank], reference);
+      chk_compare(&split, floored[bank], reference);
+    }
+  }
+
+  printf("gain %.2f: %u filterbank values, max sum %.1f bits, %u sums >= 2^23, %u sums >= 2^31 (not compared)\n",
+      gain, split.value_cnt + overflow_sum_cnt, max_sum ? log2((double)max_sum) : 0.0, wide_sum_cnt,
+      overflow_sum_cnt);
+  printf("  single axpb:         %u value mismatches, %u feature mismatches, max %d\n",
+      single_axpb.value_mismatch_cnt, single_axpb.feature_mismatch_cnt, single_axpb.feature_max_diff);
+  printf("  hi/lo split, x-128:  %u value mismatches, %u feature mismatches, max %d\n",
+      split_biased.value_mismatch_cnt, split_biased.feature_mismatch_cnt, split_biased.feature_max_diff);
+  printf("  hi/lo split, 2x-255: %u value mismatches, %u feature mismatches, max %d\n",
+      split.value_mismatch_cnt, split.feature_mismatch_cnt, split.feature_max_diff);
+  return split.feature_mismatch_cnt ? 1 : 0;
+}
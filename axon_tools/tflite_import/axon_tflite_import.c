@@ -0,0 +1,1232 @@
+/**
+ *          Copyright (c) 2020-2022, Atlazo Inc.
+ *          All rights reserved.
+ *
+ *          Licensed under the Apache License, Version 2.0 (the "License");
+ *          you may not use this file except in compliance with the License.
+ *          You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *          Unless required by applicable law or agreed to in writing, software
+ *          distributed under the License is distributed on an "AS IS" BASIS,
+ *          WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *          See the License for the specific language governing permissions and
+ *          limitations under the License.
+ *
+ */
+/*
+ * Host tool: converts an int8 .tflite model into axon fully connected/lstm parameters.
+ *
+ * Emits a header in the style of axon_kws_model_fc4_const.h and/or a binary model container
+ * (axon_model_container_api.h), and reports how closely the axon arithmetic matches TFLite's.
+ *
+ * Build (from this directory):
+ *   gcc -O2 -o axon_tflite_import axon_tflite_import.c ../../axon_audio_ml_lib/src/axon_model_container_writer.c \
+ *       ../../axon_utils/src/axon_crc32.c -I ../../axon_utils/api -I ../../axon_driver_lib/api -I ../../axon_audio_features_lib/api \
+ *       -I ../../axon_audio_ml_lib/api -I ../../axon_audio_gru_lib/api -lm
+ *
+ * Usage:
+ *   axon_tflite_import model.tflite [-o const.h] [-b container.bin] [-p PREFIX] [-l labels.txt]
+ *       [-v mel32|mfcc|mfcc_energy|mfcc_fft] [-w slices] [-h features] [-n vectors] [-s seed]
+ *
+ * Supported graphs are a chain of FULLY_CONNECTED layers, optionally behind one UNIDIRECTIONAL_SEQUENCE_LSTM.
+ * RESHAPE, SQUEEZE, STRIDED_SLICE (the lstm's last step), QUANTIZE and DEQUANTIZE pass through. A trailing SOFTMAX
+ * is dropped; the classification is an argmax, which softmax doesn't change.
+ *
+ * Parameter mapping (weights must be per-tensor symmetric int8, biases int32):
+ *   fully connected: bias_prime = bias - input_zero_point*sum(row), then one multiply/round by
+ *     input_scale*weight_scale/output_scale, the activation, and the output zero point as the standalone add.
+ *   lstm: the 8 gate weight tensors are fused into one [4*hidden][features+hidden] matrix (gates i,f,c,o), requantized
+ *     to a common scale when theirs differ. Gates are computed as q16 fixed point (multiply roundings of 16)
+ *     and the hidden state is re-quantized to int8 with the output tensor's scale and zero point.
+ *
+ * The report runs random int8 vectors through a model of the axon arithmetic and through TFLite's reference
+ * arithmetic. Fully connected layers are compared bit for bit against TFLite's integer kernel. The lstm is compared
+ * against TFLite's math done in double precision, as the driver's activation functions aren't published; treat its
+ * numbers as an estimate.
+ */
+#include <stdint.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "axon_api.h"
+#include "axon_audio_features_api.h"
+#include "axon_model_container_api.h"
+
+/*
+ * TFLite schema values used here
+ */
+#define TFLITE_OP_DEQUANTIZE 6
+#define TFLITE_OP_FULLY_CONNECTED 9
+#define TFLITE_OP_RESHAPE 22
+#define TFLITE_OP_SOFTMAX 25
+#define TFLITE_OP_SQUEEZE 43
+#define TFLITE_OP_UNIDIRECTIONAL_SEQUENCE_LSTM 44
+#define TFLITE_OP_STRIDED_SLICE 45
+#define TFLITE_OP_QUANTIZE 114
+
+#define TFLITE_TYPE_INT32 2
+#define TFLITE_TYPE_INT8 9
+
+#define TFLITE_ACTIVATION_NONE 0
+#define TFLITE_ACTIVATION_RELU 1
+#define TFLITE_ACTIVATION_TANH 4
+
+/*
+ * lstm operator inputs, by position
+ */
+#define TFLITE_LSTM_INPUT 0
+#define TFLITE_LSTM_INPUT_WEIGHTS 1      // 4 tensors: input, forget, cell, output gates
+#define TFLITE_LSTM_RECURRENT_WEIGHTS 5  // 4 tensors
+#define TFLITE_LSTM_PEEPHOLE_WEIGHTS 9   // 3 tensors, unsupported
+#define TFLITE_LSTM_GATE_BIAS 12         // 4 tensors
+#define TFLITE_LSTM_PROJECTION_WEIGHTS 16 // 2 tensors, unsupported
+#define TFLITE_LSTM_LAYER_NORM_WEIGHTS 20 // 4 tensors, unsupported
+#define TFLITE_LSTM_GATE_CNT 4
+
+/*
+ * axon arithmetic constraints the parameters are fitted to
+ */
+#define IMPORT_BIAS_MULTIPLIER_BITS 21
+#define IMPORT_MAX_ROUNDING 31
+#define IMPORT_LSTM_Q_BITS 16
+#define IMPORT_HIDDEN_MULTIPLIER_BITS 8
+#define IMPORT_INPUT_INV_SCALE_BITS 16
+#define IMPORT_INPUT_FRACTION_BITS 12 // features are q11.12
+#define IMPORT_FC_ROW_ALIGNMENT 16
+
+#define IMPORT_MAX_LENGTH 1024
+#define IMPORT_MAX_LABEL_BYTES 1024
+
+typedef struct {
+  const char *name;
+  uint8_t type;
+  uint8_t dim_cnt;
+  int32_t dims[4];
+  const uint8_t *data;
+  uint32_t data_length;
+  double scale;
+  int32_t zero_point;
+} ImportTensorStruct;
+
+typedef struct {
+  AxonModelLayerTypeEnum layer_type;
+  AxonDataWidthEnum input_data_width;
+  AxonAfEnum activation_function;
+  AxonAfEnum recurrent_activation_function;
+  uint16_t input_length;
+  uint16_t output_length;
+  uint16_t hidden_length;
+  int8_t *weights;            // output_length x input_length
+  int32_t *bias_prime;
+  int32_t bias_add_multiplier;
+  uint8_t bias_add_rounding;
+  int32_t quantize_multiplier;
+  uint8_t quantize_rounding;
+  int32_t standalone_quantize_add;
+  /* reference parameters */
+  double input_scale;
+  int32_t input_zero_point;
+  int32_t output_zero_point;
+  int32_t ref_multiplier;     // fully connected: TFLite's q31 multiplier...
+  int ref_shift;              // ...and shift
+  const int8_t *ref_weights;  // fully connected: TFLite weights, lstm: unused
+  const int32_t *ref_bias;    // fully connected: TFLite bias, may be NULL
+  double *ref_real_weights;   // lstm: real valued, per unit of the quantized input/hidden, [4*hidden][features+hidden]
+  double *ref_real_bias;      // lstm: real valued
+  double hidden_scale;        // lstm: output scale
+  uint32_t requantized_weight_cnt;
+  double requantize_max_error;
+} ImportLayerStruct;
+
+static struct {
+  const uint8_t *start;
+  const uint8_t *end;
+} fb;
+
+static ImportLayerStruct import_layers[AXON_MODEL_CONTAINER_MAX_LAYERS];
+static uint8_t import_layer_cnt;
+
+static void import_fail(const char *fmt, ...) __attribute__((noreturn, format(printf, 1, 2)));
+
+static void import_fail(const char *fmt, ...) {
+  va_list args;
+  va_start(args, fmt);
+  fprintf(stderr, "error: ");
+  vfprintf(stderr, fmt, args);
+  fprintf(stderr, "\n");
+  va_end(args);
+  exit(1);
+}
+
+/*
+ * Minimal flatbuffer reader, enough to walk the TFLite schema. Every access is bounds checked.
+ */
+static const uint8_t *fb_check(const uint8_t *ptr, uint32_t length) {
+  if ((ptr < fb.start) || (ptr > fb.end) || (length > (uint32_t)(fb.end-ptr))) {
+    import_fail("flatbuffer access out of range, corrupt model?");
+  }
+  return ptr;
+}
+
+static uint16_t fb_u16(const uint8_t *ptr) {
+  fb_check(ptr, 2);
+  return ptr[0] | (ptr[1]<<8);
+}
+
+static uint32_t fb_u32(const uint8_t *ptr) {
+  fb_check(ptr, 4);
+  return ptr[0] | (ptr[1]<<8) | (ptr[2]<<16) | ((uint32_t)ptr[3]<<24);
+}
+
+static const uint8_t *fb_deref(const uint8_t *ptr) {
+  return fb_check(ptr+fb_u32(ptr), 0);
+}
+
+/*
+ * returns a pointer to a table's field, NULL if the field isn't present.
+ */
+static const uint8_t *fb_field(const uint8_t *table, uint16_t field_ndx) {
+  const uint8_t *vtable = fb_check(table-(int32_t)fb_u32(table), 4);
+  uint16_t vtable_length = fb_u16(vtable);
+  uint16_t field_offset;
+  if (4+2*field_ndx >= vtable_length) {
+    return NULL;
+  }
+  field_offset = fb_u16(vtable+4+2*field_ndx);
+  return 0==field_offset ? NULL : table+field_offset;
+}
+
+static const uint8_t *fb_table(const uint8_t *table, uint16_t field_ndx) {
+  const uint8_t *field = fb_field(table, field_ndx);
+  return NULL==field ? NULL : fb_deref(field);
+}
+
+/*
+ * returns the vector's elements and count, NULL/0 if the field isn't present.
+ */
+static const uint8_t *fb_vector(const uint8_t *table, uint16_t field_ndx, uint32_t element_size, uint32_t *count) {
+  const uint8_t *vector = fb_table(table, field_ndx);
+  *count = 0;
+  if (NULL==vector) {
+    return NULL;
+  }
+  *count = fb_u32(vector);
+  return fb_check(vector+4, *count*element_size);
+}
+
+static const uint8_t *fb_vector_table(const uint8_t *vector, uint32_t ndx) {
+  return fb_deref(vector+4*ndx);
+}
+
+static int32_t fb_int(const uint8_t *table, uint16_t field_ndx, uint8_t size, int32_t default_value) {
+  const uint8_t *field = fb_field(table, field_ndx);
+  if (NULL==field) {
+    return default_value;
+  }
+  switch (size) {
+  case 1: fb_check(field, 1); return (int8_t)field[0];
+  case 2: return (int16_t)fb_u16(field);
+  default: return (int32_t)fb_u32(field);
+  }
+}
+
+static const char *fb_string(const uint8_t *table, uint16_t field_ndx) {
+  uint32_t length;
+  const uint8_t *string = fb_vector(table, field_ndx, 1, &length);
+  if (NULL==string) {
+    return "";
+  }
+  fb_check(string, length+1); // includes the nul
+  return (const char *)string;
+}
+
+/*
+ * TFLite model access
+ */
+static struct {
+  const uint8_t *subgraph;
+  const uint8_t *tensors;
+  uint32_t tensor_cnt;
+  const uint8_t *buffers;
+  uint32_t buffer_cnt;
+  const uint8_t *operator_codes;
+  uint32_t operator_code_cnt;
+} model;
+
+static void tflite_get_tensor(int32_t tensor_ndx, ImportTensorStruct *tensor) {
+  const uint8_t *table, *quantization, *buffer;
+  const uint8_t *shape, *values;
+  uint32_t count;
+
+  memset(tensor, 0, sizeof(*tensor));
+  if ((tensor_ndx < 0) || ((uint32_t)tensor_ndx >= model.tensor_cnt)) {
+    import_fail("tensor %d out of range", tensor_ndx);
+  }
+  table = fb_vector_table(model.tensors, tensor_ndx);
+  shape = fb_vector(table, 0, 4, &count);
+  if (count > 4) {
+    import_fail("tensor %d has %u dimensions", tensor_ndx, count);
+  }
+  tensor->dim_cnt = count;
+  for (uint32_t ndx=0;ndx<count;ndx++) {
+    tensor->dims[ndx] = (int32_t)fb_u32(shape+4*ndx);
+  }
+  tensor->type = fb_int(table, 1, 1, 0);
+  tensor->name = fb_string(table, 3);
+
+  uint32_t buffer_ndx = fb_int(table, 2, 4, 0);
+  if ((0 != buffer_ndx) && (buffer_ndx < model.buffer_cnt)) {
+    buffer = fb_vector_table(model.buffers, buffer_ndx);
+    tensor->data = fb_vector(buffer, 0, 1, &tensor->data_length);
+  }
+
+  tensor->scale = 0;
+  if (NULL != (quantization = fb_table(table, 4))) {
+    values = fb_vector(quantization, 2, 4, &count);
+    if (count > 1) {
+      import_fail("tensor %s is per-channel quantized, only per-tensor is supported", tensor->name);
+    }
+    if (1==count) {
+      float scale;
+      uint32_t bits = fb_u32(values);
+      memcpy(&scale, &bits, sizeof(scale));
+      tensor->scale = scale;
+    }
+    values = fb_vector(quantization, 3, 8, &count);
+    if (count > 0) {
+      tensor->zero_point = (int32_t)fb_u32(values); // int64, low word is enough for int8
+    }
+  }
+}
+
+static uint32_t tflite_tensor_element_cnt(const ImportTensorStruct *tensor) {
+  uint32_t cnt = 1;
+  for (uint8_t ndx=0;ndx<tensor->dim_cnt;ndx++) {
+    cnt *= tensor->dims[ndx];
+  }
+  return cnt;
+}
+
+static const void *tflite_tensor_data(const ImportTensorStruct *tensor, uint8_t type, uint32_t element_size) {
+  if (tensor->type != type) {
+    import_fail("tensor %s has type %d, expected %d", tensor->name, tensor->type, type);
+  }
+  if ((NULL==tensor->data) || (tensor->data_length != tflite_tensor_element_cnt(tensor)*element_size)) {
+    import_fail("tensor %s has no constant data of the expected size", tensor->name);
+  }
+  return tensor->data;
+}
+
+static void tflite_check_activation_tensor(const ImportTensorStruct *tensor) {
+  if ((TFLITE_TYPE_INT8 != tensor->type) || (0==tensor->scale)) {
+    import_fail("tensor %s must be quantized int8", tensor->name);
+  }
+}
+
+/*
+ * Fixed point helpers. Axon rounds by shifting right and adding the last bit shifted out.
+ */
+static int64_t axon_round(int64_t value, uint8_t rounding) {
+  return 0==rounding ? value : (value + ((int64_t)1<<(rounding-1))) >> rounding;
+}
+
+static int32_t saturate_int8(int64_t value) {
+  return value > 127 ? 127 : value < -128 ? -128 : (int32_t)value;
+}
+
+/*
+ * Finds the largest rounding for which scale*2^rounding still fits in multiplier_bits.
+ */
+static void import_quantize_scale(const char *what, double scale, uint8_t multiplier_bits, uint8_t max_rounding,
+    int32_t *multiplier, uint8_t *rounding) {
+  for (int shift=max_rounding;shift>=0;shift--) {
+    double fixed = floor(ldexp(scale, shift)+0.5);
+    if (fixed < ldexp(1, multiplier_bits)) {
+      if (fixed < 1) {
+        break;
+      }
+      *multiplier = (int32_t)fixed;
+      *rounding = shift;
+      return;
+    }
+  }
+  import_fail("%s scale %g can't be represented", what, scale);
+}
+
+/*
+ * TFLite reference requantization (QuantizeMultiplier(), MultiplyByQuantizedMultiplier())
+ */
+static void tflite_quantize_multiplier(double real_multiplier, int32_t *quantized_multiplier, int *shift) {
+  int64_t q_fixed;
+  if (0==real_multiplier) {
+    *quantized_multiplier = 0;
+    *shift = 0;
+    return;
+  }
+  q_fixed = llround(frexp(real_multiplier, shift) * (double)(1ll << 31));
+  if (q_fixed == (1ll << 31)) {
+    q_fixed /= 2;
+    ++*shift;
+  }
+  if (*shift < -31) {
+    *shift = 0;
+    q_fixed = 0;
+  }
+  *quantized_multiplier = (int32_t)q_fixed;
+}
+
+static int32_t tflite_saturating_rounding_doubling_high_mul(int32_t a, int32_t b) {
+  int64_t ab = (int64_t)a*b;
+  int32_t nudge = ab >= 0 ? (1 << 30) : (1 - (1 << 30));
+  if ((a==b) && (INT32_MIN==a)) {
+    return INT32_MAX;
+  }
+  return (int32_t)((ab + nudge) / (1ll << 31));
+}
+
+static int32_t tflite_rounding_divide_by_pot(int32_t x, int exponent) {
+  int32_t mask = (int32_t)((1ll << exponent) - 1);
+  int32_t remainder = x & mask;
+  int32_t threshold = (mask >> 1) + (x < 0 ? 1 : 0);
+  return (x >> exponent) + (remainder > threshold ? 1 : 0);
+}
+
+static int32_t tflite_multiply_by_quantized_multiplier(int32_t x, int32_t quantized_multiplier, int shift) {
+  int left_shift = shift > 0 ? shift : 0;
+  int right_shift = shift > 0 ? 0 : -shift;
+  return tflite_rounding_divide_by_pot(
+      tflite_saturating_rounding_doubling_high_mul((int32_t)((uint32_t)x << left_shift), quantized_multiplier), right_shift);
+}
+
+static ImportLayerStruct *import_new_layer(AxonModelLayerTypeEnum layer_type) {
+  ImportLayerStruct *layer;
+  if (import_layer_cnt >= AXON_MODEL_CONTAINER_MAX_LAYERS) {
+    import_fail("more than %d layers", AXON_MODEL_CONTAINER_MAX_LAYERS);
+  }
+  layer = import_layers+import_layer_cnt;
+  memset(layer, 0, sizeof(*layer));
+  layer->layer_type = layer_type;
+  // the first layer gets the int8 features, the rest get the previous layer's int32 output.
+  layer->input_data_width = (0==import_layer_cnt) && (kAxonModelLayerFullyConnected==layer_type) ? kAxonDataWidth8 : kAxonDataWidth24;
+  import_layer_cnt++;
+  return layer;
+}
+
+static void import_fully_connected(const uint8_t *op, const int32_t *inputs, uint32_t input_cnt, int32_t output_ndx) {
+  ImportTensorStruct input, weights, bias, output;
+  ImportLayerStruct *layer = import_new_layer(kAxonModelLayerFullyConnected);
+  const uint8_t *options = fb_table(op, 4);
+  int32_t activation = NULL==options ? TFLITE_ACTIVATION_NONE : fb_int(options, 0, 1, TFLITE_ACTIVATION_NONE);
+  double real_multiplier;
+
+  tflite_get_tensor(inputs[0], &input);
+  tflite_get_tensor(inputs[1], &weights);
+  tflite_get_tensor(output_ndx, &output);
+  tflite_check_activation_tensor(&input);
+  tflite_check_activation_tensor(&output);
+
+  if ((2 != weights.dim_cnt) || (weights.dims[0] > IMPORT_MAX_LENGTH) || (weights.dims[1] > IMPORT_MAX_LENGTH)) {
+    import_fail("fully connected weights %s must be 2d, up to %d x %d", weights.name, IMPORT_MAX_LENGTH, IMPORT_MAX_LENGTH);
+  }
+  if (0 != weights.zero_point) {
+    import_fail("fully connected weights %s must be symmetric", weights.name);
+  }
+  layer->output_length = weights.dims[0];
+  layer->input_length = weights.dims[1];
+  layer->ref_weights = tflite_tensor_data(&weights, TFLITE_TYPE_INT8, 1);
+  if ((input_cnt > 2) && (inputs[2] >= 0)) {
+    tflite_get_tensor(inputs[2], &bias);
+    layer->ref_bias = tflite_tensor_data(&bias, TFLITE_TYPE_INT32, 4);
+    if (tflite_tensor_element_cnt(&bias) != layer->output_length) {
+      import_fail("fully connected bias %s mis-sized", bias.name);
+    }
+  }
+
+  switch (activation) {
+  case TFLITE_ACTIVATION_NONE:
+    layer->activation_function = kAxonAfDisabled;
+    break;
+  case TFLITE_ACTIVATION_RELU:
+    layer->activation_function = kAxonAfRelu;
+    break;
+  default:
+    import_fail("fully connected activation %d unsupported", activation);
+  }
+
+  layer->input_scale = input.scale;
+  layer->input_zero_point = input.zero_point;
+  layer->output_zero_point = output.zero_point;
+  layer->weights = malloc(layer->output_length*layer->input_length);
+  layer->bias_prime = malloc(layer->output_length*sizeof(int32_t));
+  memcpy(layer->weights, layer->ref_weights, layer->output_length*layer->input_length);
+
+  // axon multiplies the raw input, so the input zero point gets folded into the bias.
+  for (uint16_t row=0;row<layer->output_length;row++) {
+    int64_t bias_prime = NULL==layer->ref_bias ? 0 : layer->ref_bias[row];
+    for (uint16_t col=0;col<layer->input_length;col++) {
+      bias_prime -= (int64_t)input.zero_point*layer->weights[row*layer->input_length+col];
+    }
+    layer->bias_prime[row] = (int32_t)bias_prime;
+  }
+
+  real_multiplier = input.scale*weights.scale/output.scale;
+  import_quantize_scale(weights.name, real_multiplier, IMPORT_BIAS_MULTIPLIER_BITS, IMPORT_MAX_ROUNDING,
+      &layer->bias_add_multiplier, &layer->bias_add_rounding);
+  layer->quantize_multiplier = 1;
+  layer->quantize_rounding = 0;
+  layer->standalone_quantize_add = output.zero_point;
+  tflite_quantize_multiplier(real_multiplier, &layer->ref_multiplier, &layer->ref_shift);
+}
+
+static void import_lstm(const uint8_t *op, const int32_t *inputs, uint32_t input_cnt, int32_t output_ndx) {
+  ImportTensorStruct input, output, weights[2*TFLITE_LSTM_GATE_CNT], bias[TFLITE_LSTM_GATE_CNT];
+  ImportLayerStruct *layer = import_new_layer(kAxonModelLayerLstmCell);
+  const uint8_t *options = fb_table(op, 4);
+  uint16_t feature_cnt, hidden_length, row_length;
+  double common_scale = 0;
+
+  if (import_layer_cnt > 1) {
+    import_fail("the lstm must be the first layer");
+  }
+  if (input_cnt < 20) {
+    import_fail("lstm has %u inputs, expected at least 20", input_cnt);
+  }
+  for (uint8_t ndx=TFLITE_LSTM_PEEPHOLE_WEIGHTS;ndx<input_cnt;ndx++) {
+    // everything past the weights is optional except the biases and the 2 state tensors after the projection
+    uint8_t required = ((ndx >= TFLITE_LSTM_GATE_BIAS) && (ndx < TFLITE_LSTM_GATE_BIAS+TFLITE_LSTM_GATE_CNT)) ||
+        (ndx==TFLITE_LSTM_PROJECTION_WEIGHTS+2) || (ndx==TFLITE_LSTM_PROJECTION_WEIGHTS+3);
+    if (!required && (inputs[ndx] >= 0)) {
+      import_fail("lstm peepholes, projection and layer norm are unsupported (input %d)", ndx);
+    }
+  }
+  if ((NULL != options) && (TFLITE_ACTIVATION_TANH != fb_int(options, 0, 1, TFLITE_ACTIVATION_TANH))) {
+    import_fail("lstm activation must be tanh");
+  }
+  if ((NULL != options) && ((0 != fb_int(options, 1, 4, 0)) || (0 != fb_int(options, 2, 4, 0)))) {
+    import_fail("lstm cell/projection clipping is unsupported");
+  }
+
+  tflite_get_tensor(inputs[TFLITE_LSTM_INPUT], &input);
+  tflite_get_tensor(output_ndx, &output);
+  tflite_check_activation_tensor(&input);
+  tflite_check_activation_tensor(&output);
+  for (uint8_t gate=0;gate<TFLITE_LSTM_GATE_CNT;gate++) {
+    if ((inputs[TFLITE_LSTM_INPUT_WEIGHTS+gate] < 0) || (inputs[TFLITE_LSTM_GATE_BIAS+gate] < 0)) {
+      import_fail("lstm gate %d is missing weights or bias (CIFG is unsupported)", gate);
+    }
+    tflite_get_tensor(inputs[TFLITE_LSTM_INPUT_WEIGHTS+gate], weights+gate);
+    tflite_get_tensor(inputs[TFLITE_LSTM_RECURRENT_WEIGHTS+gate], weights+TFLITE_LSTM_GATE_CNT+gate);
+    tflite_get_tensor(inputs[TFLITE_LSTM_GATE_BIAS+gate], bias+gate);
+  }
+
+  hidden_length = weights[0].dims[0];
+  feature_cnt = weights[0].dims[1];
+  row_length = feature_cnt+hidden_length;
+  if ((4*hidden_length > IMPORT_MAX_LENGTH) || (row_length > IMPORT_MAX_LENGTH) || (hidden_length > 255)) {
+    import_fail("lstm too large: %d features, %d hidden", feature_cnt, hidden_length);
+  }
+  for (uint8_t ndx=0;ndx<2*TFLITE_LSTM_GATE_CNT;ndx++) {
+    uint16_t expected_cols = ndx < TFLITE_LSTM_GATE_CNT ? feature_cnt : hidden_length;
+    if ((2 != weights[ndx].dim_cnt) || (weights[ndx].dims[0] != hidden_length) || (weights[ndx].dims[1] != expected_cols) ||
+        (0 != weights[ndx].zero_point)) {
+      import_fail("lstm weights %s must be symmetric %d x %d", weights[ndx].name, hidden_length, expected_cols);
+    }
+    tflite_tensor_data(weights+ndx, TFLITE_TYPE_INT8, 1);
+    // the product scale: a unit of the int8 input (or hidden state) times a unit of the weight
+    double product_scale = weights[ndx].scale*(ndx < TFLITE_LSTM_GATE_CNT ? input.scale : output.scale);
+    common_scale = product_scale > common_scale ? product_scale : common_scale;
+  }
+
+  layer->input_length = row_length;
+  layer->output_length = 4*hidden_length;
+  layer->hidden_length = hidden_length;
+  layer->activation_function = kAxonAfTanh;
+  layer->recurrent_activation_function = kAxonAfSigmoid;
+  layer->input_scale = input.scale;
+  layer->input_zero_point = input.zero_point;
+  layer->output_zero_point = output.zero_point;
+  layer->hidden_scale = output.scale;
+  layer->weights = malloc(layer->output_length*row_length);
+  layer->bias_prime = malloc(layer->output_length*sizeof(int32_t));
+  layer->ref_real_weights = malloc(layer->output_length*row_length*sizeof(double));
+  layer->ref_real_bias = malloc(layer->output_length*sizeof(double));
+
+  /*
+   * Fuse [input weights | recurrent weights] per gate, rescaled to the largest product scale so one multiplier
+   * serves the whole row. Rescaling only shrinks weights, so they stay in int8.
+   */
+  for (uint8_t gate=0;gate<TFLITE_LSTM_GATE_CNT;gate++) {
+    const int32_t *gate_bias = tflite_tensor_data(bias+gate, TFLITE_TYPE_INT32, 4);
+    if (tflite_tensor_element_cnt(bias+gate) != hidden_length) {
+      import_fail("lstm bias %s mis-sized", bias[gate].name);
+    }
+    for (uint16_t unit=0;unit<hidden_length;unit++) {
+      uint16_t row = gate*hidden_length+unit;
+      int64_t bias_prime;
+      double bias_scale = input.scale*weights[gate].scale;
+      layer->ref_real_bias[row] = gate_bias[unit]*bias_scale;
+      bias_prime = llround(gate_bias[unit]*bias_scale/common_scale);
+      for (uint16_t col=0;col<row_length;col++) {
+        uint8_t which = col < feature_cnt ? gate : TFLITE_LSTM_GATE_CNT+gate;
+        uint16_t weight_col = col < feature_cnt ? col : col-feature_cnt;
+        int8_t weight = ((const int8_t *)weights[which].data)[unit*weights[which].dims[1]+weight_col];
+        double product_scale = weights[which].scale*(col < feature_cnt ? input.scale : output.scale);
+        double rescaled = weight*product_scale/common_scale;
+        int8_t requantized = (int8_t)lround(rescaled);
+        double error = fabs(rescaled-requantized);
+
+        layer->ref_real_weights[row*row_length+col] = weight*product_scale;
+        layer->weights[row*row_length+col] = requantized;
+        if (requantized != weight) {
+          layer->requantized_weight_cnt++;
+        }
+        layer->requantize_max_error = error > layer->requantize_max_error ? error : layer->requantize_max_error;
+        bias_prime -= (int64_t)requantized*(col < feature_cnt ? input.zero_point : output.zero_point);
+      }
+      layer->bias_prime[row] = (int32_t)bias_prime;
+    }
+  }
+
+  // gates come out as q16 fixed point...
+  import_quantize_scale("lstm gate", common_scale*(1<<IMPORT_LSTM_Q_BITS), IMPORT_BIAS_MULTIPLIER_BITS, IMPORT_MAX_ROUNDING,
+      &layer->bias_add_multiplier, &layer->bias_add_rounding);
+  // ...and the q16 hidden state is re-quantized to int8
+  import_quantize_scale("lstm hidden state", 1.0/(output.scale*(1<<IMPORT_LSTM_Q_BITS)), IMPORT_HIDDEN_MULTIPLIER_BITS,
+      IMPORT_MAX_ROUNDING, &layer->quantize_multiplier, &layer->quantize_rounding);
+  layer->standalone_quantize_add = output.zero_point;
+}
+
+/*
+ * Walks the main subgraph, converting the supported operators in order.
+ */
+static void import_model(const uint8_t *buffer, uint32_t length) {
+  const uint8_t *root, *subgraphs, *operators;
+  uint32_t subgraph_cnt, operator_cnt;
+  uint8_t softmax_seen = 0;
+
+  fb.start = buffer;
+  fb.end = buffer+length;
+  if ((length < 8) || memcmp(buffer+4, "TFL3", 4)) {
+    import_fail("not a .tflite model");
+  }
+  root = fb_deref(buffer);
+  model.operator_codes = fb_vector(root, 1, 4, &model.operator_code_cnt);
+  subgraphs = fb_vector(root, 2, 4, &subgraph_cnt);
+  model.buffers = fb_vector(root, 4, 4, &model.buffer_cnt);
+  if (0==subgraph_cnt) {
+    import_fail("model has no subgraphs");
+  }
+  model.subgraph = fb_vector_table(subgraphs, 0);
+  model.tensors = fb_vector(model.subgraph, 0, 4, &model.tensor_cnt);
+  operators = fb_vector(model.subgraph, 3, 4, &operator_cnt);
+
+  for (uint32_t op_ndx=0;op_ndx<operator_cnt;op_ndx++) {
+    const uint8_t *op = fb_vector_table(operators, op_ndx);
+    uint32_t opcode_ndx = fb_int(op, 0, 4, 0);
+    uint32_t input_cnt, output_cnt;
+    const uint8_t *op_inputs = fb_vector(op, 1, 4, &input_cnt);
+    const uint8_t *op_outputs = fb_vector(op, 2, 4, &output_cnt);
+    int32_t inputs[24];
+    int32_t builtin_code;
+
+    if (opcode_ndx >= model.operator_code_cnt) {
+      import_fail("operator %u has a bad opcode", op_ndx);
+    }
+    const uint8_t *opcode = fb_vector_table(model.operator_codes, opcode_ndx);
+    // builtin codes > 127 moved to a new field, the deprecated one holds the smaller of the two
+    builtin_code = fb_int(opcode, 0, 1, 0);
+    if (fb_int(opcode, 3, 4, 0) > builtin_code) {
+      builtin_code = fb_int(opcode, 3, 4, 0);
+    }
+
+    if ((input_cnt > sizeof(inputs)/sizeof(inputs[0])) || (0==output_cnt)) {
+      import_fail("operator %u has %u inputs, %u outputs", op_ndx, input_cnt, output_cnt);
+    }
+    for (uint32_t ndx=0;ndx<input_cnt;ndx++) {
+      inputs[ndx] = (int32_t)fb_u32(op_inputs+4*ndx);
+    }
+    if (softmax_seen && (TFLITE_OP_DEQUANTIZE != builtin_code)) {
+      import_fail("softmax must be the last operator");
+    }
+
+    switch (builtin_code) {
+    case TFLITE_OP_FULLY_CONNECTED:
+      import_fully_connected(op, inputs, input_cnt, (int32_t)fb_u32(op_outputs));
+      break;
+    case TFLITE_OP_UNIDIRECTIONAL_SEQUENCE_LSTM:
+      import_lstm(op, inputs, input_cnt, (int32_t)fb_u32(op_outputs));
+      break;
+    case TFLITE_OP_SOFTMAX:
+      softmax_seen = 1;
+      break;
+    case TFLITE_OP_RESHAPE:
+    case TFLITE_OP_SQUEEZE:
+    case TFLITE_OP_STRIDED_SLICE:
+    case TFLITE_OP_QUANTIZE:
+    case TFLITE_OP_DEQUANTIZE:
+      break;
+    default:
+      import_fail("operator %u: builtin op %d is unsupported", op_ndx, builtin_code);
+    }
+  }
+  if (0==import_layer_cnt) {
+    import_fail("model has no fully connected or lstm layers");
+  }
+  for (uint8_t layer_ndx=1;layer_ndx<import_layer_cnt;layer_ndx++) {
+    uint16_t previous_output = kAxonModelLayerLstmCell==import_layers[layer_ndx-1].layer_type ?
+        import_layers[layer_ndx-1].hidden_length : import_layers[layer_ndx-1].output_length;
+    if (import_layers[layer_ndx].input_length != previous_output) {
+      import_fail("layer %d input length %d doesn't match the previous layer's output %d",
+          layer_ndx+1, import_layers[layer_ndx].input_length, previous_output);
+    }
+  }
+}
+
+/*
+ * Axon model of a fully connected layer. Returns the (unsaturated) int32 output that the next layer sees.
+ */
+static void axon_fully_connected(const ImportLayerStruct *layer, const int32_t *input, int32_t *output) {
+  for (uint16_t row=0;row<layer->output_length;row++) {
+    int64_t acc = layer->bias_prime[row];
+    for (uint16_t col=0;col<layer->input_length;col++) {
+      acc += (int64_t)input[col]*layer->weights[row*layer->input_length+col];
+    }
+    acc = axon_round(acc*layer->bias_add_multiplier, layer->bias_add_rounding);
+    if ((kAxonAfRelu==layer->activation_function) && (acc < 0)) {
+      acc = 0;
+    }
+    acc = axon_round(acc*layer->quantize_multiplier, layer->quantize_rounding);
+    output[row] = (int32_t)(acc + layer->standalone_quantize_add);
+  }
+}
+
+/*
+ * TFLite's int8 fully connected kernel. With saturate false, the int8 output range isn't applied (the activation
+ * still is), which is what axon's arithmetic is compared against.
+ */
+static void tflite_fully_connected(const ImportLayerStruct *layer, const int32_t *input, int32_t *output, uint8_t saturate) {
+  for (uint16_t row=0;row<layer->output_length;row++) {
+    int32_t acc = NULL==layer->ref_bias ? 0 : layer->ref_bias[row];
+    for (uint16_t col=0;col<layer->input_length;col++) {
+      acc += (input[col]-layer->input_zero_point)*layer->ref_weights[row*layer->input_length+col];
+    }
+    acc = tflite_multiply_by_quantized_multiplier(acc, layer->ref_multiplier, layer->ref_shift) + layer->output_zero_point;
+    if (kAxonAfRelu==layer->activation_function) {
+      acc = acc < layer->output_zero_point ? layer->output_zero_point : acc;
+    }
+    output[row] = saturate ? saturate_int8(acc) : acc;
+  }
+}
+
+static int32_t q16_activation(AxonAfEnum af, int64_t value_q16) {
+  double value = (double)value_q16/(1<<IMPORT_LSTM_Q_BITS);
+  value = kAxonAfSigmoid==af ? 1/(1+exp(-value)) : tanh(value);
+  return (int32_t)lround(value*(1<<IMPORT_LSTM_Q_BITS));
+}
+
+/*
+ * Axon model of an lstm time step: q16 gates and cell state, int8 hidden state.
+ * cell_q16 and hidden are updated in place.
+ */
+static void axon_lstm_step(const ImportLayerStruct *layer, const int32_t *features, int32_t *hidden, int64_t *cell_q16) {
+  uint16_t hidden_length = layer->hidden_length;
+  uint16_t feature_cnt = layer->input_length-hidden_length;
+  int32_t gates[4*256];
+  for (uint16_t row=0;row<layer->output_length;row++) {
+    int64_t acc = layer->bias_prime[row];
+    for (uint16_t col=0;col<layer->input_length;col++) {
+      int32_t in = col < feature_cnt ? features[col] : hidden[col-feature_cnt];
+      acc += (int64_t)in*layer->weights[row*layer->input_length+col];
+    }
+    acc = axon_round(acc*layer->bias_add_multiplier, layer->bias_add_rounding);
+    gates[row] = q16_activation(2==row/hidden_length ? layer->activation_function : layer->recurrent_activation_function, acc);
+  }
+  for (uint16_t unit=0;unit<hidden_length;unit++) {
+    int64_t input_gate = gates[unit], forget_gate = gates[hidden_length+unit];
+    int64_t cell_gate = gates[2*hidden_length+unit], output_gate = gates[3*hidden_length+unit];
+    cell_q16[unit] = axon_round(forget_gate*cell_q16[unit], IMPORT_LSTM_Q_BITS) + axon_round(input_gate*cell_gate, IMPORT_LSTM_Q_BITS);
+    int64_t hidden_q16 = axon_round(output_gate*q16_activation(layer->activation_function, cell_q16[unit]), IMPORT_LSTM_Q_BITS);
+    hidden[unit] = saturate_int8(axon_round(hidden_q16*layer->quantize_multiplier, layer->quantize_rounding) + layer->standalone_quantize_add);
+  }
+}
+
+/*
+ * TFLite lstm math in double precision, with the int8 hidden state TFLite carries between steps.
+ */
+static void tflite_lstm_step(const ImportLayerStruct *layer, const int32_t *features, int32_t *hidden, double *cell) {
+  uint16_t hidden_length = layer->hidden_length;
+  uint16_t feature_cnt = layer->input_length-hidden_length;
+  double gates[4*256];
+  for (uint16_t row=0;row<layer->output_length;row++) {
+    double acc = layer->ref_real_bias[row];
+    for (uint16_t col=0;col<layer->input_length;col++) {
+      int32_t in = col < feature_cnt ? features[col]-layer->input_zero_point : hidden[col-feature_cnt]-layer->output_zero_point;
+      acc += in*layer->ref_real_weights[row*layer->input_length+col];
+    }
+    gates[row] = 2==row/hidden_length ? tanh(acc) : 1/(1+exp(-acc));
+  }
+  for (uint16_t unit=0;unit<hidden_length;unit++) {
+    cell[unit] = gates[hidden_length+unit]*cell[unit] + gates[unit]*gates[2*hidden_length+unit];
+    double hidden_real = gates[3*hidden_length+unit]*tanh(cell[unit]);
+    hidden[unit] = saturate_int8(lround(hidden_real/layer->hidden_scale) + layer->output_zero_point);
+  }
+}
+
+typedef struct {
+  uint32_t compared;
+  uint32_t mismatched;
+  uint32_t out_of_int8;
+  int32_t max_abs_diff;
+} ImportStatsStruct;
+
+static void import_compare(ImportStatsStruct *stats, const int32_t *axon, const int32_t *reference, uint16_t length) {
+  for (uint16_t ndx=0;ndx<length;ndx++) {
+    int32_t diff = abs(axon[ndx]-reference[ndx]);
+    stats->compared++;
+    stats->mismatched += 0 != diff;
+    stats->out_of_int8 += (axon[ndx] < -128) || (axon[ndx] > 127);
+    stats->max_abs_diff = diff > stats->max_abs_diff ? diff : stats->max_abs_diff;
+  }
+}
+
+static uint16_t import_argmax(const int32_t *values, uint16_t length) {
+  uint16_t max_ndx = 0;
+  for (uint16_t ndx=1;ndx<length;ndx++) {
+    if (values[ndx] > values[max_ndx]) {
+      max_ndx = ndx;
+    }
+  }
+  return max_ndx;
+}
+
+/*
+ * Runs vector_cnt random inputs through both models. Each fully connected layer is compared on identical (reference)
+ * inputs against TFLite before its int8 saturation, then the whole model is compared end to end on the final
+ * classification.
+ */
+static void import_report(uint32_t vector_cnt, uint8_t slice_cnt) {
+  static ImportStatsStruct stats[AXON_MODEL_CONTAINER_MAX_LAYERS];
+  static int32_t reference_io[IMPORT_MAX_LENGTH], unsaturated_io[IMPORT_MAX_LENGTH];
+  static int32_t axon_io[IMPORT_MAX_LENGTH], chained_io[IMPORT_MAX_LENGTH];
+  static int32_t features[IMPORT_MAX_LENGTH];
+  uint32_t argmax_agreed = 0;
+
+  for (uint32_t vector=0;vector<vector_cnt;vector++) {
+    uint16_t length;
+    uint8_t first_fc = 0;
+
+    if (kAxonModelLayerLstmCell==import_layers[0].layer_type) {
+      const ImportLayerStruct *lstm = import_layers;
+      uint16_t feature_cnt = lstm->input_length-lstm->hidden_length;
+      static int32_t reference_hidden[256], axon_hidden[256];
+      static double reference_cell[256];
+      static int64_t axon_cell[256];
+      for (uint16_t unit=0;unit<lstm->hidden_length;unit++) {
+        reference_hidden[unit] = axon_hidden[unit] = lstm->output_zero_point;
+        reference_cell[unit] = 0;
+        axon_cell[unit] = 0;
+      }
+      for (uint8_t slice=0;slice<slice_cnt;slice++) {
+        for (uint16_t ndx=0;ndx<feature_cnt;ndx++) {
+          features[ndx] = (rand() & 0xff) - 128;
+        }
+        tflite_lstm_step(lstm, features, reference_hidden, reference_cell);
+        axon_lstm_step(lstm, features, axon_hidden, axon_cell);
+      }
+      import_compare(stats, axon_hidden, reference_hidden, lstm->hidden_length);
+      memcpy(reference_io, reference_hidden, lstm->hidden_length*sizeof(int32_t));
+      memcpy(chained_io, axon_hidden, lstm->hidden_length*sizeof(int32_t));
+      length = lstm->hidden_length;
+      first_fc = 1;
+    } else {
+      length = import_layers[0].input_length;
+      for (uint16_t ndx=0;ndx<length;ndx++) {
+        reference_io[ndx] = chained_io[ndx] = (rand() & 0xff) - 128;
+      }
+    }
+
+    for (uint8_t layer_ndx=first_fc;layer_ndx<import_layer_cnt;layer_ndx++) {
+      const ImportLayerStruct *layer = import_layers+layer_ndx;
+      axon_fully_connected(layer, reference_io, axon_io);
+      axon_fully_connected(layer, chained_io, chained_io);
+      tflite_fully_connected(layer, reference_io, unsaturated_io, 0);
+      tflite_fully_connected(layer, reference_io, reference_io, 1);
+      import_compare(stats+layer_ndx, axon_io, unsaturated_io, layer->output_length);
+      length = layer->output_length;
+    }
+    argmax_agreed += import_argmax(chained_io, length)==import_argmax(reference_io, length);
+  }
+
+  printf("\nreport: %u random vectors\n", vector_cnt);
+  for (uint8_t layer_ndx=0;layer_ndx<import_layer_cnt;layer_ndx++) {
+    const ImportLayerStruct *layer = import_layers+layer_ndx;
+    ImportStatsStruct *layer_stats = stats+layer_ndx;
+    printf("  layer %d %-15s: %u/%u outputs differ (%.3f%%), max diff %d lsb%s\n", layer_ndx+1,
+        kAxonModelLayerLstmCell==layer->layer_type ? "lstm (estimate)" : "fully connected",
+        layer_stats->mismatched, layer_stats->compared, 100.0*layer_stats->mismatched/layer_stats->compared,
+        layer_stats->max_abs_diff, 0==layer_stats->mismatched && kAxonModelLayerFullyConnected==layer->layer_type ? ", bit exact" : "");
+    if (layer_stats->out_of_int8 && (layer_ndx+1 < import_layer_cnt)) {
+      printf("    %u outputs exceeded int8; axon passes them on unsaturated, TFLite clamps them\n", layer_stats->out_of_int8);
+    }
+    if (layer->requantized_weight_cnt) {
+      printf("    %u weights requantized to a common scale, max error %.3f lsb\n", layer->requantized_weight_cnt, layer->requantize_max_error);
+    }
+  }
+  printf("  end to end: classification agrees on %u/%u vectors\n", argmax_agreed, vector_cnt);
+}
+
+/*
+ * Header output, in the style of the hand written const headers.
+ */
+static const char *af_name(AxonAfEnum af) {
+  switch (af) {
+  case kAxonAfRelu: return "kAxonAfRelu";
+  case kAxonAfSigmoid: return "kAxonAfSigmoid";
+  case kAxonAfTanh: return "kAxonAfTanh";
+  default: return "kAxonAfDisabled";
+  }
+}
+
+static const char *variant_names[] = {
+    "kAxonAudioFeatureMel32",
+    "kAxonAudioFeatureMfccOrtho",
+    "kAxonAudioFeatureMfccOrthoEnergyAppend",
+    "kAxonAudioFeatureMfccFftMagOrtho",
+};
+
+static void write_int_array(FILE *file, const int32_t *values, uint32_t cnt, const char *indent) {
+  for (uint32_t ndx=0;ndx<cnt;ndx++) {
+    fprintf(file, "%s%d,%s", 0==ndx%16 ? indent : "", values[ndx], 15==ndx%16 || ndx+1==cnt ? "\n" : " ");
+  }
+}
+
+static void import_write_header(const char *path, const char *prefix, uint8_t variant, uint8_t slice_cnt, uint8_t feature_cnt,
+    int32_t input_inv_scale, uint8_t input_inv_scale_shift, int32_t input_zero_point, char labels[][64], uint8_t label_cnt) {
+  FILE *file = fopen(path, "w");
+  char lower[64];
+  if (NULL==file) {
+    import_fail("can't write %s", path);
+  }
+  for (uint8_t ndx=0;ndx<sizeof(lower);ndx++) {
+    lower[ndx] = (prefix[ndx] >= 'A') && (prefix[ndx] <= 'Z') ? prefix[ndx]-'A'+'a' : prefix[ndx];
+    if (0==prefix[ndx]) {
+      break;
+    }
+  }
+
+  fprintf(file, "/*\n * Generated by axon_tflite_import, do not edit.\n */\n");
+  fprintf(file, "#include <stdint.h>\n#include <assert.h>\n#pragma once\n");
+  fprintf(file, "#define %s_AUDIO_FEATURES_TYPE  %s\n", prefix, variant_names[variant]);
+  fprintf(file, "#define %s_L1_INPUT_WIDTH %d\n", prefix, slice_cnt);
+  fprintf(file, "#define %s_L1_INPUT_HEIGHT %d\n", prefix, feature_cnt);
+  fprintf(file, "#define %s_L1_INPUT_QUANTIZE_INV_SCALING_FACTOR %d\n", prefix, input_inv_scale);
+  fprintf(file, "#define %s_L1_INPUT_QUANTIZE_INV_SCALING_FACTOR_SHIFT %d\n", prefix, input_inv_scale_shift);
+  fprintf(file, "#define %s_L1_INPUT_QUANTIZE_ZERO_POINT %d\n", prefix, input_zero_point);
+
+  for (uint8_t layer_ndx=0;layer_ndx<import_layer_cnt;layer_ndx++) {
+    const ImportLayerStruct *layer = import_layers+layer_ndx;
+    uint8_t n = layer_ndx+1;
+    fprintf(file, "\n#define %s_L%d_INPUT_BITWIDTH %s\n", prefix, n, kAxonDataWidth8==layer->input_data_width ? "kAxonDataWidth8" : "kAxonDataWidth24");
+    fprintf(file, "#define %s_L%d_ACTIVATION_FUNCTION %s\n", prefix, n, af_name(layer->activation_function));
+    if (kAxonModelLayerLstmCell==layer->layer_type) {
+      fprintf(file, "#define %s_L%d_RECURRENT_ACTIVATION_FUNCTION %s\n", prefix, n, af_name(layer->recurrent_activation_function));
+    }
+    fprintf(file, "#define %s_L%d_INPUT_LENGTH %d\n", prefix, n, layer->input_length);
+    fprintf(file, "#define %s_L%d_OUTPUT_LENGTH %d\n", prefix, n, layer->output_length);
+    fprintf(file, "const int8_t %s_l%d_weights[][%s_L%d_INPUT_LENGTH] = {\n", lower, n, prefix, n);
+    for (uint16_t row=0;row<layer->output_length;row++) {
+      fprintf(file, "  {");
+      for (uint16_t col=0;col<layer->input_length;col++) {
+        fprintf(file, "%d%s", layer->weights[row*layer->input_length+col], col+1==layer->input_length ? "" : ", ");
+      }
+      fprintf(file, "},\n");
+    }
+    fprintf(file, "};\n");
+    fprintf(file, "const int32_t %s_l%d_bias_prime[] = {\n", lower, n);
+    write_int_array(file, layer->bias_prime, layer->output_length, "  ");
+    fprintf(file, "};\n");
+    fprintf(file, "#define %s_L%d_BIAS_ADD_MULTIPLIER %d\n", prefix, n, layer->bias_add_multiplier);
+    fprintf(file, "#define %s_L%d_BIAS_ADD_ROUNDING %d\n", prefix, n, layer->bias_add_rounding);
+    if (kAxonModelLayerLstmCell==layer->layer_type) {
+      fprintf(file, "#define %s_L%d_MULTIPLIER_ROUNDING %d\n", prefix, n, IMPORT_LSTM_Q_BITS);
+      fprintf(file, "#define %s_L%d_HIDDEN_MULTIPLIER_ROUNDING %d\n", prefix, n, IMPORT_LSTM_Q_BITS);
+      fprintf(file, "#define %s_L%d_HIDDEN_LENGTH %d\n", prefix, n, layer->hidden_length);
+      fprintf(file, "#define %s_L%d_HIDDENSTATE_QUANTIZE_INV_SCALING_FACTOR %d\n", prefix, n, layer->quantize_multiplier);
+      fprintf(file, "#define %s_L%d_HIDDENSTATE_QUANTIZE_INV_SCALING_FACTOR_SHIFT %d\n", prefix, n, layer->quantize_rounding);
+      fprintf(file, "#define %s_L%d_HIDDENSTATE_QUANTIZE_ZERO_POINT %d\n", prefix, n, layer->standalone_quantize_add);
+      continue;
+    }
+    fprintf(file, "const int32_t *%s_l%d_normalization_mult = NULL;\n", lower, n);
+    fprintf(file, "#define %s_L%d_NORM_MULT_ROUNDING 0\n", prefix, n);
+    fprintf(file, "const int32_t *%s_l%d_normalization_add = NULL;\n", lower, n);
+    fprintf(file, "#define %s_L%d_NORM_ADD_ROUNDING 0\n", prefix, n);
+    fprintf(file, "#define %s_L%d_QUANTIZE_ADD 0\n", prefix, n);
+    fprintf(file, "#define %s_L%d_QUANTIZE_MULTIPLIER %d\n", prefix, n, layer->quantize_multiplier);
+    fprintf(file, "#define %s_L%d_QUANTIZE_ROUNDING %d\n", prefix, n, layer->quantize_rounding);
+    fprintf(file, "#define %s_L%d_QUANTIZE_STANDALONE_ADD %d\n", prefix, n, layer->standalone_quantize_add);
+  }
+
+  if (label_cnt) {
+    fprintf(file, "\nstatic const char *%s_labels[] = {\n", lower);
+    for (uint8_t ndx=0;ndx<label_cnt;ndx++) {
+      fprintf(file, "    \"%s\",\n", labels[ndx]);
+    }
+    fprintf(file, "};\n");
+  }
+  fclose(file);
+}
+
+/*
+ * Container output. Blobs are laid out in order after the layer table; fully connected rows are padded to
+ * IMPORT_FC_ROW_ALIGNMENT so the container can also be used from RAM.
+ */
+static uint32_t container_align(uint32_t offset) {
+  return (offset + AXON_MODEL_CONTAINER_ALIGNMENT-1) & ~(AXON_MODEL_CONTAINER_ALIGNMENT-1);
+}
+
+static void import_write_container(const char *path, uint8_t variant, uint8_t slice_cnt, uint8_t feature_cnt,
+    int32_t input_inv_scale, uint8_t input_inv_scale_shift, int32_t input_zero_point, char labels[][64], uint8_t label_cnt) {
+  uint32_t offset = container_align(sizeof(AxonModelContainerHeaderStruct)+import_layer_cnt*sizeof(AxonModelContainerLayerStruct));
+  uint32_t capacity = offset + AXON_MODEL_CONTAINER_ALIGNMENT + IMPORT_MAX_LABEL_BYTES;
+  uint8_t *container;
+  AxonModelContainerHeaderStruct *header;
+  AxonModelContainerLayerStruct *layers;
+  FILE *file;
+
+  for (uint8_t layer_ndx=0;layer_ndx<import_layer_cnt;layer_ndx++) {
+    const ImportLayerStruct *layer = import_layers+layer_ndx;
+    capacity += 2*AXON_MODEL_CONTAINER_ALIGNMENT + (uint32_t)layer->output_length*(container_align(layer->input_length)+sizeof(int32_t));
+  }
+  container = calloc(1, capacity);
+  header = (AxonModelContainerHeaderStruct *)container;
+  layers = (AxonModelContainerLayerStruct *)(container+sizeof(*header));
+
+  header->header_length = sizeof(*header);
+  header->layer_cnt = import_layer_cnt;
+  header->execution = kAxonModelLayerLstmCell==import_layers[0].layer_type ? kAxonModelExecutePerSlice : kAxonModelExecuteWindow;
+  header->feature_variant = variant;
+  header->input_width = slice_cnt;
+  header->input_height = feature_cnt;
+  header->quantization_zero_point = input_zero_point;
+  header->quantization_inv_scale_factor = input_inv_scale;
+  header->quantization_inv_scale_factor_q_factor = input_inv_scale_shift;
+  header->label_cnt = import_layers[import_layer_cnt-1].output_length;
+
+  for (uint8_t layer_ndx=0;layer_ndx<import_layer_cnt;layer_ndx++) {
+    const ImportLayerStruct *layer = import_layers+layer_ndx;
+    AxonModelContainerLayerStruct *out = layers+layer_ndx;
+    out->layer_type = layer->layer_type;
+    out->input_data_width = layer->input_data_width;
+    out->activation_function = layer->activation_function;
+    out->recurrent_activation_function = layer->recurrent_activation_function;
+    out->input_length = layer->input_length;
+    out->row_length = kAxonModelLayerFullyConnected==layer->layer_type ?
+        (layer->input_length + IMPORT_FC_ROW_ALIGNMENT-1) & ~(IMPORT_FC_ROW_ALIGNMENT-1) : layer->input_length;
+    out->output_length = layer->output_length;
+    out->hidden_length = layer->hidden_length;
+    out->bias_add_multiplier = layer->bias_add_multiplier;
+    out->bias_add_rounding = layer->bias_add_rounding;
+    out->quantize_rounding = layer->quantize_rounding;
+    out->quantize_multiplier = layer->quantize_multiplier;
+    out->standalone_quantize_add = layer->standalone_quantize_add;
+    if (kAxonModelLayerLstmCell==layer->layer_type) {
+      out->multiply_rounding = IMPORT_LSTM_Q_BITS;
+      out->hidden_multiply_rounding = IMPORT_LSTM_Q_BITS;
+      out->quantize_add = layer->standalone_quantize_add;
+      out->standalone_quantize_add = 0;
+    }
+
+    out->weights_offset = offset;
+    for (uint16_t row=0;row<layer->output_length;row++) {
+      memcpy(container+offset+row*out->row_length, layer->weights+row*layer->input_length, layer->input_length);
+    }
+    offset = container_align(offset + (uint32_t)out->row_length*layer->output_length);
+    out->bias_prime_offset = offset;
+    memcpy(container+offset, layer->bias_prime, layer->output_length*sizeof(int32_t));
+    offset = container_align(offset + layer->output_length*sizeof(int32_t));
+  }
+
+  if (label_cnt) {
+    if (label_cnt != header->label_cnt) {
+      import_fail("%d labels for %d outputs", label_cnt, header->label_cnt);
+    }
+    header->labels_offset = offset;
+    for (uint8_t ndx=0;ndx<label_cnt;ndx++) {
+      uint32_t length = strlen(labels[ndx])+1;
+      if (offset+length > capacity) {
+        import_fail("labels exceed %d bytes", IMPORT_MAX_LABEL_BYTES);
+      }
+      memcpy(container+offset, labels[ndx], length);
+      offset += length;
+    }
+    offset = container_align(offset);
+  }
+
+  AxonModelContainerFinalize(container, offset);
+  if ((NULL==(file = fopen(path, "wb"))) || (offset != fwrite(container, 1, offset, file))) {
+    import_fail("can't write %s", path);
+  }
+  fclose(file);
+  printf("wrote %s, %u bytes, crc32 0x%08x\n", path, offset, header->crc32);
+  free(container);
+}
+
+static uint8_t import_read_labels(const char *path, char labels[][64], uint8_t max_labels) {
+  FILE *file = fopen(path, "r");
+  uint8_t cnt = 0;
+  char line[256];
+  if (NULL==file) {
+    import_fail("can't read %s", path);
+  }
+  while ((cnt < max_labels) && (NULL != fgets(line, sizeof(line), file))) {
+    line[strcspn(line, "\r\n")] = 0;
+    if (0==line[0]) {
+      continue;
+    }
+    snprintf(labels[cnt++], 64, "%.63s", line);
+  }
+  fclose(file);
+  return cnt;
+}
+
+static void usage(void) {
+  fprintf(stderr,
+      "usage: axon_tflite_import model.tflite [-o const.h] [-b container.bin] [-p PREFIX] [-l labels.txt]\n"
+      "           [-v mel32|mfcc|mfcc_energy|mfcc_fft] [-w slices] [-h features] [-n vectors] [-s seed]\n");
+  exit(2);
+}
+
+int main(int argc, char **argv) {
+  const char *model_path = NULL, *header_path = NULL, *container_path = NULL, *labels_path = NULL;
+  const char *prefix = "TFLITE";
+  static const char *variant_options[] = {"mel32", "mfcc", "mfcc_energy", "mfcc_fft"};
+  uint8_t variant = kAxonAudioFeatureMfccOrtho;
+  int slice_cnt = 0, feature_cnt = 0;
+  uint32_t vector_cnt = 1000;
+  unsigned seed = 1;
+  static char labels[255][64];
+  uint8_t label_cnt = 0;
+  uint8_t *buffer;
+  long length;
+  FILE *file;
+
+  for (int ndx=1;ndx<argc;ndx++) {
+    if ('-' != argv[ndx][0]) {
+      model_path = argv[ndx];
+      continue;
+    }
+    if ((ndx+1 >= argc) || (0 != argv[ndx][2])) {
+      usage();
+    }
+    const char *value = argv[++ndx];
+    switch (argv[ndx-1][1]) {
+    case 'o': header_path = value; break;
+    case 'b': container_path = value; break;
+    case 'p': prefix = value; break;
+    case 'l': labels_path = value; break;
+    case 'w': slice_cnt = atoi(value); break;
+    case 'h': feature_cnt = atoi(value); break;
+    case 'n': vector_cnt = strtoul(value, NULL, 0); break;
+    case 's': seed = strtoul(value, NULL, 0); break;
+    case 'v':
+      for (variant=0;variant<sizeof(variant_options)/sizeof(variant_options[0]);variant++) {
+        if (0==strcmp(value, variant_options[variant])) {
+          break;
+        }
+      }
+      if (variant >= sizeof(variant_options)/sizeof(variant_options[0])) {
+        usage();
+      }
+      break;
+    default:
+      usage();
+    }
+  }
+  if ((NULL==model_path) || (strlen(prefix) >= 63)) {
+    usage();
+  }
+
+  if (NULL==(file = fopen(model_path, "rb"))) {
+    import_fail("can't read %s", model_path);
+  }
+  fseek(file, 0, SEEK_END);
+  length = ftell(file);
+  fseek(file, 0, SEEK_SET);
+  buffer = malloc(length);
+  if ((length <= 0) || (length != (long)fread(buffer, 1, length, file))) {
+    import_fail("can't read %s", model_path);
+  }
+  fclose(file);
+  import_model(buffer, length);
+
+  /*
+   * the window shape comes from the model input unless given
+   */
+  ImportTensorStruct input;
+  uint32_t input_cnt;
+  const uint8_t *model_inputs = fb_vector(model.subgraph, 1, 4, &input_cnt);
+  if (0==input_cnt) {
+    import_fail("model has no inputs");
+  }
+  tflite_get_tensor((int32_t)fb_u32(model_inputs), &input);
+  if ((0==slice_cnt) && (input.dim_cnt >= 3)) {
+    slice_cnt = input.dims[1];
+  }
+  if ((0==feature_cnt) && (input.dim_cnt >= 3)) {
+    feature_cnt = input.dims[2];
+  }
+  if (kAxonModelLayerLstmCell==import_layers[0].layer_type) {
+    feature_cnt = import_layers[0].input_length-import_layers[0].hidden_length;
+  }
+  if ((slice_cnt <= 0) || (feature_cnt <= 0) || (slice_cnt > 255) || (feature_cnt > 255) ||
+      ((kAxonModelLayerFullyConnected==import_layers[0].layer_type) && (slice_cnt*feature_cnt != import_layers[0].input_length))) {
+    import_fail("window shape %d x %d doesn't fit the model's %d inputs; use -w/-h", slice_cnt, feature_cnt, import_layers[0].input_length);
+  }
+
+  /*
+   * Feature quantization: features are q11.12, quantized as (feature*inv_scale)>>(shift+12) + zero point.
+   * Taken from the first layer's input, which is int8 even if the model input is float.
+   */
+  int32_t input_inv_scale;
+  uint8_t input_inv_scale_shift;
+  double input_scale = import_layers[0].input_scale;
+  int32_t input_zero_point = import_layers[0].input_zero_point;
+  import_quantize_scale("input", 1.0/input_scale, IMPORT_INPUT_INV_SCALE_BITS, IMPORT_MAX_ROUNDING-IMPORT_INPUT_FRACTION_BITS,
+      &input_inv_scale, &input_inv_scale_shift);
+
+  if (NULL != labels_path) {
+    label_cnt = import_read_labels(labels_path, labels, sizeof(labels)/sizeof(labels[0]));
+  }
+
+  printf("%s: %d layers, window %d x %d, input scale %g zero point %d\n", model_path, import_layer_cnt, slice_cnt, feature_cnt,
+      input_scale, input_zero_point);
+  for (uint8_t layer_ndx=0;layer_ndx<import_layer_cnt;layer_ndx++) {
+    const ImportLayerStruct *layer = import_layers+layer_ndx;
+    printf("  layer %d %s %d -> %d, %s, bias mult %d >> %d, quantize mult %d >> %d, add %d\n", layer_ndx+1,
+        kAxonModelLayerLstmCell==layer->layer_type ? "lstm" : "fully connected", layer->input_length, layer->output_length,
+        af_name(layer->activation_function), layer->bias_add_multiplier, layer->bias_add_rounding,
+        layer->quantize_multiplier, layer->quantize_rounding, layer->standalone_quantize_add);
+    if ((kAxonModelLayerLstmCell==layer->layer_type) && (0 != layer->output_zero_point)) {
+      printf("    warning: hidden state zero point %d; the lstm libraries reset the hidden state to 0, not to the zero point\n",
+          layer->output_zero_point);
+    }
+  }
+
+  srand(seed);
+  import_report(vector_cnt, slice_cnt);
+
+  if (NULL != header_path) {
+    import_write_header(header_path, prefix, variant, slice_cnt, feature_cnt, input_inv_scale, input_inv_scale_shift,
+        input_zero_point, labels, label_cnt);
+    printf("wrote %s\n", header_path);
+  }
+  if (NULL != container_path) {
+    import_write_container(container_path, variant, slice_cnt, feature_cnt, input_inv_scale, input_inv_scale_shift,
+        input_zero_point, labels, label_cnt);
+  }
+  return 0;
+}
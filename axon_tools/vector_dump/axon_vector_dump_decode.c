@@ -0,0 +1,227 @@
+/**
+ *          Copyright (c) 2020-2022, Atlazo Inc.
+ *          All rights reserved.
+ *
+ *          Licensed under the Apache License, Version 2.0 (the "License");
+ *          you may not use this file except in compliance with the License.
+ *          You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *          Unless required by applicable law or agreed to in writing, software
+ *          distributed under the License is distributed on an "AS IS" BASIS,
+ *          WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *          See the License for the specific language governing permissions and
+ *          limitations under the License.
+ *
+ */
+/*
+ * Host tool: extracts binary vector dumps (dump_vector() in axon_logging_api.h, or the print_*_vector()
+ * functions built with AXON_LOGGING_BINARY_DUMP=1) from a capture of the debug port.
+ *
+ * Each dump with a good crc is written to <out_dir>/<tag>.csv as "index,value" lines, plus a 3rd column of
+ * value/2^q when it has fraction bits. With -r the elements are also written as they were sent (little
+ * endian) to <tag>.bin. A tag that repeats gets _1, _2... appended. Everything that isn't a dump, including
+ * deferred log records, is copied to stdout, so the output can be piped on to axon_tools/deferred_log.
+ * Dumps that fail the crc are reported and dropped.
+ *
+ * Build (from this directory):
+ *   gcc -O2 -o axon_vector_dump_decode axon_vector_dump_decode.c ../../axon_utils/src/axon_crc32.c \
+ *       -I ../../axon_utils/api -I ../../axon_driver_lib/api
+ *
+ * Usage:
+ *   axon_vector_dump_decode [-o out_dir] [-r] [capture.bin]
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "axon_crc32_api.h"
+#include "axon_logging_api.h"
+
+#define DECODE_MAX_TAGS 1024
+
+static struct {
+  const char *out_dir;
+  uint8_t raw;
+  char *tags[DECODE_MAX_TAGS];  // tags seen so far, to number repeats
+  uint32_t tag_counts[DECODE_MAX_TAGS];
+  uint32_t tag_cnt;
+  uint32_t dump_cnt;
+  uint32_t bad_crc_cnt;
+} decode_info;
+
+static uint32_t decode_le32(const uint8_t *bytes) {
+  return bytes[0] | bytes[1]<<8 | bytes[2]<<16 | (uint32_t)bytes[3]<<24;
+}
+
+static int32_t decode_element(const uint8_t *bytes, AxonLoggingDumpTypeEnum type) {
+  switch (type) {
+  case kAxonLoggingDumpInt8: return (int8_t)bytes[0];
+  case kAxonLoggingDumpInt16: return (int16_t)(bytes[0] | bytes[1]<<8);
+  default: return (int32_t)decode_le32(bytes);
+  }
+}
+
+/*
+ * <out_dir>/<tag>[_n], w/ anything that doesn't belong in a file name replaced.
+ */
+static void decode_file_base(char *path, size_t path_size, const uint8_t *tag, uint8_t tag_len) {
+  char name[256];
+  uint32_t ndx;
+
+  for (ndx=0;ndx<tag_len;ndx++) {
+    char c = tag[ndx];
+    name[ndx] = (('a'<=c) && (c<='z')) || (('A'<=c) && (c<='Z')) || (('0'<=c) && (c<='9')) || ('-'==c) || ('.'==c) ? c : '_';
+  }
+  name[tag_len] = 0;
+  if (0==tag_len) {
+    strcpy(name, "untagged");
+  }
+
+  for (ndx=0;(ndx<decode_info.tag_cnt) && (0!=strcmp(decode_info.tags[ndx], name));ndx++) {
+  }
+  if (ndx==decode_info.tag_cnt) {
+    if (DECODE_MAX_TAGS==ndx) {
+      fprintf(stderr, "too many different tags\n");
+      exit(1);
+    }
+    decode_info.tags[ndx] = strdup(name);
+    decode_info.tag_cnt++;
+  }
+  if (decode_info.tag_counts[ndx]++) {
+    snprintf(path, path_size, "%s/%s_%u", decode_info.out_dir, name, decode_info.tag_counts[ndx]-1);
+  } else {
+    snprintf(path, path_size, "%s/%s", decode_info.out_dir, name);
+  }
+}
+
+static void decode_write_dump(const uint8_t *frame) {
+  AxonLoggingDumpTypeEnum type = (AxonLoggingDumpTypeEnum)frame[1];
+  uint8_t q = frame[2];
+  uint8_t tag_len = frame[3];
+  uint32_t count = decode_le32(&frame[4]);
+  uint8_t element_size = AXON_LOGGING_DUMP_ELEMENT_SIZE(type);
+  const uint8_t *elements = frame+AXON_LOGGING_DUMP_HEADER_SIZE+tag_len;
+  char base[512];
+  char path[600];
+  FILE *file;
+
+  decode_file_base(base, sizeof(base), frame+AXON_LOGGING_DUMP_HEADER_SIZE, tag_len);
+  snprintf(path, sizeof(path), "%s.csv", base);
+  if (NULL==(file=fopen(path, "w"))) {
+    perror(path);
+    exit(1);
+  }
+  fprintf(file, q ? "index,value,value/2^%u\n" : "index,value\n", q);
+  for (uint32_t ndx=0;ndx<count;ndx++) {
+    if (kAxonLoggingDumpFloat==type) {
+      float value;
+      memcpy(&value, elements+4*ndx, sizeof(value));
+      fprintf(file, "%u,%.9g\n", ndx, value);
+    } else if (q) {
+      int32_t value = decode_element(elements+element_size*ndx, type);
+      fprintf(file, "%u,%d,%.9g\n", ndx, value, (double)value/((uint64_t)1<<q));
+    } else {
+      fprintf(file, "%u,%d\n", ndx, decode_element(elements+element_size*ndx, type));
+    }
+  }
+  fclose(file);
+
+  if (decode_info.raw) {
+    snprintf(path, sizeof(path), "%s.bin", base);
+    if (NULL==(file=fopen(path, "wb"))) {
+      perror(path);
+      exit(1);
+    }
+    fwrite(elements, element_size, count, file);
+    fclose(file);
+  }
+  fprintf(stderr, "%s: %u x %s%u q%u\n", base, count, kAxonLoggingDumpFloat==type ? "float" : "int",
+      8*element_size, q);
+  decode_info.dump_cnt++;
+}
+
+/*
+ * Returns the size of the dump at bytes, or 0 if there isn't a complete one there.
+ */
+static uint32_t decode_dump_size(const uint8_t *bytes, size_t byte_cnt) {
+  uint32_t size;
+
+  if (byte_cnt < AXON_LOGGING_DUMP_HEADER_SIZE) {
+    return 0;
+  }
+  switch (bytes[1]) {
+  case kAxonLoggingDumpInt8:
+  case kAxonLoggingDumpInt16:
+  case kAxonLoggingDumpInt32:
+  case kAxonLoggingDumpFloat:
+    break;
+  default:
+    return 0;
+  }
+  if ((uint64_t)decode_le32(&bytes[4])*AXON_LOGGING_DUMP_ELEMENT_SIZE(bytes[1]) > byte_cnt) {
+    return 0;
+  }
+  size = AXON_LOGGING_DUMP_HEADER_SIZE+bytes[3]+decode_le32(&bytes[4])*AXON_LOGGING_DUMP_ELEMENT_SIZE(bytes[1]);
+  if (size+4 > byte_cnt) {
+    return 0;
+  }
+  if (AxonCrc32(0, bytes+1, size-1) != decode_le32(bytes+size)) {
+    decode_info.bad_crc_cnt++;
+    fprintf(stderr, "dump %.*s failed its crc, dropped\n", bytes[3], bytes+AXON_LOGGING_DUMP_HEADER_SIZE);
+    return 0;
+  }
+  return size+4;
+}
+
+static void usage(void) {
+  fprintf(stderr, "usage: axon_vector_dump_decode [-o out_dir] [-r] [capture.bin]\n");
+  exit(2);
+}
+
+int main(int argc, char **argv) {
+  FILE *file = stdin;
+  uint8_t *capture = NULL;
+  size_t capture_size = 0;
+  size_t read_cnt;
+  size_t ndx;
+  uint32_t dump_size;
+  int arg;
+
+  decode_info.out_dir = ".";
+  for (arg=1;(arg<argc) && ('-'==argv[arg][0]);arg++) {
+    if (0==strcmp(argv[arg], "-r")) {
+      decode_info.raw = 1;
+    } else if ((0==strcmp(argv[arg], "-o")) && (arg+1 < argc)) {
+      decode_info.out_dir = argv[++arg];
+    } else {
+      usage();
+    }
+  }
+  if (arg+1 < argc) {
+    usage();
+  }
+  if ((arg < argc) && (NULL==(file=fopen(argv[arg], "rb")))) {
+    perror(argv[arg]);
+    return 1;
+  }
+
+  // the whole capture, so a dump that fails can be passed through and scanned past.
+  do {
+    capture = realloc(capture, capture_size+65536);
+    read_cnt = fread(capture+capture_size, 1, 65536, file);
+    capture_size += read_cnt;
+  } while (read_cnt);
+
+  for (ndx=0;ndx<capture_size;) {
+    if ((AXON_LOGGING_DUMP_MARKER==capture[ndx]) && (0 != (dump_size=decode_dump_size(capture+ndx, capture_size-ndx)))) {
+      decode_write_dump(capture+ndx);
+      ndx += dump_size;
+    } else {
+      putchar(capture[ndx++]);
+    }
+  }
+  fprintf(stderr, "%u dumps, %u failed the crc\n", decode_info.dump_cnt, decode_info.bad_crc_cnt);
+  return decode_info.bad_crc_cnt ? 1 : 0;
+}
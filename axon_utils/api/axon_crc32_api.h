@@ -0,0 +1,35 @@
+/**
+ *          Copyright (c) 2020-2022, Atlazo Inc.
+ *          All rights reserved.
+ *
+ *          Licensed under the Apache License, Version 2.0 (the "License");
+ *          you may not use this file except in compliance with the License.
+ *          You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *          Unless required by applicable law or agreed to in writing, software
+ *          distributed under the License is distributed on an "AS IS" BASIS,
+ *          WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *          See the License for the specific language governing permissions and
+ *          limitations under the License.
+ *
+ */
+#pragma once
+#include <stdint.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*
+ * CRC-32 (IEEE 802.3, reflected, as zlib). Pass 0 as crc to start, or the previous result to continue
+ * over more data.
+ * Used by the model container checksum and the binary vector dumps. axon_crc32.c has no platform
+ * dependencies so host tools can build it too.
+ */
+uint32_t AxonCrc32(uint32_t crc, const void *data, uint32_t length);
+
+#if defined(__cplusplus)
+}
+#endif
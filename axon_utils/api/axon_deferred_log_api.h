@@ -0,0 +1,94 @@
+/**
+ *          Copyright (c) 2020-2022, Atlazo Inc.
+ *          All rights reserved.
+ *
+ *          Licensed under the Apache License, Version 2.0 (the "License");
+ *          you may not use this file except in compliance with the License.
+ *          You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *          Unless required by applicable law or agreed to in writing, software
+ *          distributed under the License is distributed on an "AS IS" BASIS,
+ *          WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *          See the License for the specific language governing permissions and
+ *          limitations under the License.
+ *
+ */
+#pragma once
+#include <stdint.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*
+ * Deferred logging.
+ * AxonDeferredLog() stores a format id, a timestamp and up to AXON_DEFERRED_LOG_MAX_ARG_CNT integer arguments
+ * in a ring and returns; nothing is formatted or printed. It is safe from interrupts and never waits. When the
+ * ring is full the record is dropped and counted.
+ * AxonDeferredLogDrain() empties the ring from idle time (the main loop or the RTOS sleep task). With
+ * AXON_DEFERRED_LOG_BINARY=1 it writes each record in binary through AxonHostLogWrite() and
+ * axon_tools/deferred_log renders them on the host. Otherwise it formats them on the target and prints them
+ * with AxonHostLog(), which still keeps the printing out of the code being timed.
+ * AXON_DEFERRED_LOG_RECORD_CNT=0 compiles it all out.
+ */
+#ifndef AXON_DEFERRED_LOG_RECORD_CNT
+#  define AXON_DEFERRED_LOG_RECORD_CNT (32) // power of 2
+#endif
+#ifndef AXON_DEFERRED_LOG_BINARY
+#  ifdef BLE_SDK
+#    define AXON_DEFERRED_LOG_BINARY 0 // the ml_ble_platform only provides AxonHostLog()
+#  else
+#    define AXON_DEFERRED_LOG_BINARY 1
+#  endif
+#endif
+#define AXON_DEFERRED_LOG_MAX_ARG_CNT (4)
+
+/*
+ * Binary record, little endian:
+ *   AXON_DEFERRED_LOG_RECORD_MARKER, arg_cnt (1 byte), format id (2 bytes), AxonHostGetTime() (4 bytes),
+ *   arg_cnt 4 byte arguments.
+ * Text printed on the same port passes through the decoder untouched, the marker can't appear in it.
+ */
+#define AXON_DEFERRED_LOG_RECORD_MARKER (0x1e) // ascii record separator
+#define AXON_DEFERRED_LOG_HEADER_SIZE (8)
+
+typedef enum {
+#define AXON_DEFERRED_LOG_FORMAT(id, arg_cnt, format) id,
+#include "axon_deferred_log_formats.h"
+#undef AXON_DEFERRED_LOG_FORMAT
+  kAxonDeferredLogFormatCount,
+} AxonDeferredLogFormatEnum;
+
+#if AXON_DEFERRED_LOG_RECORD_CNT
+/*
+ * Logs format with the argument count listed for it in axon_deferred_log_formats.h, as int32_t.
+ */
+void AxonDeferredLog(AxonDeferredLogFormatEnum format, ...);
+
+/*
+ * Writes or prints everything in the ring, plus a kAxonDeferredLogDropped record if any were dropped since
+ * the last drain. Call with interrupts enabled.
+ */
+void AxonDeferredLogDrain();
+
+/*
+ * Total records dropped because the ring was full.
+ */
+uint32_t AxonDeferredLogDroppedCnt();
+#else
+#  define AxonDeferredLog(...)
+#  define AxonDeferredLogDrain()
+#  define AxonDeferredLogDroppedCnt() (0)
+#endif
+
+/*
+ * Implemented by host when AXON_DEFERRED_LOG_BINARY=1 or AXON_LOGGING_DUMP_VECTOR=1 (axon_logging_api.h),
+ * writes raw bytes to the debug port.
+ */
+void AxonHostLogWrite(const uint8_t *bytes, uint32_t byte_cnt);
+
+#if defined(__cplusplus)
+}
+#endif
@@ -0,0 +1,28 @@
+/**
+ *          Copyright (c) 2020-2022, Atlazo Inc.
+ *          All rights reserved.
+ *
+ *          Licensed under the Apache License, Version 2.0 (the "License");
+ *          you may not use this file except in compliance with the License.
+ *          You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *          Unless required by applicable law or agreed to in writing, software
+ *          distributed under the License is distributed on an "AS IS" BASIS,
+ *          WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *          See the License for the specific language governing permissions and
+ *          limitations under the License.
+ *
+ */
+/*
+ * Deferred log formats, AXON_DEFERRED_LOG_FORMAT(id, arg_cnt, format string).
+ * A record only carries the id, so the firmware and axon_tools/deferred_log have to be built from the same
+ * list. Add new formats at the end, and only use integer conversions (%d, %u, %x...) on 32 bit arguments.
+ * No include guard, it is expanded once per use.
+ */
+AXON_DEFERRED_LOG_FORMAT(kAxonDeferredLogDropped, 1, "(%u deferred log records dropped)\r\n")
+AXON_DEFERRED_LOG_FORMAT(kAxonDeferredLogTriggered, 1, "triggered %d\r\n")
+AXON_DEFERRED_LOG_FORMAT(kAxonDeferredLogExpired, 1, "expired %d\r\n")
+AXON_DEFERRED_LOG_FORMAT(kAxonDeferredLogPrerollOverrun, 1, "pre-roll overrun %d\r\n")
+AXON_DEFERRED_LOG_FORMAT(kAxonDeferredLogRxOverruns, 2, "rx overruns %d, rx watchdog fired %d\r\n")
@@ -0,0 +1,141 @@
+/**
+ *          Copyright (c) 2020-2022, Atlazo Inc.
+ *          All rights reserved.
+ *
+ *          Licensed under the Apache License, Version 2.0 (the "License");
+ *          you may not use this file except in compliance with the License.
+ *          You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *          Unless required by applicable law or agreed to in writing, software
+ *          distributed under the License is distributed on an "AS IS" BASIS,
+ *          WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *          See the License for the specific language governing permissions and
+ *          limitations under the License.
+ *
+ */
+#pragma once
+#include <stdint.h>
+#include "axon_api.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*
+ * KWS pipeline performance counters.
+ * The feature and model libraries, the KWS state machine and the host count into one set of counters
+ * that accumulate across sessions (unlike the per session times AxonKwsPrintStats() prints) until
+ * AxonKwsStatsReset(). AxonKwsStatsGet() can be called at any time, from any context, so a soak test can
+ * watch them without parsing the log.
+ * Updates are short and interrupt safe. elapsed_ticks is kept up to date by the updates and by
+ * AxonKwsStatsGet(), so one of them has to happen at least once per AxonHostGetTime() wrap.
+ * AXON_KWS_STATS=0 compiles the updates out. AxonKwsStatsGet() then returns zero counts and stages, but
+ * elapsed_ticks still advances with each call.
+ */
+#ifndef AXON_KWS_STATS
+#  define AXON_KWS_STATS (1)
+#endif
+
+typedef enum {
+  kAxonKwsStatsFramesProcessed, /**< audio frames AxonKwsProcessFrame() accepted */
+  kAxonKwsStatsFramesDropped,   /**< frames the host lost because the pipeline was busy or its queue was full */
+  kAxonKwsStatsAudioOverruns,   /**< half frames of audio the host lost before they were processed */
+  kAxonKwsStatsOpListsIssued,   /**< op lists the driver accepted to queue or execute */
+  kAxonKwsStatsOpsIssued,       /**< ops in those lists */
+  kAxonKwsStatsInterrupts,      /**< Axon interrupts taken */
+  kAxonKwsStatsVadWindows,      /**< valid windows the VAD (bg/fg) found, each starts a classification */
+  kAxonKwsStatsClassifications, /**< final classifications completed */
+  kAxonKwsStatsCountCount,
+} AxonKwsStatsCountEnum;
+
+typedef enum {
+  kAxonKwsStatsStageFeatures,   /**< one frame's audio features, including the VAD */
+  kAxonKwsStatsStageModel,      /**< full model inference, once per window that gets one */
+  kAxonKwsStatsStageCount,
+} AxonKwsStatsStageEnum;
+
+typedef struct {
+  uint32_t count;
+  uint32_t min_ticks;           /**< AxonHostGetTime() ticks, 0 if count is 0 */
+  uint32_t avg_ticks;
+  uint32_t max_ticks;
+  uint64_t total_ticks;
+} AxonKwsStatsStageStruct;
+
+typedef struct {
+  uint32_t counts[kAxonKwsStatsCountCount]; /**< indexed by AxonKwsStatsCountEnum */
+  AxonKwsStatsStageStruct stages[kAxonKwsStatsStageCount];
+  uint64_t elapsed_ticks;                   /**< since the last reset (or power up) */
+  uint32_t vad_windows_per_1000_frames;
+  /*
+   * share of elapsed_ticks spent in the stages. The stages time the whole pipeline step, both the Axon op
+   * lists and the CPU work around them, so this is not Axon utilization, only an upper bound on it.
+   */
+  uint8_t pipeline_busy_percent;
+  /*
+   * time Axon had work, measured by AXON_KWS_STATS_QUEUE_OPS_LIST() and AXON_KWS_STATS_EXECUTE_OPS(): from
+   * the first op list queued until the completion callback of the last one, and for the whole of a
+   * synchronous AxonApiExecuteOps(). Includes the driver's interrupt handling between queued lists.
+   */
+  uint64_t axon_busy_ticks;
+  uint8_t axon_busy_percent;                /**< share of elapsed_ticks */
+} AxonKwsStatsStruct;
+
+/*
+ * Copies the counters to stats.
+ */
+void AxonKwsStatsGet(AxonKwsStatsStruct *stats);
+
+/*
+ * Zeroes the counters and restarts elapsed_ticks.
+ */
+void AxonKwsStatsReset();
+
+#if AXON_KWS_STATS
+/*
+ * Adds cnt to a counter.
+ */
+void AxonKwsStatsCount(AxonKwsStatsCountEnum counter, uint32_t cnt);
+
+/*
+ * Records one run of a stage that took ticks.
+ */
+void AxonKwsStatsStage(AxonKwsStatsStageEnum stage, uint32_t ticks);
+
+/*
+ * AxonApiQueueOpsList() and AxonApiExecuteOps() that count the ops and time Axon, use the macros below.
+ */
+AxonResultEnum AxonKwsStatsQueueOpsList(void *axon_handle, AxonMgrQueuedOpsStruct *ops_info);
+AxonResultEnum AxonKwsStatsExecuteOps(void *axon_handle, uint32_t op_count, AxonOpHandle ops[], AxonAsyncModeEnum async_mode);
+#  define AXON_KWS_STATS_COUNT(counter, cnt) AxonKwsStatsCount((counter), (cnt))
+#  define AXON_KWS_STATS_STAGE(stage, ticks) AxonKwsStatsStage((stage), (ticks))
+#else
+#  define AXON_KWS_STATS_COUNT(counter, cnt)
+#  define AXON_KWS_STATS_STAGE(stage, ticks)
+#endif
+
+/*
+ * Drop-in replacements for AxonApiQueueOpsList() and AxonApiExecuteOps(). Op lists the driver accepts are
+ * counted and Axon is timed until they complete (see axon_busy_ticks). A queued list's callback is
+ * temporarily replaced with one that stops the clock, then calls it; up to AXON_KWS_STATS_QUEUED_LIST_CNT
+ * lists can be timed at once. An asynchronous AxonApiExecuteOps() completes through
+ * AxonHostInterruptNotification() instead, so it is counted but not timed (nothing here uses one).
+ */
+#if AXON_KWS_STATS
+#  define AXON_KWS_STATS_QUEUE_OPS_LIST(axon_handle, ops_info) AxonKwsStatsQueueOpsList((axon_handle), (ops_info))
+#  define AXON_KWS_STATS_EXECUTE_OPS(axon_handle, op_count, ops, async_mode) \
+  AxonKwsStatsExecuteOps((axon_handle), (op_count), (ops), (async_mode))
+#else
+#  define AXON_KWS_STATS_QUEUE_OPS_LIST(axon_handle, ops_info) AxonApiQueueOpsList((axon_handle), (ops_info))
+#  define AXON_KWS_STATS_EXECUTE_OPS(axon_handle, op_count, ops, async_mode) \
+  AxonApiExecuteOps((axon_handle), (op_count), (ops), (async_mode))
+#endif
+#ifndef AXON_KWS_STATS_QUEUED_LIST_CNT
+#  define AXON_KWS_STATS_QUEUED_LIST_CNT (8)
+#endif
+
+#if defined(__cplusplus)
+}
+#endif
@@ -37,3 +37,50 @@ void print_int8_vector(void *axon_handle, char *name, int8_t *vector_ptr, uint32
 void PrintVector(void *axon_handle, char *name, uint8_t *vector_ptr, uint32_t count, uint8_t element_size);
 void axon_printf(void *axon_handle, char *fmt_string, ...);
 
+/*
+ * Binary vector dumps.
+ * dump_vector() sends a vector out the debug port as one frame through AxonHostLogWrite() instead of as
+ * decimal text, and axon_tools/vector_dump turns the frames back into csv or raw files on the host.
+ * With AXON_LOGGING_BINARY_DUMP=1 the print_*_vector() functions above (and PrintVector()) send dumps too,
+ * with a q of 0, so existing debug vector code gets them without changes. axon_demo_lib's verify_vectors*()
+ * dump the output and expected vectors on a mismatch instead of printing each mismatched element.
+ *
+ * Frame, little endian:
+ *   AXON_LOGGING_DUMP_MARKER, type (AxonLoggingDumpTypeEnum), q (fraction bits), tag length,
+ *   element count (4 bytes), tag, elements (stride removed), crc32 of everything after the marker up to
+ *   here (4 bytes, AxonCrc32()).
+ * AXON_LOGGING_DUMP_VECTOR=0 leaves dump_vector() out, for hosts without AxonHostLogWrite().
+ */
+#ifndef AXON_LOGGING_DUMP_VECTOR
+#  ifdef BLE_SDK
+#    define AXON_LOGGING_DUMP_VECTOR 0 // the ml_ble_platform only provides AxonHostLog()
+#  else
+#    define AXON_LOGGING_DUMP_VECTOR 1
+#  endif
+#endif
+#ifndef AXON_LOGGING_BINARY_DUMP
+#  define AXON_LOGGING_BINARY_DUMP 0
+#endif
+#if AXON_LOGGING_BINARY_DUMP && !AXON_LOGGING_DUMP_VECTOR
+#  error "AXON_LOGGING_BINARY_DUMP needs AXON_LOGGING_DUMP_VECTOR"
+#endif
+#define AXON_LOGGING_DUMP_MARKER (0x1c) // ascii file separator
+#define AXON_LOGGING_DUMP_HEADER_SIZE (8)
+
+typedef enum {
+  kAxonLoggingDumpInt8 = 0x01,
+  kAxonLoggingDumpInt16 = 0x02,
+  kAxonLoggingDumpInt32 = 0x04,
+  kAxonLoggingDumpFloat = 0x14,
+} AxonLoggingDumpTypeEnum;
+#define AXON_LOGGING_DUMP_ELEMENT_SIZE(type) ((type) & 0x0f)
+
+#if AXON_LOGGING_DUMP_VECTOR
+/*
+ * Dumps count elements of type, stride elements apart, starting at start_index and wrapping back to the
+ * start of the vector (as print_int16_circ_buffer()). tag is truncated to 255 characters.
+ */
+void dump_vector(void *axon_handle, const char *tag, const void *vector_ptr, AxonLoggingDumpTypeEnum type, uint8_t q,
+    uint32_t count, uint8_t stride, uint32_t start_index);
+#endif
+
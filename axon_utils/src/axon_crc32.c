@@ -0,0 +1,31 @@
+/**
+ *          Copyright (c) 2020-2022, Atlazo Inc.
+ *          All rights reserved.
+ *
+ *          Licensed under the Apache License, Version 2.0 (the "License");
+ *          you may not use this file except in compliance with the License.
+ *          You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *          Unless required by applicable law or agreed to in writing, software
+ *          distributed under the License is distributed on an "AS IS" BASIS,
+ *          WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *          See the License for the specific language governing permissions and
+ *          limitations under the License.
+ *
+ */
+#include <stdint.h>
+#include "axon_crc32_api.h"
+
+uint32_t AxonCrc32(uint32_t crc, const void *data, uint32_t length) {
+  const uint8_t *bytes = (const uint8_t *)data;
+  crc = ~crc;
+  while (length--) {
+    crc ^= *bytes++;
+    for (uint8_t bit=0;bit<8;bit++) {
+      crc = (crc >> 1) ^ (0xEDB88320 & (0-(crc & 1)));
+    }
+  }
+  return ~crc;
+}
@@ -0,0 +1,150 @@
+/**
+ *          Copyright (c) 2020-2022, Atlazo Inc.
+ *          All rights reserved.
+ *
+ *          Licensed under the Apache License, Version 2.0 (the "License");
+ *          you may not use this file except in compliance with the License.
+ *          You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *          Unless required by applicable law or agreed to in writing, software
+ *          distributed under the License is distributed on an "AS IS" BASIS,
+ *          WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *          See the License for the specific language governing permissions and
+ *          limitations under the License.
+ *
+ */
+#include <stdint.h>
+#include <stdarg.h>
+#include <stdio.h>
+
+#include "axon_api.h"
+#include "axon_dep.h"
+#include "axon_deferred_log_api.h"
+
+#if AXON_DEFERRED_LOG_RECORD_CNT
+
+#if AXON_DEFERRED_LOG_RECORD_CNT & (AXON_DEFERRED_LOG_RECORD_CNT-1)
+#  error "AXON_DEFERRED_LOG_RECORD_CNT has to be a power of 2"
+#endif
+
+typedef struct {
+  uint32_t timestamp;
+  uint16_t format;
+  uint8_t arg_cnt;
+  int32_t args[AXON_DEFERRED_LOG_MAX_ARG_CNT];
+} AxonDeferredLogRecordStruct;
+
+static const uint8_t axon_deferred_log_arg_cnts[kAxonDeferredLogFormatCount] = {
+#define AXON_DEFERRED_LOG_FORMAT(id, arg_cnt, format) arg_cnt,
+#include "axon_deferred_log_formats.h"
+#undef AXON_DEFERRED_LOG_FORMAT
+};
+
+#if !AXON_DEFERRED_LOG_BINARY
+static const char *const axon_deferred_log_formats[kAxonDeferredLogFormatCount] = {
+#define AXON_DEFERRED_LOG_FORMAT(id, arg_cnt, format) format,
+#include "axon_deferred_log_formats.h"
+#undef AXON_DEFERRED_LOG_FORMAT
+};
+#endif
+
+/*
+ * head and dropped_cnt are only written w/ interrupts disabled, tail only by the drain.
+ */
+static struct {
+  AxonDeferredLogRecordStruct records[AXON_DEFERRED_LOG_RECORD_CNT];
+  volatile uint32_t head;        // records written
+  volatile uint32_t tail;        // records drained
+  volatile uint32_t dropped_cnt;
+  uint32_t reported_dropped_cnt;
+} axon_deferred_log_info;
+
+void AxonDeferredLog(AxonDeferredLogFormatEnum format, ...) {
+  AxonDeferredLogRecordStruct *record;
+  va_list arg_list;
+  uint32_t interrupt_state;
+
+  if (format >= kAxonDeferredLogFormatCount) {
+    return;
+  }
+  /*
+   * the slot is filled inside the critical section so the drain never sees a half written record.
+   * It is a fixed, short copy.
+   */
+  interrupt_state = AxonHostDisableInterrupts();
+  if (AXON_DEFERRED_LOG_RECORD_CNT <= axon_deferred_log_info.head-axon_deferred_log_info.tail) {
+    axon_deferred_log_info.dropped_cnt++;
+    AxonHostRestoreInterrupts(interrupt_state);
+    return;
+  }
+  record = &axon_deferred_log_info.records[axon_deferred_log_info.head & (AXON_DEFERRED_LOG_RECORD_CNT-1)];
+  record->timestamp = AxonHostGetTime();
+  record->format = format;
+  record->arg_cnt = axon_deferred_log_arg_cnts[format];
+  va_start(arg_list, format);
+  for (uint8_t ndx=0;ndx<record->arg_cnt;ndx++) {
+    record->args[ndx] = va_arg(arg_list, int32_t);
+  }
+  va_end(arg_list);
+  axon_deferred_log_info.head++;
+  AxonHostRestoreInterrupts(interrupt_state);
+}
+
+/*
+ * writes or prints one record.
+ */
+static void axon_deferred_log_output(const AxonDeferredLogRecordStruct *record) {
+#if AXON_DEFERRED_LOG_BINARY
+  uint8_t bytes[AXON_DEFERRED_LOG_HEADER_SIZE+4*AXON_DEFERRED_LOG_MAX_ARG_CNT];
+  uint32_t byte_cnt = 0;
+
+  bytes[byte_cnt++] = AXON_DEFERRED_LOG_RECORD_MARKER;
+  bytes[byte_cnt++] = record->arg_cnt;
+  bytes[byte_cnt++] = record->format;
+  bytes[byte_cnt++] = record->format >> 8;
+  for (uint8_t shift=0;shift<32;shift+=8) {
+    bytes[byte_cnt++] = record->timestamp >> shift;
+  }
+  for (uint8_t ndx=0;ndx<record->arg_cnt;ndx++) {
+    for (uint8_t shift=0;shift<32;shift+=8) {
+      bytes[byte_cnt++] = (uint32_t)record->args[ndx] >> shift;
+    }
+  }
+  AxonHostLogWrite(bytes, byte_cnt);
+#else
+  char print_buffer[100];
+
+  snprintf(print_buffer, sizeof(print_buffer), axon_deferred_log_formats[record->format],
+      record->args[0], record->args[1], record->args[2], record->args[3]);
+  AxonHostLog(NULL, print_buffer);
+#endif
+}
+
+void AxonDeferredLogDrain() {
+  AxonDeferredLogRecordStruct record;
+  uint32_t dropped_cnt;
+
+  while (axon_deferred_log_info.tail != axon_deferred_log_info.head) {
+    // copy it out so the slot can be reused while it is being written.
+    record = axon_deferred_log_info.records[axon_deferred_log_info.tail & (AXON_DEFERRED_LOG_RECORD_CNT-1)];
+    axon_deferred_log_info.tail++;
+    axon_deferred_log_output(&record);
+  }
+
+  dropped_cnt = axon_deferred_log_info.dropped_cnt;
+  if (dropped_cnt != axon_deferred_log_info.reported_dropped_cnt) {
+    record.timestamp = AxonHostGetTime();
+    record.format = kAxonDeferredLogDropped;
+    record.arg_cnt = axon_deferred_log_arg_cnts[kAxonDeferredLogDropped];
+    record.args[0] = dropped_cnt-axon_deferred_log_info.reported_dropped_cnt;
+    axon_deferred_log_info.reported_dropped_cnt = dropped_cnt;
+    axon_deferred_log_output(&record);
+  }
+}
+
+uint32_t AxonDeferredLogDroppedCnt() {
+  return axon_deferred_log_info.dropped_cnt;
+}
+#endif
@@ -0,0 +1,262 @@
+/**
+ *          Copyright (c) 2020-2022, Atlazo Inc.
+ *          All rights reserved.
+ *
+ *          Licensed under the Apache License, Version 2.0 (the "License");
+ *          you may not use this file except in compliance with the License.
+ *          You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *          Unless required by applicable law or agreed to in writing, software
+ *          distributed under the License is distributed on an "AS IS" BASIS,
+ *          WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *          See the License for the specific language governing permissions and
+ *          limitations under the License.
+ *
+ */
+#include <stdint.h>
+#include <string.h>
+
+#include "axon_api.h"
+#include "axon_dep.h"
+#include "axon_kws_stats_api.h"
+
+/*
+ * only accessed w/ interrupts disabled. AxonHostGetTime() wraps, so the elapsed time is accumulated
+ * on every update rather than taken from the reset time.
+ */
+static struct {
+  uint32_t counts[kAxonKwsStatsCountCount];
+  AxonKwsStatsStageStruct stages[kAxonKwsStatsStageCount];
+  uint64_t elapsed_ticks;
+  uint32_t last_time;
+  uint64_t axon_busy_ticks;
+} axon_kws_stats_info;
+
+#if AXON_KWS_STATS
+/*
+ * Axon busy tracking, also only accessed w/ interrupts disabled. Kept apart from axon_kws_stats_info so a
+ * reset doesn't lose the op lists still in flight.
+ */
+typedef struct {
+  AxonMgrQueuedOpsStruct *ops_info; // NULL when free
+  void *callback_context;           // the caller's
+  void (*callback_function)(AxonResultEnum result, void *callback_context);
+} AxonKwsStatsQueuedListStruct;
+
+static struct {
+  AxonKwsStatsQueuedListStruct queued_lists[AXON_KWS_STATS_QUEUED_LIST_CNT];
+  uint32_t outstanding_cnt;         // op lists Axon has
+  uint32_t busy_start_time;         // when outstanding_cnt last went up from 0
+} axon_kws_stats_busy_info;
+#endif
+
+static void axon_kws_stats_update_elapsed() {
+  uint32_t now = AxonHostGetTime();
+
+  axon_kws_stats_info.elapsed_ticks += now-axon_kws_stats_info.last_time;
+  axon_kws_stats_info.last_time = now;
+}
+
+#if AXON_KWS_STATS
+void AxonKwsStatsCount(AxonKwsStatsCountEnum counter, uint32_t cnt) {
+  uint32_t interrupt_state;
+
+  if (counter >= kAxonKwsStatsCountCount) {
+    return;
+  }
+  interrupt_state = AxonHostDisableInterrupts();
+  axon_kws_stats_info.counts[counter] += cnt;
+  axon_kws_stats_update_elapsed();
+  AxonHostRestoreInterrupts(interrupt_state);
+}
+
+/*
+ * the axon_kws_stats_busy_*() functions are called w/ interrupts disabled.
+ */
+static void axon_kws_stats_busy_start() {
+  if (0==axon_kws_stats_busy_info.outstanding_cnt++) {
+    axon_kws_stats_busy_info.busy_start_time = AxonHostGetTime();
+  }
+}
+
+static void axon_kws_stats_busy_end() {
+  if (0==--axon_kws_stats_busy_info.outstanding_cnt) {
+    axon_kws_stats_info.axon_busy_ticks += AxonHostGetTime()-axon_kws_stats_busy_info.busy_start_time;
+  }
+}
+
+/*
+ * the driver refused the op list, so Axon never had it.
+ */
+static void axon_kws_stats_busy_cancel() {
+  axon_kws_stats_busy_info.outstanding_cnt--;
+}
+
+static void axon_kws_stats_ops_accepted(uint32_t op_count) {
+  axon_kws_stats_info.counts[kAxonKwsStatsOpListsIssued]++;
+  axon_kws_stats_info.counts[kAxonKwsStatsOpsIssued] += op_count;
+}
+
+/*
+ * Completion callback of a timed queued op list. Puts the caller's callback back before calling it, so it
+ * can queue the list again.
+ */
+static void axon_kws_stats_queued_list_complete(AxonResultEnum result, void *callback_context) {
+  AxonKwsStatsQueuedListStruct *queued_list = (AxonKwsStatsQueuedListStruct *)callback_context;
+  void (*callback_function)(AxonResultEnum result, void *callback_context);
+  uint32_t interrupt_state;
+
+  interrupt_state = AxonHostDisableInterrupts();
+  callback_function = queued_list->callback_function;
+  callback_context = queued_list->callback_context;
+  queued_list->ops_info->callback_function = callback_function;
+  queued_list->ops_info->callback_context = callback_context;
+  queued_list->ops_info = NULL;
+  axon_kws_stats_busy_end();
+  axon_kws_stats_update_elapsed();
+  AxonHostRestoreInterrupts(interrupt_state);
+
+  if (NULL != callback_function) {
+    callback_function(result, callback_context);
+  }
+}
+
+AxonResultEnum AxonKwsStatsQueueOpsList(void *axon_handle, AxonMgrQueuedOpsStruct *ops_info) {
+  AxonKwsStatsQueuedListStruct *queued_list = NULL;
+  uint32_t op_count = ops_info->op_handle_count;
+  AxonResultEnum result;
+  uint32_t interrupt_state;
+
+  interrupt_state = AxonHostDisableInterrupts();
+  for (uint8_t ndx=0;ndx<AXON_KWS_STATS_QUEUED_LIST_CNT;ndx++) {
+    if (NULL==axon_kws_stats_busy_info.queued_lists[ndx].ops_info) {
+      queued_list = &axon_kws_stats_busy_info.queued_lists[ndx];
+      break;
+    }
+  }
+  if (NULL != queued_list) {
+    // it can complete before AxonApiQueueOpsList() returns, so everything is in place first.
+    queued_list->ops_info = ops_info;
+    queued_list->callback_function = ops_info->callback_function;
+    queued_list->callback_context = ops_info->callback_context;
+    ops_info->callback_function = axon_kws_stats_queued_list_complete;
+    ops_info->callback_context = queued_list;
+    axon_kws_stats_busy_start();
+  }
+  AxonHostRestoreInterrupts(interrupt_state);
+
+  result = AxonApiQueueOpsList(axon_handle, ops_info);
+
+  interrupt_state = AxonHostDisableInterrupts();
+  if (kAxonResultSuccess > result) {
+    if (NULL != queued_list) {
+      ops_info->callback_function = queued_list->callback_function;
+      ops_info->callback_context = queued_list->callback_context;
+      queued_list->ops_info = NULL;
+      axon_kws_stats_busy_cancel();
+    }
+  } else {
+    axon_kws_stats_ops_accepted(op_count);
+  }
+  axon_kws_stats_update_elapsed();
+  AxonHostRestoreInterrupts(interrupt_state);
+  return result;
+}
+
+AxonResultEnum AxonKwsStatsExecuteOps(void *axon_handle, uint32_t op_count, AxonOpHandle ops[], AxonAsyncModeEnum async_mode) {
+  uint8_t timed = kAxonAsyncModeAsynchronous != async_mode; // synchronous, Axon is done when it returns
+  AxonResultEnum result;
+  uint32_t interrupt_state;
+
+  if (timed) {
+    interrupt_state = AxonHostDisableInterrupts();
+    axon_kws_stats_busy_start();
+    AxonHostRestoreInterrupts(interrupt_state);
+  }
+
+  result = AxonApiExecuteOps(axon_handle, op_count, ops, async_mode);
+
+  interrupt_state = AxonHostDisableInterrupts();
+  if (kAxonResultSuccess > result) {
+    if (timed) {
+      axon_kws_stats_busy_cancel();
+    }
+  } else {
+    if (timed) {
+      axon_kws_stats_busy_end();
+    }
+    axon_kws_stats_ops_accepted(op_count);
+  }
+  axon_kws_stats_update_elapsed();
+  AxonHostRestoreInterrupts(interrupt_state);
+  return result;
+}
+
+void AxonKwsStatsStage(AxonKwsStatsStageEnum stage, uint32_t ticks) {
+  AxonKwsStatsStageStruct *stage_stats;
+  uint32_t interrupt_state;
+
+  if (stage >= kAxonKwsStatsStageCount) {
+    return;
+  }
+  stage_stats = &axon_kws_stats_info.stages[stage];
+  interrupt_state = AxonHostDisableInterrupts();
+  if ((0==stage_stats->count) || (ticks < stage_stats->min_ticks)) {
+    stage_stats->min_ticks = ticks;
+  }
+  if (ticks > stage_stats->max_ticks) {
+    stage_stats->max_ticks = ticks;
+  }
+  stage_stats->count++;
+  stage_stats->total_ticks += ticks;
+  axon_kws_stats_update_elapsed();
+  AxonHostRestoreInterrupts(interrupt_state);
+}
+#endif
+
+void AxonKwsStatsGet(AxonKwsStatsStruct *stats) {
+  uint64_t busy_ticks = 0;
+  uint32_t interrupt_state;
+
+  interrupt_state = AxonHostDisableInterrupts();
+  axon_kws_stats_update_elapsed();
+  memcpy(stats->counts, axon_kws_stats_info.counts, sizeof(stats->counts));
+  memcpy(stats->stages, axon_kws_stats_info.stages, sizeof(stats->stages));
+  stats->elapsed_ticks = axon_kws_stats_info.elapsed_ticks;
+  stats->axon_busy_ticks = axon_kws_stats_info.axon_busy_ticks;
+#if AXON_KWS_STATS
+  if (axon_kws_stats_busy_info.outstanding_cnt) {
+    stats->axon_busy_ticks += axon_kws_stats_info.last_time-axon_kws_stats_busy_info.busy_start_time;
+  }
+#endif
+  AxonHostRestoreInterrupts(interrupt_state);
+
+  // the divisions are left to here, outside the critical section.
+  for (uint8_t stage=0;stage<kAxonKwsStatsStageCount;stage++) {
+    stats->stages[stage].avg_ticks = stats->stages[stage].count ?
+        stats->stages[stage].total_ticks/stats->stages[stage].count : 0;
+    busy_ticks += stats->stages[stage].total_ticks;
+  }
+  stats->vad_windows_per_1000_frames = stats->counts[kAxonKwsStatsFramesProcessed] ?
+      (uint64_t)1000*stats->counts[kAxonKwsStatsVadWindows]/stats->counts[kAxonKwsStatsFramesProcessed] : 0;
+  stats->pipeline_busy_percent = 0;
+  if (stats->elapsed_ticks) {
+    busy_ticks = 100*busy_ticks/stats->elapsed_ticks;
+    stats->pipeline_busy_percent = busy_ticks > 100 ? 100 : busy_ticks;
+  }
+  stats->axon_busy_percent = stats->elapsed_ticks ? 100*stats->axon_busy_ticks/stats->elapsed_ticks : 0;
+}
+
+void AxonKwsStatsReset() {
+  uint32_t interrupt_state;
+
+  interrupt_state = AxonHostDisableInterrupts();
+  memset(&axon_kws_stats_info, 0, sizeof(axon_kws_stats_info));
+  axon_kws_stats_info.last_time = AxonHostGetTime();
+#if AXON_KWS_STATS
+  axon_kws_stats_busy_info.busy_start_time = axon_kws_stats_info.last_time; // lists in flight count from now
+#endif
+  AxonHostRestoreInterrupts(interrupt_state);
+}
@@ -22,6 +22,8 @@
 #include "axon_api.h"
 #include "axon_dep.h"
 #include "axon_logging_api.h"
+#include "axon_deferred_log_api.h"
+#include "axon_crc32_api.h"
 
 /*
  * Formats a string and prints it via AxonHostLog()
@@ -40,7 +42,67 @@ void axon_printf(void *axon_handle, char *fmt_string, ...) {
    AxonHostLog(axon_instance, axon_instance->host_provided.log_buffer);
 }
 
+#if AXON_LOGGING_DUMP_VECTOR
+void dump_vector(void *axon_handle, const char *tag, const void *vector_ptr, AxonLoggingDumpTypeEnum type, uint8_t q,
+    uint32_t count, uint8_t stride, uint32_t start_index) {
+  uint8_t element_size = AXON_LOGGING_DUMP_ELEMENT_SIZE(type);
+  const uint8_t *elements = (const uint8_t *)vector_ptr;
+  uint8_t bytes[64]; // header and tag, then gathered elements
+  uint32_t byte_cnt = 0;
+  uint32_t tag_len = strlen(tag);
+  uint32_t crc;
+  (void)axon_handle;
+
+  if (tag_len > 255) {
+    tag_len = 255;
+  }
+  bytes[byte_cnt++] = AXON_LOGGING_DUMP_MARKER;
+  bytes[byte_cnt++] = type;
+  bytes[byte_cnt++] = q;
+  bytes[byte_cnt++] = tag_len;
+  for (uint8_t shift=0;shift<32;shift+=8) {
+    bytes[byte_cnt++] = count >> shift;
+  }
+  crc = AxonCrc32(0, bytes+1, byte_cnt-1);
+  AxonHostLogWrite(bytes, byte_cnt);
+  crc = AxonCrc32(crc, tag, tag_len);
+  AxonHostLogWrite((const uint8_t *)tag, tag_len);
+
+  if ((1==stride) && (0==start_index)) {
+    // contiguous, send it as is (the target is little endian).
+    crc = AxonCrc32(crc, elements, count*element_size);
+    AxonHostLogWrite(elements, count*element_size);
+  } else {
+    byte_cnt = 0;
+    start_index *= stride;
+    for (uint32_t ndx=0;ndx<count;ndx++) {
+      memcpy(&bytes[byte_cnt], elements+start_index*element_size, element_size);
+      byte_cnt += element_size;
+      if (byte_cnt==sizeof(bytes)) {
+        crc = AxonCrc32(crc, bytes, byte_cnt);
+        AxonHostLogWrite(bytes, byte_cnt);
+        byte_cnt = 0;
+      }
+      start_index += stride;
+      if (start_index >= count*stride) {
+        start_index = 0;
+      }
+    }
+    crc = AxonCrc32(crc, bytes, byte_cnt);
+    AxonHostLogWrite(bytes, byte_cnt);
+  }
+
+  for (byte_cnt=0;byte_cnt<4;byte_cnt++) {
+    bytes[byte_cnt] = crc >> (8*byte_cnt);
+  }
+  AxonHostLogWrite(bytes, 4);
+}
+#endif
+
 void print_float_vector(void *axon_handle, char *name, float *vector_ptr, uint32_t count, uint8_t stride) {
+#if AXON_LOGGING_BINARY_DUMP
+  dump_vector(axon_handle, name, vector_ptr, kAxonLoggingDumpFloat, 0, count, stride, 0);
+#else
   char printbuffer[20]; // sized big enough for longest integer.
   AxonHostLog(axon_handle, "float ");;
 
@@ -53,9 +115,13 @@ void print_float_vector(void *axon_handle, char *name, float *vector_ptr, uint32
     AxonHostLog(axon_handle, printbuffer);
   }
   AxonHostLog(axon_handle, "\r\n}\r\n");
+#endif
 }
 
 void print_int32_vector(void *axon_handle, char *name, int32_t *vector_ptr, uint32_t count, uint8_t stride) {
+#if AXON_LOGGING_BINARY_DUMP
+  dump_vector(axon_handle, name, vector_ptr, kAxonLoggingDumpInt32, 0, count, stride, 0);
+#else
   char printbuffer[20]; // sized big enough for longest integer.
 
   AxonHostLog(axon_handle, "int32_t ");;
@@ -69,12 +135,16 @@ void print_int32_vector(void *axon_handle, char *name, int32_t *vector_ptr, uint
     AxonHostLog(axon_handle, printbuffer);
   }
   AxonHostLog(axon_handle, "\r\n}\r\n");
+#endif
 }
 
 void print_int16_vector(void *axon_handle, char *name, int16_t *vector_ptr, uint32_t count, uint8_t stride) {
   print_int16_circ_buffer(axon_handle, name, vector_ptr, count, stride, 0);
 }
 void print_int16_circ_buffer(void *axon_handle, char *name, int16_t *vector_ptr, uint32_t count, uint8_t stride, uint32_t start_index) {
+#if AXON_LOGGING_BINARY_DUMP
+  dump_vector(axon_handle, name, vector_ptr, kAxonLoggingDumpInt16, 0, count, stride, start_index);
+#else
   char printbuffer[20]; // sized big enough for longest integer.
   uint32_t sample_ndx;
 
@@ -92,10 +162,13 @@ void print_int16_circ_buffer(void *axon_handle, char *name, int16_t *vector_ptr,
     }
   }
   AxonHostLog(axon_handle, "\r\n}\r\n");
-
+#endif
 }
 
 void print_int8_vector(void *axon_handle, char *name, int8_t *vector_ptr, uint32_t count) {
+#if AXON_LOGGING_BINARY_DUMP
+  dump_vector(axon_handle, name, vector_ptr, kAxonLoggingDumpInt8, 0, count, 1, 0);
+#else
   char printbuffer[20]; // sized big enough for longest integer.
   AxonHostLog(axon_handle, "int8_t ");
 
@@ -107,6 +180,7 @@ void print_int8_vector(void *axon_handle, char *name, int8_t *vector_ptr, uint32
     AxonHostLog(axon_handle, printbuffer);
   }
   AxonHostLog(axon_handle, "\r\n}\r\n");
+#endif
 }
 
 
@@ -114,6 +188,11 @@ void print_int8_vector(void *axon_handle, char *name, int8_t *vector_ptr, uint32
  * utility for printing a vector to the debug console.
  */
 void PrintVector(void *axon_handle, char *name, uint8_t *vector_ptr, uint32_t count, uint8_t element_size) {
+#if AXON_LOGGING_BINARY_DUMP
+  if ((1==element_size) || (2==element_size) || (4==element_size)) {
+    dump_vector(axon_handle, name, vector_ptr, (AxonLoggingDumpTypeEnum)element_size, 0, count, 1, 0);
+  }
+#else
   char printbuffer[20]; // sized big enough for longest integer.
   int32_t element_value = 0;
   switch (element_size) {
@@ -132,4 +211,5 @@ void PrintVector(void *axon_handle, char *name, uint8_t *vector_ptr, uint32_t co
     vector_ptr+=element_size;
   }
   AxonHostLog(axon_handle, "\r\n}\r\n");
+#endif
 }